@@ -0,0 +1,108 @@
+#ifndef CRESCENT_API_API_SERVER_H
+#define CRESCENT_API_API_SERVER_H
+
+#include "api/HttpServer.h"
+#include "api/ResponseCache.h"
+#include "creature_engine/core/CreatureCore.h"
+#include "creature_engine/core/CreatureRegistry.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace crescent::api {
+
+/**
+ * @brief Embeddable loopback HTTP/1.1 server for creature state
+ *
+ * Serves over an HttpServer, whose epoll I/O threads handle every request;
+ * simulation threads are never used for request handling. Built-in routes:
+ *
+ *   GET /creatures                  ids and versions
+ *   GET /creatures/<id>             CreatureCore::serializeToJson
+ *   GET /creatures/<id>/traits      CreatureCore::getTraits().serializeToJson
+ *   GET /creatures/<id>/abilities   CreatureCore::getAbilities()
+ *                                   .serializeToJson
+ *
+ * Creature responses carry ETag "<target>-h<handle>-v<version>" built from
+ * the registry handle (slot and generation) and version, so a creature
+ * removed and re-added under the same id never matches an old tag. A
+ * matching If-None-Match gets 304 from the lock-free version alone, without
+ * touching the creature; otherwise the body comes from the ResponseCache
+ * and is only re-serialized (under the registry's shared lock) when the
+ * handle or version moved.
+ */
+class ApiServer {
+  public:
+    using Config = HttpServer::Config;
+    using ServerMetrics = HttpServer::ServerMetrics;
+
+    explicit ApiServer(CreatureRegistry &registry);
+    ApiServer(CreatureRegistry &registry, Config config);
+    ~ApiServer() = default;
+
+    // Prevent copying and moving
+    ApiServer(const ApiServer &) = delete;
+    ApiServer &operator=(const ApiServer &) = delete;
+    ApiServer(ApiServer &&) = delete;
+    ApiServer &operator=(ApiServer &&) = delete;
+
+    /**
+     * @brief Binds and starts the I/O threads
+     * @throws std::system_error if the socket cannot be bound
+     */
+    void start() { http_.start(); }
+    void stop() { http_.stop(); }
+    bool isRunning() const { return http_.isRunning(); }
+    std::uint16_t getBoundPort() const { return http_.getBoundPort(); }
+
+    /**
+     * @brief Registers an extra route; must be called before start()
+     */
+    void addRoute(std::string prefix, RouteHandler handler) {
+        http_.addRoute(std::move(prefix), std::move(handler));
+    }
+
+    ResponseCache &getCache() { return cache_; }
+    ServerMetrics getMetrics() const { return http_.getMetrics(); }
+
+  private:
+    CreatureRegistry &registry_;
+    ResponseCache cache_;
+    HttpServer http_; // Declared last: its threads use the members above
+
+    // Creature resources served under /creatures/<id>
+    enum class CreatureView { Full, Traits, Abilities };
+
+    /**
+     * @brief Body for one view, read from the creature's own owners
+     */
+    static std::string serializeView(const CreatureCore &creature,
+                                     CreatureView view) {
+        switch (view) {
+        case CreatureView::Traits:
+            return creature.getTraits().serializeToJson().dump();
+        case CreatureView::Abilities:
+            return creature.getAbilities().serializeToJson().dump();
+        case CreatureView::Full:
+            break;
+        }
+        return creature.serializeToJson().dump();
+    }
+
+    // Internal helpers
+    std::optional<RouteResponse> serveCreature(const HttpRequest &request,
+                                               std::string_view target);
+    std::optional<RouteResponse> serveCreatureView(const HttpRequest &request,
+                                                   CreatureHandle handle,
+                                                   std::string_view key,
+                                                   CreatureView view);
+    std::optional<RouteResponse> serveCreatureList();
+    void registerBuiltinRoutes();
+};
+
+} // namespace crescent::api
+
+#endif // CRESCENT_API_API_SERVER_H
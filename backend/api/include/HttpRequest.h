@@ -0,0 +1,132 @@
+#ifndef CRESCENT_API_HTTP_REQUEST_H
+#define CRESCENT_API_HTTP_REQUEST_H
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+
+namespace crescent::api {
+
+enum class HttpMethod { Get, Head, Other };
+
+/**
+ * @brief Parsed HTTP/1.1 request head
+ *
+ * All views point into the connection's read buffer and are only valid until
+ * that buffer is compacted for the next request.
+ */
+struct HttpRequest {
+    static constexpr std::size_t MAX_HEADERS = 32;
+
+    struct Header {
+        std::string_view name;
+        std::string_view value;
+    };
+
+    HttpMethod method{HttpMethod::Other};
+    std::string_view target;
+    bool keepAlive{true};
+    std::array<Header, MAX_HEADERS> headers{};
+    std::size_t headerCount{0};
+
+    /**
+     * @brief Case-insensitive header lookup
+     */
+    std::string_view header(std::string_view name) const {
+        for (std::size_t i = 0; i < headerCount; ++i) {
+            if (equalsIgnoreCase(headers[i].name, name)) {
+                return headers[i].value;
+            }
+        }
+        return {};
+    }
+
+    static bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (std::size_t i = 0; i < a.size(); ++i) {
+            const char x = a[i] >= 'A' && a[i] <= 'Z' ? a[i] + 32 : a[i];
+            const char y = b[i] >= 'A' && b[i] <= 'Z' ? b[i] + 32 : b[i];
+            if (x != y) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+enum class ParseStatus {
+    Complete,   // Request head parsed; consumed bytes reported
+    Incomplete, // Need more bytes
+    Invalid     // Malformed or oversized; close the connection
+};
+
+/**
+ * @brief Parses one request head without allocating
+ * @param input Bytes received so far
+ * @param request Filled in on Complete
+ * @param consumed Length of the head including the blank line
+ *
+ * Request bodies are not supported; the API is read-only.
+ */
+inline ParseStatus parseHttpRequest(std::string_view input,
+                                    HttpRequest &request,
+                                    std::size_t &consumed) {
+    const std::size_t headEnd = input.find("\r\n\r\n");
+    if (headEnd == std::string_view::npos) {
+        return input.size() > 16 * 1024 ? ParseStatus::Invalid
+                                         : ParseStatus::Incomplete;
+    }
+    std::string_view head = input.substr(0, headEnd + 2);
+
+    const std::size_t lineEnd = head.find("\r\n");
+    const std::string_view line = head.substr(0, lineEnd);
+    const std::size_t firstSpace = line.find(' ');
+    const std::size_t secondSpace = line.find(' ', firstSpace + 1);
+    if (firstSpace == std::string_view::npos ||
+        secondSpace == std::string_view::npos) {
+        return ParseStatus::Invalid;
+    }
+    const std::string_view method = line.substr(0, firstSpace);
+    const std::string_view version = line.substr(secondSpace + 1);
+    request.method = method == "GET"    ? HttpMethod::Get
+                     : method == "HEAD" ? HttpMethod::Head
+                                        : HttpMethod::Other;
+    request.target = line.substr(firstSpace + 1, secondSpace - firstSpace - 1);
+    request.keepAlive = version == "HTTP/1.1";
+    request.headerCount = 0;
+
+    head.remove_prefix(lineEnd + 2);
+    while (!head.empty()) {
+        const std::size_t end = head.find("\r\n");
+        const std::string_view field = head.substr(0, end);
+        head.remove_prefix(end + 2);
+        const std::size_t colon = field.find(':');
+        if (colon == std::string_view::npos ||
+            request.headerCount == HttpRequest::MAX_HEADERS) {
+            return ParseStatus::Invalid;
+        }
+        std::string_view value = field.substr(colon + 1);
+        const std::size_t first = value.find_first_not_of(" \t");
+        const std::size_t last = value.find_last_not_of(" \t");
+        value = first == std::string_view::npos
+                    ? std::string_view{}
+                    : value.substr(first, last - first + 1);
+        request.headers[request.headerCount++] = {field.substr(0, colon),
+                                                  value};
+    }
+
+    const std::string_view connection = request.header("Connection");
+    if (HttpRequest::equalsIgnoreCase(connection, "close")) {
+        request.keepAlive = false;
+    } else if (HttpRequest::equalsIgnoreCase(connection, "keep-alive")) {
+        request.keepAlive = true;
+    }
+    consumed = headEnd + 4;
+    return ParseStatus::Complete;
+}
+
+} // namespace crescent::api
+
+#endif // CRESCENT_API_HTTP_REQUEST_H
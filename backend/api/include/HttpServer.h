@@ -0,0 +1,157 @@
+#ifndef CRESCENT_API_HTTP_SERVER_H
+#define CRESCENT_API_HTTP_SERVER_H
+
+#include "api/HttpRequest.h"
+#include "api/ResponseCache.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace crescent::api {
+
+/**
+ * @brief Response produced by a route handler
+ *
+ * A 304 carries only the ETag of its body; any other status with no body
+ * is sent with an empty one.
+ */
+struct RouteResponse {
+    int status{200};
+    CachedResponseRef body; // Shared with the cache; never copied
+};
+
+/**
+ * @brief Read-only resource handler
+ * @param request Parsed request, for conditional headers
+ * @param target Request target after the route prefix
+ * @return Response, or nullopt for 404
+ */
+using RouteHandler = std::function<std::optional<RouteResponse>(
+    const HttpRequest &request, std::string_view target)>;
+
+/**
+ * @brief Non-blocking HTTP/1.1 transport with prefix routing
+ *
+ * Each I/O thread runs its own epoll loop and accepts from the shared
+ * listening socket (registered with EPOLLEXCLUSIVE, so one loop wakes per
+ * connection). A connection stays on the loop that accepted it: requests
+ * are parsed in place from its read buffer, pipelined requests are
+ * answered in order, and keep-alive connections are closed after
+ * idleTimeoutMs without traffic. Handlers run on the I/O thread.
+ *
+ * Routes are matched by longest prefix. If-None-Match equal to a body's
+ * ETag turns the response into a 304; HEAD gets the GET headers without
+ * the body; other methods get 405.
+ */
+class HttpServer {
+  public:
+    struct Config {
+        std::string bindAddress{"127.0.0.1"}; // Loopback only by default
+        std::uint16_t port{8420};             // 0 picks a free port
+        std::size_t ioThreads{1};
+        std::size_t maxConnections{1024};
+        std::size_t readBufferSize{16 * 1024};
+        int idleTimeoutMs{30000};
+    };
+
+    HttpServer();
+    explicit HttpServer(Config config);
+    ~HttpServer();
+
+    // Prevent copying and moving
+    HttpServer(const HttpServer &) = delete;
+    HttpServer &operator=(const HttpServer &) = delete;
+    HttpServer(HttpServer &&) = delete;
+    HttpServer &operator=(HttpServer &&) = delete;
+
+    /**
+     * @brief Binds and starts the I/O threads
+     * @throws std::system_error if the socket cannot be bound
+     */
+    void start();
+
+    /**
+     * @brief Stops the I/O threads and closes every connection
+     */
+    void stop();
+    bool isRunning() const { return running_.load(); }
+    std::uint16_t getBoundPort() const { return boundPort_; }
+
+    /**
+     * @brief Registers a route; must be called before start()
+     */
+    void addRoute(std::string prefix, RouteHandler handler);
+
+    /**
+     * @brief Server-side counters
+     */
+    struct ServerMetrics {
+        std::uint64_t requests{0};
+        std::uint64_t notModified{0};
+        std::uint64_t notFound{0};
+        std::uint64_t errors{0}; // Malformed requests and handler failures
+        std::uint64_t openConnections{0};
+    };
+    ServerMetrics getMetrics() const;
+
+    /**
+     * @brief Appends a full response for request to output
+     *
+     * Turns a matching If-None-Match into 304 and drops the body for HEAD.
+     * @return Status actually written
+     */
+    static int writeResponse(const HttpRequest &request,
+                             const RouteResponse &response,
+                             std::string &output);
+
+    /**
+     * @brief Whether If-None-Match names etag (or is "*")
+     */
+    static bool matchesIfNoneMatch(const HttpRequest &request,
+                                   std::string_view etag);
+
+  private:
+    Config config_;
+
+    // Listener and I/O loops
+    int listenFd_{-1};
+    std::uint16_t boundPort_{0};
+    std::atomic<bool> running_{false};
+    struct IoLoop;
+    std::vector<std::unique_ptr<IoLoop>> loops_;
+    std::vector<std::thread> threads_;
+
+    // Routing
+    struct Route {
+        std::string prefix;
+        RouteHandler handler;
+    };
+    std::vector<Route> routes_; // Longest prefix first
+
+    // Metrics
+    std::atomic<std::uint64_t> requests_{0};
+    std::atomic<std::uint64_t> notModified_{0};
+    std::atomic<std::uint64_t> notFound_{0};
+    std::atomic<std::uint64_t> errors_{0};
+    std::atomic<std::uint64_t> openConnections_{0};
+
+    // Internal helpers
+    void runLoop(IoLoop &loop);
+    void acceptConnections(IoLoop &loop);
+    bool readConnection(IoLoop &loop, int fd);
+    bool flushConnection(IoLoop &loop, int fd);
+    void closeConnection(IoLoop &loop, int fd);
+    void closeIdleConnections(IoLoop &loop);
+    void handleRequest(const HttpRequest &request, std::string &output);
+};
+
+} // namespace crescent::api
+
+#endif // CRESCENT_API_HTTP_SERVER_H
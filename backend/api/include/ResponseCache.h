@@ -0,0 +1,134 @@
+#ifndef CRESCENT_API_RESPONSE_CACHE_H
+#define CRESCENT_API_RESPONSE_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace crescent::api {
+
+/**
+ * @brief Identity and version of the resource a body was built from
+ *
+ * Registry versions are per slot, so a version alone cannot tell a creature
+ * from one later registered under the same id. The packed handle carries the
+ * slot generation, which changes on every reuse, so a removed and re-added
+ * creature never matches an old body or ETag.
+ */
+struct ResourceVersion {
+    std::uint64_t handle{0};  // Packed CreatureHandle
+    std::uint64_t version{0}; // Registry version of that handle
+
+    bool operator==(const ResourceVersion &other) const {
+        return handle == other.handle && version == other.version;
+    }
+    bool operator!=(const ResourceVersion &other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Serialized response body tagged with the version it was built from
+ *
+ * Bodies are immutable once published and shared with in-flight writes, so
+ * an I/O thread can keep sending one while a newer version replaces it.
+ */
+struct CachedResponse {
+    ResourceVersion version;
+    std::string etag; // Quoted, e.g. "\"/creatures/c42-h300000007-v17\""
+    std::string body;
+    std::string contentType{"application/json"};
+};
+
+using CachedResponseRef = std::shared_ptr<const CachedResponse>;
+
+/**
+ * @brief Version-keyed cache of serialized resource bodies
+ *
+ * Keys are request targets ("/creatures/<id>"). A lookup only hits when the
+ * stored handle and version both equal the resource's current ones, which
+ * callers read lock-free from the CreatureRegistry; unchanged creatures are
+ * therefore never re-serialized. Sharded so I/O threads rarely share a lock.
+ */
+class ResponseCache {
+  public:
+    static constexpr std::size_t SHARD_COUNT = 16;
+
+    explicit ResponseCache(std::size_t maxEntriesPerShard = 4096);
+
+    /**
+     * @brief Returns the cached body if it matches the current version
+     *
+     * Counts a hit or a miss.
+     */
+    CachedResponseRef lookup(std::string_view key,
+                             const ResourceVersion &current) const;
+
+    /**
+     * @brief Returns a fresh body, building it with serialize() on a miss
+     *
+     * serialize() runs without the shard lock, so concurrent misses on one
+     * key may each build; the last one stored wins. When a shard is full
+     * an arbitrary entry is evicted.
+     */
+    CachedResponseRef
+    getOrBuild(std::string_view key, const ResourceVersion &current,
+               const std::function<std::string()> &serialize);
+
+    /**
+     * @brief Publishes a body built at version, replacing any older one
+     */
+    CachedResponseRef store(std::string_view key,
+                            const ResourceVersion &version, std::string body);
+
+    void invalidate(std::string_view key);
+    void clear();
+
+    /**
+     * @brief Quoted "<key>-h<handle hex>-v<version>"
+     *
+     * Characters not allowed in an entity tag are written as '_'.
+     */
+    static std::string makeETag(std::string_view key,
+                                const ResourceVersion &version);
+
+    /**
+     * @brief Cache effectiveness counters
+     */
+    struct CacheMetrics {
+        std::uint64_t hits{0};
+        std::uint64_t misses{0};
+        std::uint64_t notModified{0}; // Served as 304
+        std::uint64_t evictions{0};
+    };
+    CacheMetrics getMetrics() const;
+    void recordNotModified();
+
+  private:
+    struct alignas(64) Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, CachedResponseRef> entries;
+        // Relaxed counters, so const lookups can count
+        mutable std::atomic<std::uint64_t> hits{0};
+        mutable std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::uint64_t> evictions{0};
+    };
+
+    std::size_t maxEntriesPerShard_;
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<std::uint64_t> notModified_{0};
+
+    Shard &shardFor(std::string_view key);
+    const Shard &shardFor(std::string_view key) const;
+};
+
+} // namespace crescent::api
+
+#endif // CRESCENT_API_RESPONSE_CACHE_H
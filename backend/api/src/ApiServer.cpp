@@ -0,0 +1,119 @@
+#include "api/ApiServer.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace crescent::api {
+
+namespace {
+
+constexpr std::string_view CREATURES_PREFIX = "/creatures";
+
+} // namespace
+
+ApiServer::ApiServer(CreatureRegistry &registry)
+    : ApiServer(registry, Config{}) {}
+
+ApiServer::ApiServer(CreatureRegistry &registry, Config config)
+    : registry_(registry), http_(std::move(config)) {
+    registerBuiltinRoutes();
+}
+
+void ApiServer::registerBuiltinRoutes() {
+    http_.addRoute(std::string(CREATURES_PREFIX),
+                   [this](const HttpRequest &request, std::string_view target) {
+                       return serveCreature(request, target);
+                   });
+}
+
+std::optional<RouteResponse>
+ApiServer::serveCreature(const HttpRequest &request, std::string_view target) {
+    if (target.empty() || target == "/") {
+        return serveCreatureList();
+    }
+    if (target.front() != '/') {
+        return std::nullopt; // "/creaturesX"
+    }
+    std::string_view id = target.substr(1);
+    CreatureView view = CreatureView::Full;
+    const std::size_t slash = id.find('/');
+    if (slash != std::string_view::npos) {
+        const std::string_view suffix = id.substr(slash + 1);
+        if (suffix == "traits") {
+            view = CreatureView::Traits;
+        } else if (suffix == "abilities") {
+            view = CreatureView::Abilities;
+        } else {
+            return std::nullopt;
+        }
+        id = id.substr(0, slash);
+    }
+    const std::optional<CreatureHandle> handle =
+        registry_.find(std::string(id));
+    if (!handle) {
+        return std::nullopt;
+    }
+    const std::string key = std::string(CREATURES_PREFIX) + std::string(target);
+    return serveCreatureView(request, *handle, key, view);
+}
+
+std::optional<RouteResponse>
+ApiServer::serveCreatureView(const HttpRequest &request, CreatureHandle handle,
+                             std::string_view key, CreatureView view) {
+    const std::optional<std::uint64_t> version = registry_.getVersion(handle);
+    if (!version) {
+        return std::nullopt; // Removed since the id lookup
+    }
+    const ResourceVersion current{handle.pack(), *version};
+
+    // Conditional requests are answered from the version alone
+    std::string etag = ResponseCache::makeETag(key, current);
+    if (HttpServer::matchesIfNoneMatch(request, etag)) {
+        cache_.recordNotModified();
+        auto tag = std::make_shared<CachedResponse>();
+        tag->version = current;
+        tag->etag = std::move(etag);
+        return RouteResponse{304, std::move(tag)};
+    }
+
+    if (CachedResponseRef cached = cache_.lookup(key, current)) {
+        return RouteResponse{200, std::move(cached)};
+    }
+
+    // Tag the body with the version it was actually read at, which may be
+    // newer than current if a writer got in between
+    std::string body;
+    std::uint64_t readVersion = 0;
+    const bool live = registry_.read(
+        handle, [&](const CreatureCore &creature, std::uint64_t seen) {
+            body = serializeView(creature, view);
+            readVersion = seen;
+        });
+    if (!live) {
+        return std::nullopt;
+    }
+    return RouteResponse{
+        200, cache_.store(key, {handle.pack(), readVersion}, std::move(body))};
+}
+
+std::optional<RouteResponse> ApiServer::serveCreatureList() {
+    nlohmann::json list = nlohmann::json::array();
+    for (std::size_t shard = 0; shard < CreatureRegistry::SHARD_COUNT;
+         ++shard) {
+        registry_.forEachInShard(
+            shard, [this, &list](CreatureHandle handle,
+                                 const CreatureCore &creature) {
+                list.push_back(
+                    {{"id", creature.getIdentity().id},
+                     {"version", registry_.getVersion(handle).value_or(0)}});
+            });
+    }
+    auto response = std::make_shared<CachedResponse>();
+    response->body = list.dump();
+    return RouteResponse{200, std::move(response)};
+}
+
+} // namespace crescent::api
@@ -0,0 +1,68 @@
+// crescent_api_server: serves an empty creature registry over loopback,
+// for smoke tests and for api_load runs against the HTTP path alone.
+//
+// Usage: crescent_api_server [--port N] [--io-threads N]
+
+#include "api/ApiServer.h"
+#include "creature_engine/core/CreatureRegistry.h"
+
+#include <pthread.h>
+#include <signal.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+namespace {
+
+bool parseArguments(int argc, char **argv,
+                    crescent::api::ApiServer::Config &config) {
+    for (int i = 1; i < argc; ++i) {
+        const bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--port") == 0 && hasValue) {
+            config.port = static_cast<std::uint16_t>(std::stoul(argv[++i]));
+        } else if (std::strcmp(argv[i], "--io-threads") == 0 && hasValue) {
+            config.ioThreads = std::stoul(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    crescent::api::ApiServer::Config config;
+    try {
+        if (!parseArguments(argc, argv, config)) {
+            std::fprintf(stderr, "usage: %s [--port N] [--io-threads N]\n",
+                         argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        // Block the stop signals before any thread starts so that only the
+        // sigwait below ever receives them
+        sigset_t stopSignals;
+        sigemptyset(&stopSignals);
+        sigaddset(&stopSignals, SIGINT);
+        sigaddset(&stopSignals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+        crescent::CreatureRegistry registry;
+        crescent::api::ApiServer server(registry, config);
+        server.start();
+        std::printf("listening on %s:%u\n", config.bindAddress.c_str(),
+                    static_cast<unsigned>(server.getBoundPort()));
+
+        int received = 0;
+        sigwait(&stopSignals, &received);
+        server.stop();
+    } catch (const std::exception &error) {
+        std::fprintf(stderr, "crescent_api_server: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
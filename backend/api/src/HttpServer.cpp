@@ -0,0 +1,548 @@
+#include "api/HttpServer.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent::api {
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+// EWOULDBLOCK is EAGAIN on Linux
+bool wouldBlock() { return errno == EAGAIN; }
+
+const char *reasonPhrase(int status) {
+    switch (status) {
+    case 200:
+        return "OK";
+    case 304:
+        return "Not Modified";
+    case 400:
+        return "Bad Request";
+    case 404:
+        return "Not Found";
+    case 405:
+        return "Method Not Allowed";
+    case 500:
+        return "Internal Server Error";
+    default:
+        return "Unknown";
+    }
+}
+
+RouteResponse plainResponse(int status) {
+    auto body = std::make_shared<CachedResponse>();
+    body->body = std::string(reasonPhrase(status)) + "\n";
+    body->contentType = "text/plain";
+    return {status, std::move(body)};
+}
+
+std::string_view trim(std::string_view text) {
+    const std::size_t first = text.find_first_not_of(" \t");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const std::size_t last = text.find_last_not_of(" \t");
+    return text.substr(first, last - first + 1);
+}
+
+[[noreturn]] void throwSystemError(const char *what) {
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+void setEvents(int epollFd, int fd, std::uint32_t events) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    ::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+}
+
+} // namespace
+
+/**
+ * @brief One epoll instance and the connections it owns
+ *
+ * Only its I/O thread touches it between start() and stop().
+ */
+struct HttpServer::IoLoop {
+    struct Connection {
+        std::string input;
+        std::string output;
+        std::size_t sent{0};
+        bool closeAfterFlush{false};
+        bool wantsWrite{false};
+        SteadyClock::time_point lastActive;
+    };
+
+    int epollFd{-1};
+    int wakeFd{-1}; // Written by stop()
+    std::unordered_map<int, Connection> connections;
+    SteadyClock::time_point lastSweep{SteadyClock::now()};
+
+    IoLoop() = default;
+    ~IoLoop() {
+        for (const auto &entry : connections) {
+            ::close(entry.first);
+        }
+        if (wakeFd >= 0) {
+            ::close(wakeFd);
+        }
+        if (epollFd >= 0) {
+            ::close(epollFd);
+        }
+    }
+
+    // Prevent copying and moving
+    IoLoop(const IoLoop &) = delete;
+    IoLoop &operator=(const IoLoop &) = delete;
+    IoLoop(IoLoop &&) = delete;
+    IoLoop &operator=(IoLoop &&) = delete;
+};
+
+HttpServer::HttpServer() : HttpServer(Config{}) {}
+
+HttpServer::HttpServer(Config config) : config_(std::move(config)) {}
+
+HttpServer::~HttpServer() { stop(); }
+
+void HttpServer::start() {
+    if (running_.load()) {
+        return;
+    }
+    const auto fail = [this](const char *what) {
+        const int error = errno;
+        loops_.clear();
+        if (listenFd_ >= 0) {
+            ::close(listenFd_);
+            listenFd_ = -1;
+        }
+        errno = error;
+        throwSystemError(what);
+    };
+
+    listenFd_ =
+        ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        fail("socket");
+    }
+    const int one = 1;
+    ::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config_.port);
+    if (::inet_pton(AF_INET, config_.bindAddress.c_str(),
+                    &address.sin_addr) != 1) {
+        errno = EINVAL;
+        fail("bind address");
+    }
+    if (::bind(listenFd_, reinterpret_cast<const sockaddr *>(&address),
+               sizeof(address)) != 0) {
+        fail("bind");
+    }
+    if (::listen(listenFd_, SOMAXCONN) != 0) {
+        fail("listen");
+    }
+    socklen_t length = sizeof(address);
+    if (::getsockname(listenFd_, reinterpret_cast<sockaddr *>(&address),
+                      &length) != 0) {
+        fail("getsockname");
+    }
+    boundPort_ = ntohs(address.sin_port);
+
+    const std::size_t loopCount = std::max<std::size_t>(config_.ioThreads, 1);
+    for (std::size_t i = 0; i < loopCount; ++i) {
+        auto loop = std::make_unique<IoLoop>();
+        loop->epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        loop->wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (loop->epollFd < 0 || loop->wakeFd < 0) {
+            loops_.push_back(std::move(loop));
+            fail("epoll");
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = loop->wakeFd;
+        if (::epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, loop->wakeFd, &event) !=
+            0) {
+            loops_.push_back(std::move(loop));
+            fail("epoll_ctl");
+        }
+        // One loop wakes per pending connection
+        event.events = EPOLLIN | EPOLLEXCLUSIVE;
+        event.data.fd = listenFd_;
+        if (::epoll_ctl(loop->epollFd, EPOLL_CTL_ADD, listenFd_, &event) !=
+            0) {
+            loops_.push_back(std::move(loop));
+            fail("epoll_ctl");
+        }
+        loops_.push_back(std::move(loop));
+    }
+
+    running_.store(true);
+    for (const std::unique_ptr<IoLoop> &loop : loops_) {
+        IoLoop *target = loop.get();
+        threads_.emplace_back([this, target] { runLoop(*target); });
+    }
+}
+
+void HttpServer::stop() {
+    if (!running_.exchange(false)) {
+        return;
+    }
+    for (const std::unique_ptr<IoLoop> &loop : loops_) {
+        const std::uint64_t wake = 1;
+        [[maybe_unused]] const ssize_t written =
+            ::write(loop->wakeFd, &wake, sizeof(wake));
+    }
+    for (std::thread &thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+    for (const std::unique_ptr<IoLoop> &loop : loops_) {
+        openConnections_.fetch_sub(loop->connections.size());
+    }
+    loops_.clear();
+    ::close(listenFd_);
+    listenFd_ = -1;
+}
+
+void HttpServer::addRoute(std::string prefix, RouteHandler handler) {
+    Route route{std::move(prefix), std::move(handler)};
+    const auto position = std::find_if(
+        routes_.begin(), routes_.end(), [&route](const Route &existing) {
+            return existing.prefix.size() < route.prefix.size();
+        });
+    routes_.insert(position, std::move(route));
+}
+
+HttpServer::ServerMetrics HttpServer::getMetrics() const {
+    ServerMetrics metrics;
+    metrics.requests = requests_.load(std::memory_order_relaxed);
+    metrics.notModified = notModified_.load(std::memory_order_relaxed);
+    metrics.notFound = notFound_.load(std::memory_order_relaxed);
+    metrics.errors = errors_.load(std::memory_order_relaxed);
+    metrics.openConnections = openConnections_.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+bool HttpServer::matchesIfNoneMatch(const HttpRequest &request,
+                                    std::string_view etag) {
+    std::string_view list = request.header("If-None-Match");
+    while (!list.empty()) {
+        const std::size_t comma = list.find(',');
+        std::string_view candidate = trim(list.substr(0, comma));
+        // Weak comparison, as RFC 9110 requires for If-None-Match
+        if (candidate.substr(0, 2) == "W/") {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == "*" || candidate == etag) {
+            return true;
+        }
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        list.remove_prefix(comma + 1);
+    }
+    return false;
+}
+
+int HttpServer::writeResponse(const HttpRequest &request,
+                              const RouteResponse &response,
+                              std::string &output) {
+    const CachedResponse *body = response.body.get();
+    int status = response.status;
+    if (status == 200 && body && !body->etag.empty() &&
+        matchesIfNoneMatch(request, body->etag)) {
+        status = 304;
+    }
+
+    output += "HTTP/1.1 ";
+    output += std::to_string(status);
+    output += ' ';
+    output += reasonPhrase(status);
+    output += "\r\n";
+    if (body && !body->etag.empty()) {
+        output += "ETag: ";
+        output += body->etag;
+        output += "\r\n";
+    }
+    if (status == 405) {
+        output += "Allow: GET, HEAD\r\n";
+    }
+    const bool hasBody = status != 304;
+    if (hasBody) {
+        output += "Content-Type: ";
+        output += body ? body->contentType : "text/plain";
+        output += "\r\nContent-Length: ";
+        output += std::to_string(body ? body->body.size() : 0);
+        output += "\r\n";
+    }
+    output += request.keepAlive ? "Connection: keep-alive\r\n\r\n"
+                                : "Connection: close\r\n\r\n";
+    if (hasBody && body && request.method != HttpMethod::Head) {
+        output += body->body;
+    }
+    return status;
+}
+
+void HttpServer::runLoop(IoLoop &loop) {
+    std::array<epoll_event, 64> events{};
+    const int tickMs = std::clamp(config_.idleTimeoutMs / 2, 10, 1000);
+    while (running_.load()) {
+        const int ready = ::epoll_wait(loop.epollFd, events.data(),
+                                       static_cast<int>(events.size()),
+                                       tickMs);
+        if (ready < 0 && errno != EINTR) {
+            break;
+        }
+        for (int i = 0; i < ready; ++i) {
+            const epoll_event &event = events[static_cast<std::size_t>(i)];
+            const int fd = event.data.fd;
+            if (fd == loop.wakeFd) {
+                continue; // stop() has cleared running_
+            }
+            if (fd == listenFd_) {
+                acceptConnections(loop);
+                continue;
+            }
+            bool open = true;
+            if (event.events & EPOLLIN) {
+                open = readConnection(loop, fd);
+            }
+            if (open && (event.events & EPOLLOUT)) {
+                open = flushConnection(loop, fd);
+            }
+            if (open && (event.events & (EPOLLERR | EPOLLHUP))) {
+                closeConnection(loop, fd);
+            }
+        }
+        closeIdleConnections(loop);
+    }
+}
+
+void HttpServer::acceptConnections(IoLoop &loop) {
+    for (;;) {
+        const int fd = ::accept4(listenFd_, nullptr, nullptr,
+                                 SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return; // Drained, or another loop took it
+        }
+        if (openConnections_.load(std::memory_order_relaxed) >=
+            config_.maxConnections) {
+            ::close(fd);
+            continue;
+        }
+        const int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (::epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            ::close(fd);
+            continue;
+        }
+        loop.connections[fd].lastActive = SteadyClock::now();
+        openConnections_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool HttpServer::readConnection(IoLoop &loop, int fd) {
+    const auto found = loop.connections.find(fd);
+    if (found == loop.connections.end()) {
+        return false;
+    }
+    IoLoop::Connection &connection = found->second;
+    connection.lastActive = SteadyClock::now();
+
+    const std::size_t chunk = std::max<std::size_t>(config_.readBufferSize,
+                                                    1024);
+    bool peerClosed = false;
+    for (;;) {
+        const std::size_t used = connection.input.size();
+        connection.input.resize(used + chunk);
+        const ssize_t received =
+            ::recv(fd, connection.input.data() + used, chunk, 0);
+        if (received > 0) {
+            const auto count = static_cast<std::size_t>(received);
+            connection.input.resize(used + count);
+            if (count < chunk) {
+                break;
+            }
+            continue;
+        }
+        connection.input.resize(used);
+        if (received == 0) {
+            peerClosed = true;
+            break;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (wouldBlock()) {
+            break;
+        }
+        closeConnection(loop, fd);
+        return false;
+    }
+
+    // Answer every complete request; views stay valid until the erase
+    HttpRequest request;
+    std::size_t offset = 0;
+    while (!connection.closeAfterFlush) {
+        std::size_t consumed = 0;
+        const ParseStatus status = parseHttpRequest(
+            std::string_view(connection.input).substr(offset), request,
+            consumed);
+        if (status == ParseStatus::Incomplete) {
+            break;
+        }
+        if (status == ParseStatus::Invalid) {
+            errors_.fetch_add(1, std::memory_order_relaxed);
+            HttpRequest invalid;
+            invalid.keepAlive = false;
+            writeResponse(invalid, plainResponse(400), connection.output);
+            connection.closeAfterFlush = true;
+            break;
+        }
+        handleRequest(request, connection.output);
+        offset += consumed;
+        if (!request.keepAlive) {
+            connection.closeAfterFlush = true;
+        }
+    }
+    connection.input.erase(0, offset);
+    if (peerClosed) {
+        connection.closeAfterFlush = true;
+    }
+    return flushConnection(loop, fd);
+}
+
+bool HttpServer::flushConnection(IoLoop &loop, int fd) {
+    const auto found = loop.connections.find(fd);
+    if (found == loop.connections.end()) {
+        return false;
+    }
+    IoLoop::Connection &connection = found->second;
+    while (connection.sent < connection.output.size()) {
+        const ssize_t written =
+            ::send(fd, connection.output.data() + connection.sent,
+                   connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (written > 0) {
+            connection.sent += static_cast<std::size_t>(written);
+            continue;
+        }
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written < 0 && wouldBlock()) {
+            // Resume when the socket drains
+            if (!connection.wantsWrite) {
+                setEvents(loop.epollFd, fd, EPOLLIN | EPOLLOUT);
+                connection.wantsWrite = true;
+            }
+            return true;
+        }
+        closeConnection(loop, fd);
+        return false;
+    }
+    connection.output.clear();
+    connection.sent = 0;
+    if (connection.wantsWrite) {
+        setEvents(loop.epollFd, fd, EPOLLIN);
+        connection.wantsWrite = false;
+    }
+    if (connection.closeAfterFlush) {
+        closeConnection(loop, fd);
+        return false;
+    }
+    return true;
+}
+
+void HttpServer::closeConnection(IoLoop &loop, int fd) {
+    if (loop.connections.erase(fd) == 0) {
+        return;
+    }
+    // Counted down first so a peer that sees EOF sees the count drop too
+    openConnections_.fetch_sub(1, std::memory_order_relaxed);
+    ::epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, fd, nullptr);
+    ::close(fd);
+}
+
+void HttpServer::closeIdleConnections(IoLoop &loop) {
+    if (config_.idleTimeoutMs <= 0) {
+        return;
+    }
+    const SteadyClock::time_point now = SteadyClock::now();
+    const std::chrono::milliseconds timeout(config_.idleTimeoutMs);
+    if (now - loop.lastSweep < timeout / 2) {
+        return;
+    }
+    loop.lastSweep = now;
+    std::vector<int> idle;
+    for (const auto &[fd, connection] : loop.connections) {
+        if (now - connection.lastActive > timeout) {
+            idle.push_back(fd);
+        }
+    }
+    for (const int fd : idle) {
+        closeConnection(loop, fd);
+    }
+}
+
+void HttpServer::handleRequest(const HttpRequest &request,
+                               std::string &output) {
+    requests_.fetch_add(1, std::memory_order_relaxed);
+    if (request.method == HttpMethod::Other) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+        writeResponse(request, plainResponse(405), output);
+        return;
+    }
+    std::string_view path = request.target;
+    path = path.substr(0, path.find('?'));
+
+    std::optional<RouteResponse> response;
+    try {
+        for (const Route &route : routes_) {
+            if (path.substr(0, route.prefix.size()) == route.prefix) {
+                response = route.handler(request,
+                                         path.substr(route.prefix.size()));
+                break;
+            }
+        }
+    } catch (...) {
+        // A failing handler costs one request, not the I/O thread
+        response = plainResponse(500);
+    }
+    if (!response) {
+        response = plainResponse(404);
+    }
+
+    const int status = writeResponse(request, *response, output);
+    if (status == 304) {
+        notModified_.fetch_add(1, std::memory_order_relaxed);
+    } else if (status == 404) {
+        notFound_.fetch_add(1, std::memory_order_relaxed);
+    } else if (status >= 500) {
+        errors_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+} // namespace crescent::api
@@ -0,0 +1,116 @@
+#include "api/ResponseCache.h"
+
+#include <cstdio>
+#include <utility>
+
+namespace crescent::api {
+
+ResponseCache::ResponseCache(std::size_t maxEntriesPerShard)
+    : maxEntriesPerShard_(maxEntriesPerShard > 0 ? maxEntriesPerShard : 1) {}
+
+CachedResponseRef ResponseCache::lookup(std::string_view key,
+                                        const ResourceVersion &current) const {
+    const Shard &shard = shardFor(key);
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const auto found = shard.entries.find(std::string(key));
+        if (found != shard.entries.end() &&
+            found->second->version == current) {
+            shard.hits.fetch_add(1, std::memory_order_relaxed);
+            return found->second;
+        }
+    }
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+CachedResponseRef
+ResponseCache::getOrBuild(std::string_view key, const ResourceVersion &current,
+                          const std::function<std::string()> &serialize) {
+    if (CachedResponseRef cached = lookup(key, current)) {
+        return cached;
+    }
+    return store(key, current, serialize());
+}
+
+CachedResponseRef ResponseCache::store(std::string_view key,
+                                       const ResourceVersion &version,
+                                       std::string body) {
+    auto built = std::make_shared<CachedResponse>();
+    built->version = version;
+    built->etag = makeETag(key, version);
+    built->body = std::move(body);
+    CachedResponseRef response = std::move(built);
+
+    Shard &shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    std::string owned(key);
+    auto found = shard.entries.find(owned);
+    if (found != shard.entries.end()) {
+        found->second = response;
+        return response;
+    }
+    if (shard.entries.size() >= maxEntriesPerShard_) {
+        shard.entries.erase(shard.entries.begin());
+        shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+    shard.entries.emplace(std::move(owned), response);
+    return response;
+}
+
+void ResponseCache::invalidate(std::string_view key) {
+    Shard &shard = shardFor(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.entries.erase(std::string(key));
+}
+
+void ResponseCache::clear() {
+    for (Shard &shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.entries.clear();
+    }
+}
+
+std::string ResponseCache::makeETag(std::string_view key,
+                                    const ResourceVersion &version) {
+    std::string etag;
+    etag.reserve(key.size() + 40);
+    etag += '"';
+    for (const char c : key) {
+        // etagc: %x21 / %x23-7E
+        const bool allowed = c == '!' || (c >= '#' && c <= '~');
+        etag += allowed ? c : '_';
+    }
+    char suffix[48];
+    std::snprintf(suffix, sizeof(suffix), "-h%llx-v%llu\"",
+                  static_cast<unsigned long long>(version.handle),
+                  static_cast<unsigned long long>(version.version));
+    etag += suffix;
+    return etag;
+}
+
+ResponseCache::CacheMetrics ResponseCache::getMetrics() const {
+    CacheMetrics metrics;
+    for (const Shard &shard : shards_) {
+        metrics.hits += shard.hits.load(std::memory_order_relaxed);
+        metrics.misses += shard.misses.load(std::memory_order_relaxed);
+        metrics.evictions += shard.evictions.load(std::memory_order_relaxed);
+    }
+    metrics.notModified = notModified_.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+void ResponseCache::recordNotModified() {
+    notModified_.fetch_add(1, std::memory_order_relaxed);
+}
+
+ResponseCache::Shard &ResponseCache::shardFor(std::string_view key) {
+    return shards_[std::hash<std::string_view>()(key) & (SHARD_COUNT - 1)];
+}
+
+const ResponseCache::Shard &
+ResponseCache::shardFor(std::string_view key) const {
+    return shards_[std::hash<std::string_view>()(key) & (SHARD_COUNT - 1)];
+}
+
+} // namespace crescent::api
@@ -0,0 +1,328 @@
+#include "ApiLoadGenerator.h"
+#include "api/HttpServer.h"
+
+#include <catch2/catch.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using crescent::api::CachedResponse;
+using crescent::api::HttpRequest;
+using crescent::api::HttpServer;
+using crescent::api::ResourceVersion;
+using crescent::api::ResponseCache;
+using crescent::api::RouteResponse;
+using crescent::tools::ApiLoadGenerator;
+
+namespace {
+
+// Blocking loopback client that reads whole responses
+class Client {
+  public:
+    explicit Client(std::uint16_t port)
+        : fd_(::socket(AF_INET, SOCK_STREAM, 0)) {
+        timeval timeout{5, 0};
+        ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::connect(fd_, reinterpret_cast<const sockaddr *>(&address),
+                      sizeof(address)) != 0) {
+            throw std::runtime_error("connect failed");
+        }
+    }
+    ~Client() { ::close(fd_); }
+
+    // Prevent copying and moving
+    Client(const Client &) = delete;
+    Client &operator=(const Client &) = delete;
+    Client(Client &&) = delete;
+    Client &operator=(Client &&) = delete;
+
+    void send(std::string_view text) {
+        while (!text.empty()) {
+            const ssize_t written = ::send(fd_, text.data(), text.size(), 0);
+            if (written <= 0) {
+                throw std::runtime_error("send failed");
+            }
+            text.remove_prefix(static_cast<std::size_t>(written));
+        }
+    }
+
+    /**
+     * @brief Next full response, or nothing once the server has closed
+     */
+    std::optional<std::string> receive(bool headOnly = false) {
+        for (;;) {
+            const std::size_t end = buffer_.find("\r\n\r\n");
+            if (end != std::string::npos) {
+                std::size_t length = 0;
+                const std::size_t field = buffer_.find("Content-Length: ");
+                if (!headOnly && field != std::string::npos && field < end) {
+                    length = std::strtoul(buffer_.c_str() + field + 16,
+                                          nullptr, 10);
+                }
+                if (buffer_.size() >= end + 4 + length) {
+                    std::string response = buffer_.substr(0, end + 4 + length);
+                    buffer_.erase(0, end + 4 + length);
+                    return response;
+                }
+            }
+            char chunk[4096];
+            const ssize_t received = ::recv(fd_, chunk, sizeof(chunk), 0);
+            if (received <= 0) {
+                return std::nullopt;
+            }
+            buffer_.append(chunk, static_cast<std::size_t>(received));
+        }
+    }
+
+  private:
+    int fd_;
+    std::string buffer_;
+};
+
+std::string get(std::string_view target, std::string_view extra = {}) {
+    return "GET " + std::string(target) + " HTTP/1.1\r\nHost: test\r\n" +
+           std::string(extra) + "\r\n";
+}
+
+bool hasStatus(const std::optional<std::string> &response, int status) {
+    return response &&
+           response->rfind("HTTP/1.1 " + std::to_string(status) + " ", 0) == 0;
+}
+
+std::string bodyOf(const std::string &response) {
+    return response.substr(response.find("\r\n\r\n") + 4);
+}
+
+// Serves /items/<name> with a version that tests bump
+struct ItemRoutes {
+    std::atomic<std::uint64_t> version{1};
+    std::atomic<int> builds{0};
+    ResponseCache cache;
+
+    void install(HttpServer &server) {
+        server.addRoute("/items", [this](const HttpRequest &,
+                                         std::string_view target)
+                                      -> std::optional<RouteResponse> {
+            if (target == "/missing") {
+                return std::nullopt;
+            }
+            if (target == "/broken") {
+                throw std::runtime_error("handler failed");
+            }
+            const std::string key = "/items" + std::string(target);
+            const ResourceVersion current{1, version.load()};
+            return RouteResponse{
+                200, cache.getOrBuild(key, current, [this, &current] {
+                    ++builds;
+                    return "v" + std::to_string(current.version);
+                })};
+        });
+        server.addRoute("/items/special", [](const HttpRequest &,
+                                             std::string_view) {
+            auto body = std::make_shared<CachedResponse>();
+            body->body = "special";
+            return std::optional<RouteResponse>(RouteResponse{200, body});
+        });
+    }
+};
+
+HttpServer::Config testConfig() {
+    HttpServer::Config config;
+    config.port = 0;
+    config.ioThreads = 2;
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("Keep-alive connections answer pipelined requests in order",
+          "[http-server]") {
+    HttpServer server(testConfig());
+    ItemRoutes routes;
+    routes.install(server);
+    server.start();
+    REQUIRE(server.isRunning());
+    REQUIRE(server.getBoundPort() != 0);
+
+    Client client(server.getBoundPort());
+    client.send(get("/items/a") + get("/items/special") + get("/items/a?x=1"));
+    const auto first = client.receive();
+    const auto second = client.receive();
+    const auto third = client.receive();
+    REQUIRE(hasStatus(first, 200));
+    REQUIRE(bodyOf(*first) == "v1");
+    REQUIRE(first->find("Connection: keep-alive") != std::string::npos);
+    REQUIRE(first->find("ETag: \"/items/a-h1-v1\"") != std::string::npos);
+    // Longest prefix wins
+    REQUIRE(bodyOf(*second) == "special");
+    REQUIRE(bodyOf(*third) == "v1");
+    REQUIRE(routes.builds.load() == 1);
+
+    // The same connection keeps working after a pause
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    client.send(get("/items/a"));
+    REQUIRE(hasStatus(client.receive(), 200));
+
+    const HttpServer::ServerMetrics metrics = server.getMetrics();
+    REQUIRE(metrics.requests == 4);
+    REQUIRE(metrics.openConnections == 1);
+    server.stop();
+    REQUIRE_FALSE(server.isRunning());
+    REQUIRE(server.getMetrics().openConnections == 0);
+}
+
+TEST_CASE("A matching If-None-Match gets 304 until the version moves",
+          "[http-server]") {
+    HttpServer server(testConfig());
+    ItemRoutes routes;
+    routes.install(server);
+    server.start();
+    Client client(server.getBoundPort());
+
+    client.send(get("/items/a", "If-None-Match: \"/items/a-h1-v1\"\r\n"));
+    const auto cached = client.receive(true);
+    REQUIRE(hasStatus(cached, 304));
+    REQUIRE(cached->find("ETag: \"/items/a-h1-v1\"") != std::string::npos);
+    REQUIRE(cached->find("Content-Length") == std::string::npos);
+
+    // Weak tags and lists match too
+    client.send(get("/items/a",
+                    "If-None-Match: \"x\", W/\"/items/a-h1-v1\"\r\n"));
+    REQUIRE(hasStatus(client.receive(true), 304));
+
+    routes.version = 2;
+    client.send(get("/items/a", "If-None-Match: \"/items/a-h1-v1\"\r\n"));
+    const auto fresh = client.receive();
+    REQUIRE(hasStatus(fresh, 200));
+    REQUIRE(bodyOf(*fresh) == "v2");
+    REQUIRE(server.getMetrics().notModified == 2);
+}
+
+TEST_CASE("Errors get their status and close when they must",
+          "[http-server]") {
+    HttpServer server(testConfig());
+    ItemRoutes routes;
+    routes.install(server);
+    server.start();
+
+    {
+        Client client(server.getBoundPort());
+        client.send(get("/items/missing") + get("/nowhere") +
+                    get("/items/broken"));
+        REQUIRE(hasStatus(client.receive(), 404));
+        REQUIRE(hasStatus(client.receive(), 404));
+        REQUIRE(hasStatus(client.receive(), 500));
+
+        // HEAD: GET headers, no body
+        client.send("HEAD /items/a HTTP/1.1\r\n\r\n");
+        const auto head = client.receive(true);
+        REQUIRE(hasStatus(head, 200));
+        REQUIRE(head->find("Content-Length: 2") != std::string::npos);
+        REQUIRE(bodyOf(*head).empty());
+
+        client.send("POST /items/a HTTP/1.1\r\n\r\n");
+        const auto post = client.receive();
+        REQUIRE(hasStatus(post, 405));
+        REQUIRE(post->find("Allow: GET, HEAD") != std::string::npos);
+    }
+    {
+        Client client(server.getBoundPort());
+        client.send("garbage\r\n\r\n" + get("/items/a"));
+        const auto bad = client.receive();
+        REQUIRE(hasStatus(bad, 400));
+        REQUIRE(bad->find("Connection: close") != std::string::npos);
+        REQUIRE_FALSE(client.receive());
+    }
+    {
+        Client client(server.getBoundPort());
+        client.send("GET /items/a HTTP/1.1\r\nConnection: close\r\n\r\n");
+        REQUIRE(hasStatus(client.receive(), 200));
+        REQUIRE_FALSE(client.receive());
+    }
+    const HttpServer::ServerMetrics metrics = server.getMetrics();
+    REQUIRE(metrics.notFound == 2);
+    REQUIRE(metrics.errors == 3); // 500, 405 and 400
+}
+
+TEST_CASE("Idle connections are closed", "[http-server]") {
+    HttpServer::Config config = testConfig();
+    config.idleTimeoutMs = 50;
+    HttpServer server(config);
+    ItemRoutes routes;
+    routes.install(server);
+    server.start();
+
+    Client client(server.getBoundPort());
+    client.send(get("/items/a"));
+    REQUIRE(hasStatus(client.receive(), 200));
+    REQUIRE_FALSE(client.receive()); // Closed by the server, not timed out
+    REQUIRE(server.getMetrics().openConnections == 0);
+}
+
+TEST_CASE("Connections past the limit are refused", "[http-server]") {
+    HttpServer::Config config = testConfig();
+    config.maxConnections = 1;
+    config.ioThreads = 1;
+    HttpServer server(config);
+    ItemRoutes routes;
+    routes.install(server);
+    server.start();
+
+    Client first(server.getBoundPort());
+    first.send(get("/items/a"));
+    REQUIRE(hasStatus(first.receive(), 200));
+    Client second(server.getBoundPort());
+    second.send(get("/items/a"));
+    REQUIRE_FALSE(second.receive());
+    first.send(get("/items/a"));
+    REQUIRE(hasStatus(first.receive(), 200));
+}
+
+TEST_CASE("The load generator measures a live server", "[http-server]") {
+    HttpServer server(testConfig());
+    ItemRoutes routes;
+    routes.install(server);
+    server.start();
+
+    ApiLoadGenerator::Config config;
+    config.port = server.getBoundPort();
+    config.targets = {"/items/a", "/items/b"};
+    config.connections = 4;
+    config.threads = 2;
+    config.duration = std::chrono::seconds(1);
+    config.warmup = std::chrono::seconds(0);
+    const ApiLoadGenerator::Report report = ApiLoadGenerator(config).run();
+
+    REQUIRE(report.requests > 100);
+    REQUIRE(report.errors == 0);
+    // Every request after a connection's first for a target is conditional
+    REQUIRE(report.notModified + 8 >= report.requests);
+    REQUIRE(report.latency.count == report.requests);
+    REQUIRE(report.latency.p50 > 0);
+    REQUIRE(report.requestsPerSecond > 0.0);
+    REQUIRE(server.getMetrics().requests >= report.requests);
+    REQUIRE(ApiLoadGenerator::formatReport(report).find("p99") !=
+            std::string::npos);
+
+    config.port = 1; // Nothing listens there
+    REQUIRE_THROWS_AS(ApiLoadGenerator(config).run(), std::system_error);
+}
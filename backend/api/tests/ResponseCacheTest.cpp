@@ -0,0 +1,106 @@
+#include "api/ResponseCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using crescent::api::CachedResponseRef;
+using crescent::api::ResourceVersion;
+using crescent::api::ResponseCache;
+
+TEST_CASE("Bodies are rebuilt only when the version moves",
+          "[response-cache]") {
+    ResponseCache cache;
+    int builds = 0;
+    const auto build = [&builds] {
+        ++builds;
+        return "body" + std::to_string(builds);
+    };
+
+    const CachedResponseRef first =
+        cache.getOrBuild("/creatures/a", {0x300000007, 4}, build);
+    const CachedResponseRef again =
+        cache.getOrBuild("/creatures/a", {0x300000007, 4}, build);
+    REQUIRE(builds == 1);
+    REQUIRE(again == first);
+    REQUIRE(first->body == "body1");
+    REQUIRE(first->etag == "\"/creatures/a-h300000007-v4\"");
+
+    // A new version, or the same version under a reused slot, misses
+    REQUIRE(cache.getOrBuild("/creatures/a", {0x300000007, 5}, build)->body ==
+            "body2");
+    REQUIRE(cache.getOrBuild("/creatures/a", {0x400000007, 5}, build)->body ==
+            "body3");
+    REQUIRE_FALSE(cache.lookup("/creatures/a", {0x300000007, 5}));
+    // The old body stays valid for whoever still holds it
+    REQUIRE(first->body == "body1");
+
+    const ResponseCache::CacheMetrics metrics = cache.getMetrics();
+    REQUIRE(metrics.hits == 1);
+    REQUIRE(metrics.misses == 4);
+    REQUIRE(metrics.evictions == 0);
+}
+
+TEST_CASE("Stored bodies carry the version they were built at",
+          "[response-cache]") {
+    ResponseCache cache;
+    const CachedResponseRef stored =
+        cache.store("/creatures/b", {1, 9}, "{\"id\":\"b\"}");
+    REQUIRE(stored->version == ResourceVersion{1, 9});
+    REQUIRE(cache.lookup("/creatures/b", {1, 9}) == stored);
+
+    cache.invalidate("/creatures/b");
+    REQUIRE_FALSE(cache.lookup("/creatures/b", {1, 9}));
+    cache.store("/creatures/b", {1, 9}, "x");
+    cache.clear();
+    REQUIRE_FALSE(cache.lookup("/creatures/b", {1, 9}));
+
+    cache.recordNotModified();
+    REQUIRE(cache.getMetrics().notModified == 1);
+}
+
+TEST_CASE("ETags only hold entity-tag characters", "[response-cache]") {
+    REQUIRE(ResponseCache::makeETag("/c/\"odd id\"\x01", {0xff, 2}) ==
+            "\"/c/_odd_id__-hff-v2\"");
+}
+
+TEST_CASE("Full shards evict", "[response-cache]") {
+    ResponseCache cache(2);
+    for (int i = 0; i < 200; ++i) {
+        cache.store("/k" + std::to_string(i), {1, 1}, "v");
+    }
+    const ResponseCache::CacheMetrics metrics = cache.getMetrics();
+    REQUIRE(metrics.evictions >= 200 - 2 * ResponseCache::SHARD_COUNT);
+}
+
+TEST_CASE("Concurrent readers share one entry", "[response-cache]") {
+    ResponseCache cache;
+    std::atomic<int> builds{0};
+    std::atomic<int> mismatched{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache, &builds, &mismatched] {
+            for (std::uint64_t version = 1; version <= 200; ++version) {
+                const CachedResponseRef body = cache.getOrBuild(
+                    "/creatures/hot", {7, version / 10}, [&builds, version] {
+                        ++builds;
+                        return std::to_string(version / 10);
+                    });
+                if (body->body != std::to_string(body->version.version)) {
+                    ++mismatched;
+                }
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    REQUIRE(mismatched.load() == 0);
+    REQUIRE(builds.load() >= 21);
+    const ResponseCache::CacheMetrics metrics = cache.getMetrics();
+    REQUIRE(metrics.hits + metrics.misses == 800);
+}
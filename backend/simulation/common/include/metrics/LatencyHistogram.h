@@ -0,0 +1,184 @@
+#ifndef SIMULATION_COMMON_METRICS_LATENCY_HISTOGRAM_H
+#define SIMULATION_COMMON_METRICS_LATENCY_HISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace crescent::metrics {
+
+/**
+ * @brief Percentile summary of a latency distribution, in nanoseconds
+ */
+struct LatencySummary {
+    std::uint64_t count{0};
+    std::uint64_t min{0};
+    std::uint64_t max{0};
+    double mean{0.0};
+    std::uint64_t p50{0};
+    std::uint64_t p90{0};
+    std::uint64_t p99{0};
+    std::uint64_t p999{0};
+};
+
+/**
+ * @brief HDR-style log-linear histogram of nanosecond latencies
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly; above that each power
+ * of two is split into 2^SUB_BUCKET_BITS linear sub-buckets, bounding the
+ * relative error at about 3%. Values past MAX_VALUE_BITS saturate into the
+ * last bucket.
+ *
+ * Buckets are atomics written with relaxed load/store by a single owning
+ * thread (see MetricsRegistry), so recording is wait-free and readers can
+ * merge shards concurrently without tearing.
+ */
+class LatencyHistogram {
+  public:
+    static constexpr unsigned SUB_BUCKET_BITS = 5;
+    static constexpr unsigned MAX_VALUE_BITS = 40; // ~18 minutes
+    static constexpr std::size_t SUB_BUCKET_COUNT = std::size_t{1}
+                                                    << SUB_BUCKET_BITS;
+    static constexpr std::size_t BUCKET_COUNT =
+        (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    /**
+     * @brief Records one sample; must only be called by the owning thread
+     */
+    void record(std::uint64_t nanos) {
+        bump(buckets_[bucketIndex(nanos)], 1);
+        bump(count_, 1);
+        bump(sum_, nanos);
+        if (nanos > max_.load(std::memory_order_relaxed)) {
+            max_.store(nanos, std::memory_order_relaxed);
+        }
+        if (nanos < min_.load(std::memory_order_relaxed)) {
+            min_.store(nanos, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t getCount() const {
+        return count_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Plain, non-atomic copy used for merging and percentile queries
+     */
+    struct Snapshot {
+        std::array<std::uint64_t, BUCKET_COUNT> buckets{};
+        std::uint64_t count{0};
+        std::uint64_t sum{0};
+        std::uint64_t min{UINT64_MAX};
+        std::uint64_t max{0};
+
+        void merge(const Snapshot &other);
+        std::uint64_t valueAtPercentile(double percentile) const;
+        LatencySummary summarize() const;
+    };
+
+    void mergeInto(Snapshot &target) const;
+
+    static std::size_t bucketIndex(std::uint64_t value);
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+  private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets_{};
+    std::atomic<std::uint64_t> count_{0};
+    std::atomic<std::uint64_t> sum_{0};
+    std::atomic<std::uint64_t> min_{UINT64_MAX};
+    std::atomic<std::uint64_t> max_{0};
+
+    // Single-writer increment; avoids a locked RMW on the hot path
+    static void bump(std::atomic<std::uint64_t> &counter,
+                     std::uint64_t amount) {
+        counter.store(counter.load(std::memory_order_relaxed) + amount,
+                      std::memory_order_relaxed);
+    }
+};
+
+inline std::size_t LatencyHistogram::bucketIndex(std::uint64_t value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return value;
+    }
+    unsigned msb = 63u - static_cast<unsigned>(__builtin_clzll(value));
+    if (msb >= MAX_VALUE_BITS) {
+        return BUCKET_COUNT - 1;
+    }
+    const unsigned shift = msb - SUB_BUCKET_BITS;
+    const std::size_t subBucket = (value >> shift) & (SUB_BUCKET_COUNT - 1);
+    return (static_cast<std::size_t>(shift) + 1) * SUB_BUCKET_COUNT +
+           subBucket;
+}
+
+inline std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    const std::size_t shift = index / SUB_BUCKET_COUNT - 1;
+    const std::uint64_t subBucket = (index % SUB_BUCKET_COUNT) |
+                                    SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+inline void LatencyHistogram::mergeInto(Snapshot &target) const {
+    Snapshot local;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        local.buckets[i] = buckets_[i].load(std::memory_order_relaxed);
+    }
+    local.count = count_.load(std::memory_order_relaxed);
+    local.sum = sum_.load(std::memory_order_relaxed);
+    local.min = min_.load(std::memory_order_relaxed);
+    local.max = max_.load(std::memory_order_relaxed);
+    target.merge(local);
+}
+
+inline void LatencyHistogram::Snapshot::merge(const Snapshot &other) {
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    count += other.count;
+    sum += other.sum;
+    min = other.min < min ? other.min : min;
+    max = other.max > max ? other.max : max;
+}
+
+inline std::uint64_t
+LatencyHistogram::Snapshot::valueAtPercentile(double percentile) const {
+    if (count == 0) {
+        return 0;
+    }
+    const double rank = percentile / 100.0 * static_cast<double>(count);
+    std::uint64_t target = static_cast<std::uint64_t>(rank + 0.5);
+    target = target == 0 ? 1 : target;
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKET_COUNT; ++i) {
+        seen += buckets[i];
+        if (seen >= target) {
+            const std::uint64_t bound = bucketUpperBound(i);
+            return bound < max ? bound : max;
+        }
+    }
+    return max;
+}
+
+inline LatencySummary LatencyHistogram::Snapshot::summarize() const {
+    LatencySummary summary;
+    summary.count = count;
+    if (count == 0) {
+        return summary;
+    }
+    summary.min = min;
+    summary.max = max;
+    summary.mean = static_cast<double>(sum) / static_cast<double>(count);
+    summary.p50 = valueAtPercentile(50.0);
+    summary.p90 = valueAtPercentile(90.0);
+    summary.p99 = valueAtPercentile(99.0);
+    summary.p999 = valueAtPercentile(99.9);
+    return summary;
+}
+
+} // namespace crescent::metrics
+
+#endif // SIMULATION_COMMON_METRICS_LATENCY_HISTOGRAM_H
@@ -0,0 +1,120 @@
+#ifndef SIMULATION_COMMON_METRICS_METRICS_REGISTRY_H
+#define SIMULATION_COMMON_METRICS_METRICS_REGISTRY_H
+
+#include "common/metrics/LatencyHistogram.h"
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace crescent::metrics {
+
+/**
+ * @brief Instrumented engine operations
+ */
+enum class Operation {
+    ManifestAbility,    // AbilityProcessor::manifestAbility
+    ApplyChange,        // TraitProcessor / CreatureCore::applyChange
+    ProcessSynthesis,   // SynthesisProcessor::processSynthesis
+    UpdateTraits,       // TraitManager::updateTraits
+    SerializeCreature,  // CreatureCore::serializeToJson
+    SerializeTraits,    // TraitManager / TraitProcessor::serializeToJson
+    SerializeAbilities, // AbilityProcessor::serializeToJson
+    SerializeSynthesis, // SynthesisProcessor / SynthesisRules::serializeToJson
+    Count
+};
+
+constexpr std::size_t OPERATION_COUNT =
+    static_cast<std::size_t>(Operation::Count);
+
+inline std::string_view operationName(Operation op) {
+    switch (op) {
+    case Operation::ManifestAbility:
+        return "manifestAbility";
+    case Operation::ApplyChange:
+        return "applyChange";
+    case Operation::ProcessSynthesis:
+        return "processSynthesis";
+    case Operation::UpdateTraits:
+        return "updateTraits";
+    case Operation::SerializeCreature:
+        return "serializeCreature";
+    case Operation::SerializeTraits:
+        return "serializeTraits";
+    case Operation::SerializeAbilities:
+        return "serializeAbilities";
+    case Operation::SerializeSynthesis:
+        return "serializeSynthesis";
+    case Operation::Count:
+        break;
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Per-thread histogram set; only its owning thread records into it
+ */
+struct ThreadShard {
+    std::array<LatencyHistogram, OPERATION_COUNT> histograms;
+};
+
+/**
+ * @brief Process-wide owner of per-thread latency shards
+ *
+ * Each thread lazily registers one shard on first use; that is the only
+ * point that takes the registry lock. Shards outlive their threads so counts
+ * from finished workers still appear in summaries.
+ */
+class MetricsRegistry {
+  public:
+    static MetricsRegistry &instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    void record(Operation op, std::uint64_t nanos) {
+        localShard().histograms[static_cast<std::size_t>(op)].record(nanos);
+    }
+
+    /**
+     * @brief Merges every shard's histogram for one operation
+     */
+    LatencyHistogram::Snapshot snapshot(Operation op) const {
+        LatencyHistogram::Snapshot merged;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &shard : shards_) {
+            shard->histograms[static_cast<std::size_t>(op)].mergeInto(merged);
+        }
+        return merged;
+    }
+
+    LatencySummary summarize(Operation op) const {
+        return snapshot(op).summarize();
+    }
+
+  private:
+    MetricsRegistry() = default;
+
+    ThreadShard &localShard() {
+        thread_local ThreadShard *shard = registerShard();
+        return *shard;
+    }
+
+    ThreadShard *registerShard() {
+        auto shard = std::make_unique<ThreadShard>();
+        ThreadShard *raw = shard.get();
+        std::lock_guard<std::mutex> lock(mutex_);
+        shards_.push_back(std::move(shard));
+        return raw;
+    }
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadShard>> shards_;
+};
+
+} // namespace crescent::metrics
+
+#endif // SIMULATION_COMMON_METRICS_METRICS_REGISTRY_H
@@ -0,0 +1,244 @@
+#ifndef SIMULATION_COMMON_METRICS_TRACE_SPAN_H
+#define SIMULATION_COMMON_METRICS_TRACE_SPAN_H
+
+#include "common/metrics/MetricsRegistry.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace crescent::metrics {
+
+/**
+ * @brief Completed span as written to the Chrome trace
+ */
+struct TraceEvent {
+    Operation operation;
+    std::uint64_t startNanos;
+    std::uint64_t durationNanos;
+};
+
+/**
+ * @brief Per-thread span rings exportable as Chrome trace JSON
+ *
+ * Tracing is off until enable() is called. Each thread records into its own
+ * single-producer ring without taking a lock; drain() moves finished spans
+ * into the collector, which keeps the newest DEFAULT_EVENTS_PER_THREAD per
+ * thread. A span recorded while its ring is full is dropped and counted, so
+ * a long trace should be drained periodically. The registry lock is taken
+ * only when a thread records its first span and while draining.
+ */
+class TraceRecorder {
+  public:
+    static constexpr std::size_t DEFAULT_EVENTS_PER_THREAD = 1 << 16;
+
+    static TraceRecorder &instance() {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    void enable() { enabled_.store(true, std::memory_order_relaxed); }
+    void disable() { enabled_.store(false, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    void record(const TraceEvent &event) {
+        ThreadBuffer &buffer = localBuffer();
+        const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        if (head - buffer.tail.load(std::memory_order_acquire) ==
+            DEFAULT_EVENTS_PER_THREAD) {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer.ring[head % DEFAULT_EVENTS_PER_THREAD] = event;
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Moves every thread's recorded spans into the collector
+     *
+     * Safe to call from any thread while others are recording.
+     */
+    void drain() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &buffer : buffers_) {
+            drainLocked(*buffer);
+        }
+    }
+
+    /**
+     * @brief Spans lost to full rings since the recorder was created
+     */
+    std::uint64_t droppedSpans() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::uint64_t total = 0;
+        for (const auto &buffer : buffers_) {
+            total += buffer->dropped.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Visits collected spans as (thread index, event), oldest first
+     * within each thread; call drain() first to include recent spans
+     */
+    template <typename Visitor> void forEachEvent(Visitor &&visitor) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto &buffer : buffers_) {
+            const std::vector<TraceEvent> &events = buffer->collected;
+            const std::size_t oldest =
+                events.size() < DEFAULT_EVENTS_PER_THREAD ? 0 : buffer->next;
+            for (std::size_t i = 0; i < events.size(); ++i) {
+                visitor(buffer->threadIndex,
+                        events[(oldest + i) % events.size()]);
+            }
+        }
+    }
+
+    /**
+     * @brief Drains, then writes all collected spans in Chrome trace event
+     * format
+     * @return False if the file could not be opened
+     *
+     * Load the result in chrome://tracing or Perfetto.
+     */
+    bool writeChromeTrace(const std::string &path) {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        drain();
+        out << "{\"traceEvents\":[";
+        bool first = true;
+        forEachEvent([&](std::size_t threadIndex, const TraceEvent &event) {
+            out << (first ? "" : ",") << "{\"name\":\""
+                << operationName(event.operation)
+                << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadIndex
+                << ",\"ts\":";
+            writeMicros(out, event.startNanos);
+            out << ",\"dur\":";
+            writeMicros(out, event.durationNanos);
+            out << "}";
+            first = false;
+        });
+        out << "]}\n";
+        return static_cast<bool>(out);
+    }
+
+  private:
+    struct ThreadBuffer {
+        // Written only by the owning thread
+        std::unique_ptr<TraceEvent[]> ring =
+            std::make_unique<TraceEvent[]>(DEFAULT_EVENTS_PER_THREAD);
+        std::atomic<std::uint64_t> head{0};
+        std::atomic<std::uint64_t> dropped{0};
+        // Advanced only by drain, under the registry lock
+        std::atomic<std::uint64_t> tail{0};
+        std::vector<TraceEvent> collected;
+        std::size_t next{0};
+        std::size_t threadIndex{0};
+    };
+
+    TraceRecorder() = default;
+
+    // Chrome expects microseconds; keep full nanosecond precision
+    static void writeMicros(std::ostream &out, std::uint64_t nanos) {
+        const std::uint64_t fraction = nanos % 1000;
+        out << nanos / 1000 << '.' << (fraction < 100 ? "0" : "")
+            << (fraction < 10 ? "0" : "") << fraction;
+    }
+
+    static void drainLocked(ThreadBuffer &buffer) {
+        const std::uint64_t head = buffer.head.load(std::memory_order_acquire);
+        std::uint64_t tail = buffer.tail.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            const TraceEvent &event =
+                buffer.ring[tail % DEFAULT_EVENTS_PER_THREAD];
+            if (buffer.collected.size() < DEFAULT_EVENTS_PER_THREAD) {
+                buffer.collected.push_back(event);
+            } else {
+                buffer.collected[buffer.next] = event;
+            }
+            buffer.next = (buffer.next + 1) % DEFAULT_EVENTS_PER_THREAD;
+        }
+        // Hands the slots back to the producer
+        buffer.tail.store(head, std::memory_order_release);
+    }
+
+    ThreadBuffer &localBuffer() {
+        thread_local ThreadBuffer *buffer = registerBuffer();
+        return *buffer;
+    }
+
+    ThreadBuffer *registerBuffer() {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        ThreadBuffer *raw = buffer.get();
+        std::lock_guard<std::mutex> lock(mutex_);
+        raw->threadIndex = buffers_.size();
+        buffers_.push_back(std::move(buffer));
+        return raw;
+    }
+
+    std::atomic<bool> enabled_{false};
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+};
+
+/**
+ * @brief Times a scope into the latency histograms and, if enabled, the trace
+ */
+class ScopedSpan {
+  public:
+    explicit ScopedSpan(Operation op)
+        : operation_(op), start_(std::chrono::steady_clock::now()) {}
+
+    ~ScopedSpan() {
+        const auto end = std::chrono::steady_clock::now();
+        const auto duration = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_)
+                .count());
+        MetricsRegistry::instance().record(operation_, duration);
+
+        TraceRecorder &recorder = TraceRecorder::instance();
+        if (recorder.isEnabled()) {
+            const auto startNanos = static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    start_.time_since_epoch())
+                    .count());
+            recorder.record({operation_, startNanos, duration});
+        }
+    }
+
+    // Prevent copying and moving
+    ScopedSpan(const ScopedSpan &) = delete;
+    ScopedSpan &operator=(const ScopedSpan &) = delete;
+    ScopedSpan(ScopedSpan &&) = delete;
+    ScopedSpan &operator=(ScopedSpan &&) = delete;
+
+  private:
+    Operation operation_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace crescent::metrics
+
+/**
+ * Instrumentation entry point. With CRESCENT_ENABLE_METRICS undefined the
+ * macro expands to nothing, so instrumented code pays no cost at all.
+ */
+#define CRESCENT_METRICS_CONCAT_INNER(a, b) a##b
+#define CRESCENT_METRICS_CONCAT(a, b) CRESCENT_METRICS_CONCAT_INNER(a, b)
+
+#ifdef CRESCENT_ENABLE_METRICS
+#define CRESCENT_TRACE_SPAN(operation)                                         \
+    ::crescent::metrics::ScopedSpan CRESCENT_METRICS_CONCAT(                   \
+        crescentTraceSpan_, __LINE__)(::crescent::metrics::Operation::operation)
+#else
+#define CRESCENT_TRACE_SPAN(operation) static_cast<void>(0)
+#endif
+
+#endif // SIMULATION_COMMON_METRICS_TRACE_SPAN_H
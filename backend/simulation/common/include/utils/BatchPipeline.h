@@ -0,0 +1,201 @@
+#ifndef SIMULATION_COMMON_UTILS_BATCH_PIPELINE_H
+#define SIMULATION_COMMON_UTILS_BATCH_PIPELINE_H
+
+#include "common/utils/BoundedQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Runs batches through ordered stages on dedicated thread groups
+ *
+ * Each stage has its own threads, and consecutive stages are linked by a
+ * BoundedQueue of queueDepth batches, so a slow stage holds back the ones
+ * before it instead of letting work pile up. Within a stage batches may
+ * finish out of order; the sink runs on the calling thread and sees them
+ * in their original order.
+ *
+ * The first exception thrown by a stage or the sink closes every queue,
+ * and run() rethrows it once all threads have stopped.
+ */
+template <typename Batch> class BatchPipeline {
+  public:
+    struct Stage {
+        std::function<void(Batch &)> body;
+        std::size_t threads{1};
+    };
+
+    /**
+     * @brief Busy time per stage, summed over its threads, then the sink's
+     */
+    using Timings = std::vector<std::chrono::nanoseconds>;
+
+    BatchPipeline(std::vector<Stage> stages, std::size_t queueDepth)
+        : stages_(std::move(stages)),
+          queueDepth_(std::max<std::size_t>(queueDepth, 1)) {}
+
+    // Prevent copying and moving
+    BatchPipeline(const BatchPipeline &) = delete;
+    BatchPipeline &operator=(const BatchPipeline &) = delete;
+    BatchPipeline(BatchPipeline &&) = delete;
+    BatchPipeline &operator=(BatchPipeline &&) = delete;
+
+    /**
+     * @brief Pushes every batch through the stages, then into sink in order
+     * @return One entry per stage, plus a last one for the sink
+     */
+    Timings run(std::vector<Batch> batches,
+                const std::function<void(Batch &)> &sink) {
+        // queues[i] feeds stage i; the last one feeds the sink
+        std::vector<std::unique_ptr<BoundedQueue<Item>>> queues;
+        for (std::size_t i = 0; i <= stages_.size(); ++i) {
+            queues.push_back(std::make_unique<BoundedQueue<Item>>(queueDepth_));
+        }
+        Shared shared(stages_.size());
+
+        std::vector<std::thread> threads;
+        threads.emplace_back([&] {
+            std::uint64_t sequence = 0;
+            for (Batch &batch : batches) {
+                if (!queues.front()->push({sequence++, std::move(batch)})) {
+                    return;
+                }
+            }
+            queues.front()->close();
+        });
+        for (std::size_t stage = 0; stage < stages_.size(); ++stage) {
+            const std::size_t count =
+                std::max<std::size_t>(stages_[stage].threads, 1);
+            shared.running[stage] = count;
+            for (std::size_t t = 0; t < count; ++t) {
+                threads.emplace_back([&, stage] {
+                    runStage(stage, *queues[stage], *queues[stage + 1],
+                             shared);
+                });
+            }
+        }
+
+        Timings timings(stages_.size() + 1);
+        try {
+            drain(*queues.back(), sink, timings.back());
+        } catch (...) {
+            shared.fail(std::current_exception());
+        }
+        if (shared.failed()) {
+            for (auto &queue : queues) {
+                queue->close();
+            }
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        if (shared.error) {
+            std::rethrow_exception(shared.error);
+        }
+        for (std::size_t stage = 0; stage < stages_.size(); ++stage) {
+            timings[stage] = std::chrono::nanoseconds(shared.busy[stage]);
+        }
+        return timings;
+    }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Item {
+        std::uint64_t sequence{0};
+        Batch batch;
+    };
+
+    // State shared by the threads of one run()
+    struct Shared {
+        explicit Shared(std::size_t stages)
+            : running(stages), busy(stages) {}
+
+        std::vector<std::size_t> running; // Threads left per stage
+        std::vector<std::atomic<std::int64_t>> busy;
+        std::mutex mutex;
+        std::exception_ptr error;
+        std::atomic<bool> aborted{false};
+
+        void fail(std::exception_ptr exception) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::move(exception);
+            }
+            aborted = true;
+        }
+        bool failed() const { return aborted.load(); }
+    };
+
+    std::vector<Stage> stages_;
+    std::size_t queueDepth_;
+
+    void runStage(std::size_t stage, BoundedQueue<Item> &input,
+                  BoundedQueue<Item> &output, Shared &shared) {
+        std::int64_t busy = 0;
+        try {
+            while (std::optional<Item> item = input.pop()) {
+                const auto start = Clock::now();
+                stages_[stage].body(item->batch);
+                busy += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            Clock::now() - start)
+                            .count();
+                if (!output.push(std::move(*item))) {
+                    break;
+                }
+            }
+        } catch (...) {
+            shared.fail(std::current_exception());
+            input.close();
+            output.close();
+        }
+        shared.busy[stage] += busy;
+
+        // The last thread out ends the next stage's input
+        bool last = false;
+        {
+            std::lock_guard<std::mutex> lock(shared.mutex);
+            last = --shared.running[stage] == 0;
+        }
+        if (last || shared.failed()) {
+            output.close();
+        }
+    }
+
+    static void drain(BoundedQueue<Item> &input,
+                      const std::function<void(Batch &)> &sink,
+                      std::chrono::nanoseconds &busy) {
+        std::map<std::uint64_t, Batch> pending;
+        std::uint64_t next = 0;
+        while (std::optional<Item> item = input.pop()) {
+            pending.emplace(item->sequence, std::move(item->batch));
+            auto it = pending.begin();
+            while (it != pending.end() && it->first == next) {
+                const auto start = Clock::now();
+                sink(it->second);
+                busy += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    Clock::now() - start);
+                it = pending.erase(it);
+                ++next;
+            }
+        }
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_BATCH_PIPELINE_H
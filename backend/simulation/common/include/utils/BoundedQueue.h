@@ -0,0 +1,90 @@
+#ifndef SIMULATION_COMMON_UTILS_BOUNDED_QUEUE_H
+#define SIMULATION_COMMON_UTILS_BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace crescent::common {
+
+/**
+ * @brief Blocking multi-producer, multi-consumer queue with a fixed capacity
+ *
+ * Meant for pipeline stages that hand off whole batches, where the lock is
+ * taken once per batch and the capacity provides backpressure so a fast
+ * stage cannot run arbitrarily far ahead of a slow one. close() wakes all
+ * waiters; consumers drain what remains and then receive nullopt.
+ */
+template <typename T> class BoundedQueue {
+  public:
+    explicit BoundedQueue(std::size_t capacity) : capacity_(capacity) {}
+
+    // Prevent copying and moving
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+    BoundedQueue(BoundedQueue &&) = delete;
+    BoundedQueue &operator=(BoundedQueue &&) = delete;
+
+    /**
+     * @brief Blocks while full
+     * @return False if the queue was closed; the value is dropped
+     */
+    bool push(T value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock,
+                      [&] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(value));
+        lock.unlock();
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Blocks while empty
+     * @return Nullopt once the queue is closed and drained
+     */
+    std::optional<T> pop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return std::nullopt;
+        }
+        std::optional<T> value(std::move(items_.front()));
+        items_.pop_front();
+        lock.unlock();
+        notFull_.notify_one();
+        return value;
+    }
+
+    void close() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        notEmpty_.notify_all();
+        notFull_.notify_all();
+    }
+
+    bool isClosed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closed_;
+    }
+
+  private:
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable notEmpty_;
+    std::condition_variable notFull_;
+    std::deque<T> items_;
+    bool closed_{false};
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_BOUNDED_QUEUE_H
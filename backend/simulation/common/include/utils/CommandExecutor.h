@@ -0,0 +1,400 @@
+#ifndef SIMULATION_COMMON_UTILS_COMMAND_EXECUTOR_H
+#define SIMULATION_COMMON_UTILS_COMMAND_EXECUTOR_H
+
+#include "common/utils/MpscQueue.h"
+#include "common/utils/ScheduledQueue.h"
+#include "common/utils/ShardedSlotMap.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Move-only mutation queued against a single entry
+ */
+template <typename T> class Command {
+  public:
+    Command() = default;
+    template <typename Fn>
+    explicit Command(Fn &&fn)
+        : impl_(std::make_unique<Model<std::decay_t<Fn>>>(
+              std::forward<Fn>(fn))) {}
+
+    void operator()(T &target) { impl_->run(target); }
+    explicit operator bool() const { return impl_ != nullptr; }
+
+  private:
+    struct Concept {
+        virtual ~Concept() = default;
+        virtual void run(T &target) = 0;
+    };
+    template <typename Fn> struct Model final : Concept {
+        explicit Model(Fn f) : fn(std::move(f)) {}
+        void run(T &target) override { fn(target); }
+        Fn fn;
+    };
+
+    std::unique_ptr<Concept> impl_;
+};
+
+/**
+ * @brief Per-entry command queue
+ *
+ * Any thread may post; only the worker that owns the entry drains. The
+ * scheduled flag makes sure a mailbox sits in its worker's ready queue at
+ * most once no matter how many producers post concurrently (see
+ * ScheduledQueue for the hand-off protocol).
+ */
+template <typename T> class Mailbox {
+  public:
+    explicit Mailbox(SlotHandle handle) : handle_(handle) {}
+
+    SlotHandle getHandle() const { return handle_; }
+
+    void post(Command<T> command) { queue_.push(std::move(command)); }
+
+    /**
+     * @brief Claims the right to enqueue this mailbox for draining
+     * @return True if the caller must hand it to the owning worker
+     */
+    bool trySchedule() { return queue_.trySchedule(); }
+
+    /**
+     * @brief Drops the scheduled flag after a drain
+     * @return True if commands arrived meanwhile and it must be rescheduled
+     */
+    bool releaseSchedule() { return queue_.releaseSchedule(); }
+
+    // Worker side
+    std::optional<Command<T>> take() { return queue_.pop(); }
+    bool isEmpty() const { return queue_.empty(); }
+
+  private:
+    SlotHandle handle_;
+    ScheduledQueue<Command<T>> queue_;
+};
+
+/**
+ * @brief Runs queued commands against the entries of a sharded store in
+ * batches on a worker pool
+ *
+ * Store is a ShardedSlotMap or anything with its SHARD_COUNT and
+ * write(handle, fn(T &)). Every entry is pinned to one worker by store
+ * shard, so commands for an entry execute in submission order on a single
+ * thread and never contend with each other. A worker applies up to
+ * maxBatchSize commands per store write, taking the entry's lock once per
+ * batch instead of once per command; readers only ever see whole batches.
+ * A mailbox with more than one batch waiting goes to the back of its
+ * worker's ready queue between batches, so one hot entry cannot starve the
+ * others on that worker.
+ *
+ * Commands submitted while the executor is stopped wait for start(). A
+ * command that is destroyed without running (its entry was removed, or the
+ * executor was destroyed first) leaves a broken_promise in its future.
+ */
+template <typename T, typename Store> class BasicCommandExecutor {
+  public:
+    using MailboxRef = std::shared_ptr<Mailbox<T>>;
+
+    struct Config {
+        std::size_t workerCount{0}; // 0 = hardware concurrency
+        std::size_t maxBatchSize{64};
+    };
+
+    explicit BasicCommandExecutor(Store &store)
+        : BasicCommandExecutor(store, Config{}) {}
+
+    BasicCommandExecutor(Store &store, Config config)
+        : store_(store), config_(config) {
+        if (config_.workerCount == 0) {
+            config_.workerCount =
+                std::max(1u, std::thread::hardware_concurrency());
+        }
+        // A worker owns whole shards, so more would sit idle
+        config_.workerCount =
+            std::min<std::size_t>(config_.workerCount, Store::SHARD_COUNT);
+        config_.maxBatchSize = std::max<std::size_t>(config_.maxBatchSize, 1);
+        for (std::size_t i = 0; i < config_.workerCount; ++i) {
+            workers_.push_back(std::make_unique<Worker>());
+        }
+    }
+
+    ~BasicCommandExecutor() { stop(); }
+
+    // Prevent copying and moving
+    BasicCommandExecutor(const BasicCommandExecutor &) = delete;
+    BasicCommandExecutor &operator=(const BasicCommandExecutor &) = delete;
+    BasicCommandExecutor(BasicCommandExecutor &&) = delete;
+    BasicCommandExecutor &operator=(BasicCommandExecutor &&) = delete;
+
+    /**
+     * @brief Starts the workers; commands already queued run first
+     */
+    void start() {
+        std::lock_guard<std::mutex> lock(lifecycleMutex_);
+        if (running_.exchange(true)) {
+            return;
+        }
+        for (const auto &worker : workers_) {
+            Worker *raw = worker.get();
+            raw->thread = std::thread([this, raw] { workerLoop(*raw); });
+        }
+    }
+
+    /**
+     * @brief Joins the workers once their ready queues are empty, then runs
+     * whatever was scheduled during shutdown on the calling thread
+     *
+     * Every command submitted before stop() is called has run when it
+     * returns.
+     */
+    void stop() {
+        std::lock_guard<std::mutex> lock(lifecycleMutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+        for (const auto &worker : workers_) {
+            wake(*worker);
+        }
+        for (const auto &worker : workers_) {
+            worker->thread.join();
+        }
+        // The workers are gone, so this thread is now the only consumer
+        for (const auto &worker : workers_) {
+            while (std::optional<MailboxRef> mailbox = worker->ready.pop()) {
+                while (drainBatch(*worker, **mailbox)) {
+                }
+                finishDrain(*worker, *mailbox);
+            }
+        }
+    }
+
+    /**
+     * @brief Resolves the mailbox for an entry
+     *
+     * Takes a short shard lock; callers that post repeatedly should keep
+     * the returned reference and submit through it.
+     */
+    MailboxRef getMailbox(SlotHandle handle) {
+        MailboxShard &shard = mailboxShards_[shardOf(handle)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        MailboxRef &mailbox = shard.mailboxes[handle.pack()];
+        if (!mailbox) {
+            mailbox = std::make_shared<Mailbox<T>>(handle);
+        }
+        return mailbox;
+    }
+
+    /**
+     * @brief Forgets an entry's mailbox once the entry is removed
+     *
+     * Commands still queued in it run against the stale handle and are
+     * dropped.
+     */
+    void dropMailbox(SlotHandle handle) {
+        MailboxShard &shard = mailboxShards_[shardOf(handle)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.mailboxes.erase(handle.pack());
+    }
+
+    /**
+     * @brief Queues fn(T &) and returns its result as a future
+     *
+     * The future holds an exception if fn throws, or a broken_promise if
+     * the entry is removed before the command runs.
+     */
+    template <typename Fn> auto submit(const MailboxRef &mailbox, Fn &&fn) {
+        using Result = std::invoke_result_t<Fn &, T &>;
+        auto promise = std::make_shared<std::promise<Result>>();
+        std::future<Result> future = promise->get_future();
+        mailbox->post(Command<T>(
+            [promise, fn = std::forward<Fn>(fn)](T &target) mutable {
+                try {
+                    if constexpr (std::is_void_v<Result>) {
+                        fn(target);
+                        promise->set_value();
+                    } else {
+                        promise->set_value(fn(target));
+                    }
+                } catch (...) {
+                    promise->set_exception(std::current_exception());
+                }
+            }));
+        if (mailbox->trySchedule()) {
+            schedule(mailbox);
+        }
+        return future;
+    }
+
+    template <typename Fn> auto submit(SlotHandle handle, Fn &&fn) {
+        return submit(getMailbox(handle), std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Execution statistics
+     */
+    struct ExecutorMetrics {
+        std::size_t commandsExecuted{0};
+        std::size_t batchesExecuted{0};
+        std::size_t commandsDropped{0}; // Entry removed before running
+        float averageBatchSize{0.0f};
+    };
+    ExecutorMetrics getMetrics() const {
+        ExecutorMetrics metrics;
+        for (const auto &worker : workers_) {
+            metrics.commandsExecuted +=
+                worker->commandsExecuted.load(std::memory_order_relaxed);
+            metrics.batchesExecuted +=
+                worker->batchesExecuted.load(std::memory_order_relaxed);
+            metrics.commandsDropped +=
+                worker->commandsDropped.load(std::memory_order_relaxed);
+        }
+        if (metrics.batchesExecuted > 0) {
+            metrics.averageBatchSize =
+                static_cast<float>(metrics.commandsExecuted) /
+                static_cast<float>(metrics.batchesExecuted);
+        }
+        return metrics;
+    }
+
+  private:
+    // Mailbox lookup, sharded like the store
+    struct alignas(64) MailboxShard {
+        std::mutex mutex;
+        std::unordered_map<std::uint64_t, MailboxRef> mailboxes;
+    };
+
+    // One ready queue per worker; only its worker (or stop()) drains it
+    struct Worker {
+        std::thread thread;
+        MpscQueue<MailboxRef> ready;
+        std::mutex idleMutex;
+        std::condition_variable wakeup;
+        std::atomic<bool> sleeping{false};
+        std::vector<Command<T>> batch; // Reused scratch
+        std::atomic<std::size_t> commandsExecuted{0};
+        std::atomic<std::size_t> batchesExecuted{0};
+        std::atomic<std::size_t> commandsDropped{0};
+    };
+
+    static std::size_t shardOf(SlotHandle handle) {
+        return handle.index & (Store::SHARD_COUNT - 1);
+    }
+
+    Worker &workerFor(SlotHandle handle) const {
+        return *workers_[shardOf(handle) % workers_.size()];
+    }
+
+    void schedule(const MailboxRef &mailbox) {
+        Worker &worker = workerFor(mailbox->getHandle());
+        worker.ready.push(mailbox);
+        // Pairs with the fence in workerLoop: either the worker sees this
+        // push before sleeping or this thread sees it asleep
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (worker.sleeping.load(std::memory_order_relaxed)) {
+            wake(worker);
+        }
+    }
+
+    static void wake(Worker &worker) {
+        {
+            std::lock_guard<std::mutex> lock(worker.idleMutex);
+            worker.sleeping.store(false, std::memory_order_relaxed);
+        }
+        worker.wakeup.notify_one();
+    }
+
+    void workerLoop(Worker &worker) {
+        for (;;) {
+            if (std::optional<MailboxRef> mailbox = worker.ready.pop()) {
+                if (drainBatch(worker, **mailbox)) {
+                    // More waiting; go behind the other ready mailboxes
+                    worker.ready.push(std::move(*mailbox));
+                } else {
+                    finishDrain(worker, *mailbox);
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(worker.idleMutex);
+            worker.sleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!worker.ready.empty()) {
+                worker.sleeping.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            if (!running_.load()) {
+                return; // Nothing ready and stop() was called
+            }
+            worker.wakeup.wait(lock, [&worker] {
+                return !worker.sleeping.load(std::memory_order_relaxed);
+            });
+        }
+    }
+
+    /**
+     * @brief Runs up to maxBatchSize commands in one store write
+     * @return True if a full batch ran and more may be waiting
+     */
+    bool drainBatch(Worker &worker, Mailbox<T> &mailbox) {
+        std::vector<Command<T>> &batch = worker.batch;
+        while (batch.size() < config_.maxBatchSize) {
+            std::optional<Command<T>> command = mailbox.take();
+            if (!command) {
+                break;
+            }
+            batch.push_back(std::move(*command));
+        }
+        if (batch.empty()) {
+            return false;
+        }
+        const bool live =
+            store_.write(mailbox.getHandle(), [&batch](T &target) {
+                for (Command<T> &command : batch) {
+                    command(target);
+                }
+            });
+        if (live) {
+            worker.commandsExecuted.fetch_add(batch.size(),
+                                              std::memory_order_relaxed);
+            worker.batchesExecuted.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            worker.commandsDropped.fetch_add(batch.size(),
+                                             std::memory_order_relaxed);
+        }
+        const bool full = batch.size() == config_.maxBatchSize;
+        batch.clear(); // Breaks the promises of dropped commands
+        return full;
+    }
+
+    void finishDrain(Worker &worker, const MailboxRef &mailbox) {
+        if (mailbox->releaseSchedule()) {
+            worker.ready.push(mailbox);
+        }
+    }
+
+    Store &store_;
+    Config config_;
+    std::array<MailboxShard, Store::SHARD_COUNT> mailboxShards_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::mutex lifecycleMutex_;
+    std::atomic<bool> running_{false};
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_COMMAND_EXECUTOR_H
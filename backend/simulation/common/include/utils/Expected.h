@@ -0,0 +1,67 @@
+#ifndef SIMULATION_COMMON_UTILS_EXPECTED_H
+#define SIMULATION_COMMON_UTILS_EXPECTED_H
+
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace crescent::common {
+
+/**
+ * @brief Wraps an error so Expected can be built from it unambiguously
+ */
+template <typename E> struct Unexpected {
+    E error;
+};
+
+template <typename E> Unexpected<std::decay_t<E>> unexpected(E &&error) {
+    return {std::forward<E>(error)};
+}
+
+/**
+ * @brief Either a value or the error that prevented it
+ *
+ * A minimal std::expected for C++17. Engine operations return this instead
+ * of a struct with a success flag and message strings, so a failure costs
+ * no more than its error record and success carries only its payload.
+ * Accessing the wrong alternative is undefined; check first.
+ */
+template <typename T, typename E> class Expected {
+  public:
+    using value_type = T;
+    using error_type = E;
+
+    template <typename U = T,
+              typename = std::enable_if_t<std::is_default_constructible_v<U>>>
+    Expected() : storage_(std::in_place_index<0>) {}
+    Expected(const T &value) : storage_(std::in_place_index<0>, value) {}
+    Expected(T &&value) : storage_(std::in_place_index<0>, std::move(value)) {}
+    template <typename G>
+    Expected(Unexpected<G> error)
+        : storage_(std::in_place_index<1>, std::move(error.error)) {}
+
+    bool has_value() const { return storage_.index() == 0; }
+    explicit operator bool() const { return has_value(); }
+
+    T &value() { return *std::get_if<0>(&storage_); }
+    const T &value() const { return *std::get_if<0>(&storage_); }
+    T &operator*() { return value(); }
+    const T &operator*() const { return value(); }
+    T *operator->() { return &value(); }
+    const T *operator->() const { return &value(); }
+
+    E &error() { return *std::get_if<1>(&storage_); }
+    const E &error() const { return *std::get_if<1>(&storage_); }
+
+    template <typename U> T value_or(U &&fallback) const {
+        return has_value() ? value()
+                           : static_cast<T>(std::forward<U>(fallback));
+    }
+
+  private:
+    std::variant<T, E> storage_;
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_EXPECTED_H
@@ -0,0 +1,240 @@
+#ifndef SIMULATION_COMMON_UTILS_INLINE_VECTOR_H
+#define SIMULATION_COMMON_UTILS_INLINE_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace crescent::common {
+
+/**
+ * @brief Sequence that keeps up to N elements inline
+ *
+ * Behaves like a std::vector subset, but the first N elements live inside
+ * the object, so short lists (a result's effects, a handful of warnings)
+ * never touch the heap. Growing past N moves everything to a heap buffer
+ * that doubles like a vector's and is kept until the container is
+ * destroyed or shrink_to_fit() is called.
+ *
+ * Any growth may invalidate iterators and references, as with std::vector.
+ * Moving an inline container moves its elements one by one.
+ */
+template <typename T, std::size_t N> class InlineVector {
+    static_assert(N > 0, "InlineVector needs inline capacity");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T &;
+    using const_reference = const T &;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    static constexpr size_type INLINE_CAPACITY = N;
+
+    InlineVector() = default;
+    InlineVector(std::initializer_list<T> values) {
+        reserve(values.size());
+        for (const T &value : values) {
+            push_back(value);
+        }
+    }
+    InlineVector(const InlineVector &other) {
+        reserve(other.size_);
+        for (const T &value : other) {
+            push_back(value);
+        }
+    }
+    InlineVector(InlineVector &&other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        takeFrom(other);
+    }
+    InlineVector &operator=(const InlineVector &other) {
+        if (this != &other) {
+            clear();
+            reserve(other.size_);
+            for (const T &value : other) {
+                push_back(value);
+            }
+        }
+        return *this;
+    }
+    InlineVector &operator=(InlineVector &&other) noexcept(
+        std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            release();
+            takeFrom(other);
+        }
+        return *this;
+    }
+    ~InlineVector() {
+        clear();
+        release();
+    }
+
+    // Capacity
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    size_type capacity() const { return capacity_; }
+    bool isInline() const { return data_ == inlineData(); }
+
+    /**
+     * @brief Heap bytes owned by the container itself (not by its elements)
+     */
+    size_type heapBytes() const {
+        return isInline() ? 0 : capacity_ * sizeof(T);
+    }
+
+    void reserve(size_type count) {
+        if (count > capacity_) {
+            relocate(count);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (isInline()) {
+            return;
+        }
+        if (size_ <= N) {
+            T *heap = data_;
+            data_ = inlineData();
+            capacity_ = N;
+            moveElements(heap, data_, size_);
+            ::operator delete(static_cast<void *>(heap),
+                              std::align_val_t{alignof(T)});
+        } else if (size_ < capacity_) {
+            relocate(size_);
+        }
+    }
+
+    // Element access
+    T &operator[](size_type index) { return data_[index]; }
+    const T &operator[](size_type index) const { return data_[index]; }
+    T &at(size_type index) {
+        checkIndex(index);
+        return data_[index];
+    }
+    const T &at(size_type index) const {
+        checkIndex(index);
+        return data_[index];
+    }
+    T &front() { return data_[0]; }
+    const T &front() const { return data_[0]; }
+    T &back() { return data_[size_ - 1]; }
+    const T &back() const { return data_[size_ - 1]; }
+    T *data() { return data_; }
+    const T *data() const { return data_; }
+
+    // Iteration
+    iterator begin() { return data_; }
+    iterator end() { return data_ + size_; }
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // Modifiers
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    template <typename... Args> T &emplace_back(Args &&...args) {
+        if (size_ == capacity_) {
+            // Build first: args may refer to an element about to move
+            T value(std::forward<Args>(args)...);
+            relocate(capacity_ * 2);
+            ::new (static_cast<void *>(data_ + size_)) T(std::move(value));
+        } else {
+            ::new (static_cast<void *>(data_ + size_))
+                T(std::forward<Args>(args)...);
+        }
+        return data_[size_++];
+    }
+
+    void pop_back() { data_[--size_].~T(); }
+
+    void clear() {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    iterator erase(const_iterator position) {
+        T *target = data_ + (position - data_);
+        std::move(target + 1, end(), target);
+        pop_back();
+        return target;
+    }
+
+    friend bool operator==(const InlineVector &a, const InlineVector &b) {
+        return a.size_ == b.size_ && std::equal(a.begin(), a.end(), b.begin());
+    }
+    friend bool operator!=(const InlineVector &a, const InlineVector &b) {
+        return !(a == b);
+    }
+
+  private:
+    alignas(T) unsigned char inline_[N * sizeof(T)];
+    T *data_{inlineData()};
+    size_type size_{0};
+    size_type capacity_{N};
+
+    T *inlineData() { return reinterpret_cast<T *>(inline_); }
+    const T *inlineData() const {
+        return reinterpret_cast<const T *>(inline_);
+    }
+
+    static void moveElements(T *from, T *to, size_type count) {
+        std::uninitialized_move(from, from + count, to);
+        std::destroy(from, from + count);
+    }
+
+    void relocate(size_type newCapacity) {
+        T *heap = static_cast<T *>(::operator new(
+            newCapacity * sizeof(T), std::align_val_t{alignof(T)}));
+        moveElements(data_, heap, size_);
+        release();
+        data_ = heap;
+        capacity_ = newCapacity;
+    }
+
+    // Frees the heap buffer, if any; elements must already be gone or moved
+    void release() {
+        if (!isInline()) {
+            ::operator delete(static_cast<void *>(data_),
+                              std::align_val_t{alignof(T)});
+            data_ = inlineData();
+            capacity_ = N;
+        }
+    }
+
+    // Leaves other empty; *this must be empty and inline
+    void takeFrom(InlineVector &other) {
+        if (other.isInline()) {
+            moveElements(other.data_, data_, other.size_);
+            size_ = other.size_;
+        } else {
+            data_ = other.data_;
+            size_ = other.size_;
+            capacity_ = other.capacity_;
+            other.data_ = other.inlineData();
+            other.capacity_ = N;
+        }
+        other.size_ = 0;
+    }
+
+    void checkIndex(size_type index) const {
+        if (index >= size_) {
+            throw std::out_of_range("InlineVector index out of range");
+        }
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_INLINE_VECTOR_H
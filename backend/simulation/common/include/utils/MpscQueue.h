@@ -0,0 +1,104 @@
+#ifndef SIMULATION_COMMON_UTILS_MPSC_QUEUE_H
+#define SIMULATION_COMMON_UTILS_MPSC_QUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <optional>
+#include <utility>
+
+namespace crescent::common {
+
+/**
+ * @brief Unbounded multi-producer, single-consumer queue
+ *
+ * Linked-list design after Vyukov: push is a single atomic exchange and never
+ * blocks; pop must only be called from one thread at a time. A pop that races
+ * with a push still in progress may briefly report empty, so consumers that
+ * rely on "nothing left" should re-check after publishing their idle state.
+ */
+template <typename T> class MpscQueue {
+  public:
+    MpscQueue() : head_(&stub_), tail_(&stub_) {}
+    ~MpscQueue() {
+        while (pop()) {
+        }
+    }
+
+    // Prevent copying and moving
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+    MpscQueue(MpscQueue &&) = delete;
+    MpscQueue &operator=(MpscQueue &&) = delete;
+
+    /**
+     * @brief Enqueues a value; safe from any number of threads
+     */
+    void push(T value) {
+        Node *node = new Node(std::move(value));
+        Node *previous = head_.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Dequeues the oldest value; consumer thread only
+     */
+    std::optional<T> pop() {
+        Node *tail = tail_;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &stub_) {
+            if (!next) {
+                return std::nullopt;
+            }
+            tail_ = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            tail_ = next;
+            return take(tail);
+        }
+        if (tail != head_.load(std::memory_order_acquire)) {
+            return std::nullopt; // Producer mid-push
+        }
+        // Re-append the stub so the last real node can be released
+        stub_.next.store(nullptr, std::memory_order_relaxed);
+        Node *previous = head_.exchange(&stub_, std::memory_order_acq_rel);
+        previous->next.store(&stub_, std::memory_order_release);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            tail_ = next;
+            return take(tail);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Consumer-side emptiness hint; may miss an in-flight push
+     */
+    bool empty() const {
+        return tail_ == &stub_ &&
+               stub_.next.load(std::memory_order_acquire) == nullptr;
+    }
+
+  private:
+    struct Node {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+        std::atomic<Node *> next{nullptr};
+        std::optional<T> value;
+    };
+
+    static std::optional<T> take(Node *node) {
+        std::optional<T> value = std::move(node->value);
+        delete node;
+        return value;
+    }
+
+    alignas(64) std::atomic<Node *> head_; // Producers
+    alignas(64) Node *tail_;               // Consumer
+    Node stub_;
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_MPSC_QUEUE_H
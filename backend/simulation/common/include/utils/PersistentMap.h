@@ -0,0 +1,285 @@
+#ifndef SIMULATION_COMMON_UTILS_PERSISTENT_MAP_H
+#define SIMULATION_COMMON_UTILS_PERSISTENT_MAP_H
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Immutable hash map with structural sharing (HAMT)
+ *
+ * A hash array mapped trie: each level consumes five hash bits and stores
+ * only occupied slots, indexed through a 32-bit bitmap. Updates copy the
+ * path to the changed entry and share everything else, so snapshots are a
+ * refcount bump and diverging versions cost O(log32 n) nodes per change.
+ * Keys whose 64-bit hashes collide fully share a flat collision node.
+ */
+template <typename K, typename V, typename Hash = std::hash<K>,
+          typename Equal = std::equal_to<K>>
+class PersistentMap {
+  public:
+    PersistentMap() = default;
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const V *find(const K &key) const {
+        const std::uint64_t h = hashOf(key);
+        const Node *node = root_.get();
+        for (unsigned shift = 0; node; shift += BITS) {
+            if (node->collision) {
+                for (const auto &entry : node->entries) {
+                    const Leaf &leaf = std::get<Leaf>(entry);
+                    if (Equal()(leaf.first, key)) {
+                        return &leaf.second;
+                    }
+                }
+                return nullptr;
+            }
+            const std::uint32_t bit = bitFor(h, shift);
+            if (!(node->bitmap & bit)) {
+                return nullptr;
+            }
+            const auto &entry = node->entries[slotOf(node->bitmap, bit)];
+            if (const Leaf *leaf = std::get_if<Leaf>(&entry)) {
+                return Equal()(leaf->first, key) ? &leaf->second : nullptr;
+            }
+            node = std::get<NodePtr>(entry).get();
+        }
+        return nullptr;
+    }
+
+    bool contains(const K &key) const { return find(key) != nullptr; }
+
+    /**
+     * @brief Returns a map with key bound to value
+     */
+    PersistentMap set(K key, V value) const {
+        PersistentMap result;
+        bool added = false;
+        const std::uint64_t h = hashOf(key);
+        result.root_ = insert(root_, 0, h, Leaf(std::move(key),
+                                                std::move(value)),
+                              added);
+        result.size_ = size_ + (added ? 1 : 0);
+        return result;
+    }
+
+    /**
+     * @brief Returns a map without key; shares this map if absent
+     */
+    PersistentMap erase(const K &key) const {
+        bool removed = false;
+        NodePtr root = remove(root_, 0, hashOf(key), key, removed);
+        if (!removed) {
+            return *this;
+        }
+        PersistentMap result;
+        result.root_ = std::move(root);
+        result.size_ = size_ - 1;
+        return result;
+    }
+
+    /**
+     * @brief Visits entries as fn(key, value) in unspecified order
+     */
+    template <typename Fn> void forEach(Fn &&fn) const {
+        if (root_) {
+            visit(*root_, fn);
+        }
+    }
+
+    bool sharesRootWith(const PersistentMap &other) const {
+        return root_ == other.root_;
+    }
+
+  private:
+    static constexpr unsigned BITS = 5;
+    static constexpr unsigned HASH_BITS = 64;
+
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+    using Leaf = std::pair<K, V>;
+    using Entry = std::variant<Leaf, NodePtr>;
+
+    struct Node {
+        std::uint32_t bitmap{0};
+        bool collision{false}; // Entries are leaves with equal hashes
+        std::vector<Entry> entries;
+    };
+
+    NodePtr root_;
+    std::size_t size_{0};
+
+    static std::uint64_t hashOf(const K &key) {
+        // Spread weak hashes (identity for integers) across all levels
+        std::uint64_t z = static_cast<std::uint64_t>(Hash()(key));
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+    static std::uint32_t bitFor(std::uint64_t h, unsigned shift) {
+        return std::uint32_t{1} << ((h >> shift) & 31);
+    }
+    static std::size_t slotOf(std::uint32_t bitmap, std::uint32_t bit) {
+        return std::bitset<32>(bitmap & (bit - 1)).count();
+    }
+
+    static NodePtr merge(unsigned shift, Leaf a, std::uint64_t ha, Leaf b,
+                         std::uint64_t hb) {
+        auto node = std::make_shared<Node>();
+        if (shift >= HASH_BITS) {
+            node->collision = true;
+            node->entries.emplace_back(std::move(a));
+            node->entries.emplace_back(std::move(b));
+            return node;
+        }
+        const std::uint32_t bitA = bitFor(ha, shift);
+        const std::uint32_t bitB = bitFor(hb, shift);
+        if (bitA == bitB) {
+            node->bitmap = bitA;
+            node->entries.emplace_back(merge(shift + BITS, std::move(a), ha,
+                                             std::move(b), hb));
+        } else {
+            node->bitmap = bitA | bitB;
+            if (bitA < bitB) {
+                node->entries.emplace_back(std::move(a));
+                node->entries.emplace_back(std::move(b));
+            } else {
+                node->entries.emplace_back(std::move(b));
+                node->entries.emplace_back(std::move(a));
+            }
+        }
+        return node;
+    }
+
+    static NodePtr insert(const NodePtr &node, unsigned shift,
+                          std::uint64_t h, Leaf leaf, bool &added) {
+        if (!node) {
+            auto fresh = std::make_shared<Node>();
+            fresh->bitmap = bitFor(h, shift);
+            fresh->entries.emplace_back(std::move(leaf));
+            added = true;
+            return fresh;
+        }
+        auto copy = std::make_shared<Node>(*node);
+        if (node->collision) {
+            for (auto &entry : copy->entries) {
+                Leaf &existing = std::get<Leaf>(entry);
+                if (Equal()(existing.first, leaf.first)) {
+                    existing.second = std::move(leaf.second);
+                    return copy;
+                }
+            }
+            copy->entries.emplace_back(std::move(leaf));
+            added = true;
+            return copy;
+        }
+        const std::uint32_t bit = bitFor(h, shift);
+        const std::size_t slot = slotOf(node->bitmap, bit);
+        if (!(node->bitmap & bit)) {
+            copy->bitmap |= bit;
+            copy->entries.emplace(copy->entries.begin() + slot,
+                                  std::move(leaf));
+            added = true;
+            return copy;
+        }
+        Entry &entry = copy->entries[slot];
+        if (Leaf *existing = std::get_if<Leaf>(&entry)) {
+            if (Equal()(existing->first, leaf.first)) {
+                existing->second = std::move(leaf.second);
+            } else {
+                const std::uint64_t existingHash = hashOf(existing->first);
+                entry = merge(shift + BITS, std::move(*existing),
+                              existingHash, std::move(leaf), h);
+                added = true;
+            }
+            return copy;
+        }
+        entry = insert(std::get<NodePtr>(entry), shift + BITS, h,
+                       std::move(leaf), added);
+        return copy;
+    }
+
+    static NodePtr remove(const NodePtr &node, unsigned shift,
+                          std::uint64_t h, const K &key, bool &removed) {
+        if (!node) {
+            return node;
+        }
+        if (node->collision) {
+            for (std::size_t i = 0; i < node->entries.size(); ++i) {
+                if (Equal()(std::get<Leaf>(node->entries[i]).first, key)) {
+                    removed = true;
+                    if (node->entries.size() == 1) {
+                        return nullptr;
+                    }
+                    auto copy = std::make_shared<Node>(*node);
+                    copy->entries.erase(copy->entries.begin() + i);
+                    return copy;
+                }
+            }
+            return node;
+        }
+        const std::uint32_t bit = bitFor(h, shift);
+        if (!(node->bitmap & bit)) {
+            return node;
+        }
+        const std::size_t slot = slotOf(node->bitmap, bit);
+        const Entry &entry = node->entries[slot];
+        std::optional<Entry> replacement;
+        if (const Leaf *leaf = std::get_if<Leaf>(&entry)) {
+            if (!Equal()(leaf->first, key)) {
+                return node;
+            }
+            removed = true;
+        } else {
+            const NodePtr &child = std::get<NodePtr>(entry);
+            NodePtr updated = remove(child, shift + BITS, h, key, removed);
+            if (!removed) {
+                return node;
+            }
+            if (updated) {
+                // Pull a lone leaf up so lookups stay short after erases
+                if (updated->entries.size() == 1 &&
+                    std::holds_alternative<Leaf>(updated->entries[0])) {
+                    replacement = updated->entries[0];
+                } else {
+                    replacement = std::move(updated);
+                }
+            }
+        }
+        auto copy = std::make_shared<Node>(*node);
+        if (replacement) {
+            copy->entries[slot] = std::move(*replacement);
+            return copy;
+        }
+        copy->bitmap &= ~bit;
+        copy->entries.erase(copy->entries.begin() + slot);
+        if (copy->entries.empty()) {
+            return nullptr;
+        }
+        return copy;
+    }
+
+    template <typename Fn> static void visit(const Node &node, Fn &fn) {
+        for (const auto &entry : node.entries) {
+            if (const Leaf *leaf = std::get_if<Leaf>(&entry)) {
+                fn(leaf->first, leaf->second);
+            } else {
+                visit(*std::get<NodePtr>(entry), fn);
+            }
+        }
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_PERSISTENT_MAP_H
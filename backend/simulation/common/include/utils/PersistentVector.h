@@ -0,0 +1,332 @@
+#ifndef SIMULATION_COMMON_UTILS_PERSISTENT_VECTOR_H
+#define SIMULATION_COMMON_UTILS_PERSISTENT_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Immutable vector with structural sharing
+ *
+ * A 32-way trie of shared, never-mutated full leaves, plus a tail buffer
+ * holding the last 1-32 elements. Every update returns a new vector that
+ * copies only the root-to-leaf path it touches (at most log32(n) nodes);
+ * the rest is shared with the original. Copying a vector is a refcount
+ * bump, so keeping old versions around for undo costs nothing until they
+ * diverge.
+ *
+ * Appends construct into the shared tail in place when no other version
+ * has appended past this one (claimed with a CAS, so versions on different
+ * threads may append concurrently). Otherwise, and when the tail is full,
+ * the tail is copied, so push_back is amortized O(1) element copies.
+ */
+template <typename T> class PersistentVector {
+  public:
+    PersistentVector() = default;
+
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    const T &operator[](std::size_t index) const {
+        const std::size_t offset = tailOffset();
+        if (index >= offset) {
+            return tail_->data[index - offset];
+        }
+        return leafFor(index)->values[index & MASK];
+    }
+
+    const T &at(std::size_t index) const {
+        if (index >= size_) {
+            throw std::out_of_range("PersistentVector index out of range");
+        }
+        return (*this)[index];
+    }
+
+    const T &back() const { return (*this)[size_ - 1]; }
+
+    PersistentVector set(std::size_t index, T value) const {
+        if (index >= size_) {
+            throw std::out_of_range("PersistentVector index out of range");
+        }
+        PersistentVector result = *this;
+        const std::size_t offset = tailOffset();
+        if (index >= offset) {
+            const std::size_t count = size_ - offset;
+            result.tail_ = copyTail(*tail_, count, tail_->capacity);
+            result.tail_->data[index - offset] = std::move(value);
+        } else {
+            result.root_ = assign(root_, shift_, index, std::move(value));
+        }
+        return result;
+    }
+
+    PersistentVector push_back(T value) const {
+        PersistentVector result = *this;
+        const std::size_t count = size_ - tailOffset();
+        if (count == WIDTH) {
+            // Tail is full; it becomes the trie's next leaf
+            result.pushLeaf(toLeaf(*tail_));
+            result.tail_ = std::make_shared<Tail>(MIN_TAIL_CAPACITY);
+            result.tail_->emplace(std::move(value));
+        } else if (!tail_ || !tail_->tryAppend(count, value)) {
+            const std::size_t capacity =
+                std::min(WIDTH, std::max(MIN_TAIL_CAPACITY, count * 2));
+            result.tail_ = tail_ ? copyTail(*tail_, count, capacity)
+                                 : std::make_shared<Tail>(capacity);
+            result.tail_->emplace(std::move(value));
+        }
+        ++result.size_;
+        return result;
+    }
+
+    PersistentVector pop_back() const {
+        if (size_ == 0) {
+            throw std::out_of_range("pop_back on empty PersistentVector");
+        }
+        PersistentVector result;
+        if (size_ == 1) {
+            return result;
+        }
+        result.size_ = size_ - 1;
+        if (size_ - tailOffset() > 1) {
+            // Share the tail; its extra element is invisible to the result
+            result.root_ = root_;
+            result.shift_ = shift_;
+            result.tail_ = tail_;
+            return result;
+        }
+        // The trie's last leaf becomes the tail
+        const Node &leaf = *leafFor(size_ - 2);
+        result.tail_ = std::make_shared<Tail>(WIDTH);
+        for (const T &value : leaf.values) {
+            result.tail_->emplace(value);
+        }
+        if (shift_ == 0) {
+            return result; // The trie was a single leaf
+        }
+        result.root_ = removeLastLeaf(root_, shift_, size_ - 2);
+        result.shift_ = shift_;
+        // Collapse a root left with a single child
+        while (result.shift_ > 0 && result.root_->children.size() == 1) {
+            result.root_ = result.root_->children[0];
+            result.shift_ -= BITS;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Keeps only the last count elements
+     *
+     * Rebuilds the retained suffix; O(count), not O(1). Used for bounded
+     * histories, where it runs once per batch of pushes.
+     */
+    PersistentVector keepLast(std::size_t count) const {
+        if (count >= size_) {
+            return *this;
+        }
+        PersistentVector result;
+        for (std::size_t i = size_ - count; i < size_; ++i) {
+            result = result.push_back((*this)[i]);
+        }
+        return result;
+    }
+
+    template <typename Fn> void forEach(Fn &&fn) const {
+        for (std::size_t i = 0; i < size_; ++i) {
+            fn((*this)[i]);
+        }
+    }
+
+    std::vector<T> toVector() const {
+        std::vector<T> out;
+        out.reserve(size_);
+        forEach([&](const T &value) { out.push_back(value); });
+        return out;
+    }
+
+    /**
+     * @brief True if both share the same trie and tail (same version)
+     */
+    bool sharesRootWith(const PersistentVector &other) const {
+        return root_ == other.root_ && tail_ == other.tail_ &&
+               size_ == other.size_;
+    }
+
+  private:
+    static constexpr unsigned BITS = 5;
+    static constexpr std::size_t WIDTH = std::size_t{1} << BITS;
+    static constexpr std::size_t MASK = WIDTH - 1;
+    static constexpr std::size_t MIN_TAIL_CAPACITY = 4;
+
+    struct Node {
+        std::vector<std::shared_ptr<const Node>> children; // Branches
+        std::vector<T> values;                             // Full leaves
+    };
+    using NodePtr = std::shared_ptr<const Node>;
+
+    /**
+     * @brief Append-only buffer shared by every version that ends in it
+     *
+     * Slots below claimed are constructed and never change afterwards
+     * (except through a version that copied the tail first), so a version
+     * reading its first n elements never races with another appending.
+     */
+    struct Tail {
+        explicit Tail(std::size_t slots)
+            : capacity(slots), data(std::allocator<T>().allocate(slots)) {}
+        ~Tail() {
+            std::destroy_n(data, claimed.load(std::memory_order_relaxed));
+            std::allocator<T>().deallocate(data, capacity);
+        }
+
+        Tail(const Tail &) = delete;
+        Tail &operator=(const Tail &) = delete;
+
+        // Appends to a tail no other thread can see yet
+        template <typename U> void emplace(U &&value) {
+            const std::size_t count = claimed.load(std::memory_order_relaxed);
+            ::new (static_cast<void *>(data + count))
+                T(std::forward<U>(value));
+            claimed.store(count + 1, std::memory_order_relaxed);
+        }
+
+        // Appends after the first count slots if no version has yet
+        bool tryAppend(std::size_t count, T &value) {
+            std::size_t expected = count;
+            if (count == capacity ||
+                !claimed.compare_exchange_strong(expected, count + 1,
+                                                 std::memory_order_acq_rel)) {
+                return false;
+            }
+            try {
+                ::new (static_cast<void *>(data + count)) T(std::move(value));
+            } catch (...) {
+                // No version can see slot count yet, so it is still ours
+                claimed.store(count, std::memory_order_release);
+                throw;
+            }
+            return true;
+        }
+
+        const std::size_t capacity;
+        T *const data;
+        std::atomic<std::size_t> claimed{0};
+    };
+
+    NodePtr root_; // Full leaves only; null while everything fits the tail
+    unsigned shift_{0}; // 0 when the root is a leaf
+    std::shared_ptr<Tail> tail_;
+    std::size_t size_{0};
+
+    // Elements stored in the trie; the tail holds the rest
+    std::size_t tailOffset() const {
+        return size_ == 0 ? 0 : ((size_ - 1) >> BITS) << BITS;
+    }
+
+    const Node *leafFor(std::size_t index) const {
+        const Node *node = root_.get();
+        for (unsigned shift = shift_; shift > 0; shift -= BITS) {
+            node = node->children[(index >> shift) & MASK].get();
+        }
+        return node;
+    }
+
+    static std::shared_ptr<Tail> copyTail(const Tail &from, std::size_t count,
+                                          std::size_t capacity) {
+        auto tail = std::make_shared<Tail>(capacity);
+        for (std::size_t i = 0; i < count; ++i) {
+            tail->emplace(from.data[i]);
+        }
+        return tail;
+    }
+
+    static NodePtr toLeaf(const Tail &tail) {
+        auto leaf = std::make_shared<Node>();
+        leaf->values.assign(tail.data, tail.data + WIDTH);
+        return leaf;
+    }
+
+    void pushLeaf(NodePtr leaf) {
+        const std::size_t index = tailOffset();
+        if (!root_) {
+            root_ = std::move(leaf);
+        } else if ((index >> BITS) >= (std::size_t{1} << shift_)) {
+            // Root is full; grow a level
+            auto root = std::make_shared<Node>();
+            root->children.push_back(root_);
+            root->children.push_back(pathTo(shift_, std::move(leaf)));
+            root_ = std::move(root);
+            shift_ += BITS;
+        } else {
+            root_ = appendLeaf(root_, shift_, index, std::move(leaf));
+        }
+    }
+
+    static NodePtr assign(const NodePtr &node, unsigned shift,
+                          std::size_t index, T value) {
+        auto copy = std::make_shared<Node>(*node);
+        if (shift == 0) {
+            copy->values[index & MASK] = std::move(value);
+        } else {
+            std::size_t slot = (index >> shift) & MASK;
+            copy->children[slot] = assign(node->children[slot],
+                                          shift - BITS, index,
+                                          std::move(value));
+        }
+        return copy;
+    }
+
+    static NodePtr pathTo(unsigned shift, NodePtr leaf) {
+        if (shift == 0) {
+            return leaf;
+        }
+        auto node = std::make_shared<Node>();
+        node->children.push_back(pathTo(shift - BITS, std::move(leaf)));
+        return node;
+    }
+
+    // Index is the first element of the new leaf; shift is above leaf level
+    static NodePtr appendLeaf(const NodePtr &node, unsigned shift,
+                              std::size_t index, NodePtr leaf) {
+        auto copy = std::make_shared<Node>(*node);
+        std::size_t slot = (index >> shift) & MASK;
+        if (slot < copy->children.size()) {
+            copy->children[slot] = appendLeaf(node->children[slot],
+                                              shift - BITS, index,
+                                              std::move(leaf));
+        } else {
+            copy->children.push_back(pathTo(shift - BITS, std::move(leaf)));
+        }
+        return copy;
+    }
+
+    // Index is any element of the last leaf; shift is above leaf level
+    static NodePtr removeLastLeaf(const NodePtr &node, unsigned shift,
+                                  std::size_t index) {
+        auto copy = std::make_shared<Node>(*node);
+        if (shift == BITS) {
+            copy->children.pop_back();
+            return copy;
+        }
+        std::size_t slot = (index >> shift) & MASK;
+        NodePtr child =
+            removeLastLeaf(node->children[slot], shift - BITS, index);
+        if (child->children.empty()) {
+            copy->children.pop_back();
+        } else {
+            copy->children[slot] = std::move(child);
+        }
+        return copy;
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_PERSISTENT_VECTOR_H
@@ -0,0 +1,116 @@
+#ifndef SIMULATION_COMMON_UTILS_PROCESS_BARRIER_H
+#define SIMULATION_COMMON_UTILS_PROCESS_BARRIER_H
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace crescent::common {
+
+/**
+ * @brief Reusable barrier that works across processes
+ *
+ * Construct it in shared memory before forking; every party then calls
+ * arriveAndWait() once per phase. Like std::barrier, the last party to
+ * arrive runs a completion function before anyone is released, which is
+ * the place to latch decisions every party must agree on (whether to stop,
+ * the next tick). Waiters spin briefly, then sleep on a futex keyed by the
+ * shared generation word, so a blocked process costs no CPU.
+ *
+ * abort() releases every current and future waiter with false; use it
+ * when a party has died and the phase can never complete.
+ */
+class ProcessBarrier {
+  public:
+    explicit ProcessBarrier(std::uint32_t parties) : parties_(parties) {}
+
+    // Prevent copying and moving; the object's address is shared
+    ProcessBarrier(const ProcessBarrier &) = delete;
+    ProcessBarrier &operator=(const ProcessBarrier &) = delete;
+    ProcessBarrier(ProcessBarrier &&) = delete;
+    ProcessBarrier &operator=(ProcessBarrier &&) = delete;
+
+    /**
+     * @return False if the barrier was aborted
+     */
+    bool arriveAndWait() {
+        return arriveAndWait([] {});
+    }
+
+    template <typename Completion> bool arriveAndWait(Completion &&complete) {
+        const std::uint32_t generation =
+            generation_.load(std::memory_order_acquire);
+        if (aborted()) {
+            return false;
+        }
+        if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+            parties_) {
+            complete();
+            arrived_.store(0, std::memory_order_relaxed);
+            generation_.store(generation + 1, std::memory_order_release);
+            wakeAll();
+            return !aborted();
+        }
+        for (int spin = 0; spin < SPIN_LIMIT; ++spin) {
+            if (generation_.load(std::memory_order_acquire) != generation) {
+                return !aborted();
+            }
+        }
+        while (generation_.load(std::memory_order_acquire) == generation) {
+            wait(generation);
+        }
+        return !aborted();
+    }
+
+    void abort() {
+        aborted_.store(1, std::memory_order_release);
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        wakeAll();
+    }
+
+    bool aborted() const {
+        return aborted_.load(std::memory_order_acquire) != 0;
+    }
+
+    std::uint32_t parties() const { return parties_; }
+
+  private:
+    static constexpr int SPIN_LIMIT = 1024;
+    static_assert(std::atomic<std::uint32_t>::is_always_lock_free &&
+                      sizeof(std::atomic<std::uint32_t>) == sizeof(int),
+                  "Futex words must be plain 32-bit integers");
+
+    alignas(64) std::atomic<std::uint32_t> arrived_{0};
+    alignas(64) std::atomic<std::uint32_t> generation_{0};
+    std::atomic<std::uint32_t> aborted_{0};
+    const std::uint32_t parties_;
+
+    // Not FUTEX_PRIVATE: waiters live in different processes
+    void wait(std::uint32_t generation) {
+#ifdef __linux__
+        ::syscall(SYS_futex, reinterpret_cast<int *>(&generation_),
+                  FUTEX_WAIT, static_cast<int>(generation), nullptr,
+                  nullptr, 0);
+#else
+        (void)generation;
+        std::this_thread::yield();
+#endif
+    }
+    void wakeAll() {
+#ifdef __linux__
+        ::syscall(SYS_futex, reinterpret_cast<int *>(&generation_),
+                  FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_PROCESS_BARRIER_H
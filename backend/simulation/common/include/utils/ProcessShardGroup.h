@@ -0,0 +1,467 @@
+#ifndef SIMULATION_COMMON_UTILS_PROCESS_SHARD_GROUP_H
+#define SIMULATION_COMMON_UTILS_PROCESS_SHARD_GROUP_H
+
+#include "common/utils/ProcessBarrier.h"
+#include "common/utils/SharedMemory.h"
+#include "common/utils/SimulationClock.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace crescent::common {
+
+/**
+ * @brief Messages a shard sends to other shards during one tick
+ */
+class ShardOutbox {
+  public:
+    explicit ShardOutbox(std::uint32_t shardCount) : pending_(shardCount) {}
+
+    /**
+     * @brief Queues payload for shard; empty payloads are not allowed
+     */
+    void send(std::uint32_t shard, std::string payload) {
+        if (payload.empty()) {
+            throw std::invalid_argument("Shard messages must not be empty");
+        }
+        pending_.at(shard).push_back(std::move(payload));
+    }
+
+    std::uint32_t shardCount() const {
+        return static_cast<std::uint32_t>(pending_.size());
+    }
+
+  private:
+    friend class ProcessShardGroup;
+    std::vector<std::vector<std::string>> pending_;
+};
+
+/**
+ * @brief Simulation work owned by one shard process
+ *
+ * Created in the child after fork, so it builds (or loads) only its own
+ * partition. Each tick the group calls step(), delivers the messages every
+ * shard sent to this one through admit() in source-shard order, then
+ * waits for all shards at the tick barrier.
+ */
+class ShardWorker {
+  public:
+    virtual ~ShardWorker() = default;
+
+    virtual void step(SimTick tick, ShardOutbox &outbox) = 0;
+    virtual void admit(std::uint32_t fromShard, std::string_view payload) = 0;
+
+    /**
+     * @brief Called once after the last tick, before the process exits
+     */
+    virtual void finish() {}
+};
+
+/**
+ * @brief Runs N shard workers as forked processes in lock step
+ *
+ * One anonymous shared region holds the tick barrier, per-shard counters
+ * and an SpscByteRing for every ordered pair of shards. A tick is:
+ *
+ *   1. step(): the worker simulates its partition and queues migrants.
+ *   2. Exchange: each shard pushes its messages into its outbound rings,
+ *      ends each with an empty frame, and meanwhile drains its inbound
+ *      rings until it has seen every peer's end frame. Pushing and
+ *      draining interleave, so a full ring never deadlocks.
+ *   3. admit(): messages are delivered grouped by source shard, in send
+ *      order, so the result does not depend on process scheduling.
+ *   4. The tick barrier. Its completion latches the stop decision, so
+ *      every shard leaves after the same tick.
+ *
+ * The parent process only supervises: it reaps the children and aborts
+ * the barrier if one exits early, which makes the others fail fast instead
+ * of hanging. Everything runs on one machine, so the same binary can test
+ * a multi-shard run end to end.
+ */
+class ProcessShardGroup {
+  public:
+    using WorkerFactory =
+        std::function<std::unique_ptr<ShardWorker>(std::uint32_t shard)>;
+
+    struct Config {
+        std::uint32_t shardCount{2};
+        std::size_t ringCapacity{1 << 20}; // Per ordered pair; power of two
+        SimTick startTick{};
+        std::uint32_t tickCount{0}; // 0 = until requestStop()
+    };
+
+    struct ShardReport {
+        std::uint32_t shard{0};
+        bool succeeded{false};
+        int exitStatus{0}; // As returned by waitpid
+        std::uint64_t ticksCompleted{0};
+        std::uint64_t messagesSent{0};     // To other shards
+        std::uint64_t messagesReceived{0}; // From other shards
+        std::uint64_t bytesSent{0};
+        double exchangeSeconds{0.0}; // Pushing and draining rings
+        double barrierSeconds{0.0};  // Waiting for slower shards
+        std::string error;
+    };
+
+    struct Report {
+        bool succeeded{false};
+        std::vector<ShardReport> shards;
+    };
+
+    explicit ProcessShardGroup(Config config) : config_(config) {
+        if (config_.shardCount == 0) {
+            throw std::invalid_argument("ProcessShardGroup needs a shard");
+        }
+        const std::size_t ringBytes =
+            roundUp(SpscByteRing::bytesFor(config_.ringCapacity));
+        const std::size_t rings =
+            std::size_t{config_.shardCount} * config_.shardCount;
+        region_ = SharedMemoryRegion(sizeof(Control) +
+                                     sizeof(ShardSlot) * config_.shardCount +
+                                     ringBytes * rings);
+        control_ = new (region_.data()) Control(config_.shardCount);
+        slots_ = reinterpret_cast<ShardSlot *>(region_.data() +
+                                               sizeof(Control));
+        for (std::uint32_t i = 0; i < config_.shardCount; ++i) {
+            new (slots_ + i) ShardSlot();
+        }
+        ringBase_ = region_.data() + sizeof(Control) +
+                    sizeof(ShardSlot) * config_.shardCount;
+        ringStride_ = ringBytes;
+        for (std::size_t i = 0; i < rings; ++i) {
+            SpscByteRing(ringBase_ + i * ringStride_, config_.ringCapacity,
+                         true);
+        }
+    }
+
+    // Prevent copying and moving; children hold addresses in the region
+    ProcessShardGroup(const ProcessShardGroup &) = delete;
+    ProcessShardGroup &operator=(const ProcessShardGroup &) = delete;
+    ProcessShardGroup(ProcessShardGroup &&) = delete;
+    ProcessShardGroup &operator=(ProcessShardGroup &&) = delete;
+
+    /**
+     * @brief Forks the shards and blocks until they have all exited
+     *
+     * A group runs once. The calling process must be single-threaded:
+     * fork copies only the calling thread, so a lock another thread held
+     * (in malloc, stdio or a WorkerPool) would stay locked in every shard.
+     * Start shards before any pool or logging thread. Flush stdio before
+     * calling: children inherit unflushed buffers (they exit without
+     * flushing them).
+     * @throws std::logic_error if the process has other threads
+     */
+    Report run(const WorkerFactory &factory) {
+        if (threadCount() > 1) {
+            throw std::logic_error(
+                "ProcessShardGroup::run needs a single-threaded process");
+        }
+        std::vector<pid_t> children(config_.shardCount, -1);
+        for (std::uint32_t shard = 0; shard < config_.shardCount; ++shard) {
+            const pid_t pid = ::fork();
+            if (pid == 0) {
+                ::_exit(runShard(shard, factory));
+            }
+            if (pid < 0) {
+                const int error = errno;
+                control_->barrier.abort();
+                reap(children);
+                throw std::system_error(error, std::generic_category(),
+                                        "fork shard");
+            }
+            children[shard] = pid;
+        }
+        std::vector<int> statuses = reap(children);
+
+        Report report;
+        report.succeeded = true;
+        for (std::uint32_t shard = 0; shard < config_.shardCount; ++shard) {
+            const ShardSlot &slot = slots_[shard];
+            ShardReport &entry = report.shards.emplace_back();
+            entry.shard = shard;
+            entry.exitStatus = statuses[shard];
+            entry.succeeded = WIFEXITED(statuses[shard]) &&
+                              WEXITSTATUS(statuses[shard]) == 0;
+            entry.ticksCompleted = slot.ticks.load();
+            entry.messagesSent = slot.sent.load();
+            entry.messagesReceived = slot.received.load();
+            entry.bytesSent = slot.bytesSent.load();
+            entry.exchangeSeconds =
+                static_cast<double>(slot.exchangeNanos.load()) * 1e-9;
+            entry.barrierSeconds =
+                static_cast<double>(slot.barrierNanos.load()) * 1e-9;
+            entry.error.assign(slot.error,
+                               ::strnlen(slot.error, sizeof(slot.error)));
+            if (!entry.succeeded && entry.error.empty()) {
+                entry.error = WIFSIGNALED(statuses[shard])
+                                  ? "killed by signal " +
+                                        std::to_string(
+                                            WTERMSIG(statuses[shard]))
+                                  : "aborted after a peer failed";
+            }
+            report.succeeded = report.succeeded && entry.succeeded;
+        }
+        return report;
+    }
+
+    /**
+     * @brief Asks every shard to stop after the tick in progress
+     *
+     * Async-signal-safe; call it from the parent (a signal handler or
+     * another thread) or from inside a worker.
+     */
+    void requestStop() {
+        control_->stopRequested.store(1, std::memory_order_release);
+    }
+
+  private:
+    struct Control {
+        explicit Control(std::uint32_t parties) : barrier(parties) {}
+        ProcessBarrier barrier;
+        std::atomic<std::uint32_t> stopRequested{0};
+        std::atomic<std::uint32_t> stopLatched{0}; // Set by the completion
+    };
+
+    struct alignas(64) ShardSlot {
+        std::atomic<std::uint64_t> ticks{0};
+        std::atomic<std::uint64_t> sent{0};
+        std::atomic<std::uint64_t> received{0};
+        std::atomic<std::uint64_t> bytesSent{0};
+        std::atomic<std::uint64_t> exchangeNanos{0};
+        std::atomic<std::uint64_t> barrierNanos{0};
+        char error[256]{};
+    };
+
+    Config config_;
+    SharedMemoryRegion region_;
+    Control *control_{nullptr};
+    ShardSlot *slots_{nullptr};
+    std::byte *ringBase_{nullptr};
+    std::size_t ringStride_{0};
+
+    static std::size_t roundUp(std::size_t bytes) {
+        return (bytes + 63) & ~std::size_t{63};
+    }
+
+    SpscByteRing ring(std::uint32_t from, std::uint32_t to) const {
+        return SpscByteRing(
+            ringBase_ + (std::size_t{from} * config_.shardCount + to) *
+                            ringStride_,
+            config_.ringCapacity, false);
+    }
+
+    // Threads in this process; 0 where /proc/self/task cannot be read
+    static std::size_t threadCount() {
+        std::size_t count = 0;
+        if (DIR *tasks = ::opendir("/proc/self/task")) {
+            while (const dirent *entry = ::readdir(tasks)) {
+                if (entry->d_name[0] != '.') {
+                    ++count;
+                }
+            }
+            ::closedir(tasks);
+        }
+        return count;
+    }
+
+    // Waits for every child; aborts the barrier once any of them fails
+    std::vector<int> reap(const std::vector<pid_t> &children) {
+        std::vector<int> statuses(children.size(), 0);
+        std::size_t running = static_cast<std::size_t>(
+            std::count_if(children.begin(), children.end(),
+                          [](pid_t pid) { return pid > 0; }));
+        while (running > 0) {
+            int status = 0;
+            const pid_t pid = ::waitpid(-1, &status, 0);
+            if (pid < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            auto it = std::find(children.begin(), children.end(), pid);
+            if (it == children.end()) {
+                continue;
+            }
+            statuses[static_cast<std::size_t>(it - children.begin())] =
+                status;
+            --running;
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                control_->barrier.abort();
+            }
+        }
+        return statuses;
+    }
+
+    // Child body; returns the exit code
+    int runShard(std::uint32_t shard, const WorkerFactory &factory) {
+        ShardSlot &slot = slots_[shard];
+        try {
+            std::unique_ptr<ShardWorker> worker = factory(shard);
+            ShardOutbox outbox(config_.shardCount);
+            std::vector<SpscByteRing> outbound;
+            std::vector<SpscByteRing> inbound;
+            for (std::uint32_t peer = 0; peer < config_.shardCount; ++peer) {
+                outbound.push_back(ring(shard, peer));
+                inbound.push_back(ring(peer, shard));
+            }
+            SimTick tick = config_.startTick;
+            for (std::uint32_t done = 0;; ++done) {
+                if (config_.tickCount != 0 && done == config_.tickCount) {
+                    break;
+                }
+                worker->step(tick, outbox);
+                if (!exchange(shard, outbox, *worker, slot, outbound,
+                              inbound)) {
+                    return 1;
+                }
+                const auto waitStart = std::chrono::steady_clock::now();
+                const bool released = control_->barrier.arriveAndWait([&] {
+                    control_->stopLatched.store(
+                        control_->stopRequested.load(
+                            std::memory_order_acquire),
+                        std::memory_order_relaxed);
+                });
+                slot.barrierNanos.fetch_add(nanosSince(waitStart),
+                                            std::memory_order_relaxed);
+                if (!released) {
+                    return 1;
+                }
+                slot.ticks.fetch_add(1, std::memory_order_relaxed);
+                tick = SimTick{tick.value + 1};
+                if (control_->stopLatched.load(std::memory_order_acquire)) {
+                    break;
+                }
+            }
+            worker->finish();
+            return 0;
+        } catch (const std::exception &e) {
+            std::snprintf(slot.error, sizeof(slot.error), "%s", e.what());
+        } catch (...) {
+            std::snprintf(slot.error, sizeof(slot.error), "unknown error");
+        }
+        control_->barrier.abort();
+        return 1;
+    }
+
+    /**
+     * @return False if a peer failed while this shard waited on it
+     */
+    bool exchange(std::uint32_t self, ShardOutbox &outbox,
+                  ShardWorker &worker, ShardSlot &slot,
+                  std::vector<SpscByteRing> &outbound,
+                  std::vector<SpscByteRing> &inbound) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::uint32_t count = config_.shardCount;
+        std::vector<std::vector<std::string>> received(count);
+        received[self] = std::move(outbox.pending_[self]);
+        outbox.pending_[self].clear();
+
+        std::vector<std::size_t> nextToSend(count, 0);
+        std::vector<bool> sendDone(count, false);
+        std::vector<bool> ended(count, false);
+        std::uint32_t sendsOpen = count - 1;
+        std::uint32_t peersOpen = count - 1;
+
+        std::string frame;
+        int idleRounds = 0;
+        while (sendsOpen > 0 || peersOpen > 0) {
+            bool progressed = false;
+            for (std::uint32_t peer = 0; peer < count; ++peer) {
+                if (peer == self) {
+                    continue;
+                }
+                if (sendDone[peer]) {
+                    continue;
+                }
+                std::vector<std::string> &queue = outbox.pending_[peer];
+                std::size_t &next = nextToSend[peer];
+                while (next < queue.size() &&
+                       outbound[peer].tryPush(queue[next])) {
+                    slot.bytesSent.fetch_add(queue[next].size(),
+                                             std::memory_order_relaxed);
+                    ++next;
+                    progressed = true;
+                }
+                if (next == queue.size() && outbound[peer].tryPush({})) {
+                    slot.sent.fetch_add(queue.size(),
+                                        std::memory_order_relaxed);
+                    queue.clear();
+                    next = 0;
+                    sendDone[peer] = true;
+                    --sendsOpen;
+                    progressed = true;
+                }
+            }
+            for (std::uint32_t peer = 0; peer < count; ++peer) {
+                if (peer == self || ended[peer]) {
+                    continue;
+                }
+                while (inbound[peer].tryPop(frame)) {
+                    progressed = true;
+                    if (frame.empty()) {
+                        ended[peer] = true;
+                        --peersOpen;
+                        break;
+                    }
+                    received[peer].push_back(std::move(frame));
+                    frame.clear();
+                }
+            }
+            if (progressed) {
+                idleRounds = 0;
+            } else if (control_->barrier.aborted()) {
+                return false;
+            } else if (++idleRounds > 64) {
+                std::this_thread::yield();
+            }
+        }
+        slot.exchangeNanos.fetch_add(nanosSince(start),
+                                     std::memory_order_relaxed);
+
+        for (std::uint32_t peer = 0; peer < count; ++peer) {
+            for (const std::string &payload : received[peer]) {
+                worker.admit(peer, payload);
+            }
+            if (peer != self) {
+                slot.received.fetch_add(received[peer].size(),
+                                        std::memory_order_relaxed);
+            }
+        }
+        return true;
+    }
+
+    static std::uint64_t
+    nanosSince(std::chrono::steady_clock::time_point start) {
+        return static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_PROCESS_SHARD_GROUP_H
@@ -0,0 +1,74 @@
+#ifndef SIMULATION_COMMON_UTILS_SCHEDULED_QUEUE_H
+#define SIMULATION_COMMON_UTILS_SCHEDULED_QUEUE_H
+
+#include "common/utils/MpscQueue.h"
+
+#include <atomic>
+#include <optional>
+#include <utility>
+
+namespace crescent::common {
+
+/**
+ * @brief MpscQueue with a flag that hands it to a single drainer at a time
+ *
+ * Producers push and then call trySchedule(); the one that wins must hand
+ * the queue to its consumer (typically by putting it on a worker's ready
+ * queue). The consumer drains with pop() and then calls releaseSchedule(),
+ * which reports whether items arrived during the drain and the consumer
+ * has to go round again. Without that re-check a producer that saw the flag
+ * still set would leave its item stranded.
+ *
+ * releaseSchedule() drops the flag with a sequentially consistent exchange
+ * rather than a release store. A plain store may be reordered after the
+ * emptiness check that follows it, so the consumer could see an empty queue
+ * while a producer still sees the flag set, and nobody reschedules. As a
+ * read-modify-write the exchange is ordered with every trySchedule(): either
+ * the producer's trySchedule() sees the cleared flag and schedules, or the
+ * exchange reads the producer's flag write and with it the pushed item.
+ */
+template <typename T> class ScheduledQueue {
+  public:
+    ScheduledQueue() = default;
+
+    // Prevent copying and moving
+    ScheduledQueue(const ScheduledQueue &) = delete;
+    ScheduledQueue &operator=(const ScheduledQueue &) = delete;
+    ScheduledQueue(ScheduledQueue &&) = delete;
+    ScheduledQueue &operator=(ScheduledQueue &&) = delete;
+
+    /**
+     * @brief Enqueues a value; safe from any number of threads
+     */
+    void push(T value) { queue_.push(std::move(value)); }
+
+    /**
+     * @brief Claims the right to hand this queue to its consumer
+     * @return True if the caller must schedule it
+     */
+    bool trySchedule() {
+        return !scheduled_.exchange(true, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief Drops the scheduled flag after a drain; consumer only
+     * @return True if items arrived meanwhile and the caller must schedule
+     * the queue again
+     */
+    bool releaseSchedule() {
+        scheduled_.exchange(false, std::memory_order_seq_cst);
+        return !queue_.empty() && trySchedule();
+    }
+
+    // Consumer side
+    std::optional<T> pop() { return queue_.pop(); }
+    bool empty() const { return queue_.empty(); }
+
+  private:
+    MpscQueue<T> queue_;
+    std::atomic<bool> scheduled_{false};
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_SCHEDULED_QUEUE_H
@@ -0,0 +1,111 @@
+#ifndef SIMULATION_COMMON_UTILS_SEEDED_RANDOM_H
+#define SIMULATION_COMMON_UTILS_SEEDED_RANDOM_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace crescent::common {
+
+/**
+ * @brief Advances a SplitMix64 state and returns the next output
+ */
+inline std::uint64_t splitMix64(std::uint64_t &state) {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Derives an independent seed from a base seed and a coordinate
+ *
+ * Lets parallel workers seed each item from (run seed, stream, ordinal)
+ * without sharing a generator, so output is identical for any thread count
+ * or scheduling order.
+ */
+inline std::uint64_t deriveSeed(std::uint64_t base, std::uint64_t stream,
+                                std::uint64_t ordinal) {
+    std::uint64_t state = base;
+    std::uint64_t mixed = splitMix64(state) ^ stream;
+    mixed = splitMix64(mixed) ^ ordinal;
+    return splitMix64(mixed);
+}
+
+/**
+ * @brief Small, fast, reproducible generator (xoshiro256**)
+ *
+ * Cheap to construct per item and 32 bytes of state, unlike std::mt19937.
+ * Satisfies UniformRandomBitGenerator, but the helpers below are preferred
+ * because std distributions are not reproducible across standard libraries.
+ */
+class SeededRandom {
+  public:
+    using result_type = std::uint64_t;
+
+    explicit SeededRandom(std::uint64_t seed) {
+        for (std::uint64_t &word : state_) {
+            word = splitMix64(seed);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type{0}; }
+
+    result_type operator()() {
+        const std::uint64_t result = rotl(state_[1] * 5, 7) * 9;
+        const std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Uniform in [0, bound) without modulo bias
+     */
+    std::uint64_t below(std::uint64_t bound) {
+        if (bound == 0) {
+            return 0;
+        }
+        const std::uint64_t threshold = (0 - bound) % bound;
+        for (;;) {
+            const std::uint64_t value = (*this)();
+            if (value >= threshold) {
+                return value % bound;
+            }
+        }
+    }
+
+    int uniformInt(int min, int max) {
+        const auto span = static_cast<std::uint64_t>(
+            static_cast<std::int64_t>(max) - min + 1);
+        return static_cast<int>(min + static_cast<std::int64_t>(below(span)));
+    }
+
+    float uniformFloat(float min = 0.0f, float max = 1.0f) {
+        const float unit =
+            static_cast<float>((*this)() >> 40) * (1.0f / 16777216.0f);
+        const float value = min + unit * (max - min);
+        // Rounding can land on max for wide ranges; keep the range half-open
+        return value < max ? value : std::nextafter(max, min);
+    }
+
+    bool chance(float probability) { return uniformFloat() < probability; }
+
+    std::size_t pickIndex(std::size_t size) { return below(size); }
+
+  private:
+    std::uint64_t state_[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_SEEDED_RANDOM_H
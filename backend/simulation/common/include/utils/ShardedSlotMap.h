@@ -0,0 +1,395 @@
+#ifndef SIMULATION_COMMON_UTILS_SHARDED_SLOT_MAP_H
+#define SIMULATION_COMMON_UTILS_SHARDED_SLOT_MAP_H
+
+#include <array>
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Compact generational handle into a ShardedSlotMap
+ *
+ * The low ShardBits of index select the shard, the rest the slot within it.
+ * The generation changes whenever a slot is reused, so stale handles fail
+ * lookups instead of aliasing a newer entry. Slots never use generation 0,
+ * so a default handle never resolves and a packed value of 0 is free for
+ * use as a "no handle" sentinel.
+ */
+struct SlotHandle {
+    std::uint32_t index{0};
+    std::uint32_t generation{0};
+
+    /**
+     * @brief False for default handles; true does not mean the entry is live
+     */
+    bool isSet() const { return generation != 0; }
+
+    std::uint64_t pack() const {
+        return (static_cast<std::uint64_t>(generation) << 32) | index;
+    }
+    static SlotHandle unpack(std::uint64_t value) {
+        return {static_cast<std::uint32_t>(value),
+                static_cast<std::uint32_t>(value >> 32)};
+    }
+
+    bool operator==(const SlotHandle &other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const SlotHandle &other) const { return !(*this == other); }
+};
+
+/**
+ * @brief Concurrent slot map split into independently locked shards
+ *
+ * Handle resolution, version checks and shard iteration never take a shard
+ * lock: slot storage lives in fixed segments that are never moved once
+ * published. Only insert and erase serialize, and only within one shard.
+ *
+ * Each entry carries a small reader/writer spin lock and a version that is
+ * bumped after every write. read() callers share the entry; write() callers
+ * get it exclusively. Optimistic readers remember the version they derived
+ * data from and skip re-reading while version() still matches.
+ *
+ * Entry locks are not reentrant. A read() or forEachInShard() callback must
+ * not call read() or write() on the entry it was handed: the lock prefers
+ * writers, so a nested read waits behind any writer queued on the outer
+ * read, and that writer waits for the outer read to finish. Debug builds
+ * assert on such re-entry. Accessing other entries from a callback is
+ * allowed.
+ */
+template <typename T, unsigned ShardBits = 6> class ShardedSlotMap {
+  public:
+    static constexpr std::size_t SHARD_COUNT = std::size_t{1} << ShardBits;
+
+    ShardedSlotMap() = default;
+    ~ShardedSlotMap() {
+        for (Shard &shard : shards_) {
+            for (std::size_t s = 0; s < MAX_SEGMENTS; ++s) {
+                delete[] shard.segments[s].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Prevent copying and moving
+    ShardedSlotMap(const ShardedSlotMap &) = delete;
+    ShardedSlotMap &operator=(const ShardedSlotMap &) = delete;
+    ShardedSlotMap(ShardedSlotMap &&) = delete;
+    ShardedSlotMap &operator=(ShardedSlotMap &&) = delete;
+
+    /**
+     * @brief Stores a value in the given shard
+     * @param shardHint Any value; reduced modulo SHARD_COUNT
+     */
+    SlotHandle insert(std::unique_ptr<T> value, std::size_t shardHint) {
+        const std::size_t shardIndex = shardHint & (SHARD_COUNT - 1);
+        Shard &shard = shards_[shardIndex];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        std::uint32_t local;
+        if (!shard.freeList.empty()) {
+            local = shard.freeList.back();
+            shard.freeList.pop_back();
+        } else {
+            local = shard.highWater.load(std::memory_order_relaxed);
+            ensureSegment(shard, local);
+        }
+
+        Slot &slot = slotAt(shard, local);
+        slot.lock.lockExclusive();
+        slot.value = std::move(value);
+        slot.live.store(true, std::memory_order_relaxed);
+        slot.version.fetch_add(1, std::memory_order_relaxed);
+        const std::uint32_t generation =
+            slot.generation.load(std::memory_order_relaxed);
+        slot.lock.unlockExclusive();
+
+        if (local == shard.highWater.load(std::memory_order_relaxed)) {
+            shard.highWater.store(local + 1, std::memory_order_release);
+        }
+        size_.fetch_add(1, std::memory_order_relaxed);
+        return {static_cast<std::uint32_t>((local << ShardBits) | shardIndex),
+                generation};
+    }
+
+    /**
+     * @brief Removes an entry, waiting for in-flight readers to finish
+     * @return The stored value, or nullptr if the handle is stale
+     */
+    std::unique_ptr<T> erase(SlotHandle handle) {
+        Shard &shard = shards_[handle.index & (SHARD_COUNT - 1)];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        Slot *slot = resolve(handle);
+        if (!slot) {
+            return nullptr;
+        }
+        slot->lock.lockExclusive();
+        if (!matches(*slot, handle)) {
+            slot->lock.unlockExclusive();
+            return nullptr;
+        }
+        std::unique_ptr<T> value = std::move(slot->value);
+        slot->live.store(false, std::memory_order_relaxed);
+        retireGeneration(*slot);
+        slot->version.fetch_add(1, std::memory_order_relaxed);
+        slot->lock.unlockExclusive();
+
+        shard.freeList.push_back(handle.index >> ShardBits);
+        size_.fetch_sub(1, std::memory_order_relaxed);
+        return value;
+    }
+
+    /**
+     * @brief Runs fn(const T &, version) with the entry shared-locked
+     * @return False if the handle is stale
+     */
+    template <typename Fn> bool read(SlotHandle handle, Fn &&fn) const {
+        Slot *slot = resolve(handle);
+        if (!slot) {
+            return false;
+        }
+        const SharedGuard guard(*slot);
+        const bool valid = matches(*slot, handle);
+        if (valid) {
+            fn(static_cast<const T &>(*slot->value),
+               slot->version.load(std::memory_order_relaxed));
+        }
+        return valid;
+    }
+
+    /**
+     * @brief Runs fn(T &) with the entry exclusively locked, then bumps its
+     * version
+     * @return False if the handle is stale
+     */
+    template <typename Fn> bool write(SlotHandle handle, Fn &&fn) {
+        Slot *slot = resolve(handle);
+        if (!slot) {
+            return false;
+        }
+        assertNotHeld(*slot);
+        slot->lock.lockExclusive();
+        const bool valid = matches(*slot, handle);
+        if (valid) {
+            try {
+                fn(*slot->value);
+            } catch (...) {
+                slot->version.fetch_add(1, std::memory_order_release);
+                slot->lock.unlockExclusive();
+                throw;
+            }
+            slot->version.fetch_add(1, std::memory_order_release);
+        }
+        slot->lock.unlockExclusive();
+        return valid;
+    }
+
+    /**
+     * @brief Current version of an entry, without locking
+     */
+    std::optional<std::uint64_t> version(SlotHandle handle) const {
+        const Slot *slot = resolve(handle);
+        if (!slot || !matches(*slot, handle)) {
+            return std::nullopt;
+        }
+        return slot->version.load(std::memory_order_acquire);
+    }
+
+    bool contains(SlotHandle handle) const {
+        const Slot *slot = resolve(handle);
+        return slot && matches(*slot, handle);
+    }
+
+    /**
+     * @brief Visits every live entry in one shard as fn(handle, const T &)
+     *
+     * Shards are independent, so a scheduler can hand one shard to each
+     * worker. Entries inserted during the walk may or may not be visited.
+     */
+    template <typename Fn> void forEachInShard(std::size_t shardIndex,
+                                               Fn &&fn) const {
+        const Shard &shard = shards_[shardIndex];
+        const std::uint32_t limit =
+            shard.highWater.load(std::memory_order_acquire);
+        for (std::uint32_t local = 0; local < limit; ++local) {
+            Slot &slot = slotAt(shard, local);
+            if (!slot.live.load(std::memory_order_relaxed)) {
+                continue;
+            }
+            const SharedGuard guard(slot);
+            if (slot.live.load(std::memory_order_relaxed)) {
+                const SlotHandle handle{
+                    static_cast<std::uint32_t>(
+                        (local << ShardBits) | shardIndex),
+                    slot.generation.load(std::memory_order_relaxed)};
+                fn(handle, static_cast<const T &>(*slot.value));
+            }
+        }
+    }
+
+    std::size_t size() const { return size_.load(std::memory_order_relaxed); }
+    static constexpr std::size_t shardCount() { return SHARD_COUNT; }
+
+  private:
+    // Segment k holds BASE_SEGMENT_SIZE << k slots and is never reallocated
+    static constexpr std::size_t BASE_SEGMENT_SIZE = 64;
+    static constexpr std::size_t MAX_SEGMENTS = 26;
+
+    /**
+     * @brief Writer-preferring reader/writer spin lock, one word per entry
+     */
+    class SpinRwLock {
+      public:
+        void lockShared() {
+            for (;;) {
+                std::uint32_t state = state_.load(std::memory_order_relaxed);
+                if ((state & WRITER) == 0 &&
+                    state_.compare_exchange_weak(state, state + 1,
+                                                 std::memory_order_acquire)) {
+                    return;
+                }
+                std::this_thread::yield();
+            }
+        }
+        void unlockShared() { state_.fetch_sub(1, std::memory_order_release); }
+
+        void lockExclusive() {
+            while (state_.fetch_or(WRITER, std::memory_order_acquire) &
+                   WRITER) {
+                std::this_thread::yield();
+            }
+            while ((state_.load(std::memory_order_acquire) & ~WRITER) != 0) {
+                std::this_thread::yield();
+            }
+        }
+        void unlockExclusive() {
+            state_.fetch_and(~WRITER, std::memory_order_release);
+        }
+
+      private:
+        static constexpr std::uint32_t WRITER = 1u << 31;
+        std::atomic<std::uint32_t> state_{0};
+    };
+
+    struct Slot {
+        mutable SpinRwLock lock;
+        std::atomic<std::uint64_t> version{0};
+        std::atomic<std::uint32_t> generation{1}; // 0 is never used
+        std::atomic<bool> live{false};
+        std::unique_ptr<T> value;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex; // Insert/erase only
+        std::array<std::atomic<Slot *>, MAX_SEGMENTS> segments{};
+        std::atomic<std::uint32_t> highWater{0};
+        std::vector<std::uint32_t> freeList;
+    };
+
+    std::array<Shard, SHARD_COUNT> shards_;
+    std::atomic<std::size_t> size_{0};
+
+#ifndef NDEBUG
+    // Entries this thread holds shared, to catch re-entry before it hangs
+    static std::vector<const Slot *> &heldByThisThread() {
+        thread_local std::vector<const Slot *> held;
+        return held;
+    }
+#endif
+
+    static void assertNotHeld([[maybe_unused]] const Slot &slot) {
+#ifndef NDEBUG
+        const auto &held = heldByThisThread();
+        assert(std::find(held.begin(), held.end(), &slot) == held.end() &&
+               "ShardedSlotMap entry re-entered from its own callback");
+#endif
+    }
+
+    /**
+     * @brief Holds an entry shared for one scope, including on throw
+     */
+    class SharedGuard {
+      public:
+        explicit SharedGuard(Slot &slot) : slot_(slot) {
+            assertNotHeld(slot_);
+            slot_.lock.lockShared();
+#ifndef NDEBUG
+            heldByThisThread().push_back(&slot_);
+#endif
+        }
+        ~SharedGuard() {
+#ifndef NDEBUG
+            heldByThisThread().pop_back();
+#endif
+            slot_.lock.unlockShared();
+        }
+
+        SharedGuard(const SharedGuard &) = delete;
+        SharedGuard &operator=(const SharedGuard &) = delete;
+
+      private:
+        Slot &slot_;
+    };
+
+    static void retireGeneration(Slot &slot) {
+        std::uint32_t next =
+            slot.generation.load(std::memory_order_relaxed) + 1;
+        if (next == 0) {
+            next = 1; // Skip the reserved generation on wraparound
+        }
+        slot.generation.store(next, std::memory_order_relaxed);
+    }
+
+    static std::pair<std::size_t, std::size_t> locate(std::uint32_t local) {
+        const std::size_t bucket = local / BASE_SEGMENT_SIZE + 1;
+        std::size_t segment = 0;
+        while ((bucket >> (segment + 1)) != 0) {
+            ++segment;
+        }
+        const std::size_t start =
+            BASE_SEGMENT_SIZE * ((std::size_t{1} << segment) - 1);
+        return {segment, local - start};
+    }
+
+    static Slot &slotAt(const Shard &shard, std::uint32_t local) {
+        const auto [segment, offset] = locate(local);
+        return shard.segments[segment].load(std::memory_order_acquire)[offset];
+    }
+
+    static void ensureSegment(Shard &shard, std::uint32_t local) {
+        const std::size_t segment = locate(local).first;
+        if (!shard.segments[segment].load(std::memory_order_relaxed)) {
+            shard.segments[segment].store(
+                new Slot[BASE_SEGMENT_SIZE << segment],
+                std::memory_order_release);
+        }
+    }
+
+    Slot *resolve(SlotHandle handle) const {
+        const Shard &shard = shards_[handle.index & (SHARD_COUNT - 1)];
+        const std::uint32_t local = handle.index >> ShardBits;
+        if (local >= shard.highWater.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slotAt(shard, local);
+    }
+
+    static bool matches(const Slot &slot, SlotHandle handle) {
+        return slot.live.load(std::memory_order_relaxed) &&
+               slot.generation.load(std::memory_order_relaxed) ==
+                   handle.generation;
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_SHARDED_SLOT_MAP_H
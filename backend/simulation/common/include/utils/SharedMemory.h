@@ -0,0 +1,218 @@
+#ifndef SIMULATION_COMMON_UTILS_SHARED_MEMORY_H
+#define SIMULATION_COMMON_UTILS_SHARED_MEMORY_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include <sys/mman.h>
+
+namespace crescent::common {
+
+/**
+ * @brief Anonymous mapping shared with every process forked after it
+ *
+ * Pages are zero-filled and only backed once touched, so a large region
+ * that is mostly unused costs address space, not memory. The mapping is
+ * released by the destructor in each process that holds it.
+ */
+class SharedMemoryRegion {
+  public:
+    SharedMemoryRegion() = default;
+
+    /**
+     * @throws std::system_error if the mapping cannot be created
+     */
+    explicit SharedMemoryRegion(std::size_t bytes) : size_(bytes) {
+        void *memory = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(),
+                                    "mmap shared region");
+        }
+        data_ = static_cast<std::byte *>(memory);
+    }
+
+    ~SharedMemoryRegion() { release(); }
+
+    // Prevent copying, allow moving
+    SharedMemoryRegion(const SharedMemoryRegion &) = delete;
+    SharedMemoryRegion &operator=(const SharedMemoryRegion &) = delete;
+    SharedMemoryRegion(SharedMemoryRegion &&other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+    SharedMemoryRegion &operator=(SharedMemoryRegion &&other) noexcept {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    std::byte *data() const { return data_; }
+    std::size_t size() const { return size_; }
+
+  private:
+    std::byte *data_{nullptr};
+    std::size_t size_{0};
+
+    void release() {
+        if (data_) {
+            ::munmap(data_, size_);
+            data_ = nullptr;
+        }
+    }
+};
+
+/**
+ * @brief Lock-free single-producer, single-consumer ring of byte frames
+ *
+ * Lives entirely inside caller-provided memory, normally a
+ * SharedMemoryRegion, so the producer and consumer may be different
+ * processes. Each frame is a 4-byte length followed by its bytes, copied
+ * in at most two pieces around the wrap; frames are delivered whole and in
+ * order. Head and tail are running byte counts on separate cache lines,
+ * and each side caches the other's counter so an uncontended push or pop
+ * touches only its own line.
+ *
+ * Exactly one process pushes and one pops. This object is a view: each
+ * side constructs its own over the same memory, and only one of them
+ * (before either uses it) passes initialize = true.
+ */
+class SpscByteRing {
+  public:
+    static constexpr std::size_t FRAME_HEADER = sizeof(std::uint32_t);
+
+    /**
+     * @brief Bytes of memory a ring with this capacity occupies
+     */
+    static constexpr std::size_t bytesFor(std::size_t capacity) {
+        return sizeof(Control) + capacity;
+    }
+
+    /**
+     * @param capacity Data bytes; a power of two
+     * @throws std::invalid_argument if capacity is not a power of two
+     */
+    SpscByteRing(std::byte *memory, std::size_t capacity, bool initialize)
+        : control_(reinterpret_cast<Control *>(memory)),
+          data_(memory + sizeof(Control)), mask_(capacity - 1) {
+        if (capacity < 2 * FRAME_HEADER || (capacity & mask_) != 0) {
+            throw std::invalid_argument(
+                "SpscByteRing capacity must be a power of two");
+        }
+        if (initialize) {
+            new (control_) Control();
+        }
+        cachedTail_ = control_->tail.load(std::memory_order_acquire);
+        cachedHead_ = control_->head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Largest frame that fits in an empty ring
+     */
+    std::size_t maxFrame() const { return mask_ + 1 - FRAME_HEADER; }
+
+    /**
+     * @brief Appends a frame; producer only
+     * @return False if there is no room now; nothing is written
+     * @throws std::length_error if the frame can never fit
+     */
+    bool tryPush(std::string_view frame) {
+        if (frame.size() > maxFrame()) {
+            throw std::length_error("SpscByteRing frame too large");
+        }
+        const std::size_t needed = FRAME_HEADER + frame.size();
+        const std::uint64_t head =
+            control_->head.load(std::memory_order_relaxed);
+        if (head + needed - cachedTail_ > mask_ + 1) {
+            cachedTail_ = control_->tail.load(std::memory_order_acquire);
+            if (head + needed - cachedTail_ > mask_ + 1) {
+                return false;
+            }
+        }
+        const auto length = static_cast<std::uint32_t>(frame.size());
+        copyIn(head, &length, FRAME_HEADER);
+        copyIn(head + FRAME_HEADER, frame.data(), frame.size());
+        control_->head.store(head + needed, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Takes the oldest frame into out; consumer only
+     * @return False if the ring is empty
+     */
+    bool tryPop(std::string &out) {
+        const std::uint64_t tail =
+            control_->tail.load(std::memory_order_relaxed);
+        if (tail == cachedHead_) {
+            cachedHead_ = control_->head.load(std::memory_order_acquire);
+            if (tail == cachedHead_) {
+                return false;
+            }
+        }
+        std::uint32_t length;
+        copyOut(tail, &length, FRAME_HEADER);
+        out.resize(length);
+        copyOut(tail + FRAME_HEADER, out.data(), length);
+        control_->tail.store(tail + FRAME_HEADER + length,
+                             std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return control_->head.load(std::memory_order_acquire) ==
+               control_->tail.load(std::memory_order_acquire);
+    }
+
+  private:
+    struct Control {
+        alignas(64) std::atomic<std::uint64_t> head{0}; // Bytes pushed
+        alignas(64) std::atomic<std::uint64_t> tail{0}; // Bytes popped
+    };
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+                  "Cross-process rings need address-free atomics");
+
+    Control *control_;
+    std::byte *data_;
+    std::size_t mask_;
+    std::uint64_t cachedTail_{0}; // Producer's view of tail
+    std::uint64_t cachedHead_{0}; // Consumer's view of head
+
+    void copyIn(std::uint64_t position, const void *source,
+                std::size_t count) {
+        if (count == 0) {
+            return;
+        }
+        const std::size_t offset = position & mask_;
+        const std::size_t first = std::min(count, mask_ + 1 - offset);
+        std::memcpy(data_ + offset, source, first);
+        std::memcpy(data_, static_cast<const std::byte *>(source) + first,
+                    count - first);
+    }
+    void copyOut(std::uint64_t position, void *target,
+                 std::size_t count) const {
+        if (count == 0) {
+            return;
+        }
+        const std::size_t offset = position & mask_;
+        const std::size_t first = std::min(count, mask_ + 1 - offset);
+        std::memcpy(target, data_ + offset, first);
+        std::memcpy(static_cast<std::byte *>(target) + first, data_,
+                    count - first);
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_SHARED_MEMORY_H
@@ -0,0 +1,215 @@
+#ifndef SIMULATION_COMMON_UTILS_SIMULATION_CLOCK_H
+#define SIMULATION_COMMON_UTILS_SIMULATION_CLOCK_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace crescent::common {
+
+/**
+ * @brief Point in simulation time, counted in ticks
+ *
+ * Four bytes instead of a time_point's eight, and meaningful only
+ * relative to a SimulationClock. At the default 100 ms tick a 32-bit
+ * count lasts over 13 years of simulated time.
+ *
+ * Ordering uses the signed difference (serial number arithmetic), so it
+ * stays correct across wraparound for ticks less than 2^31 apart (about
+ * 6.8 years at 100 ms). It is not a total order over arbitrary values;
+ * don't sort or key containers by SimTick.
+ */
+struct SimTick {
+    std::uint32_t value{0};
+
+    /**
+     * @brief Ticks elapsed since earlier; well defined across wraparound
+     */
+    std::uint32_t ticksSince(SimTick earlier) const {
+        return value - earlier.value;
+    }
+
+    /**
+     * @brief Signed ticks from b to a; negative if a is earlier
+     */
+    static std::int32_t difference(SimTick a, SimTick b) {
+        return static_cast<std::int32_t>(a.value - b.value);
+    }
+
+    friend bool operator==(SimTick a, SimTick b) { return a.value == b.value; }
+    friend bool operator!=(SimTick a, SimTick b) { return a.value != b.value; }
+    friend bool operator<(SimTick a, SimTick b) { return difference(a, b) < 0; }
+    friend bool operator<=(SimTick a, SimTick b) {
+        return difference(a, b) <= 0;
+    }
+    friend bool operator>(SimTick a, SimTick b) { return difference(a, b) > 0; }
+    friend bool operator>=(SimTick a, SimTick b) {
+        return difference(a, b) >= 0;
+    }
+};
+
+/**
+ * @brief A clock's configuration and position in portable units
+ *
+ * Serialized state stores raw tick values; files that hold them store one
+ * of these too (SnapshotHeader::clock), so a loader can rebuild the clock
+ * the ticks were counted on instead of converting through wall time.
+ */
+struct ClockRecord {
+    std::int64_t tickLengthMicros{100000};
+    std::int64_t epochMicros{0}; // Wall time of tick 0, Unix microseconds
+    SimTick tick{};              // Current tick when recorded
+};
+
+/**
+ * @brief Engine time source; the tick only moves when the scheduler says so
+ *
+ * State stamps itself with now(), a relaxed atomic load, so hot paths
+ * never read the system clock and a run is reproducible given its inputs.
+ * Serialization writes raw ticks plus record(), and loading installs a
+ * clock built from that record; wall time exists only for reporting
+ * (toWallTime) and for inputs given in wall time (fromWallTime, which
+ * clamps and so is not a round trip).
+ *
+ * One clock is current for the whole engine. Tools and replays install
+ * their own (with a fixed epoch) before creating any state.
+ */
+class SimulationClock {
+  public:
+    using WallClock = std::chrono::system_clock;
+    using TickLength = std::chrono::microseconds;
+
+    struct Config {
+        TickLength tickLength{100000}; // 100 ms
+        WallClock::time_point epoch{}; // Wall time of tick 0
+        SimTick start{};
+    };
+
+    /**
+     * @brief Default clock with its epoch at construction
+     */
+    SimulationClock() : SimulationClock(Config{TickLength{100000},
+                                               WallClock::now(), {}}) {}
+    explicit SimulationClock(Config config)
+        : tickLength_(config.tickLength.count() > 0 ? config.tickLength
+                                                    : TickLength{1}),
+          epoch_(config.epoch), tick_(config.start.value) {}
+
+    /**
+     * @brief Clock equal to the one that produced record
+     */
+    explicit SimulationClock(const ClockRecord &record)
+        : SimulationClock(configFor(record)) {}
+
+    static Config configFor(const ClockRecord &record) {
+        using std::chrono::duration_cast;
+        const WallClock::time_point epoch(duration_cast<WallClock::duration>(
+            std::chrono::microseconds(record.epochMicros)));
+        return {TickLength(record.tickLengthMicros), epoch, record.tick};
+    }
+
+    // Prevent copying and moving
+    SimulationClock(const SimulationClock &) = delete;
+    SimulationClock &operator=(const SimulationClock &) = delete;
+    SimulationClock(SimulationClock &&) = delete;
+    SimulationClock &operator=(SimulationClock &&) = delete;
+
+    SimTick now() const { return {tick_.load(std::memory_order_relaxed)}; }
+
+    /**
+     * @brief Moves time forward; called once per tick by the scheduler
+     * @return The new current tick
+     */
+    SimTick advance(std::uint32_t ticks = 1) {
+        return {tick_.fetch_add(ticks, std::memory_order_relaxed) + ticks};
+    }
+
+    /**
+     * @brief Jumps to a tick, e.g. when restoring a snapshot or a replay
+     */
+    void set(SimTick tick) {
+        tick_.store(tick.value, std::memory_order_relaxed);
+    }
+
+    TickLength tickLength() const { return tickLength_; }
+    WallClock::time_point epoch() const { return epoch_; }
+
+    /**
+     * @brief Everything needed to rebuild this clock at its current tick
+     */
+    ClockRecord record() const {
+        using std::chrono::duration_cast;
+        return {tickLength_.count(),
+                duration_cast<std::chrono::microseconds>(
+                    epoch_.time_since_epoch())
+                    .count(),
+                now()};
+    }
+
+    float tickSeconds() const {
+        return std::chrono::duration<float>(tickLength_).count();
+    }
+    float secondsBetween(SimTick from, SimTick to) const {
+        return static_cast<float>(to.ticksSince(from)) * tickSeconds();
+    }
+
+    WallClock::time_point toWallTime(SimTick tick) const {
+        const TickLength offset =
+            tickLength_ * static_cast<std::int64_t>(tick.value);
+        return epoch_ +
+               std::chrono::duration_cast<WallClock::duration>(offset);
+    }
+
+    /**
+     * @brief Nearest tick at or before a wall time, clamped to the range
+     *
+     * Lossy: times before the epoch or past the last tick clamp, so use
+     * it for inputs given in wall time, never to reload serialized ticks.
+     */
+    SimTick fromWallTime(WallClock::time_point time) const {
+        if (time <= epoch_) {
+            return {};
+        }
+        const auto ticks =
+            std::chrono::duration_cast<TickLength>(time - epoch_) /
+            tickLength_;
+        constexpr auto MAX = std::numeric_limits<std::uint32_t>::max();
+        return {ticks >= MAX ? MAX : static_cast<std::uint32_t>(ticks)};
+    }
+
+    /**
+     * @brief The engine's clock: the installed one, else a default
+     */
+    static SimulationClock &current() {
+        SimulationClock *clock = installed().load(std::memory_order_acquire);
+        return clock ? *clock : defaultClock();
+    }
+
+    /**
+     * @brief Makes clock current; nullptr restores the default
+     *
+     * The caller keeps ownership and must uninstall before destroying it.
+     */
+    static void install(SimulationClock *clock) {
+        installed().store(clock, std::memory_order_release);
+    }
+
+  private:
+    TickLength tickLength_;
+    WallClock::time_point epoch_;
+    std::atomic<std::uint32_t> tick_;
+
+    static std::atomic<SimulationClock *> &installed() {
+        static std::atomic<SimulationClock *> clock{nullptr};
+        return clock;
+    }
+    static SimulationClock &defaultClock() {
+        static SimulationClock clock;
+        return clock;
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_SIMULATION_CLOCK_H
@@ -0,0 +1,345 @@
+#ifndef SIMULATION_COMMON_UTILS_SMALL_FLAT_MAP_H
+#define SIMULATION_COMMON_UTILS_SMALL_FLAT_MAP_H
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Associative container that keeps up to N entries inline
+ *
+ * Small maps are stored as an unsorted inline array and searched linearly,
+ * with no heap allocation. Inserting entry N+1 moves everything into a flat
+ * open-addressing table (linear probing, backward-shift deletion) that stays
+ * in use until clear(). The array and the table share storage, so the map
+ * is never larger than the bigger of the two plus a tag. Intended for
+ * per-creature maps that almost always hold a handful of entries.
+ *
+ * Differences from std::unordered_map:
+ * - value_type is std::pair<Key, Value>; keys must not be modified through
+ *   iterators
+ * - any insertion or erase invalidates all iterators and references
+ * - Key and Value must be default constructible
+ */
+template <typename Key, typename Value, std::size_t N,
+          typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class SmallFlatMap {
+    static_assert(N > 0, "SmallFlatMap needs inline capacity");
+
+    struct Slot {
+        std::pair<Key, Value> entry;
+        bool occupied{false};
+    };
+
+    template <bool IsConst> class Iterator;
+
+  public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<Key, Value>;
+    using size_type = std::size_t;
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    static constexpr size_type INLINE_CAPACITY = N;
+
+    SmallFlatMap() = default;
+    SmallFlatMap(std::initializer_list<value_type> values) {
+        for (const auto &value : values) {
+            insert_or_assign(value.first, value.second);
+        }
+    }
+
+    // Capacity
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    bool isInline() const { return storage_.index() == 0; }
+
+    /**
+     * @brief Heap bytes owned by the container itself (not by its elements)
+     */
+    size_type heapBytes() const {
+        return isInline() ? 0 : table().capacity() * sizeof(Slot);
+    }
+
+    // Iteration
+    iterator begin() { return iterator(this, firstIndex()); }
+    iterator end() { return iterator(this, endIndex()); }
+    const_iterator begin() const { return const_iterator(this, firstIndex()); }
+    const_iterator end() const { return const_iterator(this, endIndex()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    // Lookup
+    iterator find(const Key &key) { return iterator(this, indexOf(key)); }
+    const_iterator find(const Key &key) const {
+        return const_iterator(this, indexOf(key));
+    }
+    size_type count(const Key &key) const {
+        return indexOf(key) == endIndex() ? 0 : 1;
+    }
+
+    Value &at(const Key &key) {
+        const size_type index = indexOf(key);
+        if (index == endIndex()) {
+            throw std::out_of_range("SmallFlatMap::at: key not found");
+        }
+        return entryAt(index).second;
+    }
+    const Value &at(const Key &key) const {
+        return const_cast<SmallFlatMap *>(this)->at(key);
+    }
+
+    Value &operator[](const Key &key) { return try_emplace(key).first->second; }
+
+    // Modification
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+        const size_type existing = indexOf(key);
+        if (existing != endIndex()) {
+            return {iterator(this, existing), false};
+        }
+        const size_type index =
+            insertNew(key, Value(std::forward<Args>(args)...));
+        return {iterator(this, index), true};
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const Key &key, V &&value) {
+        const size_type existing = indexOf(key);
+        if (existing != endIndex()) {
+            entryAt(existing).second = std::forward<V>(value);
+            return {iterator(this, existing), false};
+        }
+        return {iterator(this, insertNew(key, Value(std::forward<V>(value)))),
+                true};
+    }
+
+    std::pair<iterator, bool> insert(const value_type &value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    size_type erase(const Key &key) {
+        const size_type index = indexOf(key);
+        if (index == endIndex()) {
+            return 0;
+        }
+        if (isInline()) {
+            // Unordered storage: fill the hole with the last entry
+            InlineEntries &entries = inlineEntries();
+            if (index != size_ - 1) {
+                entries[index] = std::move(entries[size_ - 1]);
+            }
+            entries[size_ - 1] = value_type{};
+        } else {
+            eraseSlot(index);
+        }
+        --size_;
+        return 1;
+    }
+
+    void clear() {
+        storage_.template emplace<InlineEntries>();
+        size_ = 0;
+    }
+
+  private:
+    using InlineEntries = std::array<value_type, N>;
+    using Table = std::vector<Slot>;
+
+    std::variant<InlineEntries, Table> storage_; // Inline until spilled
+    size_type size_{0};
+
+    static constexpr float MAX_LOAD_FACTOR = 0.75f;
+
+    InlineEntries &inlineEntries() { return *std::get_if<0>(&storage_); }
+    const InlineEntries &inlineEntries() const {
+        return *std::get_if<0>(&storage_);
+    }
+    Table &table() { return *std::get_if<1>(&storage_); }
+    const Table &table() const { return *std::get_if<1>(&storage_); }
+
+    // Positions are array indices while inline and slot indices once spilled
+    size_type endIndex() const { return isInline() ? size_ : table().size(); }
+
+    size_type firstIndex() const {
+        return isInline() ? 0 : nextOccupied(0);
+    }
+
+    size_type nextOccupied(size_type index) const {
+        const Table &slots = table();
+        while (index < slots.size() && !slots[index].occupied) {
+            ++index;
+        }
+        return index;
+    }
+
+    value_type &entryAt(size_type index) {
+        return isInline() ? inlineEntries()[index] : table()[index].entry;
+    }
+    const value_type &entryAt(size_type index) const {
+        return isInline() ? inlineEntries()[index] : table()[index].entry;
+    }
+
+    size_type indexOf(const Key &key) const {
+        if (isInline()) {
+            const InlineEntries &entries = inlineEntries();
+            for (size_type i = 0; i < size_; ++i) {
+                if (KeyEqual{}(entries[i].first, key)) {
+                    return i;
+                }
+            }
+            return size_;
+        }
+        const Table &slots = table();
+        const size_type mask = slots.size() - 1;
+        for (size_type i = Hash{}(key) & mask;; i = (i + 1) & mask) {
+            if (!slots[i].occupied) {
+                return slots.size();
+            }
+            if (KeyEqual{}(slots[i].entry.first, key)) {
+                return i;
+            }
+        }
+    }
+
+    size_type insertNew(const Key &key, Value value) {
+        if (isInline() && size_ < N) {
+            inlineEntries()[size_] = value_type(key, std::move(value));
+            return size_++;
+        }
+        if (isInline()) {
+            // Smallest table that takes the spilled entries under the limit
+            rehash(static_cast<size_type>(static_cast<float>(N + 1) /
+                                          MAX_LOAD_FACTOR) +
+                   1);
+        } else {
+            const size_type slots = table().size();
+            if (static_cast<float>(size_ + 1) >
+                MAX_LOAD_FACTOR * static_cast<float>(slots)) {
+                rehash(slots * 2);
+            }
+        }
+        ++size_;
+        return placeInTable(table(), value_type(key, std::move(value)));
+    }
+
+    static size_type placeInTable(Table &slots, value_type entry) {
+        const size_type mask = slots.size() - 1;
+        size_type i = Hash{}(entry.first) & mask;
+        while (slots[i].occupied) {
+            i = (i + 1) & mask;
+        }
+        slots[i].entry = std::move(entry);
+        slots[i].occupied = true;
+        return i;
+    }
+
+    void rehash(size_type minimumSlots) {
+        size_type capacity = 1;
+        while (capacity < minimumSlots) {
+            capacity <<= 1;
+        }
+        Table resized(capacity);
+        if (isInline()) {
+            // Spilling out of inline storage
+            InlineEntries &entries = inlineEntries();
+            for (size_type i = 0; i < size_; ++i) {
+                placeInTable(resized, std::move(entries[i]));
+            }
+        } else {
+            for (Slot &slot : table()) {
+                if (slot.occupied) {
+                    placeInTable(resized, std::move(slot.entry));
+                }
+            }
+        }
+        storage_ = std::move(resized);
+    }
+
+    void eraseSlot(size_type hole) {
+        Table &slots = table();
+        const size_type mask = slots.size() - 1;
+        slots[hole].entry = value_type{};
+        slots[hole].occupied = false;
+        // Backward-shift later members of the probe run into the hole
+        for (size_type i = (hole + 1) & mask; slots[i].occupied;
+             i = (i + 1) & mask) {
+            const size_type home = Hash{}(slots[i].entry.first) & mask;
+            const bool homeAfterHole = hole <= i ? (home > hole && home <= i)
+                                                 : (home > hole || home <= i);
+            if (homeAfterHole) {
+                continue;
+            }
+            slots[hole] = std::move(slots[i]);
+            slots[i].entry = value_type{};
+            slots[i].occupied = false;
+            hole = i;
+        }
+    }
+
+    template <bool IsConst> class Iterator {
+        using Owner =
+            std::conditional_t<IsConst, const SmallFlatMap, SmallFlatMap>;
+
+      public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = SmallFlatMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<IsConst, const value_type &,
+                                             value_type &>;
+        using pointer = std::conditional_t<IsConst, const value_type *,
+                                           value_type *>;
+
+        Iterator() = default;
+        Iterator(Owner *owner, size_type index)
+            : owner_(owner), index_(index) {}
+        template <bool WasConst,
+                  typename = std::enable_if_t<IsConst && !WasConst>>
+        Iterator(const Iterator<WasConst> &other)
+            : owner_(other.owner_), index_(other.index_) {}
+
+        reference operator*() const { return owner_->entryAt(index_); }
+        pointer operator->() const { return &owner_->entryAt(index_); }
+
+        Iterator &operator++() {
+            ++index_;
+            if (!owner_->isInline()) {
+                index_ = owner_->nextOccupied(index_);
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        bool operator==(const Iterator &other) const {
+            return index_ == other.index_ && owner_ == other.owner_;
+        }
+        bool operator!=(const Iterator &other) const {
+            return !(*this == other);
+        }
+
+      private:
+        friend class SmallFlatMap;
+        template <bool> friend class Iterator;
+        Owner *owner_{nullptr};
+        size_type index_{0};
+    };
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_SMALL_FLAT_MAP_H
@@ -0,0 +1,40 @@
+#ifndef SIMULATION_COMMON_UTILS_STATUS_VISITOR_H
+#define SIMULATION_COMMON_UTILS_STATUS_VISITOR_H
+
+#include "common/utils/SimulationClock.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace crescent::common {
+
+/**
+ * @brief Receives status fields one at a time without intermediate copies
+ *
+ * Polling APIs call back into a visitor instead of building result structs.
+ * Every string_view passed to a callback points into the owner's storage and
+ * is only valid for the duration of that callback; copy it if it must
+ * outlive the call. Owners that are internally locked hold their lock for the
+ * whole visit, so visitors must not call back into the object being visited.
+ * Timestamps arrive as simulation ticks; a visitor that reports wall time
+ * converts with SimulationClock::current().toWallTime().
+ */
+class StatusVisitor {
+  public:
+    virtual ~StatusVisitor() = default;
+
+    virtual void onFlag(std::string_view /*field*/, bool /*value*/) {}
+    virtual void onValue(std::string_view /*field*/, float /*value*/) {}
+    virtual void onCount(std::string_view /*field*/, std::int64_t /*value*/) {}
+    virtual void onTimestamp(std::string_view /*field*/, SimTick /*value*/) {}
+
+    // Collection members, reported one element per call
+    virtual void onListItem(std::string_view /*list*/,
+                            std::string_view /*item*/) {}
+    virtual void onMapEntry(std::string_view /*map*/, std::string_view /*key*/,
+                            float /*value*/) {}
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_STATUS_VISITOR_H
@@ -0,0 +1,400 @@
+#ifndef SIMULATION_COMMON_UTILS_STRING_ARENA_H
+#define SIMULATION_COMMON_UTILS_STRING_ARENA_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Append-only storage for many short strings
+ *
+ * Strings are packed back to back in fixed-size chunks that are never moved
+ * or freed before the arena itself, so returned views stay valid for the
+ * arena's lifetime. Each string is also addressable by a dense 32-bit id.
+ */
+class StringArena {
+  public:
+    using Id = std::uint32_t;
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 1 << 20;
+
+    explicit StringArena(std::size_t chunkSize = DEFAULT_CHUNK_SIZE)
+        : chunkSize_(chunkSize) {}
+
+    // Prevent copying, allow moving
+    StringArena(const StringArena &) = delete;
+    StringArena &operator=(const StringArena &) = delete;
+    StringArena(StringArena &&) = default;
+    StringArena &operator=(StringArena &&) = default;
+
+    /**
+     * @brief Reserves bytes for a string the caller writes in place
+     *
+     * The caller must fill all length bytes and then call commit() before
+     * the next allocation.
+     */
+    char *allocate(std::size_t length) {
+        if (remaining_ < length) {
+            const std::size_t size = std::max(chunkSize_, length);
+            chunks_.push_back(std::make_unique<char[]>(size));
+            cursor_ = chunks_.back().get();
+            remaining_ = size;
+            bytesReserved_ += size;
+        }
+        pending_ = length;
+        return cursor_;
+    }
+
+    Id commit() {
+        views_.emplace_back(cursor_, pending_);
+        cursor_ += pending_;
+        remaining_ -= pending_;
+        pending_ = 0;
+        return static_cast<Id>(views_.size() - 1);
+    }
+
+    Id append(std::string_view text) {
+        char *out = allocate(text.size());
+        std::memcpy(out, text.data(), text.size());
+        return commit();
+    }
+
+    /**
+     * @brief Points an existing id at a copy of text
+     *
+     * The old bytes stay allocated until the arena is rebuilt.
+     */
+    void replace(Id id, std::string_view text) {
+        char *out = allocate(text.size());
+        if (!text.empty()) {
+            std::memcpy(out, text.data(), text.size());
+        }
+        views_[id] = std::string_view(out, text.size());
+        cursor_ += text.size();
+        remaining_ -= text.size();
+        pending_ = 0;
+    }
+
+    /**
+     * @brief Drops the most recent string; its bytes are reused
+     */
+    void popBack() {
+        const std::string_view last = views_.back();
+        views_.pop_back();
+        if (last.data() + last.size() == cursor_) {
+            cursor_ -= last.size();
+            remaining_ += last.size();
+        }
+    }
+
+    std::string_view operator[](Id id) const { return views_[id]; }
+    std::size_t size() const { return views_.size(); }
+    void reserve(std::size_t strings) { views_.reserve(strings); }
+
+    std::size_t getMemoryFootprint() const {
+        return bytesReserved_ +
+               views_.capacity() * sizeof(std::string_view) +
+               chunks_.capacity() * sizeof(std::unique_ptr<char[]>);
+    }
+
+  private:
+    std::size_t chunkSize_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::vector<std::string_view> views_;
+    char *cursor_{nullptr};
+    std::size_t remaining_{0};
+    std::size_t pending_{0};
+    std::size_t bytesReserved_{0};
+};
+
+/**
+ * @brief Compact hash set of strings stored in a StringArena
+ *
+ * Each slot is 8 bytes: the string id plus a 32-bit hash tag, so most
+ * mismatches are rejected without touching string bytes. Linear probing,
+ * kept below 50% load.
+ */
+class UniqueStringSet {
+  public:
+    using Id = StringArena::Id;
+
+    explicit UniqueStringSet(const StringArena &arena) : arena_(&arena) {}
+
+    void reserve(std::size_t count) {
+        std::size_t capacity = 16;
+        while (capacity < count * 2) {
+            capacity <<= 1;
+        }
+        if (capacity > slots_.size()) {
+            rehash(capacity);
+        }
+    }
+
+    static std::uint64_t hash(std::string_view text) {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : text) {
+            h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+        }
+        return h ^ (h >> 29);
+    }
+
+    bool contains(std::string_view text) const {
+        return contains(text, hash(text));
+    }
+
+    bool contains(std::string_view text, std::uint64_t h) const {
+        return find(text, h).has_value();
+    }
+
+    std::optional<Id> find(std::string_view text, std::uint64_t h) const {
+        if (slots_.empty()) {
+            return std::nullopt;
+        }
+        const std::uint32_t tag = static_cast<std::uint32_t>(h >> 32);
+        for (std::size_t i = h & mask_;; i = (i + 1) & mask_) {
+            const Slot &slot = slots_[i];
+            if (slot.idPlusOne == 0) {
+                return std::nullopt;
+            }
+            if (slot.tag == tag && (*arena_)[slot.idPlusOne - 1] == text) {
+                return slot.idPlusOne - 1;
+            }
+        }
+    }
+
+    /**
+     * @brief Adds an arena string known not to be present
+     */
+    void insert(Id id, std::uint64_t h) {
+        if ((count_ + 1) * 2 > slots_.size()) {
+            rehash(slots_.empty() ? 16 : slots_.size() * 2);
+        }
+        place(id, h);
+        ++count_;
+    }
+
+    /**
+     * @brief Removes a present id; its arena string must still be intact
+     *
+     * Backward-shift deletion, so lookups never see tombstones.
+     */
+    void erase(Id id, std::uint64_t h) {
+        std::size_t hole = h & mask_;
+        while (slots_[hole].idPlusOne != id + 1) {
+            hole = (hole + 1) & mask_;
+        }
+        for (std::size_t i = (hole + 1) & mask_; slots_[i].idPlusOne != 0;
+             i = (i + 1) & mask_) {
+            const std::size_t home =
+                hash((*arena_)[slots_[i].idPlusOne - 1]) & mask_;
+            // Move back only if the hole lies between home and i
+            if (((i - home) & mask_) >= ((i - hole) & mask_)) {
+                slots_[hole] = slots_[i];
+                hole = i;
+            }
+        }
+        slots_[hole] = Slot{};
+        --count_;
+    }
+
+    std::size_t size() const { return count_; }
+    std::size_t getMemoryFootprint() const {
+        return slots_.capacity() * sizeof(Slot);
+    }
+
+  private:
+    struct Slot {
+        std::uint32_t idPlusOne{0}; // 0 = empty
+        std::uint32_t tag{0};
+    };
+
+    const StringArena *arena_;
+    std::vector<Slot> slots_;
+    std::size_t mask_{0};
+    std::size_t count_{0};
+
+    void place(Id id, std::uint64_t h) {
+        std::size_t i = h & mask_;
+        while (slots_[i].idPlusOne != 0) {
+            i = (i + 1) & mask_;
+        }
+        slots_[i] = {id + 1, static_cast<std::uint32_t>(h >> 32)};
+    }
+
+    void rehash(std::size_t capacity) {
+        std::vector<Slot> old = std::move(slots_);
+        slots_.assign(capacity, Slot{});
+        mask_ = capacity - 1;
+        for (const Slot &slot : old) {
+            if (slot.idPlusOne != 0) {
+                place(slot.idPlusOne - 1,
+                      hash((*arena_)[slot.idPlusOne - 1]));
+            }
+        }
+    }
+};
+
+/**
+ * @brief Thread-safe, reference-counted string -> dense id table backed by
+ * a StringArena
+ *
+ * Every intern() or retain() takes a reference that release() drops. When
+ * the last one goes the string is forgotten and its id reused by a later
+ * first sighting. Once dead bytes pass TRIM_BYTES and outweigh the live
+ * ones, the arena is rebuilt with only live strings, under the exclusive
+ * lock; ids never change. Strings are only handed out as copies, so the
+ * rebuild cannot invalidate anything a reader holds.
+ *
+ * Lookups take a shared lock; first sightings and releases take it
+ * exclusively.
+ */
+class StringInterner {
+  public:
+    using Id = StringArena::Id;
+    static constexpr std::size_t CHUNK_SIZE = 64 * 1024;
+    static constexpr std::size_t TRIM_BYTES = CHUNK_SIZE;
+
+    StringInterner() : set_(arena_) {}
+
+    // Prevent copying and moving; the set points into the arena
+    StringInterner(const StringInterner &) = delete;
+    StringInterner &operator=(const StringInterner &) = delete;
+    StringInterner(StringInterner &&) = delete;
+    StringInterner &operator=(StringInterner &&) = delete;
+
+    /**
+     * @brief Id of text, taking a reference to it
+     */
+    Id intern(std::string_view text) {
+        const std::uint64_t h = UniqueStringSet::hash(text);
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            if (const std::optional<Id> id = set_.find(text, h)) {
+                refs_[*id].fetch_add(1, std::memory_order_relaxed);
+                return *id;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (const std::optional<Id> id = set_.find(text, h)) {
+            refs_[*id].fetch_add(1, std::memory_order_relaxed);
+            return *id;
+        }
+        Id id;
+        if (!freeIds_.empty()) {
+            id = freeIds_.back();
+            freeIds_.pop_back();
+            arena_.replace(id, text);
+            refs_[id].store(1, std::memory_order_relaxed);
+        } else {
+            id = arena_.append(text);
+            refs_.emplace_back(1);
+        }
+        set_.insert(id, h);
+        liveBytes_ += text.size();
+        return id;
+    }
+
+    /**
+     * @brief Takes one more reference to each id in [first, last)
+     */
+    template <typename It> void retain(It first, It last) {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (; first != last; ++first) {
+            refs_[*first].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Drops one reference to each id in [first, last)
+     */
+    template <typename It> void release(It first, It last) {
+        if (first == last) {
+            return;
+        }
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (; first != last; ++first) {
+            const Id id = *first;
+            if (refs_[id].fetch_sub(1, std::memory_order_relaxed) == 1) {
+                forget(id);
+            }
+        }
+        if (deadBytes_ >= TRIM_BYTES && deadBytes_ > liveBytes_) {
+            rebuildArena();
+        }
+    }
+
+    void release(Id id) { release(&id, &id + 1); }
+
+    std::optional<Id> find(std::string_view text) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return set_.find(text, UniqueStringSet::hash(text));
+    }
+
+    /**
+     * @brief Copy of a live id's string
+     */
+    std::string str(Id id) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return std::string(arena_[id]);
+    }
+
+    /**
+     * @brief Number of live strings
+     */
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return set_.size();
+    }
+
+    std::size_t getMemoryFootprint() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return arena_.getMemoryFootprint() + set_.getMemoryFootprint() +
+               refs_.size() * sizeof(std::atomic<std::uint32_t>) +
+               freeIds_.capacity() * sizeof(Id);
+    }
+
+  private:
+    mutable std::shared_mutex mutex_;
+    StringArena arena_{CHUNK_SIZE};
+    UniqueStringSet set_;
+    std::deque<std::atomic<std::uint32_t>> refs_; // Per id; stable addresses
+    std::vector<Id> freeIds_;
+    std::size_t liveBytes_{0};
+    std::size_t deadBytes_{0};
+
+    // Caller holds mutex_ exclusively
+    void forget(Id id) {
+        const std::string_view text = arena_[id];
+        set_.erase(id, UniqueStringSet::hash(text));
+        arena_.replace(id, {});
+        freeIds_.push_back(id);
+        liveBytes_ -= text.size();
+        deadBytes_ += text.size();
+    }
+
+    // Caller holds mutex_ exclusively; ids keep their strings
+    void rebuildArena() {
+        StringArena fresh(CHUNK_SIZE);
+        fresh.reserve(arena_.size());
+        for (Id id = 0; id < arena_.size(); ++id) {
+            fresh.append(arena_[id]);
+        }
+        arena_ = std::move(fresh);
+        deadBytes_ = 0;
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_STRING_ARENA_H
@@ -0,0 +1,167 @@
+#ifndef SIMULATION_COMMON_UTILS_VERSIONED_BYTE_CACHE_H
+#define SIMULATION_COMMON_UTILS_VERSIONED_BYTE_CACHE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace crescent::common {
+
+/**
+ * @brief Immutable serialized text shared between cache and callers
+ */
+using SerializedBytes = std::shared_ptr<const std::string>;
+
+/**
+ * @brief Versions a cached output was built from, compared exactly
+ *
+ * An owner whose output embeds other components' output records each of
+ * their versions alongside its own, so a change in any of them misses the
+ * cache without the owner tracking it directly. Unused components stay 0.
+ */
+struct VersionStamp {
+    static constexpr std::size_t MAX_COMPONENTS = 4;
+    std::array<std::uint64_t, MAX_COMPONENTS> components{};
+
+    VersionStamp() = default;
+    // Owners with a single version pass it directly
+    VersionStamp(std::uint64_t version) : components{{version}} {}
+    VersionStamp(std::uint64_t first, std::uint64_t second,
+                 std::uint64_t third = 0, std::uint64_t fourth = 0)
+        : components{{first, second, third, fourth}} {}
+
+    bool operator==(const VersionStamp &other) const {
+        return components == other.components;
+    }
+    bool operator!=(const VersionStamp &other) const {
+        return !(*this == other);
+    }
+};
+
+/**
+ * @brief Per-object cache of serialized output keyed by options and version
+ *
+ * Holds a handful of entries (one per distinct options value in use) and
+ * replaces an entry when its stamp is stale. Keys are stored and compared
+ * with ==, never hashed, so two option sets share an entry only if they
+ * are equal; Key must be default-constructible and copyable. Lookups from
+ * concurrent const readers are safe; the lock is a single word so owning
+ * objects stay cheap to move.
+ */
+template <typename Key> class BasicVersionedByteCache {
+  public:
+    static constexpr std::size_t CAPACITY = 4;
+
+    BasicVersionedByteCache() = default;
+    BasicVersionedByteCache(BasicVersionedByteCache &&other) noexcept
+        : entries_(std::move(other.entries_)), next_(other.next_) {}
+    BasicVersionedByteCache &
+    operator=(BasicVersionedByteCache &&other) noexcept {
+        entries_ = std::move(other.entries_);
+        next_ = other.next_;
+        return *this;
+    }
+    BasicVersionedByteCache(const BasicVersionedByteCache &) = delete;
+    BasicVersionedByteCache &
+    operator=(const BasicVersionedByteCache &) = delete;
+
+    /**
+     * @brief Returns cached bytes or builds and stores them
+     * @param build Callable returning std::string; runs without the lock held
+     */
+    template <typename Build>
+    SerializedBytes getOrBuild(const Key &options, const VersionStamp &version,
+                               Build &&build) const {
+        if (SerializedBytes cached = lookup(options, version)) {
+            return cached;
+        }
+        auto bytes = std::make_shared<const std::string>(build());
+        store(options, version, bytes);
+        return bytes;
+    }
+
+    SerializedBytes lookup(const Key &options,
+                           const VersionStamp &version) const {
+        Guard guard(lock_);
+        for (const Entry &entry : entries_) {
+            if (entry.bytes && entry.options == options &&
+                entry.version == version) {
+                return entry.bytes;
+            }
+        }
+        return nullptr;
+    }
+
+    void clear() {
+        Guard guard(lock_);
+        entries_ = {};
+    }
+
+    /**
+     * @brief Heap bytes retained by cached output
+     */
+    std::size_t retainedBytes() const {
+        Guard guard(lock_);
+        std::size_t total = 0;
+        for (const Entry &entry : entries_) {
+            total += entry.bytes ? entry.bytes->capacity() : 0;
+        }
+        return total;
+    }
+
+  private:
+    struct Entry {
+        Key options{};
+        VersionStamp version;
+        SerializedBytes bytes;
+    };
+
+    class Guard {
+      public:
+        explicit Guard(std::atomic_flag &flag) : flag_(flag) {
+            while (flag_.test_and_set(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+        ~Guard() { flag_.clear(std::memory_order_release); }
+        Guard(const Guard &) = delete;
+        Guard &operator=(const Guard &) = delete;
+
+      private:
+        std::atomic_flag &flag_;
+    };
+
+    void store(const Key &options, const VersionStamp &version,
+               SerializedBytes bytes) const {
+        Guard guard(lock_);
+        for (Entry &entry : entries_) {
+            if (entry.bytes && entry.options == options) {
+                // Stamps are not ordered, so the newest build wins
+                entry = {options, version, std::move(bytes)};
+                return;
+            }
+        }
+        entries_[next_] = {options, version, std::move(bytes)};
+        next_ = (next_ + 1) % CAPACITY;
+    }
+
+    mutable std::atomic_flag lock_ = ATOMIC_FLAG_INIT;
+    mutable std::array<Entry, CAPACITY> entries_{};
+    mutable std::size_t next_{0};
+};
+
+/**
+ * @brief Cache keyed by a caller-packed integer
+ *
+ * For owners whose options already fit losslessly in 64 bits.
+ */
+using VersionedByteCache = BasicVersionedByteCache<std::uint64_t>;
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_VERSIONED_BYTE_CACHE_H
@@ -0,0 +1,69 @@
+#ifndef SIMULATION_COMMON_UTILS_VIEWS_H
+#define SIMULATION_COMMON_UTILS_VIEWS_H
+
+#include <cstddef>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Non-owning view over contiguous elements
+ *
+ * Stand-in for std::span until the engine moves past C++17. A view is only
+ * valid while the owning container is neither modified nor destroyed.
+ */
+template <typename T> class Span {
+  public:
+    using element_type = T;
+    using iterator = T *;
+
+    constexpr Span() = default;
+    constexpr Span(T *data, std::size_t size) : data_(data), size_(size) {}
+    template <typename U, typename Alloc>
+    Span(const std::vector<U, Alloc> &values)
+        : data_(values.data()), size_(values.size()) {}
+
+    // A temporary vector would be gone before the view is read
+    template <typename U, typename Alloc>
+    Span(const std::vector<U, Alloc> &&values) = delete;
+
+    constexpr iterator begin() const { return data_; }
+    constexpr iterator end() const { return data_ + size_; }
+    constexpr T &operator[](std::size_t index) const { return data_[index]; }
+    constexpr T *data() const { return data_; }
+    constexpr std::size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+
+  private:
+    T *data_{nullptr};
+    std::size_t size_{0};
+};
+
+/**
+ * @brief Read-only view over an associative container
+ *
+ * Keeps the owner's storage type out of the view's users so the underlying
+ * map can change without breaking callers. Same lifetime rules as Span.
+ */
+template <typename Map> class MapView {
+  public:
+    using key_type = typename Map::key_type;
+    using const_iterator = typename Map::const_iterator;
+
+    MapView() = default;
+    explicit MapView(const Map &map) : map_(&map) {}
+    explicit MapView(const Map &&map) = delete;
+
+    const_iterator begin() const { return map_->begin(); }
+    const_iterator end() const { return map_->end(); }
+    const_iterator find(const key_type &key) const { return map_->find(key); }
+    std::size_t size() const { return map_ ? map_->size() : 0; }
+    bool empty() const { return size() == 0; }
+
+  private:
+    const Map *map_{nullptr};
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_VIEWS_H
@@ -0,0 +1,179 @@
+#ifndef SIMULATION_COMMON_UTILS_WORKER_POOL_H
+#define SIMULATION_COMMON_UTILS_WORKER_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace crescent::common {
+
+/**
+ * @brief Parked threads that split index ranges into claimed chunks
+ *
+ * forEachChunk(count, grain, fn) calls fn(begin, end, worker) for every
+ * chunk of [0, count); workers claim chunks from a shared counter, and the
+ * calling thread participates as worker 0. Worker indices are dense in
+ * [0, size()), so callers can keep per-worker scratch without locking.
+ *
+ * One forEachChunk runs at a time; the pool is not reentrant.
+ */
+class WorkerPool {
+  public:
+    explicit WorkerPool(std::size_t workerCount = 0) {
+        if (workerCount == 0) {
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        // The calling thread participates, so spawn one fewer
+        for (std::size_t i = 1; i < workerCount; ++i) {
+            workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Prevent copying and moving
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    WorkerPool(WorkerPool &&) = delete;
+    WorkerPool &operator=(WorkerPool &&) = delete;
+
+    /**
+     * @brief Number of workers, including the calling thread
+     */
+    std::size_t size() const { return workers_.size() + 1; }
+
+    /**
+     * @brief Runs fn(begin, end, worker) over [0, count) in grain chunks
+     *
+     * Rethrows the first exception thrown by any chunk once all workers
+     * have stopped.
+     */
+    template <typename Fn>
+    void forEachChunk(std::size_t count, std::size_t grain, Fn &&fn) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<std::size_t>(grain, 1);
+        const std::size_t chunks = (count + grain - 1) / grain;
+        if (chunks == 1 || workers_.empty()) {
+            for (std::size_t begin = 0; begin < count; begin += grain) {
+                fn(begin, std::min(begin + grain, count), std::size_t{0});
+            }
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // Constness is restored by the cast in invoke_
+            job_ = const_cast<void *>(
+                static_cast<const void *>(std::addressof(fn)));
+            invoke_ = [](void *job, std::size_t begin, std::size_t end,
+                         std::size_t worker) {
+                (*static_cast<std::remove_reference_t<Fn> *>(job))(begin, end,
+                                                                   worker);
+            };
+            count_ = count;
+            grain_ = grain;
+            chunkCount_ = chunks;
+            nextChunk_.store(0, std::memory_order_relaxed);
+            error_ = nullptr;
+            busyWorkers_ = workers_.size();
+            ++generation_;
+        }
+        wake_.notify_all();
+        runChunks(0);
+        std::exception_ptr error;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [&] { return busyWorkers_ == 0; });
+            error = error_;
+            job_ = nullptr;
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+  private:
+    using Invoke = void (*)(void *, std::size_t, std::size_t, std::size_t);
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::uint64_t generation_{0};
+    std::size_t busyWorkers_{0};
+    bool stopping_{false};
+
+    // Current job; written under mutex_ before the generation bump
+    void *job_{nullptr};
+    Invoke invoke_{nullptr};
+    std::size_t count_{0};
+    std::size_t grain_{1};
+    std::size_t chunkCount_{0};
+    std::atomic<std::size_t> nextChunk_{0};
+    std::exception_ptr error_;
+
+    void workerLoop(std::size_t worker) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock,
+                           [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) {
+                    return;
+                }
+                seen = generation_;
+            }
+            runChunks(worker);
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --busyWorkers_;
+            }
+            done_.notify_one();
+        }
+    }
+
+    void runChunks(std::size_t worker) {
+        for (;;) {
+            const std::size_t chunk =
+                nextChunk_.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunkCount_) {
+                return;
+            }
+            const std::size_t begin = chunk * grain_;
+            try {
+                invoke_(job_, begin, std::min(begin + grain_, count_), worker);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) {
+                    error_ = std::current_exception();
+                }
+                // Drain the remaining chunks so every worker finishes fast
+                nextChunk_.store(chunkCount_, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+};
+
+} // namespace crescent::common
+
+#endif // SIMULATION_COMMON_UTILS_WORKER_POOL_H
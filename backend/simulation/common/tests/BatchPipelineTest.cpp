@@ -0,0 +1,105 @@
+#include "common/utils/BatchPipeline.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using crescent::common::BatchPipeline;
+
+namespace {
+
+struct Work {
+    std::size_t id{0};
+    std::vector<std::uint64_t> values;
+};
+
+std::vector<Work> makeWork(std::size_t count) {
+    std::vector<Work> batches(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        batches[i].id = i;
+    }
+    return batches;
+}
+
+} // namespace
+
+TEST_CASE("Batches reach the sink in order through parallel stages",
+          "[batch_pipeline]") {
+    const std::size_t depth = GENERATE(std::size_t{1}, std::size_t{4});
+    BatchPipeline<Work> pipeline(
+        {{[](Work &work) {
+              // Uneven cost so batches overtake each other
+              if (work.id % 3 == 0) {
+                  std::this_thread::sleep_for(std::chrono::microseconds(200));
+              }
+              work.values.push_back(work.id);
+          },
+          4},
+         {[](Work &work) { work.values.push_back(work.values.back() * 2); },
+          3}},
+        depth);
+
+    std::vector<std::size_t> seen;
+    const BatchPipeline<Work>::Timings timings =
+        pipeline.run(makeWork(200), [&](Work &work) {
+            REQUIRE(work.values.size() == 2);
+            REQUIRE(work.values[1] == work.id * 2);
+            seen.push_back(work.id);
+        });
+
+    REQUIRE(seen.size() == 200);
+    for (std::size_t i = 0; i < seen.size(); ++i) {
+        REQUIRE(seen[i] == i);
+    }
+    REQUIRE(timings.size() == 3);
+    // 67 sleeping batches in stage one
+    REQUIRE(timings[0] >= std::chrono::microseconds(67 * 200));
+}
+
+TEST_CASE("Without stages batches go straight to the sink",
+          "[batch_pipeline]") {
+    BatchPipeline<Work> pipeline({}, 2);
+    std::size_t next = 0;
+    pipeline.run(makeWork(10), [&](Work &work) { REQUIRE(work.id == next++); });
+    REQUIRE(next == 10);
+}
+
+TEST_CASE("A stage failure stops the pipeline and is rethrown",
+          "[batch_pipeline]") {
+    std::atomic<std::size_t> processed{0};
+    BatchPipeline<Work> pipeline(
+        {{[&](Work &) { ++processed; }, 2},
+         {[](Work &work) {
+              if (work.id == 5) {
+                  throw std::runtime_error("stage failed");
+              }
+          },
+          2}},
+        2);
+
+    std::size_t sunk = 0;
+    REQUIRE_THROWS_WITH(pipeline.run(makeWork(10000),
+                                     [&](Work &) { ++sunk; }),
+                        "stage failed");
+    REQUIRE(sunk <= 5);
+    // Backpressure stopped the feeder long before the end
+    REQUIRE(processed.load() < 10000);
+}
+
+TEST_CASE("A sink failure stops the stages and is rethrown",
+          "[batch_pipeline]") {
+    BatchPipeline<Work> pipeline({{[](Work &) {}, 2}}, 1);
+    REQUIRE_THROWS_AS(pipeline.run(makeWork(10000),
+                                   [](Work &work) {
+                                       if (work.id == 3) {
+                                           throw std::logic_error("sink");
+                                       }
+                                   }),
+                      std::logic_error);
+}
@@ -0,0 +1,95 @@
+#include "common/utils/BoundedQueue.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using crescent::common::BoundedQueue;
+
+TEST_CASE("Items come out in push order", "[bounded_queue]") {
+    BoundedQueue<std::unique_ptr<int>> queue(4);
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(queue.push(std::make_unique<int>(i)));
+    }
+    for (int i = 0; i < 4; ++i) {
+        REQUIRE(**queue.pop() == i);
+    }
+}
+
+TEST_CASE("Closing drains then ends consumers", "[bounded_queue]") {
+    BoundedQueue<int> queue(4);
+    REQUIRE(queue.push(1));
+    queue.close();
+    REQUIRE(queue.isClosed());
+    REQUIRE_FALSE(queue.push(2));
+    REQUIRE(queue.pop() == 1);
+    REQUIRE_FALSE(queue.pop());
+}
+
+TEST_CASE("A full queue blocks producers until space frees",
+          "[bounded_queue]") {
+    BoundedQueue<int> queue(2);
+    REQUIRE(queue.push(0));
+    REQUIRE(queue.push(1));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&] { pushed = queue.push(2); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE_FALSE(pushed);
+
+    REQUIRE(queue.pop() == 0);
+    producer.join();
+    REQUIRE(pushed);
+    REQUIRE(queue.pop() == 1);
+    REQUIRE(queue.pop() == 2);
+}
+
+TEST_CASE("Close wakes a blocked producer", "[bounded_queue]") {
+    BoundedQueue<int> queue(1);
+    REQUIRE(queue.push(0));
+    std::atomic<bool> result{true};
+    std::thread producer([&] { result = queue.push(1); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.close();
+    producer.join();
+    REQUIRE_FALSE(result);
+}
+
+TEST_CASE("Producers and consumers pass every item once",
+          "[bounded_queue]") {
+    constexpr int PER_PRODUCER = 5000;
+    BoundedQueue<int> queue(8);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 3; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                queue.push(p * PER_PRODUCER + i);
+            }
+        });
+    }
+    std::atomic<long> sum{0};
+    std::atomic<int> count{0};
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < 2; ++c) {
+        consumers.emplace_back([&] {
+            while (auto value = queue.pop()) {
+                sum += *value;
+                ++count;
+            }
+        });
+    }
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+    queue.close();
+    for (std::thread &consumer : consumers) {
+        consumer.join();
+    }
+    const long n = 3 * PER_PRODUCER;
+    REQUIRE(count == n);
+    REQUIRE(sum == n * (n - 1) / 2);
+}
@@ -0,0 +1,177 @@
+#include "common/utils/CommandExecutor.h"
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using crescent::common::BasicCommandExecutor;
+using crescent::common::ShardedSlotMap;
+using crescent::common::SlotHandle;
+
+namespace {
+
+// Commands append (producer, sequence) so ordering can be checked afterwards
+struct Journal {
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> entries;
+};
+
+using Store = ShardedSlotMap<Journal>;
+using Executor = BasicCommandExecutor<Journal, Store>;
+
+std::vector<SlotHandle> addJournals(Store &store, std::size_t count) {
+    std::vector<SlotHandle> handles;
+    for (std::size_t i = 0; i < count; ++i) {
+        handles.push_back(store.insert(std::make_unique<Journal>(), i));
+    }
+    return handles;
+}
+
+std::vector<std::pair<std::uint32_t, std::uint32_t>>
+entriesOf(const Store &store, SlotHandle handle) {
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> entries;
+    store.read(handle, [&entries](const Journal &journal, std::uint64_t) {
+        entries = journal.entries;
+    });
+    return entries;
+}
+
+} // namespace
+
+TEST_CASE("Commands for one entry run in submission order",
+          "[command-executor]") {
+    Store store;
+    const std::vector<SlotHandle> handles = addJournals(store, 8);
+    Executor executor(store, {4, 16});
+    executor.start();
+
+    constexpr std::uint32_t PRODUCERS = 4;
+    constexpr std::uint32_t PER_ENTRY = 500;
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&executor, &handles, p] {
+            std::vector<Executor::MailboxRef> mailboxes;
+            for (const SlotHandle handle : handles) {
+                mailboxes.push_back(executor.getMailbox(handle));
+            }
+            for (std::uint32_t i = 0; i < PER_ENTRY; ++i) {
+                for (const Executor::MailboxRef &mailbox : mailboxes) {
+                    executor.submit(mailbox, [p, i](Journal &journal) {
+                        journal.entries.emplace_back(p, i);
+                    });
+                }
+            }
+        });
+    }
+    for (std::thread &producer : producers) {
+        producer.join();
+    }
+    executor.stop();
+
+    for (const SlotHandle handle : handles) {
+        const auto entries = entriesOf(store, handle);
+        REQUIRE(entries.size() == PRODUCERS * PER_ENTRY);
+        std::vector<std::uint32_t> next(PRODUCERS, 0);
+        for (const auto &[producer, sequence] : entries) {
+            REQUIRE(sequence == next[producer]);
+            ++next[producer];
+        }
+    }
+    const Executor::ExecutorMetrics metrics = executor.getMetrics();
+    REQUIRE(metrics.commandsExecuted == 8 * PRODUCERS * PER_ENTRY);
+    REQUIRE(metrics.commandsDropped == 0);
+    REQUIRE(metrics.averageBatchSize <= 16.0f);
+}
+
+TEST_CASE("Futures carry results and exceptions", "[command-executor]") {
+    Store store;
+    const SlotHandle handle = addJournals(store, 1).front();
+    Executor executor(store, {2, 8});
+    executor.start();
+
+    std::future<std::size_t> size = executor.submit(handle, [](Journal &j) {
+        j.entries.emplace_back(0, 0);
+        return j.entries.size();
+    });
+    std::future<void> failed = executor.submit(
+        handle, [](Journal &) { throw std::runtime_error("rejected"); });
+    std::future<std::size_t> after = executor.submit(
+        handle, [](Journal &j) { return j.entries.size(); });
+
+    REQUIRE(size.get() == 1);
+    REQUIRE_THROWS_AS(failed.get(), std::runtime_error);
+    // A throwing command does not stop the rest of its batch
+    REQUIRE(after.get() == 1);
+}
+
+TEST_CASE("Stop drains every outstanding command", "[command-executor]") {
+    Store store;
+    const std::vector<SlotHandle> handles = addJournals(store, 4);
+    Executor executor(store, {2, 4});
+
+    // Queued before start: they wait, then run in batches of at most 4
+    std::vector<std::future<void>> early;
+    for (std::uint32_t i = 0; i < 10; ++i) {
+        early.push_back(executor.submit(handles[0], [i](Journal &journal) {
+            journal.entries.emplace_back(0, i);
+        }));
+    }
+    REQUIRE(early.front().wait_for(std::chrono::milliseconds(0)) ==
+            std::future_status::timeout);
+    executor.start();
+
+    std::vector<std::future<void>> pending;
+    for (std::uint32_t i = 0; i < 20000; ++i) {
+        pending.push_back(executor.submit(
+            handles[i % handles.size()], [i](Journal &journal) {
+                std::this_thread::yield();
+                journal.entries.emplace_back(1, i);
+            }));
+    }
+    executor.stop();
+
+    for (std::future<void> &future : early) {
+        REQUIRE(future.wait_for(std::chrono::milliseconds(0)) ==
+                std::future_status::ready);
+    }
+    for (std::future<void> &future : pending) {
+        REQUIRE(future.wait_for(std::chrono::milliseconds(0)) ==
+                std::future_status::ready);
+    }
+    std::size_t total = 0;
+    for (const SlotHandle handle : handles) {
+        total += entriesOf(store, handle).size();
+    }
+    REQUIRE(total == 20010);
+    REQUIRE(executor.getMetrics().commandsExecuted == 20010);
+
+    // Stopped again: new commands wait for the next start
+    std::future<void> later = executor.submit(handles[1], [](Journal &) {});
+    REQUIRE(later.wait_for(std::chrono::milliseconds(0)) ==
+            std::future_status::timeout);
+    executor.start();
+    later.get();
+}
+
+TEST_CASE("Commands for a removed entry are dropped", "[command-executor]") {
+    Store store;
+    const SlotHandle handle = addJournals(store, 1).front();
+    Executor executor(store, {1, 8});
+
+    std::future<void> queued = executor.submit(handle, [](Journal &) {});
+    REQUIRE(store.erase(handle) != nullptr);
+    executor.dropMailbox(handle);
+    executor.start();
+    executor.stop();
+
+    REQUIRE_THROWS_AS(queued.get(), std::future_error);
+    REQUIRE(executor.getMetrics().commandsDropped == 1);
+    REQUIRE(executor.getMetrics().commandsExecuted == 0);
+}
@@ -0,0 +1,209 @@
+#include "common/metrics/TraceSpan.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using crescent::metrics::LatencyHistogram;
+using crescent::metrics::MetricsRegistry;
+using crescent::metrics::Operation;
+using crescent::metrics::TraceEvent;
+using crescent::metrics::TraceRecorder;
+
+TEST_CASE("Small latencies are counted exactly", "[metrics]") {
+    for (std::uint64_t value = 0; value < LatencyHistogram::SUB_BUCKET_COUNT;
+         ++value) {
+        const std::size_t index = LatencyHistogram::bucketIndex(value);
+        REQUIRE(LatencyHistogram::bucketUpperBound(index) == value);
+    }
+}
+
+TEST_CASE("Bucket bounds contain their values within 3%", "[metrics]") {
+    std::size_t previous = 0;
+    for (std::uint64_t value = 1; value < (std::uint64_t{1} << 40);
+         value = value * 3 / 2 + 1) {
+        const std::size_t index = LatencyHistogram::bucketIndex(value);
+        REQUIRE(index >= previous);
+        previous = index;
+        const std::uint64_t bound = LatencyHistogram::bucketUpperBound(index);
+        REQUIRE(bound >= value);
+        REQUIRE(static_cast<double>(bound - value) <=
+                0.032 * static_cast<double>(value));
+    }
+}
+
+TEST_CASE("Values past the range saturate into the last bucket",
+          "[metrics]") {
+    REQUIRE(LatencyHistogram::bucketIndex(UINT64_MAX) ==
+            LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST_CASE("Percentiles follow the recorded distribution", "[metrics]") {
+    LatencyHistogram histogram;
+    for (std::uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value * 1000);
+    }
+    LatencyHistogram::Snapshot snapshot;
+    histogram.mergeInto(snapshot);
+    const auto summary = snapshot.summarize();
+
+    REQUIRE(summary.count == 10000);
+    REQUIRE(summary.min == 1000);
+    REQUIRE(summary.max == 10000000);
+    REQUIRE(summary.mean == Approx(5000500.0));
+    REQUIRE(summary.p50 == Approx(5000000.0).epsilon(0.035));
+    REQUIRE(summary.p99 == Approx(9900000.0).epsilon(0.035));
+    REQUIRE(summary.p999 <= summary.max);
+}
+
+TEST_CASE("The registry merges samples from every thread", "[metrics]") {
+    MetricsRegistry &registry = MetricsRegistry::instance();
+    const std::uint64_t before =
+        registry.snapshot(Operation::ProcessSynthesis).count;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&registry] {
+            for (int i = 0; i < 1000; ++i) {
+                registry.record(Operation::ProcessSynthesis, 500);
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(registry.snapshot(Operation::ProcessSynthesis).count ==
+            before + 4000);
+}
+
+TEST_CASE("Trace spans record latency and export Chrome trace JSON",
+          "[metrics]") {
+    const std::uint64_t before =
+        MetricsRegistry::instance().snapshot(Operation::UpdateTraits).count;
+    TraceRecorder::instance().enable();
+    {
+        CRESCENT_TRACE_SPAN(UpdateTraits);
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+    TraceRecorder::instance().disable();
+
+    const auto after =
+        MetricsRegistry::instance().snapshot(Operation::UpdateTraits);
+    REQUIRE(after.count == before + 1);
+    REQUIRE(after.max >= 50000);
+
+    const std::string path = "metrics_test_trace.json";
+    REQUIRE(TraceRecorder::instance().writeChromeTrace(path));
+    std::ifstream in(path);
+    const nlohmann::json trace = nlohmann::json::parse(in);
+    bool found = false;
+    for (const auto &event : trace.at("traceEvents")) {
+        if (event.at("name") == "updateTraits") {
+            REQUIRE(event.at("ph") == "X");
+            REQUIRE(event.at("dur").get<double>() >= 50.0);
+            found = true;
+        }
+    }
+    REQUIRE(found);
+    std::remove(path.c_str());
+}
+
+namespace {
+
+// Spans from these tests carry a marker in the high bits of their start
+// time so they can be told apart from other tests' spans
+constexpr std::uint64_t RING_TEST_MARK = std::uint64_t{0xC0FFEE} << 40;
+
+std::map<std::size_t, std::vector<std::uint64_t>>
+markedSpans(std::uint64_t mark) {
+    std::map<std::size_t, std::vector<std::uint64_t>> spans;
+    TraceRecorder::instance().forEachEvent(
+        [&](std::size_t thread, const TraceEvent &event) {
+            if ((event.startNanos & ~((std::uint64_t{1} << 40) - 1)) ==
+                mark) {
+                spans[thread].push_back(event.startNanos - mark);
+            }
+        });
+    return spans;
+}
+
+} // namespace
+
+TEST_CASE("Spans drained while threads record arrive once and in order",
+          "[metrics]") {
+    TraceRecorder &recorder = TraceRecorder::instance();
+    const std::uint64_t droppedBefore = recorder.droppedSpans();
+    constexpr std::uint64_t SPANS = 20000;
+
+    std::atomic<bool> recording{true};
+    std::thread collector([&] {
+        while (recording.load()) {
+            recorder.drain();
+        }
+    });
+    std::vector<std::thread> threads;
+    for (std::uint64_t t = 0; t < 4; ++t) {
+        threads.emplace_back([&recorder, t] {
+            for (std::uint64_t i = 0; i < SPANS; ++i) {
+                recorder.record({Operation::ManifestAbility,
+                                 RING_TEST_MARK | (t << 32) | i, 1});
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    recording.store(false);
+    collector.join();
+    recorder.drain();
+
+    // Rings are larger than each thread's output, so nothing was dropped
+    REQUIRE(recorder.droppedSpans() == droppedBefore);
+    const auto spans = markedSpans(RING_TEST_MARK);
+    REQUIRE(spans.size() == 4);
+    for (const auto &[thread, starts] : spans) {
+        INFO("thread " << thread);
+        REQUIRE(starts.size() == SPANS);
+        const std::uint64_t producer = starts.front() >> 32;
+        for (std::uint64_t i = 0; i < SPANS; ++i) {
+            REQUIRE(starts[i] == ((producer << 32) | i));
+        }
+    }
+}
+
+TEST_CASE("A full ring drops new spans until it is drained", "[metrics]") {
+    TraceRecorder &recorder = TraceRecorder::instance();
+    recorder.drain();
+    const std::uint64_t droppedBefore = recorder.droppedSpans();
+    constexpr std::uint64_t CAPACITY = TraceRecorder::DEFAULT_EVENTS_PER_THREAD;
+    constexpr std::uint64_t MARK = std::uint64_t{0xC0FFEF} << 40;
+
+    std::thread([&recorder] {
+        for (std::uint64_t i = 0; i < CAPACITY + 100; ++i) {
+            recorder.record({Operation::ManifestAbility, MARK | i, 1});
+        }
+        recorder.drain();
+        recorder.record(
+            {Operation::ManifestAbility, MARK | (CAPACITY + 100), 1});
+    }).join();
+    recorder.drain();
+
+    REQUIRE(recorder.droppedSpans() == droppedBefore + 100);
+    const auto spans = markedSpans(MARK);
+    REQUIRE(spans.size() == 1);
+    // The collector keeps the newest spans; the oldest drained one is gone
+    const std::vector<std::uint64_t> &starts = spans.begin()->second;
+    REQUIRE(starts.size() == CAPACITY);
+    REQUIRE(starts.front() == 1);
+    REQUIRE(starts[CAPACITY - 2] == CAPACITY - 1);
+    REQUIRE(starts.back() == CAPACITY + 100);
+}
@@ -0,0 +1,155 @@
+#include "common/utils/PersistentVector.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using crescent::common::PersistentVector;
+
+namespace {
+
+template <typename T>
+void requireEqual(const PersistentVector<T> &actual,
+                  const std::vector<T> &expected) {
+    REQUIRE(actual.size() == expected.size());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        REQUIRE(actual[i] == expected[i]);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Appends and pops cross leaf and level boundaries",
+          "[persistent_vector]") {
+    PersistentVector<int> vector;
+    std::vector<int> expected;
+    for (int i = 0; i < 1100; ++i) {
+        vector = vector.push_back(i);
+        expected.push_back(i);
+    }
+    requireEqual(vector, expected);
+    REQUIRE(vector.back() == 1099);
+    REQUIRE_THROWS_AS(vector.at(1100), std::out_of_range);
+
+    while (!expected.empty()) {
+        vector = vector.pop_back();
+        expected.pop_back();
+        if (expected.size() % 31 == 0) {
+            requireEqual(vector, expected);
+        }
+    }
+    REQUIRE(vector.empty());
+    REQUIRE_THROWS_AS(vector.pop_back(), std::out_of_range);
+}
+
+TEST_CASE("Old versions are unchanged by later updates",
+          "[persistent_vector]") {
+    std::vector<PersistentVector<int>> versions(1);
+    std::vector<std::vector<int>> expected(1);
+    std::mt19937 rng(11);
+    for (int step = 0; step < 3000; ++step) {
+        const std::size_t from = rng() % versions.size();
+        PersistentVector<int> next = versions[from];
+        std::vector<int> model = expected[from];
+        const unsigned op = rng() % 4;
+        if (op == 0 && !model.empty()) {
+            next = next.pop_back();
+            model.pop_back();
+        } else if (op == 1 && !model.empty()) {
+            const std::size_t index = rng() % model.size();
+            next = next.set(index, step);
+            model[index] = step;
+        } else {
+            next = next.push_back(step);
+            model.push_back(step);
+        }
+        versions.push_back(std::move(next));
+        expected.push_back(std::move(model));
+    }
+    for (std::size_t i = 0; i < versions.size(); ++i) {
+        requireEqual(versions[i], expected[i]);
+    }
+}
+
+TEST_CASE("Appending to an older version does not disturb a newer one",
+          "[persistent_vector]") {
+    PersistentVector<int> base;
+    for (int i = 0; i < 40; ++i) {
+        base = base.push_back(i);
+    }
+    const PersistentVector<int> first = base.push_back(100);
+    const PersistentVector<int> second = base.push_back(200);
+    REQUIRE(first.back() == 100);
+    REQUIRE(second.back() == 200);
+    REQUIRE(base.size() == 40);
+    REQUIRE_FALSE(first.sharesRootWith(second));
+
+    const PersistentVector<int> popped = first.pop_back().push_back(300);
+    REQUIRE(first.back() == 100);
+    REQUIRE(popped.back() == 300);
+}
+
+TEST_CASE("keepLast and toVector keep order", "[persistent_vector]") {
+    PersistentVector<int> vector;
+    for (int i = 0; i < 100; ++i) {
+        vector = vector.push_back(i);
+    }
+    const std::vector<int> last = vector.keepLast(10).toVector();
+    REQUIRE(last.size() == 10);
+    REQUIRE(last.front() == 90);
+    REQUIRE(last.back() == 99);
+    REQUIRE(vector.keepLast(200).sharesRootWith(vector));
+}
+
+TEST_CASE("Every element is destroyed exactly once", "[persistent_vector]") {
+    const auto token = std::make_shared<int>(0);
+    {
+        PersistentVector<std::shared_ptr<int>> vector;
+        std::vector<PersistentVector<std::shared_ptr<int>>> kept;
+        for (int i = 0; i < 200; ++i) {
+            vector = vector.push_back(token);
+            if (i % 7 == 0) {
+                kept.push_back(vector.pop_back());
+            }
+        }
+        REQUIRE(token.use_count() > 200);
+    }
+    REQUIRE(token.use_count() == 1);
+}
+
+TEST_CASE("Threads may append to a shared version at once",
+          "[persistent_vector]") {
+    PersistentVector<int> base;
+    for (int i = 0; i < 5; ++i) {
+        base = base.push_back(i);
+    }
+    std::vector<PersistentVector<int>> results(4);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&base, &results, t] {
+            PersistentVector<int> mine = base;
+            for (int i = 0; i < 500; ++i) {
+                mine = mine.push_back(t * 1000 + i);
+            }
+            results[static_cast<std::size_t>(t)] = mine;
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (int t = 0; t < 4; ++t) {
+        const auto &result = results[static_cast<std::size_t>(t)];
+        REQUIRE(result.size() == 505);
+        for (int i = 0; i < 5; ++i) {
+            REQUIRE(result[static_cast<std::size_t>(i)] == i);
+        }
+        for (int i = 0; i < 500; ++i) {
+            REQUIRE(result[static_cast<std::size_t>(5 + i)] == t * 1000 + i);
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#include "common/utils/SeededRandom.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <vector>
+
+using crescent::common::deriveSeed;
+using crescent::common::SeededRandom;
+
+TEST_CASE("Equal seeds give equal sequences", "[random]") {
+    SeededRandom first(42);
+    SeededRandom second(42);
+    SeededRandom other(43);
+    bool differs = false;
+    for (int i = 0; i < 1000; ++i) {
+        const std::uint64_t value = first();
+        REQUIRE(value == second());
+        differs = differs || value != other();
+    }
+    REQUIRE(differs);
+}
+
+TEST_CASE("Derived seeds depend on every coordinate", "[random]") {
+    std::set<std::uint64_t> seeds;
+    for (std::uint64_t stream = 0; stream < 16; ++stream) {
+        for (std::uint64_t ordinal = 0; ordinal < 64; ++ordinal) {
+            seeds.insert(deriveSeed(7, stream, ordinal));
+        }
+    }
+    REQUIRE(seeds.size() == 16 * 64);
+    REQUIRE(deriveSeed(7, 1, 2) == deriveSeed(7, 1, 2));
+    REQUIRE(deriveSeed(7, 1, 2) != deriveSeed(8, 1, 2));
+    REQUIRE(deriveSeed(7, 1, 2) != deriveSeed(7, 2, 1));
+}
+
+TEST_CASE("Bounded draws stay in range and cover it", "[random]") {
+    SeededRandom random(1);
+    std::vector<int> hits(7, 0);
+    for (int i = 0; i < 7000; ++i) {
+        const std::size_t index = random.pickIndex(hits.size());
+        REQUIRE(index < hits.size());
+        ++hits[index];
+    }
+    for (int count : hits) {
+        REQUIRE(count > 800);
+        REQUIRE(count < 1200);
+    }
+    REQUIRE(random.below(0) == 0);
+    REQUIRE(random.below(1) == 0);
+}
+
+TEST_CASE("Integer draws include both ends", "[random]") {
+    SeededRandom random(2);
+    bool sawMin = false;
+    bool sawMax = false;
+    for (int i = 0; i < 1000; ++i) {
+        const int value = random.uniformInt(-3, 3);
+        REQUIRE(value >= -3);
+        REQUIRE(value <= 3);
+        sawMin = sawMin || value == -3;
+        sawMax = sawMax || value == 3;
+    }
+    REQUIRE(sawMin);
+    REQUIRE(sawMax);
+}
+
+TEST_CASE("Float draws are half-open", "[random]") {
+    SeededRandom random(3);
+    for (int i = 0; i < 10000; ++i) {
+        const float value = random.uniformFloat(-1.0f, 1.0f);
+        REQUIRE(value >= -1.0f);
+        REQUIRE(value < 1.0f);
+    }
+    // A range narrower than the float step would round onto max
+    const float tight = random.uniformFloat(1.0f, 1.0000001f);
+    REQUIRE(tight < 1.0000001f);
+    REQUIRE_FALSE(random.chance(0.0f));
+    REQUIRE(random.chance(1.0f));
+}
@@ -0,0 +1,131 @@
+#include "common/utils/ShardedSlotMap.h"
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using crescent::common::ShardedSlotMap;
+using crescent::common::SlotHandle;
+
+TEST_CASE("Default handles never resolve", "[slot-map]") {
+    ShardedSlotMap<int, 2> map;
+    const SlotHandle first = map.insert(std::make_unique<int>(1), 0);
+
+    REQUIRE(first.index == 0);
+    REQUIRE(first.isSet());
+    REQUIRE(first.pack() != 0);
+    REQUIRE_FALSE(SlotHandle{}.isSet());
+    REQUIRE_FALSE(map.contains(SlotHandle{}));
+    REQUIRE_FALSE(map.contains(SlotHandle::unpack(0)));
+}
+
+TEST_CASE("Reads, writes and versions", "[slot-map]") {
+    ShardedSlotMap<int, 2> map;
+    const SlotHandle handle = map.insert(std::make_unique<int>(5), 3);
+    const std::uint64_t inserted = *map.version(handle);
+
+    REQUIRE(map.write(handle, [](int &value) { value = 7; }));
+    REQUIRE(*map.version(handle) == inserted + 1);
+
+    int seen = 0;
+    std::uint64_t seenVersion = 0;
+    REQUIRE(map.read(handle, [&](const int &value, std::uint64_t version) {
+        seen = value;
+        seenVersion = version;
+    }));
+    REQUIRE(seen == 7);
+    REQUIRE(seenVersion == inserted + 1);
+}
+
+TEST_CASE("Erased slots are reused under a new generation", "[slot-map]") {
+    ShardedSlotMap<int, 2> map;
+    const SlotHandle old = map.insert(std::make_unique<int>(1), 1);
+    REQUIRE(*map.erase(old) == 1);
+    REQUIRE(map.erase(old) == nullptr);
+
+    const SlotHandle reused = map.insert(std::make_unique<int>(2), 1);
+    REQUIRE(reused.index == old.index);
+    REQUIRE(reused.generation != old.generation);
+    REQUIRE(reused.isSet());
+    REQUIRE_FALSE(map.contains(old));
+    REQUIRE_FALSE(map.write(old, [](int &) { FAIL("stale write ran"); }));
+    REQUIRE(map.size() == 1);
+}
+
+TEST_CASE("A throwing write releases the entry", "[slot-map]") {
+    ShardedSlotMap<int, 2> map;
+    const SlotHandle handle = map.insert(std::make_unique<int>(1), 0);
+
+    REQUIRE_THROWS(map.write(handle, [](int &) { throw 1; }));
+    REQUIRE(map.write(handle, [](int &value) { value = 2; }));
+}
+
+TEST_CASE("Callbacks may read other entries", "[slot-map]") {
+    ShardedSlotMap<int, 2> map;
+    const SlotHandle a = map.insert(std::make_unique<int>(1), 0);
+    const SlotHandle b = map.insert(std::make_unique<int>(2), 0);
+
+    int sum = 0;
+    map.read(a, [&](const int &outer, std::uint64_t) {
+        map.read(b, [&](const int &inner, std::uint64_t) {
+            sum = outer + inner;
+        });
+    });
+    REQUIRE(sum == 3);
+}
+
+TEST_CASE("Concurrent inserts, writes and shard walks", "[slot-map]") {
+    ShardedSlotMap<std::uint64_t, 2> map;
+    constexpr int THREADS = 4;
+    constexpr int PER_THREAD = 2000;
+
+    std::vector<std::vector<SlotHandle>> handles(THREADS);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t) {
+        threads.emplace_back([&map, &handles, t] {
+            for (int i = 0; i < PER_THREAD; ++i) {
+                const SlotHandle handle = map.insert(
+                    std::make_unique<std::uint64_t>(0),
+                    static_cast<std::size_t>(i));
+                map.write(handle, [](std::uint64_t &value) { ++value; });
+                handles[static_cast<std::size_t>(t)].push_back(handle);
+            }
+        });
+    }
+    std::atomic<bool> done{false};
+    std::thread walker([&map, &done] {
+        while (!done.load()) {
+            for (std::size_t s = 0; s < map.shardCount(); ++s) {
+                map.forEachInShard(s, [](SlotHandle, const std::uint64_t &) {});
+            }
+        }
+    });
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    done = true;
+    walker.join();
+
+    REQUIRE(map.size() == THREADS * PER_THREAD);
+    std::set<std::uint64_t> packed;
+    std::uint64_t total = 0;
+    for (std::size_t s = 0; s < map.shardCount(); ++s) {
+        map.forEachInShard(s, [&](SlotHandle handle,
+                                  const std::uint64_t &value) {
+            packed.insert(handle.pack());
+            total += value;
+        });
+    }
+    REQUIRE(packed.size() == THREADS * PER_THREAD);
+    REQUIRE(total == THREADS * PER_THREAD);
+    for (const auto &list : handles) {
+        for (const SlotHandle handle : list) {
+            REQUIRE(packed.count(handle.pack()) == 1);
+        }
+    }
+}
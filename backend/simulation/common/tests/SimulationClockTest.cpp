@@ -0,0 +1,62 @@
+#include "common/utils/SimulationClock.h"
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+using crescent::common::ClockRecord;
+using crescent::common::SimTick;
+using crescent::common::SimulationClock;
+
+TEST_CASE("Tick order holds across wraparound", "[clock]") {
+    const SimTick beforeWrap{UINT32_MAX - 5};
+    const SimTick afterWrap{4};
+    REQUIRE(beforeWrap < afterWrap);
+    REQUIRE(afterWrap > beforeWrap);
+    REQUIRE(beforeWrap <= afterWrap);
+    REQUIRE_FALSE(afterWrap < beforeWrap);
+    REQUIRE(afterWrap.ticksSince(beforeWrap) == 10);
+    REQUIRE(SimTick::difference(beforeWrap, afterWrap) == -10);
+
+    REQUIRE(SimTick{3} < SimTick{7});
+    REQUIRE(SimTick{7} >= SimTick{7});
+    REQUIRE_FALSE(SimTick{7} < SimTick{7});
+}
+
+TEST_CASE("A clock rebuilt from its record matches the original",
+          "[clock]") {
+    using namespace std::chrono;
+    SimulationClock::Config config;
+    config.tickLength = microseconds(250000);
+    config.epoch = SimulationClock::WallClock::time_point(
+        duration_cast<SimulationClock::WallClock::duration>(
+            microseconds(1700000000123456)));
+    SimulationClock original(config);
+    original.advance(42);
+
+    const ClockRecord record = original.record();
+    REQUIRE(record.tickLengthMicros == 250000);
+    REQUIRE(record.epochMicros == 1700000000123456);
+    REQUIRE(record.tick == SimTick{42});
+
+    const SimulationClock restored(record);
+    REQUIRE(restored.now() == original.now());
+    REQUIRE(restored.tickLength() == original.tickLength());
+    REQUIRE(restored.epoch() == original.epoch());
+    REQUIRE(restored.toWallTime(SimTick{1000}) ==
+            original.toWallTime(SimTick{1000}));
+}
+
+TEST_CASE("Wall time conversion clamps outside the tick range", "[clock]") {
+    using namespace std::chrono;
+    SimulationClock::Config config;
+    config.epoch = SimulationClock::WallClock::time_point(hours(1000));
+    const SimulationClock clock(config);
+
+    REQUIRE(clock.fromWallTime(clock.toWallTime(SimTick{1234})) ==
+            SimTick{1234});
+    REQUIRE(clock.fromWallTime(config.epoch - hours(1)) == SimTick{0});
+    REQUIRE(clock.fromWallTime(config.epoch + hours(24 * 365 * 20)) ==
+            SimTick{UINT32_MAX});
+}
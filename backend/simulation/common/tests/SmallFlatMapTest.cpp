@@ -0,0 +1,133 @@
+#include "common/utils/SmallFlatMap.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using crescent::common::SmallFlatMap;
+
+namespace {
+
+// Every key in a run of eight shares a home slot, to exercise probing
+struct CollidingHash {
+    std::size_t operator()(int key) const {
+        return static_cast<std::size_t>(key / 8);
+    }
+};
+
+using IntMap = SmallFlatMap<int, int, 4>;
+using CollidingMap = SmallFlatMap<int, int, 4, CollidingHash>;
+
+template <typename Map>
+std::vector<std::pair<int, int>> sorted(const Map &map) {
+    std::vector<std::pair<int, int>> entries(map.begin(), map.end());
+    std::sort(entries.begin(), entries.end());
+    return entries;
+}
+
+} // namespace
+
+// Inline array and spilled table share storage
+static_assert(sizeof(IntMap) <=
+              std::max(sizeof(std::array<std::pair<int, int>, 4>),
+                       sizeof(std::vector<std::pair<int, int>>)) +
+                  2 * sizeof(std::size_t));
+
+TEST_CASE("SmallFlatMap stays inline up to its capacity", "[small-flat-map]") {
+    IntMap map;
+    for (int key = 0; key < 4; ++key) {
+        map[key] = key * 10;
+    }
+
+    REQUIRE(map.isInline());
+    REQUIRE(map.heapBytes() == 0);
+    REQUIRE(map.size() == 4);
+    REQUIRE(map.at(3) == 30);
+    REQUIRE(map.count(7) == 0);
+}
+
+TEST_CASE("SmallFlatMap spills and keeps every entry", "[small-flat-map]") {
+    IntMap map;
+    for (int key = 0; key < 100; ++key) {
+        map.insert_or_assign(key, key + 1);
+    }
+
+    REQUIRE_FALSE(map.isInline());
+    REQUIRE(map.heapBytes() > 0);
+    REQUIRE(map.size() == 100);
+    for (int key = 0; key < 100; ++key) {
+        REQUIRE(map.find(key)->second == key + 1);
+    }
+    REQUIRE_THROWS_AS(map.at(100), std::out_of_range);
+
+    map.clear();
+    REQUIRE(map.isInline());
+    REQUIRE(map.empty());
+    REQUIRE(map.heapBytes() == 0);
+}
+
+TEST_CASE("SmallFlatMap matches unordered_map under random edits",
+          "[small-flat-map]") {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> keys(0, 63);
+    CollidingMap map;
+    std::unordered_map<int, int> reference;
+
+    for (int step = 0; step < 5000; ++step) {
+        const int key = keys(random);
+        if (random() % 3 == 0) {
+            REQUIRE(map.erase(key) == reference.erase(key));
+        } else {
+            map[key] = step;
+            reference[key] = step;
+        }
+        REQUIRE(map.size() == reference.size());
+    }
+
+    std::vector<std::pair<int, int>> expected(reference.begin(),
+                                              reference.end());
+    std::sort(expected.begin(), expected.end());
+    REQUIRE(sorted(map) == expected);
+}
+
+TEST_CASE("SmallFlatMap copies and moves in both modes", "[small-flat-map]") {
+    IntMap small{{1, 1}, {2, 2}};
+    IntMap large;
+    for (int key = 0; key < 20; ++key) {
+        large[key] = key;
+    }
+
+    IntMap smallCopy = small;
+    IntMap largeCopy = large;
+    smallCopy[1] = 5;
+    largeCopy[1] = 5;
+    REQUIRE(small.at(1) == 1);
+    REQUIRE(large.at(1) == 1);
+
+    IntMap moved = std::move(largeCopy);
+    REQUIRE(moved.size() == 20);
+    REQUIRE(moved.at(1) == 5);
+
+    moved = small;
+    REQUIRE(moved.isInline());
+    REQUIRE(sorted(moved) == sorted(small));
+}
+
+TEST_CASE("SmallFlatMap works with string keys", "[small-flat-map]") {
+    SmallFlatMap<std::string, float, 2> map;
+    map["heat"] = 0.5f;
+    map["cold"] = 0.25f;
+    map["toxin"] = 1.0f;
+
+    REQUIRE_FALSE(map.isInline());
+    REQUIRE(map.erase("cold") == 1);
+    REQUIRE(map.at("heat") == 0.5f);
+    REQUIRE(map.count("cold") == 0);
+}
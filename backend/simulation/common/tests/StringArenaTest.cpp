@@ -0,0 +1,143 @@
+#include "common/utils/StringArena.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using crescent::common::StringArena;
+using crescent::common::StringInterner;
+using crescent::common::UniqueStringSet;
+
+TEST_CASE("Arena views survive later chunks", "[string_arena]") {
+    StringArena arena(16);
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 100; ++i) {
+        views.push_back(arena[arena.append("name" + std::to_string(i))]);
+    }
+    REQUIRE(arena.size() == 100);
+    for (int i = 0; i < 100; ++i) {
+        REQUIRE(views[static_cast<std::size_t>(i)] ==
+                "name" + std::to_string(i));
+    }
+}
+
+TEST_CASE("A string longer than a chunk gets its own chunk",
+          "[string_arena]") {
+    StringArena arena(8);
+    const std::string text(40, 'x');
+    const StringArena::Id id = arena.append(text);
+    REQUIRE(arena[id] == text);
+    REQUIRE(arena.getMemoryFootprint() >= text.size());
+}
+
+TEST_CASE("Allocations written in place commit as one string",
+          "[string_arena]") {
+    StringArena arena(64);
+    char *out = arena.allocate(5);
+    std::memcpy(out, "hello", 5);
+    const StringArena::Id first = arena.commit();
+    const StringArena::Id second = arena.append("world");
+    REQUIRE(arena[first] == "hello");
+    REQUIRE(arena[second] == "world");
+}
+
+TEST_CASE("popBack reuses the dropped bytes", "[string_arena]") {
+    StringArena arena(64);
+    arena.append("keep");
+    const char *dropped = arena[arena.append("drop")].data();
+    arena.popBack();
+    REQUIRE(arena.size() == 1);
+    REQUIRE(arena[arena.append("next")].data() == dropped);
+}
+
+TEST_CASE("The unique set finds exactly what was inserted",
+          "[string_arena]") {
+    StringArena arena(256);
+    UniqueStringSet set(arena);
+    for (int i = 0; i < 1000; ++i) {
+        const std::string text = "creature " + std::to_string(i);
+        const StringArena::Id id = arena.append(text);
+        set.insert(id, UniqueStringSet::hash(text));
+    }
+    REQUIRE(set.size() == 1000);
+    for (int i = 0; i < 1000; ++i) {
+        const std::string text = "creature " + std::to_string(i);
+        const auto id = set.find(text, UniqueStringSet::hash(text));
+        REQUIRE(id);
+        REQUIRE(arena[*id] == text);
+    }
+    REQUIRE_FALSE(set.contains("creature 1000"));
+    REQUIRE_FALSE(set.contains(""));
+}
+
+TEST_CASE("Unique set erasure keeps colliding entries reachable",
+          "[string_arena]") {
+    StringArena arena(256);
+    UniqueStringSet set(arena);
+    std::vector<std::string> texts;
+    for (int i = 0; i < 200; ++i) {
+        texts.push_back("trait " + std::to_string(i));
+        set.insert(arena.append(texts.back()),
+                   UniqueStringSet::hash(texts.back()));
+    }
+    for (std::size_t i = 0; i < texts.size(); i += 3) {
+        set.erase(static_cast<StringArena::Id>(i),
+                  UniqueStringSet::hash(texts[i]));
+    }
+    for (std::size_t i = 0; i < texts.size(); ++i) {
+        REQUIRE(set.contains(texts[i]) == (i % 3 != 0));
+    }
+    REQUIRE(set.size() == 133);
+}
+
+TEST_CASE("The interner forgets strings whose references all drop",
+          "[string_arena]") {
+    StringInterner interner;
+    const StringInterner::Id fire = interner.intern("fire");
+    REQUIRE(interner.intern("fire") == fire);
+    const StringInterner::Id water = interner.intern("water");
+    REQUIRE(interner.size() == 2);
+
+    interner.release(fire);
+    REQUIRE(interner.find("fire") == fire); // One reference left
+    interner.release(fire);
+    REQUIRE_FALSE(interner.find("fire"));
+    REQUIRE(interner.size() == 1);
+
+    // The freed id is reused; other ids keep their strings
+    REQUIRE(interner.intern("earth") == fire);
+    REQUIRE(interner.str(fire) == "earth");
+    REQUIRE(interner.str(water) == "water");
+
+    const std::vector<StringInterner::Id> ids{water, water};
+    interner.retain(ids.begin(), ids.end());
+    interner.release(ids.begin(), ids.end());
+    REQUIRE(interner.find("water") == water);
+}
+
+TEST_CASE("The interner rebuilds its arena once dead bytes dominate",
+          "[string_arena]") {
+    StringInterner interner;
+    const StringInterner::Id kept = interner.intern("kept");
+    const std::size_t before = interner.getMemoryFootprint();
+
+    const std::string padding(1000, 'x');
+    for (int round = 0; round < 4; ++round) {
+        std::vector<StringInterner::Id> ids;
+        for (int i = 0; i < 100; ++i) {
+            ids.push_back(interner.intern(padding + std::to_string(round) +
+                                          "/" + std::to_string(i)));
+        }
+        interner.release(ids.begin(), ids.end());
+    }
+
+    REQUIRE(interner.size() == 1);
+    REQUIRE(interner.str(kept) == "kept");
+    REQUIRE(interner.find("kept") == kept);
+    // 400 KB of strings went through; at most one window of them remains
+    REQUIRE(interner.getMemoryFootprint() <
+            before + 2 * StringInterner::TRIM_BYTES);
+}
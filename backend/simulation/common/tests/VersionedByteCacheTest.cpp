@@ -0,0 +1,114 @@
+#include "common/utils/VersionedByteCache.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using crescent::common::BasicVersionedByteCache;
+using crescent::common::SerializedBytes;
+using crescent::common::VersionedByteCache;
+using crescent::common::VersionStamp;
+
+TEST_CASE("Stamps compare every component exactly", "[byte-cache]") {
+    REQUIRE(VersionStamp(3) == VersionStamp(3, 0));
+    REQUIRE(VersionStamp(1, 2) != VersionStamp(2, 1));
+    REQUIRE(VersionStamp(1, 2, 3, 4) != VersionStamp(1, 2, 3, 5));
+}
+
+TEST_CASE("Builds once per options key and stamp", "[byte-cache]") {
+    VersionedByteCache cache;
+    int builds = 0;
+    auto build = [&builds] {
+        ++builds;
+        return std::string("body") + std::to_string(builds);
+    };
+
+    const SerializedBytes first = cache.getOrBuild(1, {5, 7}, build);
+    const SerializedBytes again = cache.getOrBuild(1, {5, 7}, build);
+    REQUIRE(builds == 1);
+    REQUIRE(first == again);
+
+    // A component moving misses, even where a combined hash might collide
+    cache.getOrBuild(1, {5, 8}, build);
+    REQUIRE(builds == 2);
+    REQUIRE(cache.lookup(1, {5, 7}) == nullptr);
+
+    cache.getOrBuild(2, {5, 8}, build);
+    REQUIRE(builds == 3);
+    REQUIRE(*cache.lookup(1, {5, 8}) == "body2");
+    REQUIRE(*cache.lookup(2, {5, 8}) == "body3");
+}
+
+namespace {
+
+// Shaped like serialization options: a few flags and a small number
+struct Options {
+    bool pretty{false};
+    bool includeHistory{true};
+    std::uint32_t precision{6};
+
+    bool operator==(const Options &other) const {
+        return pretty == other.pretty &&
+               includeHistory == other.includeHistory &&
+               precision == other.precision;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Option sets share an entry only when equal", "[byte-cache]") {
+    BasicVersionedByteCache<Options> cache;
+    const Options compact;
+    Options verbose;
+    verbose.pretty = true;
+    verbose.precision = 3;
+
+    cache.getOrBuild(compact, 4, [] { return std::string("compact"); });
+    cache.getOrBuild(verbose, 4, [] { return std::string("verbose"); });
+    REQUIRE(*cache.lookup(compact, 4) == "compact");
+    REQUIRE(*cache.lookup(verbose, 4) == "verbose");
+
+    // One field apart is still a different key
+    Options almost = verbose;
+    almost.includeHistory = false;
+    REQUIRE(cache.lookup(almost, 4) == nullptr);
+    REQUIRE(*cache.lookup(Options{true, true, 3}, 4) == "verbose");
+}
+
+TEST_CASE("Held bytes outlive their replacement", "[byte-cache]") {
+    VersionedByteCache cache;
+    const SerializedBytes held =
+        cache.getOrBuild(1, 1, [] { return std::string("old"); });
+    cache.getOrBuild(1, 2, [] { return std::string("new"); });
+
+    REQUIRE(*held == "old");
+    REQUIRE(cache.retainedBytes() >= 3);
+    cache.clear();
+    REQUIRE(cache.lookup(1, 2) == nullptr);
+}
+
+TEST_CASE("Concurrent readers share one entry", "[byte-cache]") {
+    VersionedByteCache cache;
+    cache.getOrBuild(1, 9, [] { return std::string("shared"); });
+
+    std::vector<std::thread> readers;
+    std::vector<int> hits(4, 0);
+    for (std::size_t t = 0; t < hits.size(); ++t) {
+        readers.emplace_back([&cache, &hits, t] {
+            for (int i = 0; i < 1000; ++i) {
+                if (cache.lookup(1, 9)) {
+                    ++hits[t];
+                }
+            }
+        });
+    }
+    for (std::thread &reader : readers) {
+        reader.join();
+    }
+    for (const int count : hits) {
+        REQUIRE(count == 1000);
+    }
+}
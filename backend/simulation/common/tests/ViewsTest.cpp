@@ -0,0 +1,52 @@
+#include "common/utils/Views.h"
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using crescent::common::MapView;
+using crescent::common::Span;
+
+// Views must not bind to temporaries: they would dangle immediately
+static_assert(std::is_constructible_v<Span<const int>, std::vector<int> &>);
+static_assert(
+    std::is_constructible_v<Span<const int>, const std::vector<int> &>);
+static_assert(!std::is_constructible_v<Span<const int>, std::vector<int>>);
+static_assert(!std::is_constructible_v<Span<const int>, std::vector<int> &&>);
+static_assert(
+    !std::is_constructible_v<Span<const int>, const std::vector<int> &&>);
+
+using IntMap = std::map<std::string, int>;
+static_assert(std::is_constructible_v<MapView<IntMap>, const IntMap &>);
+static_assert(!std::is_constructible_v<MapView<IntMap>, IntMap>);
+static_assert(!std::is_constructible_v<MapView<IntMap>, IntMap &&>);
+
+TEST_CASE("Span views a vector without copying", "[views]") {
+    const std::vector<int> values{1, 2, 3, 4};
+    const Span<const int> view(values);
+
+    REQUIRE(view.size() == 4);
+    REQUIRE(view.data() == values.data());
+    REQUIRE(view[2] == 3);
+    REQUIRE(std::accumulate(view.begin(), view.end(), 0) == 10);
+}
+
+TEST_CASE("Default Span and MapView are empty", "[views]") {
+    REQUIRE(Span<const int>().empty());
+    REQUIRE(MapView<IntMap>().empty());
+    REQUIRE(MapView<IntMap>().size() == 0);
+}
+
+TEST_CASE("MapView reads through to its map", "[views]") {
+    IntMap map{{"a", 1}, {"b", 2}};
+    const MapView<IntMap> view(map);
+
+    REQUIRE(view.size() == 2);
+    REQUIRE(view.find("b")->second == 2);
+    map["c"] = 3;
+    REQUIRE(view.size() == 3);
+}
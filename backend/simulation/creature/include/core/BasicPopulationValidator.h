@@ -0,0 +1,310 @@
+#ifndef CREATURE_ENGINE_CORE_BASIC_POPULATION_VALIDATOR_H
+#define CREATURE_ENGINE_CORE_BASIC_POPULATION_VALIDATOR_H
+
+#include "common/utils/ShardedSlotMap.h"
+#include "creature_engine/core/ValidationCodes.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace crescent {
+
+/**
+ * @brief Violations found by one bulk pass, bucketed by registry shard
+ *
+ * Each shard buffer is written by exactly one worker, so the pass needs no
+ * synchronization beyond its start and end. reset() keeps every buffer's
+ * capacity; once a report has seen a tick's worth of violations, later
+ * passes run without allocating.
+ */
+template <std::size_t ShardCount> class BasicValidationReport {
+  public:
+    static constexpr std::size_t SHARD_COUNT = ShardCount;
+
+    struct alignas(64) ShardBuffer {
+        std::vector<Violation> violations;
+        std::size_t creaturesChecked{0};
+        std::size_t creaturesFailed{0};
+    };
+
+    BasicValidationReport() = default;
+    explicit BasicValidationReport(std::size_t reservePerShard) {
+        reserve(reservePerShard);
+    }
+
+    void reserve(std::size_t perShard) {
+        for (ShardBuffer &buffer : shards_) {
+            buffer.violations.reserve(perShard);
+        }
+    }
+
+    void reset() {
+        for (ShardBuffer &buffer : shards_) {
+            buffer.violations.clear();
+            buffer.creaturesChecked = 0;
+            buffer.creaturesFailed = 0;
+        }
+        elapsed_ = {};
+    }
+
+    // Writer side
+    ShardBuffer &shard(std::size_t index) { return shards_[index]; }
+    void setElapsed(std::chrono::nanoseconds elapsed) { elapsed_ = elapsed; }
+
+    // Results
+    std::size_t creaturesChecked() const {
+        return sum(&ShardBuffer::creaturesChecked);
+    }
+    std::size_t creaturesFailed() const {
+        return sum(&ShardBuffer::creaturesFailed);
+    }
+    std::size_t violationCount() const {
+        std::size_t total = 0;
+        for (const ShardBuffer &buffer : shards_) {
+            total += buffer.violations.size();
+        }
+        return total;
+    }
+    bool clean() const { return violationCount() == 0; }
+    std::chrono::nanoseconds elapsed() const { return elapsed_; }
+
+    std::array<std::size_t, VIOLATION_CODE_COUNT> countByCode() const {
+        std::array<std::size_t, VIOLATION_CODE_COUNT> counts{};
+        for (const ShardBuffer &buffer : shards_) {
+            for (const Violation &violation : buffer.violations) {
+                ++counts[static_cast<std::size_t>(violation.code)];
+            }
+        }
+        return counts;
+    }
+
+    /**
+     * @brief Visits violations as fn(SlotHandle, const Violation &)
+     *
+     * Every violation in a report comes from a registered creature, so the
+     * handle is always set.
+     */
+    template <typename Fn> void forEachViolation(Fn &&fn) const {
+        for (const ShardBuffer &buffer : shards_) {
+            for (const Violation &violation : buffer.violations) {
+                fn(common::SlotHandle::unpack(violation.subject), violation);
+            }
+        }
+    }
+
+  private:
+    std::array<ShardBuffer, SHARD_COUNT> shards_;
+    std::chrono::nanoseconds elapsed_{0};
+
+    std::size_t sum(std::size_t ShardBuffer::*field) const {
+        std::size_t total = 0;
+        for (const ShardBuffer &buffer : shards_) {
+            total += buffer.*field;
+        }
+        return total;
+    }
+};
+
+/**
+ * @brief Validates a whole registry in parallel
+ *
+ * Workers claim registry shards from a shared counter and run
+ * validateInto(ViolationSink &) on each entry under its read lock, writing
+ * into that shard's report buffer. Workers are started once and parked
+ * between passes, so a pass after every tick costs a wakeup per worker
+ * rather than thread creation; the thread calling run() claims shards too.
+ *
+ * Registry is CreatureRegistry or any store with its SHARD_COUNT, read()
+ * and forEachInShard(). One run() at a time.
+ */
+template <typename Registry> class BasicPopulationValidator {
+  public:
+    using Report = BasicValidationReport<Registry::SHARD_COUNT>;
+
+    struct Config {
+        std::size_t workerCount{0};              // 0 = hardware concurrency
+        std::size_t maxViolationsPerCreature{8}; // Checks stop at the limit
+    };
+
+    explicit BasicPopulationValidator(const Registry &registry)
+        : BasicPopulationValidator(registry, Config{}) {}
+
+    BasicPopulationValidator(const Registry &registry, Config config)
+        : registry_(registry), config_(config) {
+        std::size_t workerCount = config_.workerCount;
+        if (workerCount == 0) {
+            workerCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        workerCount = std::min(workerCount, Registry::SHARD_COUNT);
+        // The calling thread participates, so spawn one fewer
+        for (std::size_t i = 1; i < workerCount; ++i) {
+            workers_.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ~BasicPopulationValidator() {
+        {
+            std::lock_guard<std::mutex> lock(passMutex_);
+            stopping_ = true;
+        }
+        passStart_.notify_all();
+        for (std::thread &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    // Prevent copying and moving
+    BasicPopulationValidator(const BasicPopulationValidator &) = delete;
+    BasicPopulationValidator &
+    operator=(const BasicPopulationValidator &) = delete;
+    BasicPopulationValidator(BasicPopulationValidator &&) = delete;
+    BasicPopulationValidator &operator=(BasicPopulationValidator &&) = delete;
+
+    /**
+     * @brief Resets the report and validates every live creature into it
+     *
+     * Blocks until the pass completes. Creatures added or removed during the
+     * pass may or may not be included. Rethrows the first exception thrown
+     * by a check once every worker has finished.
+     */
+    void run(Report &report) {
+        const auto start = std::chrono::steady_clock::now();
+        report.reset();
+        {
+            std::lock_guard<std::mutex> lock(passMutex_);
+            currentReport_ = &report;
+            nextShard_.store(0, std::memory_order_relaxed);
+            workersBusy_ = workers_.size();
+            error_ = nullptr;
+            ++passNumber_;
+        }
+        passStart_.notify_all();
+
+        std::exception_ptr error;
+        try {
+            claimShards(report);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        {
+            std::unique_lock<std::mutex> lock(passMutex_);
+            passDone_.wait(lock, [this] { return workersBusy_ == 0; });
+            currentReport_ = nullptr;
+            if (!error) {
+                error = error_;
+            }
+        }
+        report.setElapsed(std::chrono::steady_clock::now() - start);
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    /**
+     * @brief Validates a single creature into its shard's buffer
+     * @return False if the handle is stale
+     */
+    bool validateOne(common::SlotHandle handle, Report &report) const {
+        typename Report::ShardBuffer &buffer =
+            report.shard(handle.index & (Registry::SHARD_COUNT - 1));
+        return registry_.read(handle,
+                              [&](const auto &creature, std::uint64_t) {
+                                  check(handle, creature, buffer);
+                              });
+    }
+
+  private:
+    const Registry &registry_;
+    Config config_;
+
+    // Pass state shared with parked workers
+    std::vector<std::thread> workers_;
+    std::mutex passMutex_;
+    std::condition_variable passStart_;
+    std::condition_variable passDone_;
+    Report *currentReport_{nullptr};
+    std::uint64_t passNumber_{0};
+    std::size_t workersBusy_{0};
+    std::exception_ptr error_;
+    bool stopping_{false};
+    std::atomic<std::size_t> nextShard_{0};
+
+    void workerLoop() {
+        std::uint64_t seen = 0;
+        for (;;) {
+            Report *report = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(passMutex_);
+                passStart_.wait(lock, [this, seen] {
+                    return stopping_ || passNumber_ != seen;
+                });
+                if (stopping_) {
+                    return;
+                }
+                seen = passNumber_;
+                report = currentReport_;
+            }
+            std::exception_ptr error;
+            try {
+                claimShards(*report);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            bool last = false;
+            {
+                std::lock_guard<std::mutex> lock(passMutex_);
+                if (error && !error_) {
+                    error_ = error;
+                }
+                last = --workersBusy_ == 0;
+            }
+            if (last) {
+                passDone_.notify_one();
+            }
+        }
+    }
+
+    void claimShards(Report &report) {
+        for (;;) {
+            const std::size_t shard =
+                nextShard_.fetch_add(1, std::memory_order_relaxed);
+            if (shard >= Registry::SHARD_COUNT) {
+                return;
+            }
+            validateShard(shard, report);
+        }
+    }
+
+    void validateShard(std::size_t shard, Report &report) const {
+        typename Report::ShardBuffer &buffer = report.shard(shard);
+        registry_.forEachInShard(
+            shard, [&](common::SlotHandle handle, const auto &creature) {
+                check(handle, creature, buffer);
+            });
+    }
+
+    template <typename Creature>
+    void check(common::SlotHandle handle, const Creature &creature,
+               typename Report::ShardBuffer &buffer) const {
+        ViolationSink sink(buffer.violations, handle.pack(),
+                           config_.maxViolationsPerCreature);
+        creature.validateInto(sink);
+        ++buffer.creaturesChecked;
+        if (!sink.clean()) {
+            ++buffer.creaturesFailed;
+        }
+    }
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_BASIC_POPULATION_VALIDATOR_H
@@ -0,0 +1,50 @@
+#ifndef CREATURE_ENGINE_CORE_CHANGE_TRACKING_H
+#define CREATURE_ENGINE_CORE_CHANGE_TRACKING_H
+
+#include <cstdint>
+
+namespace crescent {
+
+/**
+ * @brief Monotonic version counter plus a mask of fields changed since the
+ * last persisted snapshot
+ *
+ * Every mutation bumps the version and ORs in the touched field bits. The
+ * version never resets, so any consumer can compare against the version it
+ * last saw; the dirty mask is owned by the snapshot writer and is only cleared
+ * once a checkpoint containing those fields has been committed.
+ */
+class ChangeTracker {
+  public:
+    using FieldMask = std::uint32_t;
+    static constexpr FieldMask ALL_FIELDS = ~FieldMask{0};
+
+    void markDirty(FieldMask fields) {
+        dirtyFields_ |= fields;
+        ++version_;
+    }
+
+    /**
+     * @brief Clears dirty bits up to a persisted version
+     * @param persistedVersion Version captured when the snapshot was written
+     *
+     * Mutations that landed after the snapshot was taken keep their bits.
+     */
+    void clearDirty(std::uint64_t persistedVersion) {
+        if (persistedVersion >= version_) {
+            dirtyFields_ = 0;
+        }
+    }
+
+    bool isDirty() const { return dirtyFields_ != 0; }
+    FieldMask getDirtyFields() const { return dirtyFields_; }
+    std::uint64_t getVersion() const { return version_; }
+
+  private:
+    std::uint64_t version_{0};
+    FieldMask dirtyFields_{ALL_FIELDS}; // New objects belong in the next delta
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_CHANGE_TRACKING_H
@@ -1,18 +1,29 @@
 #ifndef CREATURE_ENGINE_CORE_BASE_CREATURE_CORE_H
 #define CREATURE_ENGINE_CORE_BASE_CREATURE_CORE_H
 
+#include "common/metrics/TraceSpan.h"
+#include "common/utils/PersistentVector.h"
+#include "common/utils/SimulationClock.h"
+#include "common/utils/SmallFlatMap.h"
+#include "creature_engine/core/ChangeTracking.h"
+#include "creature_engine/core/ValidationCodes.h"
 #include "creature_engine/core/base/CreatureEnums.h"
 #include "creature_engine/core/changes/ChangeProcessor.h"
 #include "creature_engine/core/changes/FormChange.h"
 #include "creature_engine/core/state/CreatureState.h"
+#include "creature_engine/io/JsonStreamWriter.h"
+#include "creature_engine/io/SerializationCache.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/systems/environment/stress/StressState.h"
+#include "creature_engine/traits/processors/AbilityProcessor.h"
+#include "creature_engine/traits/processors/TraitManager.h"
+#include "environment/core/StressSample.h"
 
-#include <chrono>
 #include <memory>
 #include <nlohmann/json.hpp>
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -34,7 +45,7 @@ class CreatureCore {
         std::string speciesId;               // Current species grouping
         std::optional<std::string> parentId; // Original creature ID if derived
         std::string originEnvironment;       // Where first generated
-        std::chrono::system_clock::time_point creationTime;
+        common::SimTick creationTick;        // Simulation time of creation
         int generationNumber; // How many adaptations deep
     };
 
@@ -51,7 +62,29 @@ class CreatureCore {
     // Core identity access
     const CreatureIdentity &getIdentity() const { return identity_; }
 
+    // Traits, abilities and syntheses; owned by this creature
+    traits::TraitManager &getTraits() { return *traits_; }
+    const traits::TraitManager &getTraits() const { return *traits_; }
+    traits::AbilityProcessor &getAbilities() { return *abilities_; }
+    const traits::AbilityProcessor &getAbilities() const {
+        return *abilities_;
+    }
+
     // Adaptation and Environment
+    struct EnvironmentBinding {
+        std::string name;                        // Environment it is in
+        std::weak_ptr<EnvironmentSystem> system; // Source of stress
+    };
+    const EnvironmentBinding &getEnvironment() const { return environment_; }
+
+    /**
+     * @brief Moves the creature into an environment
+     *
+     * Rebinds stress processing to binding.system and passes the new
+     * environment to the trait and ability processors.
+     */
+    void bindEnvironment(EnvironmentBinding binding);
+
     bool canAdaptTo(const std::string &environment) const;
     float calculateAdaptationPotential(const std::string &environment) const;
 
@@ -63,42 +96,245 @@ class CreatureCore {
     std::unique_ptr<CreatureCore>
     createAdaptedOffspring(const std::string &environment) const;
 
+    /**
+     * @brief Cheap clone for speculative simulation
+     *
+     * Shares state, history and the trait table with this creature
+     * copy-on-write; either side copies a part only when it first mutates
+     * it. Ability states and in-flight syntheses are few per creature and
+     * are cloned (TraitManager::fork, AbilityProcessor::fork). The fork
+     * keeps the same identity and environment binding, starts with fresh
+     * change tracking, and must not be registered.
+     */
+    std::unique_ptr<CreatureCore> fork() const;
+
+    /**
+     * @brief fork(), then bindEnvironment(environment) on the copy
+     */
+    std::unique_ptr<CreatureCore> fork(EnvironmentBinding environment) const;
+
     // State Management
-    CreatureState &getState() { return state_; }
-    const CreatureState &getState() const { return state_; }
+    /**
+     * @brief Read-only; state is shared copy-on-write with checkpoints and
+     * forks, so writes go through applyChange()
+     *
+     * The reference is invalidated by the next mutation or restore(), which
+     * may replace the shared state rather than edit it.
+     */
+    const CreatureState &getState() const { return *state_; }
     const StressState &getStressState() const { return stressState_; }
 
     // Change Processing
-    void applyChange(const FormChange &change);
+    void applyChange(const FormChange &change) {
+        CRESCENT_TRACE_SPAN(ApplyChange);
+        applyChangeImpl(change);
+    }
     void applyChanges(const std::vector<FormChange> &changes);
     bool undoLastChange();
-    const std::vector<FormChange> &getRecentChanges(size_t count = 10) const;
+    std::vector<FormChange> getRecentChanges(size_t count = 10) const;
+
+    /**
+     * @brief Saved creature state that shares structure with the live one
+     *
+     * Holds the state copy-on-write and the change history as a persistent
+     * vector, so taking one is a few refcount bumps and the live creature
+     * only copies what it mutates afterwards.
+     */
+    class Checkpoint {
+      public:
+        std::uint64_t getVersion() const { return version_; }
+
+      private:
+        friend class CreatureCore;
+        std::shared_ptr<const CreatureState> state_;
+        StressState stressState_;
+        common::PersistentVector<FormChange> changeHistory_;
+        std::uint64_t version_{0};
+    };
+
+    /**
+     * @brief O(1) snapshot of state, stress and history
+     */
+    Checkpoint checkpoint() const;
+
+    /**
+     * @brief Swaps a checkpoint back in; no replay and no deep copy
+     *
+     * Marks state, stress and history dirty so snapshots and caches see
+     * the revert as a new version.
+     */
+    void restore(const Checkpoint &checkpoint);
 
     // Stress and Adaptation
     void processEnvironmentalStress(float deltaTime);
+
+    /**
+     * @brief Applies stress read from the creature's cell of a StressField
+     */
+    void processEnvironmentalStress(float deltaTime,
+                                    const environment::StressSample &sample);
     bool hasReachedSpeciationThreshold() const;
     float calculateDivergenceFromParent() const;
 
+    /**
+     * @brief sizeof(CreatureCore) plus the heap it reaches
+     *
+     * Counts the CreatureState, spilled map storage, the change history
+     * and getMemoryFootprint() of every trait, ability and synthesis
+     * state. Storage shared with checkpoints or forks (the CreatureState,
+     * history nodes, copy-on-write trait states) is counted in full by
+     * each holder, so a sum over a population overstates. Catalyst
+     * influence rows live in the shared CatalystInfluenceTable and are
+     * not counted.
+     */
+    std::size_t getMemoryFootprint() const;
+
     // Validation
     bool isValid() const;
     void revertToLastValidState();
     std::vector<std::string> validate() const;
 
+    /**
+     * @brief Reports violations as codes without allocating on success
+     *
+     * Checks the creature's own identity, state, stress, divergence and
+     * history, then getTraits() (trait states and pairwise compatibility),
+     * getTraits().getSynthesis() and getAbilities(). Returns as soon as
+     * sink.full(), so later checks are skipped once the limit is reached.
+     * isValid() runs this with a limit of one; validate() runs it without
+     * a limit and formats each violation.
+     */
+    void validateInto(ViolationSink &sink) const;
+
+    // Change tracking
+    enum DirtyField : ChangeTracker::FieldMask {
+        DirtyIdentity = 1u << 0,
+        DirtyState = 1u << 1,
+        DirtyStress = 1u << 2,
+        DirtyAdaptation = 1u << 3,
+        DirtyHistory = 1u << 4,
+        // Reported while the owning component's tracker is dirty
+        DirtyTraits = 1u << 5,
+        DirtyAbilities = 1u << 6,
+        DirtySyntheses = 1u << 7
+    };
+    const ChangeTracker &getChangeTracker() const { return changeTracker_; }
+
+    /**
+     * @brief Own dirty bits plus DirtyTraits, DirtyAbilities and
+     * DirtySyntheses for each owned component with a dirty tracker
+     */
+    ChangeTracker::FieldMask getDirtyFields() const;
+
+    /**
+     * @brief Tracker versions a snapshot record was written at
+     */
+    struct PersistedVersions {
+        std::uint64_t creature{0};
+        std::uint64_t traits{0};
+        std::uint64_t abilities{0};
+        std::uint64_t syntheses{0};
+    };
+    PersistedVersions capturePersistedVersions() const;
+
+    /**
+     * @brief Clears every tracker that has not moved past persisted
+     *
+     * Called once the snapshot holding the record has been committed;
+     * changes made after the record was written keep their bits.
+     */
+    void clearDirty(const PersistedVersions &persisted);
+
     // Serialization
     nlohmann::json
-    serializeToJson(const SerializationOptions &options = {}) const;
+    serializeToJson(const SerializationOptions &options = {}) const {
+        CRESCENT_TRACE_SPAN(SerializeCreature);
+        return serializeToJsonImpl(options);
+    }
     static CreatureCore deserializeFromJson(const nlohmann::json &data);
 
+    /**
+     * @brief Streams the same JSON as serializeToJson without a DOM
+     *
+     * Byte-identical to serializeToJson(options).dump().
+     */
+    void writeJson(io::JsonStreamWriter &writer,
+                   const SerializationOptions &options = {}) const;
+
+    /**
+     * @brief Compact binary form for moving a creature between processes
+     *
+     * Appends the fields serializeToJson covers, including trait, ability
+     * and synthesis state, in the io::CreatureCodec layout. Floats keep
+     * their exact bits. Nothing is written as an id into this process's
+     * tables: traits go by id string, and the catalyst influences (held in
+     * a CatalystInfluenceTable) and synthesis history (interned in a
+     * shared StringInterner) are written as values by io::putInfluences
+     * and io::putHistory. Environment bindings are not encoded; the
+     * receiving side binds the creature to its own environment.
+     */
+    void encodeBinary(std::string &out) const;
+
+    /**
+     * @brief Rebuilds an encodeBinary record in this process
+     *
+     * Catalyst influences become rows of a new owner in influences, and
+     * history strings are interned afresh, so the result compares equal
+     * field by field to the encoded creature.
+     * @throws SerializationException on truncated or corrupt input
+     */
+    static CreatureCore
+    decodeBinary(std::string_view bytes,
+                 traits::CatalystInfluenceTable &influences);
+
+    /**
+     * @brief Serialized JSON text, cached per options and version stamp
+     *
+     * The creature's own fields are written fresh on a miss; the trait
+     * section (syntheses included) and the ability section are spliced in
+     * from getTraits().serializeToBytes() and getAbilities()
+     * .serializeToBytes(). An unchanged creature therefore costs a
+     * shared_ptr copy, and a changed one re-serializes its own fields plus
+     * whichever components moved.
+     */
+    SerializedBytes
+    serializeToBytes(const SerializationOptions &options = {}) const;
+
+    /**
+     * @brief Own version, trait and synthesis versions and ability version,
+     * compared exactly by the cache
+     */
+    VersionStamp getSerializationVersion() const;
+
+    /**
+     * @brief Serializes only the requested top-level fields
+     * @param fields Mask of DirtyField bits to include; DirtyTraits,
+     * DirtyAbilities and DirtySyntheses write the whole component
+     * @return Partial object suitable for a delta snapshot record
+     */
+    nlohmann::json
+    serializeFieldsToJson(ChangeTracker::FieldMask fields,
+                          const SerializationOptions &options = {}) const;
+
+    /**
+     * @brief Overlays a delta record produced by serializeFieldsToJson
+     */
+    void applyDeltaFromJson(const nlohmann::json &delta);
+
   private:
     // Core state
     CreatureIdentity identity_;
-    CreatureState state_;
+    std::shared_ptr<const CreatureState> state_; // Shared with checkpoints
     StressState stressState_;
 
     // Processing systems
     std::unique_ptr<ChangeProcessor> changeProcessor_;
     std::shared_ptr<StressManager> stressManager_;
-    std::weak_ptr<EnvironmentSystem> currentEnvironment_;
+    EnvironmentBinding environment_;
+
+    // Traits (with their syntheses) and abilities
+    std::unique_ptr<traits::TraitManager> traits_;
+    std::unique_ptr<traits::AbilityProcessor> abilities_;
 
     // Adaptation tracking
     struct AdaptationMetrics {
@@ -106,19 +342,35 @@ class CreatureCore {
         float averageStressLevel;
         int timeInEnvironment;
         float divergenceFromParent;
-        std::unordered_map<std::string, float> traitDivergence;
+        common::SmallFlatMap<std::string, float, 8> traitDivergence;
     } adaptationMetrics_;
 
     // History
-    std::vector<FormChange> changeHistory_;
+    common::PersistentVector<FormChange> changeHistory_;
     static constexpr size_t DEFAULT_HISTORY_SIZE = 100;
     size_t maxHistorySize_ = DEFAULT_HISTORY_SIZE;
 
+    // Snapshot bookkeeping
+    ChangeTracker changeTracker_;
+    SerializationByteCache serializationCache_;
+
+    // Set after each successful validation; used by revertToLastValidState
+    std::optional<Checkpoint> lastValidCheckpoint_;
+
+    // Bodies of the instrumented entry points above
+    void applyChangeImpl(const FormChange &change);
+    nlohmann::json
+    serializeToJsonImpl(const SerializationOptions &options) const;
+
     // Internal helpers
+    CreatureState &mutableState(); // Copies state_ first if it is shared
     void updateAdaptationMetrics(float deltaTime);
     void pruneHistory();
     bool validateChange(const FormChange &change) const;
     void notifyChangeApplied(const FormChange &change);
+    void markDirty(ChangeTracker::FieldMask fields) {
+        changeTracker_.markDirty(fields);
+    }
 
     // Speciation thresholds
     static constexpr float SPECIATION_STRESS_THRESHOLD = 0.75f;
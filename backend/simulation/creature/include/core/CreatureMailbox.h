@@ -0,0 +1,60 @@
+#ifndef CREATURE_ENGINE_CORE_CREATURE_MAILBOX_H
+#define CREATURE_ENGINE_CORE_CREATURE_MAILBOX_H
+
+#include "common/utils/CommandExecutor.h"
+#include "creature_engine/core/CreatureCore.h"
+#include "creature_engine/core/CreatureRegistry.h"
+
+#include <future>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace crescent {
+
+/**
+ * @brief Move-only mutation queued against a single creature
+ */
+using CreatureCommand = common::Command<CreatureCore>;
+
+/**
+ * @brief Per-creature command queue; see common::Mailbox
+ */
+using CreatureMailbox = common::Mailbox<CreatureCore>;
+
+using MailboxRef = std::shared_ptr<CreatureMailbox>;
+
+/**
+ * @brief Runs queued creature commands in batches on a worker pool
+ *
+ * Every creature is pinned to one worker (by registry shard), so commands
+ * for a creature execute in submission order on a single thread and never
+ * contend with each other. A worker applies up to maxBatchSize commands per
+ * registry write, taking the creature's lock once per batch instead of once
+ * per mutation; API readers still see only whole batches. stop() drains
+ * outstanding commands before joining.
+ */
+class CommandExecutor final
+    : public common::BasicCommandExecutor<CreatureCore, CreatureRegistry> {
+  public:
+    using BasicCommandExecutor::BasicCommandExecutor;
+
+    // Common mutations
+    std::future<void> applyChange(CreatureHandle handle, FormChange change) {
+        return submit(handle, [change = std::move(change)](
+                                  CreatureCore &creature) {
+            creature.applyChange(change);
+        });
+    }
+    std::future<void> applyChanges(CreatureHandle handle,
+                                   std::vector<FormChange> changes) {
+        return submit(handle, [changes = std::move(changes)](
+                                  CreatureCore &creature) {
+            creature.applyChanges(changes);
+        });
+    }
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_CREATURE_MAILBOX_H
@@ -0,0 +1,119 @@
+#ifndef CREATURE_ENGINE_CORE_CREATURE_REGISTRY_H
+#define CREATURE_ENGINE_CORE_CREATURE_REGISTRY_H
+
+#include "common/utils/ShardedSlotMap.h"
+#include "creature_engine/core/CreatureCore.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace crescent {
+
+/**
+ * @brief Compact, generational id for a live creature
+ *
+ * Cheaper to pass and hash than CreatureIdentity::id. Becomes stale when the
+ * creature is removed from the registry.
+ */
+using CreatureHandle = common::SlotHandle;
+
+/**
+ * @brief Owner of all live CreatureCore instances
+ *
+ * API threads resolve and read creatures while simulation workers mutate
+ * them. Handle lookups, version checks and per-shard iteration are lock-free;
+ * reads share a creature, writes hold it exclusively and bump its version.
+ * Lookups by string id go through a separately sharded index.
+ */
+class CreatureRegistry {
+  public:
+    using Storage = common::ShardedSlotMap<CreatureCore>;
+    static constexpr std::size_t SHARD_COUNT = Storage::SHARD_COUNT;
+
+    CreatureRegistry() = default;
+    ~CreatureRegistry() = default;
+
+    // Prevent copying and moving
+    CreatureRegistry(const CreatureRegistry &) = delete;
+    CreatureRegistry &operator=(const CreatureRegistry &) = delete;
+    CreatureRegistry(CreatureRegistry &&) = delete;
+    CreatureRegistry &operator=(CreatureRegistry &&) = delete;
+
+    /**
+     * @brief Takes ownership of a creature
+     * @throws StateException if a creature with the same id is registered
+     */
+    CreatureHandle add(std::unique_ptr<CreatureCore> creature);
+
+    /**
+     * @brief Releases a creature, waiting for in-flight reads to finish
+     * @return The creature, or nullptr if the handle is stale
+     */
+    std::unique_ptr<CreatureCore> remove(CreatureHandle handle);
+
+    std::optional<CreatureHandle> find(const std::string &creatureId) const;
+    bool contains(CreatureHandle handle) const {
+        return storage_.contains(handle);
+    }
+
+    /**
+     * @brief Runs fn(const CreatureCore &, version) under a shared lock
+     * @return False if the handle is stale
+     */
+    template <typename Fn> bool read(CreatureHandle handle, Fn &&fn) const {
+        return storage_.read(handle, std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Runs fn(CreatureCore &) exclusively and bumps the version
+     * @return False if the handle is stale
+     */
+    template <typename Fn> bool write(CreatureHandle handle, Fn &&fn) {
+        return storage_.write(handle, std::forward<Fn>(fn));
+    }
+
+    /**
+     * @brief Lock-free version for optimistic readers and response caches
+     */
+    std::optional<std::uint64_t> getVersion(CreatureHandle handle) const {
+        return storage_.version(handle);
+    }
+
+    /**
+     * @brief Visits one shard as fn(handle, const CreatureCore &)
+     *
+     * The parallel scheduler hands shards [0, SHARD_COUNT) to workers.
+     */
+    template <typename Fn>
+    void forEachInShard(std::size_t shard, Fn &&fn) const {
+        storage_.forEachInShard(shard, std::forward<Fn>(fn));
+    }
+
+    std::size_t size() const { return storage_.size(); }
+
+  private:
+    Storage storage_;
+
+    // String id index, sharded by the same hash used to place creatures
+    struct alignas(64) IndexShard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, CreatureHandle> handles;
+    };
+    std::array<IndexShard, SHARD_COUNT> index_;
+
+    static std::size_t shardFor(const std::string &creatureId) {
+        return std::hash<std::string>()(creatureId) & (SHARD_COUNT - 1);
+    }
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_CREATURE_REGISTRY_H
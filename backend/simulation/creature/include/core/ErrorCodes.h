@@ -0,0 +1,223 @@
+#ifndef CREATURE_ENGINE_CORE_ERROR_CODES_H
+#define CREATURE_ENGINE_CORE_ERROR_CODES_H
+
+#include "common/utils/Expected.h"
+#include "common/utils/InlineVector.h"
+
+#include <cstdint>
+#include <string>
+
+namespace crescent {
+
+/**
+ * @brief Reason an engine operation failed or warned
+ */
+enum class ErrorCode : std::uint16_t {
+    Unspecified,
+
+    // Traits
+    TraitNotFound,      // No such trait definition or state
+    TraitAlreadyActive, // Trait is already present
+    TraitIncompatible,  // Conflicts with an active trait
+    TraitRequirements,  // Prerequisites not met
+    TraitInvalidChange, // FormChange rejected by validation
+    TraitBatchEmpty,    // Nothing pending to commit
+
+    // Abilities
+    AbilityNotFound,          // Not registered
+    AbilityAlreadyRegistered, // Registered twice
+    AbilityUnavailable,       // Requirements not met
+    AbilityAlreadyManifested, // Manifest called while manifested
+    AbilityNotManifested,     // Unmanifest called while dormant
+    AbilitySuppressed,        // Blocked by the current environment
+    AbilityEffectSuppressed,  // Manifested with an effect suppressed
+
+    // Synthesis
+    SynthesisInProgress,    // Trait is already synthesizing
+    SynthesisNotActive,     // No synthesis to advance or revert
+    SynthesisRequirements,  // SynthesisFailureType::Requirements
+    SynthesisUnstable,      // SynthesisFailureType::Stability
+    SynthesisIncompatible,  // SynthesisFailureType::Incompatible
+    SynthesisEnvironmental, // SynthesisFailureType::Environmental
+    SynthesisCatalystWeak,  // SynthesisFailureType::CatalystWeak
+    SynthesisSystemic,      // SynthesisFailureType::SystemicFailure
+    SynthesisLowStability,  // Succeeded but stability is marginal
+
+    // Environment, adaptation and limits
+    EnvironmentIncompatible, // State cannot exist in the environment
+    AdaptationThreshold,     // Stress below the adaptation threshold
+    LimitExceeded,           // A configured cap was reached
+
+    // Storage
+    SerializationFailed, // Encode, decode or file I/O failed
+    Count
+};
+
+/**
+ * @brief Stable identifier for logs and metrics
+ */
+inline const char *errorCodeName(ErrorCode code) {
+    switch (code) {
+    case ErrorCode::Unspecified:
+        return "Unspecified";
+    case ErrorCode::TraitNotFound:
+        return "TraitNotFound";
+    case ErrorCode::TraitAlreadyActive:
+        return "TraitAlreadyActive";
+    case ErrorCode::TraitIncompatible:
+        return "TraitIncompatible";
+    case ErrorCode::TraitRequirements:
+        return "TraitRequirements";
+    case ErrorCode::TraitInvalidChange:
+        return "TraitInvalidChange";
+    case ErrorCode::TraitBatchEmpty:
+        return "TraitBatchEmpty";
+    case ErrorCode::AbilityNotFound:
+        return "AbilityNotFound";
+    case ErrorCode::AbilityAlreadyRegistered:
+        return "AbilityAlreadyRegistered";
+    case ErrorCode::AbilityUnavailable:
+        return "AbilityUnavailable";
+    case ErrorCode::AbilityAlreadyManifested:
+        return "AbilityAlreadyManifested";
+    case ErrorCode::AbilityNotManifested:
+        return "AbilityNotManifested";
+    case ErrorCode::AbilitySuppressed:
+        return "AbilitySuppressed";
+    case ErrorCode::AbilityEffectSuppressed:
+        return "AbilityEffectSuppressed";
+    case ErrorCode::SynthesisInProgress:
+        return "SynthesisInProgress";
+    case ErrorCode::SynthesisNotActive:
+        return "SynthesisNotActive";
+    case ErrorCode::SynthesisRequirements:
+        return "SynthesisRequirements";
+    case ErrorCode::SynthesisUnstable:
+        return "SynthesisUnstable";
+    case ErrorCode::SynthesisIncompatible:
+        return "SynthesisIncompatible";
+    case ErrorCode::SynthesisEnvironmental:
+        return "SynthesisEnvironmental";
+    case ErrorCode::SynthesisCatalystWeak:
+        return "SynthesisCatalystWeak";
+    case ErrorCode::SynthesisSystemic:
+        return "SynthesisSystemic";
+    case ErrorCode::SynthesisLowStability:
+        return "SynthesisLowStability";
+    case ErrorCode::EnvironmentIncompatible:
+        return "EnvironmentIncompatible";
+    case ErrorCode::AdaptationThreshold:
+        return "AdaptationThreshold";
+    case ErrorCode::LimitExceeded:
+        return "LimitExceeded";
+    case ErrorCode::SerializationFailed:
+        return "SerializationFailed";
+    case ErrorCode::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief Human-readable explanation; a static string, never allocated
+ */
+inline const char *describeError(ErrorCode code) {
+    switch (code) {
+    case ErrorCode::Unspecified:
+        return "unspecified failure";
+    case ErrorCode::TraitNotFound:
+        return "trait not found";
+    case ErrorCode::TraitAlreadyActive:
+        return "trait is already active";
+    case ErrorCode::TraitIncompatible:
+        return "trait is incompatible with an active trait";
+    case ErrorCode::TraitRequirements:
+        return "trait requirements are not met";
+    case ErrorCode::TraitInvalidChange:
+        return "form change failed validation";
+    case ErrorCode::TraitBatchEmpty:
+        return "no pending changes to commit";
+    case ErrorCode::AbilityNotFound:
+        return "ability is not registered";
+    case ErrorCode::AbilityAlreadyRegistered:
+        return "ability is already registered";
+    case ErrorCode::AbilityUnavailable:
+        return "ability requirements are not met";
+    case ErrorCode::AbilityAlreadyManifested:
+        return "ability is already manifested";
+    case ErrorCode::AbilityNotManifested:
+        return "ability is not manifested";
+    case ErrorCode::AbilitySuppressed:
+        return "ability is suppressed by the environment";
+    case ErrorCode::AbilityEffectSuppressed:
+        return "an ability effect was suppressed";
+    case ErrorCode::SynthesisInProgress:
+        return "synthesis already in progress";
+    case ErrorCode::SynthesisNotActive:
+        return "no active synthesis";
+    case ErrorCode::SynthesisRequirements:
+        return "synthesis requirements are not met";
+    case ErrorCode::SynthesisUnstable:
+        return "synthesis stability is insufficient";
+    case ErrorCode::SynthesisIncompatible:
+        return "synthesis target form is incompatible";
+    case ErrorCode::SynthesisEnvironmental:
+        return "environment does not support synthesis";
+    case ErrorCode::SynthesisCatalystWeak:
+        return "catalyst is too weak";
+    case ErrorCode::SynthesisSystemic:
+        return "synthesis failed internally";
+    case ErrorCode::SynthesisLowStability:
+        return "synthesis stability is marginal";
+    case ErrorCode::EnvironmentIncompatible:
+        return "incompatible with the environment";
+    case ErrorCode::AdaptationThreshold:
+        return "stress is below the adaptation threshold";
+    case ErrorCode::LimitExceeded:
+        return "limit exceeded";
+    case ErrorCode::SerializationFailed:
+        return "serialization failed";
+    case ErrorCode::Count:
+        break;
+    }
+    return "unknown error";
+}
+
+/**
+ * @brief Failure record returned by engine operations
+ *
+ * Trivially copyable, like Violation: detail is code specific (an index,
+ * a count, a SynthesisFailureType) and the text is only built when
+ * message() is called, typically by a logger or an API response.
+ */
+struct Error {
+    ErrorCode code{ErrorCode::Unspecified};
+    std::uint32_t detail{0};
+
+    std::string message() const {
+        std::string text = describeError(code);
+        if (detail != 0) {
+            text += " (";
+            text += std::to_string(detail);
+            text += ')';
+        }
+        return text;
+    }
+};
+
+/**
+ * @brief Non-fatal conditions reported alongside a successful result
+ */
+using WarningList = common::InlineVector<ErrorCode, 4>;
+
+/**
+ * @brief Shorthand for returning a failure from an Expected function
+ */
+inline common::Unexpected<Error> fail(ErrorCode code,
+                                      std::uint32_t detail = 0) {
+    return {Error{code, detail}};
+}
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_ERROR_CODES_H
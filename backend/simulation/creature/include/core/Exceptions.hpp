@@ -1,19 +1,72 @@
 #ifndef CREATURE_ENGINE_CORE_BASE_CREATURE_EXCEPTIONS_H
 #define CREATURE_ENGINE_CORE_BASE_CREATURE_EXCEPTIONS_H
 
+#include "creature_engine/core/ErrorCodes.h"
+
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace crescent {
 
 /**
  * @brief Base exception class for all creature-related errors
+ *
+ * Holds an ErrorCode, a static category and optional context; nothing is
+ * concatenated until what() is first called, so throwing with just a code
+ * allocates nothing. The "Category: text" message is then built once and
+ * cached; concurrent what() calls on one exception all see that single
+ * string. The text is the context, or the code's description if there is
+ * none. Copies format their own message on demand.
  */
 class CreatureException : public std::runtime_error {
   public:
-    explicit CreatureException(const std::string &message)
-        : std::runtime_error(message) {}
+    explicit CreatureException(std::string message)
+        : CreatureException(nullptr, ErrorCode::Unspecified,
+                            std::move(message)) {}
+    explicit CreatureException(ErrorCode code, std::string context = {})
+        : CreatureException(nullptr, code, std::move(context)) {}
+
+    CreatureException(const CreatureException &other)
+        : std::runtime_error(other), category_(other.category_),
+          code_(other.code_), context_(other.context_) {}
+    CreatureException &operator=(const CreatureException &) = delete;
+
+    const char *what() const noexcept override {
+        try {
+            std::call_once(formatted_, [this] {
+                if (category_) {
+                    message_ += category_;
+                    message_ += ": ";
+                }
+                message_ +=
+                    context_.empty() ? describeError(code_) : context_.c_str();
+            });
+        } catch (...) {
+            // Out of memory; the category alone is still meaningful
+            return category_ ? category_ : describeError(code_);
+        }
+        return message_.c_str();
+    }
+
+    ErrorCode code() const { return code_; }
+    const std::string &context() const { return context_; }
+
+  protected:
+    // category is a static prefix such as "Trait Error", or nullptr
+    CreatureException(const char *category, ErrorCode code,
+                      std::string context)
+        : std::runtime_error(""), category_(category), code_(code),
+          context_(std::move(context)) {}
+
+  private:
+    const char *category_;
+    ErrorCode code_;
+    std::string context_;
+    mutable std::once_flag formatted_;
+    mutable std::string message_;
 };
 
 /**
@@ -21,10 +74,11 @@ class CreatureException : public std::runtime_error {
  */
 class ValidationException : public CreatureException {
   public:
-    ValidationException(const std::string &message,
-                        const std::vector<std::string> &violations)
-        : CreatureException("Validation Error: " + message),
-          violations_(violations) {}
+    ValidationException(std::string message,
+                        std::vector<std::string> violations)
+        : CreatureException("Validation Error", ErrorCode::Unspecified,
+                            std::move(message)),
+          violations_(std::move(violations)) {}
 
     const std::vector<std::string> &getViolations() const {
         return violations_;
@@ -39,8 +93,11 @@ class ValidationException : public CreatureException {
  */
 class StateException : public CreatureException {
   public:
-    explicit StateException(const std::string &message)
-        : CreatureException("State Error: " + message) {}
+    explicit StateException(std::string message)
+        : CreatureException("State Error", ErrorCode::Unspecified,
+                            std::move(message)) {}
+    explicit StateException(ErrorCode code, std::string context = {})
+        : CreatureException("State Error", code, std::move(context)) {}
 };
 
 /**
@@ -48,8 +105,11 @@ class StateException : public CreatureException {
  */
 class TraitException : public CreatureException {
   public:
-    explicit TraitException(const std::string &message)
-        : CreatureException("Trait Error: " + message) {}
+    explicit TraitException(std::string message)
+        : CreatureException("Trait Error", ErrorCode::Unspecified,
+                            std::move(message)) {}
+    explicit TraitException(ErrorCode code, std::string context = {})
+        : CreatureException("Trait Error", code, std::move(context)) {}
 };
 
 /**
@@ -57,9 +117,13 @@ class TraitException : public CreatureException {
  */
 class SynthesisException : public CreatureException {
   public:
-    explicit SynthesisException(const std::string &message,
-                                const std::string &traitId = "")
-        : CreatureException("Synthesis Error: " + message), traitId_(traitId) {}
+    explicit SynthesisException(std::string message, std::string traitId = {})
+        : CreatureException("Synthesis Error", ErrorCode::Unspecified,
+                            std::move(message)),
+          traitId_(std::move(traitId)) {}
+    explicit SynthesisException(ErrorCode code, std::string traitId = {})
+        : CreatureException("Synthesis Error", code, {}),
+          traitId_(std::move(traitId)) {}
 
     const std::string &getTraitId() const { return traitId_; }
 
@@ -72,8 +136,11 @@ class SynthesisException : public CreatureException {
  */
 class EnvironmentException : public CreatureException {
   public:
-    explicit EnvironmentException(const std::string &message)
-        : CreatureException("Environment Error: " + message) {}
+    explicit EnvironmentException(std::string message)
+        : CreatureException("Environment Error", ErrorCode::Unspecified,
+                            std::move(message)) {}
+    explicit EnvironmentException(ErrorCode code, std::string context = {})
+        : CreatureException("Environment Error", code, std::move(context)) {}
 };
 
 /**
@@ -81,9 +148,13 @@ class EnvironmentException : public CreatureException {
  */
 class AdaptationException : public CreatureException {
   public:
-    AdaptationException(const std::string &message, float currentStress,
+    AdaptationException(std::string message, float currentStress,
                         float threshold)
-        : CreatureException("Adaptation Error: " + message),
+        : CreatureException("Adaptation Error", ErrorCode::Unspecified,
+                            std::move(message)),
+          currentStress_(currentStress), threshold_(threshold) {}
+    AdaptationException(ErrorCode code, float currentStress, float threshold)
+        : CreatureException("Adaptation Error", code, {}),
           currentStress_(currentStress), threshold_(threshold) {}
 
     float getCurrentStress() const { return currentStress_; }
@@ -99,10 +170,12 @@ class AdaptationException : public CreatureException {
  */
 class LimitException : public CreatureException {
   public:
-    LimitException(const std::string &message, const std::string &limitType,
+    LimitException(std::string message, std::string limitType,
                    size_t currentValue, size_t maxValue)
-        : CreatureException("Limit Error: " + message), limitType_(limitType),
-          currentValue_(currentValue), maxValue_(maxValue) {}
+        : CreatureException("Limit Error", ErrorCode::LimitExceeded,
+                            std::move(message)),
+          limitType_(std::move(limitType)), currentValue_(currentValue),
+          maxValue_(maxValue) {}
 
     const std::string &getLimitType() const { return limitType_; }
     size_t getCurrentValue() const { return currentValue_; }
@@ -119,10 +192,12 @@ class LimitException : public CreatureException {
  */
 class SerializationException : public CreatureException {
   public:
-    explicit SerializationException(const std::string &message)
-        : CreatureException("Serialization Error: " + message) {}
+    explicit SerializationException(std::string message)
+        : CreatureException("Serialization Error",
+                            ErrorCode::SerializationFailed,
+                            std::move(message)) {}
 };
 
 } // namespace crescent
 
-#endif // CREATURE_ENGINE_CORE_BASE_CREATURE_EXCEPTIONS_H
\ No newline at end of file
+#endif // CREATURE_ENGINE_CORE_BASE_CREATURE_EXCEPTIONS_H
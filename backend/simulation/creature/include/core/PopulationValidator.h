@@ -0,0 +1,23 @@
+#ifndef CREATURE_ENGINE_CORE_POPULATION_VALIDATOR_H
+#define CREATURE_ENGINE_CORE_POPULATION_VALIDATOR_H
+
+#include "creature_engine/core/BasicPopulationValidator.h"
+#include "creature_engine/core/CreatureRegistry.h"
+
+namespace crescent {
+
+/**
+ * @brief Violations found by one bulk pass, bucketed by registry shard
+ */
+using ValidationReport =
+    BasicValidationReport<CreatureRegistry::SHARD_COUNT>;
+
+/**
+ * @brief Validates every registered creature in parallel with
+ * CreatureCore::validateInto; see BasicPopulationValidator
+ */
+using PopulationValidator = BasicPopulationValidator<CreatureRegistry>;
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_POPULATION_VALIDATOR_H
@@ -0,0 +1,248 @@
+#ifndef CREATURE_ENGINE_CORE_RESONANCE_FIELD_H
+#define CREATURE_ENGINE_CORE_RESONANCE_FIELD_H
+
+#include "common/utils/WorkerPool.h"
+#include "creature_engine/core/CreatureRegistry.h"
+#include "environment/core/SpatialHashGrid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace crescent {
+
+/**
+ * @brief Creature-to-creature resonance computed from local neighborhoods
+ *
+ * Positions and emission strengths are kept per creature in dense arrays
+ * (swap-removed, so indices are not stable across remove()). Each tick
+ * compute() rebuilds a SpatialHashGrid with cell size equal to the
+ * interaction radius and, in parallel, sums the emissions of every
+ * neighbor j within the radius of creature i:
+ *
+ *   sum_i = sum_j emission_j * (1 - d_ij^2 / r^2)^2
+ *   exposure_i = 1 - exp(-sum_i)
+ *
+ * so exposure stays in [0, 1) however crowded a neighborhood gets, and the
+ * kernel needs no square root. Each creature reads three short bucket
+ * rows, so a tick is O(n * local density) instead of O(n^2).
+ *
+ * Setters and compute() are single-threaded with respect to each other;
+ * compute() and deliver() use the field's own workers. deliver() hands
+ * exposures to each creature's SynthesisProcessor as a Resonance catalyst.
+ */
+class ResonanceField {
+  public:
+    struct Config {
+        float radius{4.0f};         // Interaction range, world units
+        float minIntensity{0.01f};  // Smaller exposures are not delivered
+        std::size_t workerCount{0}; // 0 = hardware concurrency
+        std::size_t grain{2048};    // Creatures per parallel chunk
+        // Catalyst id deliver() reports to syntheses
+        std::string catalystId{"resonance"};
+    };
+
+    explicit ResonanceField(Config config)
+        : config_(config), pool_(config.workerCount),
+          grid_({config.radius, config.grain}) {}
+
+    // Prevent copying and moving
+    ResonanceField(const ResonanceField &) = delete;
+    ResonanceField &operator=(const ResonanceField &) = delete;
+    ResonanceField(ResonanceField &&) = delete;
+    ResonanceField &operator=(ResonanceField &&) = delete;
+
+    std::size_t size() const { return handles_.size(); }
+    float radius() const { return config_.radius; }
+
+    /**
+     * @brief Adds or moves a creature; emission is how strongly it resonates
+     */
+    void set(CreatureHandle creature, float x, float y, float emission) {
+        auto [it, inserted] = slots_.try_emplace(
+            creature.pack(), static_cast<std::uint32_t>(handles_.size()));
+        if (inserted) {
+            layoutChanged_ = true;
+            handles_.push_back(creature);
+            xs_.push_back(x);
+            ys_.push_back(y);
+            emission_.push_back(emission);
+            exposure_.push_back(0.0f);
+            return;
+        }
+        setPosition(creature, x, y);
+        emission_[it->second] = emission;
+    }
+
+    void setPosition(CreatureHandle creature, float x, float y) {
+        auto it = slots_.find(creature.pack());
+        if (it == slots_.end()) {
+            return;
+        }
+        if (xs_[it->second] != x || ys_[it->second] != y) {
+            layoutChanged_ = true;
+        }
+        xs_[it->second] = x;
+        ys_[it->second] = y;
+    }
+
+    bool remove(CreatureHandle creature) {
+        auto it = slots_.find(creature.pack());
+        if (it == slots_.end()) {
+            return false;
+        }
+        const std::uint32_t slot = it->second;
+        const std::uint32_t last =
+            static_cast<std::uint32_t>(handles_.size() - 1);
+        slots_.erase(it);
+        layoutChanged_ = true;
+        if (slot != last) {
+            handles_[slot] = handles_[last];
+            xs_[slot] = xs_[last];
+            ys_[slot] = ys_[last];
+            emission_[slot] = emission_[last];
+            exposure_[slot] = exposure_[last];
+            slots_[handles_[slot].pack()] = slot;
+        }
+        handles_.pop_back();
+        xs_.pop_back();
+        ys_.pop_back();
+        emission_.pop_back();
+        exposure_.pop_back();
+        return true;
+    }
+
+    void clear() {
+        layoutChanged_ = true;
+        slots_.clear();
+        handles_.clear();
+        xs_.clear();
+        ys_.clear();
+        emission_.clear();
+        exposure_.clear();
+    }
+
+    /**
+     * @brief Rebuilds the grid and recomputes every exposure
+     */
+    void compute() {
+        grid_.rebuild(xs_.data(), ys_.data(), handles_.size(), &pool_);
+        layoutChanged_ = false;
+        const float invRadiusSq = 1.0f / (config_.radius * config_.radius);
+        const std::vector<std::uint32_t> &order = grid_.order();
+        // Grid order keeps consecutive queries on neighbouring buckets
+        pool_.forEachChunk(
+            order.size(), config_.grain,
+            [&](std::size_t begin, std::size_t end, std::size_t) {
+                for (std::size_t p = begin; p < end; ++p) {
+                    const std::uint32_t i = order[p];
+                    float sum = 0.0f;
+                    grid_.forEachWithin(
+                        xs_[i], ys_[i], config_.radius,
+                        [&](std::uint32_t j, float distanceSq) {
+                            if (j == i) {
+                                return;
+                            }
+                            const float falloff =
+                                1.0f - distanceSq * invRadiusSq;
+                            sum += emission_[j] * falloff * falloff;
+                        });
+                    exposure_[i] = 1.0f - std::exp(-std::max(sum, 0.0f));
+                }
+            });
+    }
+
+    std::optional<float> exposureOf(CreatureHandle creature) const {
+        auto it = slots_.find(creature.pack());
+        if (it == slots_.end()) {
+            return std::nullopt;
+        }
+        return exposure_[it->second];
+    }
+
+    /**
+     * @brief Records each exposure of at least minIntensity with its
+     * creature's syntheses
+     *
+     * Forwards to SynthesisProcessor::recordCatalystExposure with
+     * CatalystType::Resonance and Config::catalystId, under the registry
+     * write lock and in parallel across creatures. Stale handles are
+     * skipped.
+     * @return Number of creatures that received an exposure
+     */
+    std::size_t deliver(CreatureRegistry &registry) {
+        std::atomic<std::size_t> delivered{0};
+        pool_.forEachChunk(
+            handles_.size(), config_.grain,
+            [&](std::size_t begin, std::size_t end, std::size_t) {
+                std::size_t local = 0;
+                for (std::size_t i = begin; i < end; ++i) {
+                    const float intensity = exposure_[i];
+                    if (intensity < config_.minIntensity) {
+                        continue;
+                    }
+                    if (registry.write(handles_[i], [&](CreatureCore &core) {
+                            core.getTraits()
+                                .getSynthesis()
+                                .recordCatalystExposure(
+                                    traits::CatalystType::Resonance,
+                                    config_.catalystId, intensity);
+                        })) {
+                        ++local;
+                    }
+                }
+                delivered.fetch_add(local, std::memory_order_relaxed);
+            });
+        return delivered.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Up to k nearest creatures to a creature, nearest first
+     *
+     * Uses positions as of the last compute(); empty if creatures were
+     * added, moved or removed since.
+     */
+    std::vector<CreatureHandle> nearest(CreatureHandle creature,
+                                        std::size_t k) const {
+        std::vector<CreatureHandle> out;
+        auto it = slots_.find(creature.pack());
+        if (it == slots_.end() || layoutChanged_) {
+            return out;
+        }
+        std::vector<environment::SpatialHashGrid::Neighbor> neighbors;
+        grid_.nearest(xs_[it->second], ys_[it->second], k, neighbors,
+                      std::numeric_limits<float>::infinity(), it->second);
+        out.reserve(neighbors.size());
+        for (const auto &neighbor : neighbors) {
+            out.push_back(handles_[neighbor.index]);
+        }
+        return out;
+    }
+
+    const environment::SpatialHashGrid &getGrid() const { return grid_; }
+
+  private:
+    Config config_;
+    common::WorkerPool pool_;
+    environment::SpatialHashGrid grid_;
+
+    // Dense per-creature arrays; slots_ maps packed handle -> index
+    std::unordered_map<std::uint64_t, std::uint32_t> slots_;
+    std::vector<CreatureHandle> handles_;
+    std::vector<float> xs_;
+    std::vector<float> ys_;
+    std::vector<float> emission_;
+    std::vector<float> exposure_;
+    bool layoutChanged_{false}; // Grid no longer matches the arrays
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_RESONANCE_FIELD_H
@@ -0,0 +1,172 @@
+#ifndef CREATURE_ENGINE_CORE_SHARDED_SIMULATION_H
+#define CREATURE_ENGINE_CORE_SHARDED_SIMULATION_H
+
+#include "common/utils/ProcessShardGroup.h"
+#include "common/utils/SimulationClock.h"
+#include "creature_engine/core/CreatureCore.h"
+#include "creature_engine/core/CreatureRegistry.h"
+#include "creature_engine/io/CreatureCodec.h"
+#include "creature_engine/io/DeltaSnapshot.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent {
+
+/**
+ * @brief Decides which shard simulates each environment
+ *
+ * Environments are the unit of partitioning: a region is simulated by
+ * exactly one process, and a creature lives on the shard of the
+ * environment it is in. Explicit assignments win; anything unassigned
+ * is placed by a stable FNV-1a hash, so every process (and every run)
+ * agrees without coordination.
+ */
+class ShardPartition {
+  public:
+    explicit ShardPartition(std::uint32_t shardCount = 1)
+        : shardCount_(shardCount) {
+        if (shardCount_ == 0) {
+            throw std::invalid_argument("ShardPartition needs a shard");
+        }
+    }
+
+    /**
+     * @brief Pins an environment to a shard, e.g. to balance hot regions
+     */
+    void assign(std::string environment, std::uint32_t shard) {
+        if (shard >= shardCount_) {
+            throw std::out_of_range("Shard index out of range");
+        }
+        assigned_[std::move(environment)] = shard;
+    }
+
+    std::uint32_t shardFor(std::string_view environment) const {
+        if (!assigned_.empty()) {
+            auto it = assigned_.find(std::string(environment));
+            if (it != assigned_.end()) {
+                return it->second;
+            }
+        }
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        for (char c : environment) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+        }
+        return static_cast<std::uint32_t>(hash % shardCount_);
+    }
+
+    std::uint32_t shardCount() const { return shardCount_; }
+
+  private:
+    std::uint32_t shardCount_;
+    std::unordered_map<std::string, std::uint32_t> assigned_;
+};
+
+/**
+ * @brief Simulates the creatures of one shard's environments
+ *
+ * Built inside the shard process. It loads the initial snapshot and keeps
+ * only creatures whose environment maps to its shard. Each step advances
+ * the process's SimulationClock to the tick, processes stress for every
+ * local creature, then applies queued environment transitions. A
+ * transition to an environment owned by another shard removes the
+ * creature from the registry, encodes it with CreatureCore::encodeBinary,
+ * and sends it framed by io::encodeMigration; admit() decodes it, with
+ * its catalyst influences going into this process's
+ * CatalystInfluenceTable::global(), binds it to the destination
+ * environment and registers it. A creature is therefore on exactly one
+ * shard at every tick barrier.
+ */
+class CreatureShardWorker final : public common::ShardWorker {
+  public:
+    struct Config {
+        std::uint32_t shard{0};
+        ShardPartition partition;
+        std::filesystem::path snapshotDirectory; // Initial population
+        io::SnapshotId snapshotId{0};
+        std::filesystem::path outputDirectory; // Final snapshot; empty = none
+    };
+
+    /**
+     * @throws SerializationException if the snapshot cannot be loaded
+     */
+    explicit CreatureShardWorker(Config config);
+    ~CreatureShardWorker() override;
+
+    // Prevent copying and moving
+    CreatureShardWorker(const CreatureShardWorker &) = delete;
+    CreatureShardWorker &operator=(const CreatureShardWorker &) = delete;
+    CreatureShardWorker(CreatureShardWorker &&) = delete;
+    CreatureShardWorker &operator=(CreatureShardWorker &&) = delete;
+
+    // common::ShardWorker
+    void step(common::SimTick tick, common::ShardOutbox &outbox) override;
+    void admit(std::uint32_t fromShard, std::string_view payload) override;
+
+    /**
+     * @brief Writes this shard's population as a base snapshot
+     */
+    void finish() override;
+
+    /**
+     * @brief Moves a creature into environment at the end of this step
+     */
+    void requestTransition(CreatureHandle creature, std::string environment);
+
+    const CreatureRegistry &getRegistry() const { return registry_; }
+
+    struct ShardMetrics {
+        std::size_t population{0};
+        std::size_t emigrated{0};
+        std::size_t immigrated{0};
+        std::size_t encodedBytes{0};
+    };
+    ShardMetrics getMetrics() const { return metrics_; }
+
+  private:
+    Config config_;
+    CreatureRegistry registry_;
+    common::SimulationClock clock_;
+    ShardMetrics metrics_;
+
+    // Environment of each local creature, by CreatureHandle::pack()
+    std::unordered_map<std::uint64_t, std::string> environments_;
+    std::vector<std::pair<CreatureHandle, std::string>> transitions_;
+    std::string scratch_; // Reused encodeBinary buffer
+
+    void emigrate(CreatureHandle creature, const std::string &environment,
+                  common::SimTick tick, common::ShardOutbox &outbox);
+};
+
+/**
+ * @brief Runs a population across local processes, one per shard
+ */
+struct ShardedSimulationConfig {
+    ShardPartition partition;
+    std::size_t ringCapacity{1 << 20}; // Per ordered shard pair
+    common::SimTick startTick{};
+    std::uint32_t tickCount{0}; // 0 = until stopped
+    std::filesystem::path snapshotDirectory;
+    io::SnapshotId snapshotId{0};
+    std::filesystem::path outputDirectory; // Receives one snapshot per shard
+};
+
+/**
+ * @brief Forks partition.shardCount() CreatureShardWorker processes
+ *
+ * Blocks until every shard has finished; the report lists per-shard
+ * ticks, migrations, exchange and barrier time, and any failure.
+ */
+common::ProcessShardGroup::Report
+runShardedSimulation(const ShardedSimulationConfig &config);
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_SHARDED_SIMULATION_H
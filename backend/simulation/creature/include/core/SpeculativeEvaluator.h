@@ -0,0 +1,140 @@
+#ifndef CREATURE_ENGINE_CORE_SPECULATIVE_EVALUATOR_H
+#define CREATURE_ENGINE_CORE_SPECULATIVE_EVALUATOR_H
+
+#include "creature_engine/core/CreatureCore.h"
+#include "creature_engine/core/CreatureRegistry.h"
+#include "creature_engine/traits/synthesis/SynthesisEnums.h"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace crescent {
+
+/**
+ * @brief One hypothetical future to try on a forked creature
+ */
+struct AdaptationCandidate {
+    struct CatalystExposure {
+        traits::CatalystType type;
+        std::string catalystId;
+        float intensity{0.0f};
+    };
+
+    std::string label;                       // Echoed in the outcome
+    std::optional<std::string> environment;  // Fork relocated here
+    std::vector<FormChange> changes;         // Applied once before ticking
+    std::vector<CatalystExposure> catalysts; // Applied every tick
+};
+
+/**
+ * @brief Result of advancing one fork; higher score is better
+ */
+struct CandidateOutcome {
+    std::size_t candidateIndex{0};
+    std::string label;
+    float score{0.0f};
+    float finalStress{0.0f};
+    float adaptationPotential{0.0f};
+    float divergenceFromParent{0.0f};
+    bool valid{true};      // Passed validation after the last tick
+    bool speciated{false}; // Crossed the speciation threshold
+    std::size_t violations{0};
+    std::chrono::nanoseconds elapsed{0};
+};
+
+/**
+ * @brief Ranks adaptation candidates by simulating them on forks
+ *
+ * Each candidate runs on a CreatureCore::fork(), which shares state,
+ * history and the trait table with the live creature copy-on-write and
+ * clones only its few ability and synthesis states, so only the parts a
+ * candidate actually changes are copied. A candidate with an environment
+ * gets a fork bound to it (CreatureCore::fork(EnvironmentBinding)), with
+ * the system looked up through Config::resolveEnvironment. Forks are
+ * advanced for a fixed number of ticks in parallel, scored, and dropped;
+ * the live creature is never written.
+ */
+class SpeculativeEvaluator {
+  public:
+    /**
+     * @brief Scores a fork after its last tick
+     *
+     * The default favours low stress and high adaptation potential and
+     * rejects invalid end states.
+     */
+    using Scorer =
+        std::function<float(const CreatureCore &fork,
+                            const CandidateOutcome &outcome)>;
+
+    /**
+     * @brief Environment system for a candidate's environment name
+     */
+    using EnvironmentResolver = std::function<std::weak_ptr<EnvironmentSystem>(
+        const std::string &environment)>;
+
+    struct Config {
+        std::size_t ticks{100};
+        float tickSeconds{1.0f};
+        std::size_t workerCount{0}; // 0 = hardware concurrency
+        Scorer scorer;              // Empty = defaultScore
+        // Empty = relocated forks are bound by name only, with no stress
+        EnvironmentResolver resolveEnvironment;
+    };
+
+    SpeculativeEvaluator();
+    explicit SpeculativeEvaluator(Config config);
+    ~SpeculativeEvaluator();
+
+    // Prevent copying and moving
+    SpeculativeEvaluator(const SpeculativeEvaluator &) = delete;
+    SpeculativeEvaluator &operator=(const SpeculativeEvaluator &) = delete;
+    SpeculativeEvaluator(SpeculativeEvaluator &&) = delete;
+    SpeculativeEvaluator &operator=(SpeculativeEvaluator &&) = delete;
+
+    /**
+     * @brief Evaluates every candidate against one creature
+     * @return Outcomes sorted best first
+     */
+    std::vector<CandidateOutcome>
+    evaluate(const CreatureCore &creature,
+             const std::vector<AdaptationCandidate> &candidates) const;
+
+    /**
+     * @brief Forks under the registry read lock, then evaluates unlocked
+     * @return Empty if the handle is stale
+     */
+    std::vector<CandidateOutcome>
+    evaluate(const CreatureRegistry &registry, CreatureHandle handle,
+             const std::vector<AdaptationCandidate> &candidates) const;
+
+    /**
+     * @brief Advances a single, already forked creature in place
+     */
+    CandidateOutcome run(CreatureCore &fork,
+                         const AdaptationCandidate &candidate,
+                         std::size_t candidateIndex) const;
+
+    static float defaultScore(const CreatureCore &fork,
+                              const CandidateOutcome &outcome);
+
+  private:
+    Config config_;
+
+    // Internal helpers
+    std::size_t resolveWorkerCount(std::size_t candidates) const;
+    std::unique_ptr<CreatureCore>
+    forkFor(const CreatureCore &creature,
+            const AdaptationCandidate &candidate) const;
+    // Forwards each exposure to the fork's SynthesisProcessor
+    void applyCatalysts(CreatureCore &fork,
+                        const AdaptationCandidate &candidate) const;
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_SPECULATIVE_EVALUATOR_H
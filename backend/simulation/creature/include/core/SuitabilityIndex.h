@@ -0,0 +1,287 @@
+#ifndef CREATURE_ENGINE_CORE_SUITABILITY_INDEX_H
+#define CREATURE_ENGINE_CORE_SUITABILITY_INDEX_H
+
+#include "creature_engine/core/CreatureRegistry.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent {
+
+/**
+ * @brief Per-environment ranking of creatures by suitability score
+ *
+ * Each environment keeps its creatures in an ordered set (best first) plus
+ * a handle -> score map, so an update is O(log n), top-K is O(log n + k)
+ * and threshold queries are O(log n + matches). Environments are locked
+ * independently: simulation workers update while tools query.
+ *
+ * Scores are refreshed per creature and only when its registry version has
+ * moved, so a tick costs work proportional to the creatures that changed.
+ * Each score remembers the registry version it was computed from and is
+ * never replaced by one computed from an older version, so concurrent
+ * refreshes of one creature cannot publish out of order.
+ */
+class SuitabilityIndex {
+  public:
+    using EnvironmentId = std::uint32_t;
+
+    struct Entry {
+        CreatureHandle creature;
+        float score{0.0f};
+    };
+
+    SuitabilityIndex() = default;
+
+    // Prevent copying and moving
+    SuitabilityIndex(const SuitabilityIndex &) = delete;
+    SuitabilityIndex &operator=(const SuitabilityIndex &) = delete;
+    SuitabilityIndex(SuitabilityIndex &&) = delete;
+    SuitabilityIndex &operator=(SuitabilityIndex &&) = delete;
+
+    /**
+     * @brief Registers an environment; call before concurrent use
+     */
+    EnvironmentId addEnvironment(std::string_view name) {
+        auto it = environmentIds_.find(std::string(name));
+        if (it != environmentIds_.end()) {
+            return it->second;
+        }
+        const auto id = static_cast<EnvironmentId>(environments_.size());
+        environments_.emplace_back(std::make_unique<Environment>());
+        environments_.back()->name = std::string(name);
+        environmentIds_.emplace(std::string(name), id);
+        return id;
+    }
+
+    std::optional<EnvironmentId> findEnvironment(std::string_view name) const {
+        auto it = environmentIds_.find(std::string(name));
+        if (it == environmentIds_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::size_t environmentCount() const { return environments_.size(); }
+    const std::string &environmentName(EnvironmentId id) const {
+        return environments_[id]->name;
+    }
+
+    /**
+     * @brief Sets a score computed from the given registry version
+     * @return False if the stored score came from a newer version
+     */
+    bool update(CreatureHandle creature, EnvironmentId environment,
+                float score, std::uint64_t version) {
+        if (std::isnan(score)) {
+            score = -std::numeric_limits<float>::infinity();
+        }
+        Environment &env = *environments_[environment];
+        std::unique_lock<std::shared_mutex> lock(env.mutex);
+        const std::uint64_t key = creature.pack();
+        auto [it, inserted] =
+            env.scores.try_emplace(key, Scored{score, version});
+        if (!inserted) {
+            if (it->second.version > version) {
+                return false;
+            }
+            it->second.version = version;
+            if (it->second.score == score) {
+                return true;
+            }
+            env.ranking.erase({it->second.score, key});
+            it->second.score = score;
+        }
+        env.ranking.insert({score, key});
+        return true;
+    }
+
+    void remove(CreatureHandle creature) {
+        const std::uint64_t key = creature.pack();
+        for (auto &env : environments_) {
+            std::unique_lock<std::shared_mutex> lock(env->mutex);
+            auto it = env->scores.find(key);
+            if (it != env->scores.end()) {
+                env->ranking.erase({it->second.score, key});
+                env->scores.erase(it);
+            }
+        }
+        std::lock_guard<std::mutex> lock(versionsMutex_);
+        seenVersions_.erase(key);
+    }
+
+    /**
+     * @brief Rescores a creature for every environment if it changed
+     *
+     * score(const CreatureCore &, const std::string &environment) runs under
+     * the creature's read lock; CreatureCore::calculateAdaptationPotential is
+     * the usual choice. The scores are published with the version the
+     * read saw, not the one checked beforehand.
+     * @return True if the creature was rescored
+     */
+    template <typename Score>
+    bool refresh(const CreatureRegistry &registry, CreatureHandle creature,
+                 Score &&score) {
+        const std::uint64_t key = creature.pack();
+        const std::optional<std::uint64_t> current =
+            registry.getVersion(creature);
+        if (!current) {
+            remove(creature);
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(versionsMutex_);
+            auto it = seenVersions_.find(key);
+            if (it != seenVersions_.end() && it->second >= *current) {
+                return false;
+            }
+        }
+        std::vector<float> scores(environments_.size());
+        std::uint64_t version = 0;
+        const bool live = registry.read(
+            creature, [&](const CreatureCore &core, std::uint64_t seen) {
+                version = seen;
+                for (std::size_t e = 0; e < environments_.size(); ++e) {
+                    scores[e] = score(core, environments_[e]->name);
+                }
+            });
+        if (!live) {
+            remove(creature);
+            return false;
+        }
+        bool published = false;
+        for (std::size_t e = 0; e < scores.size(); ++e) {
+            published |= update(creature, static_cast<EnvironmentId>(e),
+                                scores[e], version);
+        }
+        std::lock_guard<std::mutex> lock(versionsMutex_);
+        auto [it, inserted] = seenVersions_.try_emplace(key, version);
+        if (!inserted && it->second < version) {
+            it->second = version;
+        }
+        return published;
+    }
+
+    std::optional<float> scoreOf(CreatureHandle creature,
+                                 EnvironmentId environment) const {
+        const Environment &env = *environments_[environment];
+        std::shared_lock<std::shared_mutex> lock(env.mutex);
+        auto it = env.scores.find(creature.pack());
+        if (it == env.scores.end()) {
+            return std::nullopt;
+        }
+        return it->second.score;
+    }
+
+    /**
+     * @brief Best k live creatures for an environment, best first
+     *
+     * Entries whose handle the registry no longer resolves (removed, or the
+     * slot reused under a new generation) are skipped; remove() or the next
+     * refresh drops them.
+     */
+    std::vector<Entry> topK(const CreatureRegistry &registry,
+                            EnvironmentId environment, std::size_t k) const {
+        std::vector<Entry> out;
+        if (k == 0) {
+            return out;
+        }
+        forEachAtLeast(registry, environment,
+                       -std::numeric_limits<float>::infinity(),
+                       [&](const Entry &entry) {
+                           out.push_back(entry);
+                           return out.size() < k;
+                       });
+        return out;
+    }
+
+    /**
+     * @brief Visits live creatures scoring at least threshold as fn(Entry),
+     * best first; stale handles are skipped as in topK
+     *
+     * fn may return false to stop early.
+     * @return Number visited
+     */
+    template <typename Fn>
+    std::size_t forEachAtLeast(const CreatureRegistry &registry,
+                               EnvironmentId environment, float threshold,
+                               Fn &&fn) const {
+        const Environment &env = *environments_[environment];
+        std::shared_lock<std::shared_mutex> lock(env.mutex);
+        std::size_t visited = 0;
+        for (auto it = env.ranking.begin();
+             it != env.ranking.end() && it->score >= threshold; ++it) {
+            const CreatureHandle creature =
+                CreatureHandle::unpack(it->creature);
+            if (!registry.contains(creature)) {
+                continue;
+            }
+            ++visited;
+            if constexpr (std::is_same_v<decltype(fn(std::declval<Entry>())),
+                                         bool>) {
+                if (!fn(Entry{creature, it->score})) {
+                    break;
+                }
+            } else {
+                fn(Entry{creature, it->score});
+            }
+        }
+        return visited;
+    }
+
+    std::size_t size(EnvironmentId environment) const {
+        const Environment &env = *environments_[environment];
+        std::shared_lock<std::shared_mutex> lock(env.mutex);
+        return env.scores.size();
+    }
+
+  private:
+    struct Ranked {
+        float score;
+        std::uint64_t creature;
+        bool operator<(const Ranked &other) const {
+            if (score != other.score) {
+                return score > other.score; // Best first
+            }
+            return creature < other.creature;
+        }
+    };
+
+    struct Scored {
+        float score;
+        std::uint64_t version; // Registry version the score came from
+    };
+
+    struct Environment {
+        std::string name;
+        mutable std::shared_mutex mutex;
+        std::set<Ranked> ranking;
+        std::unordered_map<std::uint64_t, Scored> scores;
+    };
+
+    std::vector<std::unique_ptr<Environment>> environments_;
+    std::unordered_map<std::string, EnvironmentId> environmentIds_;
+
+    // Newest registry version each creature was scored at; only a filter,
+    // the per-environment versions decide what is published
+    std::mutex versionsMutex_;
+    std::unordered_map<std::uint64_t, std::uint64_t> seenVersions_;
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_SUITABILITY_INDEX_H
@@ -0,0 +1,129 @@
+#ifndef CREATURE_ENGINE_CORE_VALIDATION_CODES_H
+#define CREATURE_ENGINE_CORE_VALIDATION_CODES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace crescent {
+
+/**
+ * @brief Structured reason a creature failed validation
+ */
+enum class ViolationCode : std::uint16_t {
+    MissingIdentity,         // Empty id or species
+    InvalidGeneration,       // Negative generation or missing parent
+    InvalidThemeStack,       // Theme combination not allowed
+    EnvironmentIncompatible, // State cannot exist in current environment
+    StressOutOfRange,        // Stress level outside [0, 1] or non-finite
+    DivergenceOutOfRange,    // Divergence metrics outside [0, 1]
+    HistoryOverflow,         // Change history above its configured cap
+    TraitIncompatible,       // Two active traits are incompatible
+    TraitStateInvalid,       // A trait state failed its own checks
+    AbilityStateInvalid,     // An ability state failed its own checks
+    SynthesisStateInvalid,   // The synthesis state failed its own checks
+    Count
+};
+
+constexpr std::size_t VIOLATION_CODE_COUNT =
+    static_cast<std::size_t>(ViolationCode::Count);
+
+inline const char *violationCodeName(ViolationCode code) {
+    switch (code) {
+    case ViolationCode::MissingIdentity:
+        return "MissingIdentity";
+    case ViolationCode::InvalidGeneration:
+        return "InvalidGeneration";
+    case ViolationCode::InvalidThemeStack:
+        return "InvalidThemeStack";
+    case ViolationCode::EnvironmentIncompatible:
+        return "EnvironmentIncompatible";
+    case ViolationCode::StressOutOfRange:
+        return "StressOutOfRange";
+    case ViolationCode::DivergenceOutOfRange:
+        return "DivergenceOutOfRange";
+    case ViolationCode::HistoryOverflow:
+        return "HistoryOverflow";
+    case ViolationCode::TraitIncompatible:
+        return "TraitIncompatible";
+    case ViolationCode::TraitStateInvalid:
+        return "TraitStateInvalid";
+    case ViolationCode::AbilityStateInvalid:
+        return "AbilityStateInvalid";
+    case ViolationCode::SynthesisStateInvalid:
+        return "SynthesisStateInvalid";
+    case ViolationCode::Count:
+        break;
+    }
+    return "Unknown";
+}
+
+/**
+ * @brief One violation found in a creature
+ *
+ * detail is code specific (e.g. the index of the offending trait) so the
+ * record stays trivially copyable; text is only formatted on demand.
+ *
+ * subject is the packed CreatureHandle of a registered creature, or
+ * NO_SUBJECT for a creature validated on its own. Registry slots never use
+ * generation 0, so no packed handle equals NO_SUBJECT.
+ */
+struct Violation {
+    static constexpr std::uint64_t NO_SUBJECT = 0;
+
+    std::uint64_t subject{NO_SUBJECT};
+    ViolationCode code{ViolationCode::Count};
+    std::uint32_t detail{0};
+
+    bool hasSubject() const { return subject != NO_SUBJECT; }
+};
+
+/**
+ * @brief Append-only destination for violations of a single creature
+ *
+ * Writes into a caller-owned vector that is reused across passes, so a clean
+ * creature costs nothing and a dirty one only allocates while the vector is
+ * still growing to its high-water mark.
+ *
+ * At most limit violations are stored. Checks may stop as soon as full()
+ * is true, so count() is exact below the limit and only a lower bound once
+ * it is reached.
+ */
+class ViolationSink {
+  public:
+    /**
+     * @param subject Packed CreatureHandle of the creature being checked, or
+     * Violation::NO_SUBJECT outside the registry
+     */
+    ViolationSink(std::vector<Violation> &out, std::uint64_t subject,
+                  std::size_t limit = SIZE_MAX)
+        : out_(out), subject_(subject), limit_(limit) {}
+
+    void report(ViolationCode code, std::uint32_t detail = 0) {
+        if (count_ < limit_) {
+            out_.push_back({subject_, code, detail});
+        }
+        ++count_;
+    }
+
+    /**
+     * @brief True once the limit is reached; checks may stop early
+     */
+    bool full() const { return count_ >= limit_; }
+
+    /**
+     * @brief Violations reported so far; a lower bound once full()
+     */
+    std::size_t count() const { return count_; }
+    bool clean() const { return count_ == 0; }
+
+  private:
+    std::vector<Violation> &out_;
+    std::uint64_t subject_;
+    std::size_t limit_;
+    std::size_t count_{0};
+};
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_CORE_VALIDATION_CODES_H
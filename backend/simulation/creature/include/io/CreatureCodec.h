@@ -0,0 +1,313 @@
+#ifndef CREATURE_ENGINE_IO_CREATURE_CODEC_H
+#define CREATURE_ENGINE_IO_CREATURE_CODEC_H
+
+#include "common/utils/SimulationClock.h"
+#include "creature_engine/core/Exceptions.hpp"
+#include "creature_engine/traits/synthesis/CatalystInfluenceTable.h"
+#include "creature_engine/traits/synthesis/SynthesisHistoryLog.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace crescent::io {
+
+/**
+ * @brief Primitives of the binary creature encoding
+ *
+ * CreatureCore::encodeBinary writes MAGIC, VERSION and then every field
+ * serializeToJson covers, in declaration order: unsigned integers as
+ * varints, signed ones zigzagged, floats as their raw little-endian bits
+ * (so values round-trip exactly), strings and nested records as a length
+ * varint plus bytes, optionals and maps prefixed by a presence flag or a
+ * count. Nothing is self-describing; VERSION changes with the layout.
+ *
+ * Only values are written, never ids that mean something in one process
+ * alone: traits go by id string, and the synthesis state's catalyst
+ * influences and history go through putInfluences and putHistory, which
+ * spell out every catalyst, form and trait.
+ */
+struct CreatureCodec {
+    static constexpr std::uint32_t MAGIC = 0x31455243; // "CRE1"
+    static constexpr std::uint32_t VERSION = 1;
+
+    static void putVarint(std::string &out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+    static void putSigned(std::string &out, std::int64_t value) {
+        putVarint(out, (static_cast<std::uint64_t>(value) << 1) ^
+                           static_cast<std::uint64_t>(value >> 63));
+    }
+    static void putFixed32(std::string &out, std::uint32_t value) {
+        for (unsigned i = 0; i < 4; ++i) {
+            out.push_back(static_cast<char>(value >> (8 * i)));
+        }
+    }
+    static void putFloat(std::string &out, float value) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        putFixed32(out, bits);
+    }
+    static void putBytes(std::string &out, std::string_view bytes) {
+        putVarint(out, bytes.size());
+        out.append(bytes.data(), bytes.size());
+    }
+};
+
+/**
+ * @brief Bounds-checked cursor over a binary creature record
+ *
+ * Every read throws SerializationException instead of running past the
+ * end, so a truncated migration or file is reported, never misread.
+ * Views returned by bytes() point into the input.
+ */
+class CreatureReader {
+  public:
+    explicit CreatureReader(std::string_view data) : data_(data) {}
+
+    std::uint8_t byte() {
+        if (offset_ >= data_.size()) {
+            throw SerializationException("Truncated creature record");
+        }
+        return static_cast<std::uint8_t>(data_[offset_++]);
+    }
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t b = byte();
+            value |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                return value;
+            }
+        }
+        throw SerializationException("Corrupt varint in creature record");
+    }
+    std::int64_t signedVarint() {
+        const std::uint64_t value = varint();
+        return static_cast<std::int64_t>(value >> 1) ^
+               -static_cast<std::int64_t>(value & 1);
+    }
+    std::uint32_t fixed32() {
+        std::uint32_t value = 0;
+        for (unsigned i = 0; i < 4; ++i) {
+            value |= static_cast<std::uint32_t>(byte()) << (8 * i);
+        }
+        return value;
+    }
+    float floating() {
+        const std::uint32_t bits = fixed32();
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    std::string_view bytes() {
+        const std::uint64_t length = varint();
+        if (length > data_.size() - offset_) {
+            throw SerializationException("Truncated creature record");
+        }
+        std::string_view view = data_.substr(offset_, length);
+        offset_ += length;
+        return view;
+    }
+
+    /**
+     * @throws SerializationException unless MAGIC and VERSION come next
+     */
+    void expectHeader() {
+        if (fixed32() != CreatureCodec::MAGIC) {
+            throw SerializationException("Not a creature record");
+        }
+        if (varint() != CreatureCodec::VERSION) {
+            throw SerializationException("Unsupported creature version");
+        }
+    }
+
+    bool atEnd() const { return offset_ == data_.size(); }
+
+  private:
+    std::string_view data_;
+    std::size_t offset_{0};
+};
+
+/**
+ * @throws SerializationException unless the next value is a CatalystType
+ */
+inline traits::CatalystType readCatalystType(CreatureReader &reader) {
+    const std::uint64_t type = reader.varint();
+    if (type > static_cast<std::uint64_t>(traits::CatalystType::External)) {
+        throw SerializationException("Corrupt catalyst type");
+    }
+    return static_cast<traits::CatalystType>(type);
+}
+
+/**
+ * @brief Writes an owner's catalyst influences as values
+ *
+ * Rows and interned ids belong to the writing process's table, so each
+ * row is written whole: type, catalyst id, current and peak strength, idle
+ * seconds, exposure count and affected forms, after a row count.
+ */
+inline void putInfluences(std::string &out,
+                          const traits::CatalystInfluenceTable &table,
+                          traits::CatalystInfluenceTable::OwnerId owner) {
+    std::vector<std::pair<traits::CatalystKey, traits::CatalystInfluence>>
+        rows;
+    table.forEachOf(owner, [&](const traits::CatalystKey &key,
+                               const traits::CatalystInfluence &influence) {
+        rows.emplace_back(key, influence);
+    });
+    CreatureCodec::putVarint(out, rows.size());
+    for (const auto &[key, influence] : rows) {
+        CreatureCodec::putVarint(out, static_cast<std::uint64_t>(key.type));
+        CreatureCodec::putBytes(out, key.id);
+        CreatureCodec::putFloat(out, influence.currentStrength);
+        CreatureCodec::putFloat(out, influence.peakStrength);
+        CreatureCodec::putFloat(out, influence.secondsSinceExposure);
+        CreatureCodec::putSigned(out, influence.exposureCount);
+        CreatureCodec::putVarint(out, influence.affectedForms.size());
+        for (const std::string &form : influence.affectedForms) {
+            CreatureCodec::putBytes(out, form);
+        }
+    }
+}
+
+/**
+ * @brief Restores putInfluences output as rows of owner in table
+ * @throws SerializationException on truncated or corrupt input
+ */
+inline void readInfluences(CreatureReader &reader,
+                           traits::CatalystInfluenceTable &table,
+                           traits::CatalystInfluenceTable::OwnerId owner) {
+    const std::uint64_t rows = reader.varint();
+    for (std::uint64_t i = 0; i < rows; ++i) {
+        traits::CatalystKey key;
+        key.type = readCatalystType(reader);
+        key.id = std::string(reader.bytes());
+        traits::CatalystInfluence influence;
+        influence.currentStrength = reader.floating();
+        influence.peakStrength = reader.floating();
+        influence.secondsSinceExposure = reader.floating();
+        influence.exposureCount = static_cast<int>(reader.signedVarint());
+        const std::uint64_t forms = reader.varint();
+        for (std::uint64_t f = 0; f < forms; ++f) {
+            influence.affectedForms.emplace_back(reader.bytes());
+        }
+        table.restore(owner, key, influence);
+    }
+}
+
+/**
+ * @brief Writes a history log's events as values, oldest first
+ *
+ * Interner ids belong to the writing process, so forms, catalyst ids and
+ * traits are written as strings, and ticks as absolute values.
+ */
+inline void putHistory(std::string &out,
+                       const traits::SynthesisHistoryLog &history) {
+    CreatureCodec::putVarint(out, history.maxEvents());
+    const std::vector<traits::SynthesisEvent> events = history.recent();
+    CreatureCodec::putVarint(out, events.size());
+    for (const traits::SynthesisEvent &event : events) {
+        CreatureCodec::putBytes(out, event.sourceForm);
+        CreatureCodec::putBytes(out, event.resultForm);
+        CreatureCodec::putVarint(
+            out, static_cast<std::uint64_t>(event.catalystType));
+        CreatureCodec::putBytes(out, event.catalystId);
+        CreatureCodec::putFloat(out, event.intensity);
+        CreatureCodec::putVarint(out, static_cast<std::uint64_t>(event.stage));
+        CreatureCodec::putVarint(out, event.affectedTraits.size());
+        for (const std::string &trait : event.affectedTraits) {
+            CreatureCodec::putBytes(out, trait);
+        }
+        CreatureCodec::putVarint(out, event.timestamp.value);
+    }
+}
+
+/**
+ * @brief Rebuilds putHistory output, interning into strings
+ * @throws SerializationException on truncated or corrupt input
+ */
+inline traits::SynthesisHistoryLog readHistory(
+    CreatureReader &reader,
+    common::StringInterner &strings =
+        traits::SynthesisHistoryLog::sharedStrings()) {
+    traits::SynthesisHistoryLog history(reader.varint(), strings);
+    const std::uint64_t events = reader.varint();
+    traits::SynthesisEvent event;
+    for (std::uint64_t i = 0; i < events; ++i) {
+        event.sourceForm = std::string(reader.bytes());
+        event.resultForm = std::string(reader.bytes());
+        event.catalystType = readCatalystType(reader);
+        event.catalystId = std::string(reader.bytes());
+        event.intensity = reader.floating();
+        const std::uint64_t stage = reader.varint();
+        if (stage > static_cast<std::uint64_t>(
+                        traits::SynthesisStage::Critical)) {
+            throw SerializationException("Corrupt synthesis stage");
+        }
+        event.stage = static_cast<traits::SynthesisStage>(stage);
+        event.affectedTraits.clear();
+        const std::uint64_t traitCount = reader.varint();
+        for (std::uint64_t t = 0; t < traitCount; ++t) {
+            event.affectedTraits.emplace_back(reader.bytes());
+        }
+        event.timestamp = {static_cast<std::uint32_t>(reader.varint())};
+        history.append(event);
+    }
+    return history;
+}
+
+/**
+ * @brief A creature in transit between shards
+ */
+struct MigrationRecord {
+    common::SimTick tick{}; // Tick the creature left
+    std::uint32_t fromShard{0};
+    std::string_view destination; // Environment it moves into
+    std::string_view creature;    // CreatureCore::encodeBinary output
+};
+
+/**
+ * @brief Frames an encoded creature with its routing data
+ */
+inline std::string encodeMigration(common::SimTick tick,
+                                   std::uint32_t fromShard,
+                                   std::string_view destination,
+                                   std::string_view creature) {
+    std::string out;
+    out.reserve(creature.size() + destination.size() + 16);
+    CreatureCodec::putVarint(out, tick.value);
+    CreatureCodec::putVarint(out, fromShard);
+    CreatureCodec::putBytes(out, destination);
+    CreatureCodec::putBytes(out, creature);
+    return out;
+}
+
+/**
+ * @brief Views into payload; valid while payload is
+ * @throws SerializationException on truncated or corrupt input
+ */
+inline MigrationRecord decodeMigration(std::string_view payload) {
+    CreatureReader reader(payload);
+    MigrationRecord record;
+    record.tick = {static_cast<std::uint32_t>(reader.varint())};
+    record.fromShard = static_cast<std::uint32_t>(reader.varint());
+    record.destination = reader.bytes();
+    record.creature = reader.bytes();
+    if (!reader.atEnd()) {
+        throw SerializationException("Trailing bytes in migration record");
+    }
+    return record;
+}
+
+} // namespace crescent::io
+
+#endif // CREATURE_ENGINE_IO_CREATURE_CODEC_H
@@ -0,0 +1,53 @@
+#ifndef CREATURE_ENGINE_IO_DELTA_SNAPSHOT_H
+#define CREATURE_ENGINE_IO_DELTA_SNAPSHOT_H
+
+#include "creature_engine/core/CreatureCore.h"
+#include "creature_engine/io/SerializationStructures.h"
+#include "creature_engine/io/SnapshotStore.h"
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent::io {
+
+/**
+ * @brief Writes base and delta snapshots of CreatureCore populations
+ *
+ * See BasicDeltaSnapshotWriter for the chain and dirty-bit rules.
+ */
+using DeltaSnapshotWriter =
+    BasicDeltaSnapshotWriter<CreatureCore, SerializationOptions>;
+
+/**
+ * @brief Reconstructs a population from a base snapshot and its deltas
+ */
+class DeltaSnapshotReader : public SnapshotReader {
+  public:
+    explicit DeltaSnapshotReader(std::filesystem::path directory)
+        : SnapshotReader(std::move(directory)) {}
+
+    /**
+     * @brief Loads creatures as of head
+     *
+     * Their ticks count on the clock in head's header; install
+     * SimulationClock(header.clock) before stepping them.
+     */
+    std::vector<CreatureCore> loadPopulation(SnapshotId head) const {
+        const std::unordered_map<std::string, CreatureDeltaRecord> merged =
+            loadMerged(head);
+        std::vector<CreatureCore> population;
+        population.reserve(merged.size());
+        for (const auto &entry : merged) {
+            population.push_back(
+                CreatureCore::deserializeFromJson(entry.second.payload));
+        }
+        return population;
+    }
+};
+
+} // namespace crescent::io
+
+#endif // CREATURE_ENGINE_IO_DELTA_SNAPSHOT_H
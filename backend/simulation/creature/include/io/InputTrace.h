@@ -0,0 +1,546 @@
+#ifndef CREATURE_ENGINE_IO_INPUT_TRACE_H
+#define CREATURE_ENGINE_IO_INPUT_TRACE_H
+
+#include "common/utils/SimulationClock.h"
+#include "creature_engine/core/Exceptions.h"
+#include "creature_engine/core/changes/FormChange.h"
+#include "creature_engine/io/DeltaSnapshot.h"
+#include "creature_engine/traits/synthesis/SynthesisEnums.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent::io {
+
+/**
+ * @brief Encodes a FormChange for a trace; defined alongside its JSON form
+ */
+std::string encodeTracedChange(const FormChange &change);
+FormChange decodeTracedChange(std::string_view payload);
+
+enum class TraceRecordKind : std::uint8_t {
+    End,                   // Last record; carries the record count
+    Tick,                  // The scheduler finished a tick
+    FormChange,            // Change applied to a creature
+    EnvironmentTransition, // Creature moved between environments
+    CatalystExposure,      // Exposure delivered to a creature's synthesis
+    Seed                   // Seed drawn for a random stream
+};
+
+/**
+ * @brief Everything needed to start a replay before the first record
+ */
+struct TraceHeader {
+    std::int64_t tickLengthMicros{100000};
+    std::int64_t epochMillis{0}; // Wall time of tick 0, Unix milliseconds
+    common::SimTick startTick{};
+    std::uint64_t runSeed{0};
+    SnapshotId snapshotId{0};      // Initial population
+    std::string snapshotDirectory; // Relative to the trace file if relative
+};
+
+/**
+ * @brief One decoded record; views stay valid while the reader lives
+ */
+struct TraceRecord {
+    TraceRecordKind kind{TraceRecordKind::End};
+    common::SimTick tick{};
+    std::string_view creatureId; // FormChange, transition and exposure
+    std::string_view name;       // Source environment, catalyst id or stream
+    std::string_view target;     // Target environment or catalyst form
+    std::string_view payload;    // encodeTracedChange output
+    traits::CatalystType catalystType{traits::CatalystType::Environmental};
+    float intensity{0.0f};
+    std::uint64_t seed{0};
+};
+
+/**
+ * @brief Byte layout shared by InputTraceWriter and InputTraceReader
+ *
+ * A file is MAGIC, a version word, the header, then records. Each record
+ * is a kind byte, the ticks since the previous record as a varint, and its
+ * fields. Strings are written once: a reference is a varint id, with 0
+ * meaning "new string follows" (length and bytes), assigned the next id.
+ * Creature and catalyst ids repeat constantly, so most records are a
+ * handful of bytes. Integers are little-endian.
+ */
+struct TraceFormat {
+    static constexpr char MAGIC[8] = {'C', 'R', 'S', 'T', 'R', 'A', 'C', 'E'};
+    static constexpr std::uint32_t VERSION = 1;
+
+    static void putVarint(std::string &out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<char>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+    static void putFixed(std::string &out, std::uint64_t value,
+                         unsigned bytes) {
+        for (unsigned i = 0; i < bytes; ++i) {
+            out.push_back(static_cast<char>(value >> (8 * i)));
+        }
+    }
+    static std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^
+               static_cast<std::uint64_t>(value >> 63);
+    }
+    static std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^
+               -static_cast<std::int64_t>(value & 1);
+    }
+};
+
+/**
+ * @brief Captures the inputs of a run so it can be replayed offline
+ *
+ * Engine entry points check active() and, when a writer is installed,
+ * record what they were given: CreatureCore::applyChange,
+ * createAdaptedOffspring, SynthesisProcessor::recordCatalystExposure and
+ * every seed handed to a random stream. The scheduler records a Tick after
+ * each step. With no writer installed the cost is one relaxed load.
+ *
+ * Records from concurrent threads are serialized under one lock in the
+ * order they happened, which is the order a replay applies them. The
+ * buffer is flushed to disk every FLUSH_BYTES, so a crash loses at most
+ * that much; a file without an End record reads as truncated.
+ *
+ * A failed write throws SerializationException from whichever call
+ * flushed: the record that crossed FLUSH_BYTES, flush() or close(). The
+ * writer then drops every later record, and close() throws again, so a
+ * broken trace is never mistaken for a complete one.
+ *
+ * The writer holds a pin on the header's base snapshot, so a
+ * SnapshotCompactor sharing the chain cannot retire it mid-capture.
+ * Replaying later still needs the base on disk; copy or keep it pinned.
+ */
+class InputTraceWriter {
+  public:
+    static constexpr std::size_t FLUSH_BYTES = 1 << 16;
+
+    /**
+     * @param base Pin on header.snapshotId, e.g. chain.pin(id)
+     * @throws SerializationException if base does not pin the header's
+     * snapshot or the file cannot be created
+     */
+    InputTraceWriter(const std::filesystem::path &path,
+                     const TraceHeader &header, SnapshotChain::Pin base)
+        : path_(path), base_(std::move(base)) {
+        if (!base_ || base_.header().id != header.snapshotId) {
+            throw SerializationException(
+                "Trace base snapshot " + std::to_string(header.snapshotId) +
+                " is not pinned");
+        }
+        out_.open(path, std::ios::binary | std::ios::trunc);
+        if (!out_) {
+            throw SerializationException("Cannot create trace file " +
+                                         path.string());
+        }
+        buffer_.append(TraceFormat::MAGIC, sizeof(TraceFormat::MAGIC));
+        TraceFormat::putFixed(buffer_, TraceFormat::VERSION, 4);
+        TraceFormat::putVarint(buffer_, TraceFormat::zigzag(
+                                            header.tickLengthMicros));
+        TraceFormat::putVarint(buffer_,
+                               TraceFormat::zigzag(header.epochMillis));
+        TraceFormat::putVarint(buffer_, header.startTick.value);
+        TraceFormat::putFixed(buffer_, header.runSeed, 8);
+        TraceFormat::putVarint(buffer_, header.snapshotId);
+        putBytes(header.snapshotDirectory);
+        lastTick_ = header.startTick;
+    }
+
+    ~InputTraceWriter() {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+
+    // Prevent copying and moving
+    InputTraceWriter(const InputTraceWriter &) = delete;
+    InputTraceWriter &operator=(const InputTraceWriter &) = delete;
+    InputTraceWriter(InputTraceWriter &&) = delete;
+    InputTraceWriter &operator=(InputTraceWriter &&) = delete;
+
+    void recordTick(common::SimTick tick) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        begin(TraceRecordKind::Tick, tick);
+    }
+
+    void recordFormChange(common::SimTick tick, const std::string &creatureId,
+                          const FormChange &change) {
+        const std::string payload = encodeTracedChange(change);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!begin(TraceRecordKind::FormChange, tick)) {
+            return;
+        }
+        putString(creatureId);
+        putBytes(payload);
+    }
+
+    void recordEnvironmentTransition(common::SimTick tick,
+                                     const std::string &creatureId,
+                                     const std::string &from,
+                                     const std::string &to) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!begin(TraceRecordKind::EnvironmentTransition, tick)) {
+            return;
+        }
+        putString(creatureId);
+        putString(from);
+        putString(to);
+    }
+
+    void recordCatalystExposure(common::SimTick tick,
+                                const std::string &creatureId,
+                                traits::CatalystType type,
+                                const std::string &catalystId,
+                                float intensity,
+                                const std::string &form = {}) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &intensity, sizeof(bits));
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!begin(TraceRecordKind::CatalystExposure, tick)) {
+            return;
+        }
+        putString(creatureId);
+        buffer_.push_back(static_cast<char>(type));
+        putString(catalystId);
+        TraceFormat::putFixed(buffer_, bits, 4);
+        putString(form);
+    }
+
+    void recordSeed(common::SimTick tick, const std::string &stream,
+                    std::uint64_t seed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!begin(TraceRecordKind::Seed, tick)) {
+            return;
+        }
+        putString(stream);
+        TraceFormat::putFixed(buffer_, seed, 8);
+    }
+
+    /**
+     * @brief Writes buffered records to the file and the OS
+     * @throws SerializationException if the write fails, now or earlier
+     */
+    void flush() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        throwIfFailed();
+        if (!closed_) {
+            flushBuffer();
+        }
+    }
+
+    /**
+     * @brief Writes the End record and flushes; later records are dropped
+     * @throws SerializationException if the file could not be written
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        throwIfFailed();
+        if (closed_) {
+            return;
+        }
+        closed_ = true;
+        buffer_.push_back(static_cast<char>(TraceRecordKind::End));
+        TraceFormat::putVarint(buffer_, 0);
+        TraceFormat::putVarint(buffer_, records_);
+        flushBuffer();
+        out_.close();
+        if (!out_) {
+            fail();
+        }
+        base_.reset();
+    }
+
+    std::uint64_t recordCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+    std::uint64_t bytesWritten() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return flushed_ + buffer_.size();
+    }
+
+    /**
+     * @brief The writer engine hooks record into, or nullptr
+     */
+    static InputTraceWriter *active() {
+        return installed().load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Starts capture into writer; nullptr stops it
+     *
+     * The caller keeps ownership and must uninstall before destroying it.
+     */
+    static void install(InputTraceWriter *writer) {
+        installed().store(writer, std::memory_order_release);
+    }
+
+  private:
+    mutable std::mutex mutex_;
+    std::filesystem::path path_;
+    SnapshotChain::Pin base_;
+    std::ofstream out_;
+    std::string buffer_;
+    std::uint64_t flushed_{0};
+    std::uint64_t records_{0};
+    common::SimTick lastTick_{};
+    std::unordered_map<std::string, std::uint32_t> stringIds_;
+    bool closed_{false};
+    bool failed_{false};
+
+    static std::atomic<InputTraceWriter *> &installed() {
+        static std::atomic<InputTraceWriter *> writer{nullptr};
+        return writer;
+    }
+
+    bool begin(TraceRecordKind kind, common::SimTick tick) {
+        if (closed_) {
+            return false;
+        }
+        if (buffer_.size() >= FLUSH_BYTES) {
+            flushBuffer();
+        }
+        buffer_.push_back(static_cast<char>(kind));
+        // Modulo 2^32, so a stamp taken just before a Tick still decodes
+        TraceFormat::putVarint(buffer_, tick.ticksSince(lastTick_));
+        lastTick_ = tick;
+        ++records_;
+        return true;
+    }
+
+    void putBytes(std::string_view bytes) {
+        TraceFormat::putVarint(buffer_, bytes.size());
+        buffer_.append(bytes.data(), bytes.size());
+    }
+
+    void putString(const std::string &text) {
+        auto [it, inserted] = stringIds_.try_emplace(
+            text, static_cast<std::uint32_t>(stringIds_.size() + 1));
+        if (!inserted) {
+            TraceFormat::putVarint(buffer_, it->second);
+            return;
+        }
+        TraceFormat::putVarint(buffer_, 0);
+        putBytes(text);
+    }
+
+    // The buffer only ever holds whole records, so a throw here never
+    // leaves half a record behind
+    void flushBuffer() {
+        out_.write(buffer_.data(),
+                   static_cast<std::streamsize>(buffer_.size()));
+        out_.flush();
+        if (!out_) {
+            fail();
+        }
+        flushed_ += buffer_.size();
+        buffer_.clear();
+    }
+
+    [[noreturn]] void fail() {
+        failed_ = true;
+        closed_ = true;
+        buffer_.clear();
+        throw SerializationException(failureMessage());
+    }
+
+    void throwIfFailed() const {
+        if (failed_) {
+            throw SerializationException(failureMessage());
+        }
+    }
+
+    std::string failureMessage() const {
+        return "Failed to write trace file " + path_.string() + " after " +
+               std::to_string(flushed_) + " bytes";
+    }
+};
+
+/**
+ * @brief Decodes a trace written by InputTraceWriter
+ *
+ * The whole file is read up front so a replay measures the engine, not
+ * the disk. Records are decoded one at a time into a caller-owned
+ * TraceRecord, whose string views point into the reader.
+ */
+class InputTraceReader {
+  public:
+    /**
+     * @throws SerializationException if the file is missing, not a trace,
+     * or from a newer format version
+     */
+    explicit InputTraceReader(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            throw SerializationException("Cannot open trace file " +
+                                         path.string());
+        }
+        data_.assign(std::istreambuf_iterator<char>(in),
+                     std::istreambuf_iterator<char>());
+        if (data_.size() < sizeof(TraceFormat::MAGIC) + 4 ||
+            data_.compare(0, sizeof(TraceFormat::MAGIC), TraceFormat::MAGIC,
+                          sizeof(TraceFormat::MAGIC)) != 0) {
+            throw SerializationException("Not a trace file: " +
+                                         path.string());
+        }
+        offset_ = sizeof(TraceFormat::MAGIC);
+        if (fixed(4) != TraceFormat::VERSION) {
+            throw SerializationException("Unsupported trace version in " +
+                                         path.string());
+        }
+        header_.tickLengthMicros = TraceFormat::unzigzag(varint());
+        header_.epochMillis = TraceFormat::unzigzag(varint());
+        header_.startTick = {static_cast<std::uint32_t>(varint())};
+        header_.runSeed = fixed(8);
+        header_.snapshotId = varint();
+        header_.snapshotDirectory = std::string(bytes());
+        firstRecord_ = offset_;
+        reset();
+    }
+
+    // Prevent copying and moving; records hold views into the reader
+    InputTraceReader(const InputTraceReader &) = delete;
+    InputTraceReader &operator=(const InputTraceReader &) = delete;
+    InputTraceReader(InputTraceReader &&) = delete;
+    InputTraceReader &operator=(InputTraceReader &&) = delete;
+
+    const TraceHeader &header() const { return header_; }
+    std::size_t sizeBytes() const { return data_.size(); }
+
+    /**
+     * @brief Decodes the next record
+     * @return False once the End record has been read
+     * @throws SerializationException on truncated or corrupt input
+     */
+    bool next(TraceRecord &record) {
+        if (done_) {
+            return false;
+        }
+        const auto kind = static_cast<TraceRecordKind>(byte());
+        tick_ = {tick_.value + static_cast<std::uint32_t>(varint())};
+        record = TraceRecord{};
+        record.kind = kind;
+        record.tick = tick_;
+        switch (kind) {
+        case TraceRecordKind::End:
+            if (varint() != records_) {
+                throw SerializationException("Trace record count mismatch");
+            }
+            done_ = true;
+            return false;
+        case TraceRecordKind::Tick:
+            break;
+        case TraceRecordKind::FormChange:
+            record.creatureId = string();
+            record.payload = bytes();
+            break;
+        case TraceRecordKind::EnvironmentTransition:
+            record.creatureId = string();
+            record.name = string();
+            record.target = string();
+            break;
+        case TraceRecordKind::CatalystExposure: {
+            record.creatureId = string();
+            record.catalystType = static_cast<traits::CatalystType>(byte());
+            record.name = string();
+            const auto bits = static_cast<std::uint32_t>(fixed(4));
+            std::memcpy(&record.intensity, &bits, sizeof(bits));
+            record.target = string();
+            break;
+        }
+        case TraceRecordKind::Seed:
+            record.name = string();
+            record.seed = fixed(8);
+            break;
+        default:
+            throw SerializationException("Unknown trace record kind");
+        }
+        ++records_;
+        return true;
+    }
+
+    /**
+     * @brief Rewinds to the first record, e.g. between benchmark runs
+     */
+    void reset() {
+        offset_ = firstRecord_;
+        tick_ = header_.startTick;
+        records_ = 0;
+        done_ = false;
+        strings_.clear();
+    }
+
+  private:
+    std::string data_;
+    TraceHeader header_;
+    std::size_t firstRecord_{0};
+    std::size_t offset_{0};
+    common::SimTick tick_{};
+    std::uint64_t records_{0};
+    bool done_{false};
+    std::vector<std::string_view> strings_; // By id - 1, views into data_
+
+    std::uint8_t byte() {
+        if (offset_ >= data_.size()) {
+            throw SerializationException("Truncated trace file");
+        }
+        return static_cast<std::uint8_t>(data_[offset_++]);
+    }
+    std::uint64_t varint() {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t b = byte();
+            value |= static_cast<std::uint64_t>(b & 0x7f) << shift;
+            if (!(b & 0x80)) {
+                return value;
+            }
+        }
+        throw SerializationException("Corrupt varint in trace file");
+    }
+    std::uint64_t fixed(unsigned count) {
+        std::uint64_t value = 0;
+        for (unsigned i = 0; i < count; ++i) {
+            value |= static_cast<std::uint64_t>(byte()) << (8 * i);
+        }
+        return value;
+    }
+    std::string_view bytes() {
+        const std::uint64_t length = varint();
+        if (length > data_.size() - offset_) {
+            throw SerializationException("Truncated trace file");
+        }
+        std::string_view view(data_.data() + offset_,
+                              static_cast<std::size_t>(length));
+        offset_ += static_cast<std::size_t>(length);
+        return view;
+    }
+    std::string_view string() {
+        const std::uint64_t id = varint();
+        if (id == 0) {
+            strings_.push_back(bytes());
+            return strings_.back();
+        }
+        if (id > strings_.size()) {
+            throw SerializationException("Bad string reference in trace");
+        }
+        return strings_[id - 1];
+    }
+};
+
+} // namespace crescent::io
+
+#endif // CREATURE_ENGINE_IO_INPUT_TRACE_H
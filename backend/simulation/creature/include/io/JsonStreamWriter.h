@@ -0,0 +1,323 @@
+#ifndef CREATURE_ENGINE_IO_JSON_STREAM_WRITER_H
+#define CREATURE_ENGINE_IO_JSON_STREAM_WRITER_H
+
+#include <array>
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <nlohmann/json.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unistd.h>
+
+namespace crescent::io {
+
+/**
+ * @brief Object key validated once to need no escaping
+ *
+ * Declare keys as constants (static constexpr JsonKey NAME{"name"}) so the
+ * writer can copy them verbatim instead of escaping per call.
+ */
+class JsonKey {
+  public:
+    constexpr explicit JsonKey(std::string_view name) : name_(name) {
+        for (char c : name) {
+            if (c == '"' || c == '\\' ||
+                static_cast<unsigned char>(c) < 0x20) {
+                throw std::invalid_argument("JsonKey requires a plain key");
+            }
+        }
+    }
+    constexpr std::string_view name() const { return name_; }
+
+  private:
+    std::string_view name_;
+};
+
+/**
+ * @brief Streams compact JSON text without building a DOM
+ *
+ * Output matches nlohmann::json::dump() byte for byte provided the caller
+ * writes object keys in ascending order, as nlohmann stores objects in a
+ * std::map. Floats go through nlohmann's own shortest round-trip formatter,
+ * widened to double first exactly as the DOM does; non-finite values become
+ * null. Strings are escaped like dump() with ensure_ascii off; invalid UTF-8
+ * is passed through rather than rejected.
+ *
+ * When constructed with a file descriptor the buffer is flushed whenever it
+ * passes flushThreshold, keeping memory flat for whole-population dumps.
+ * Write errors are sticky: the first one is kept in getError(), later
+ * output is discarded, and every flush() after it returns false, so a
+ * caller that checks the final flush() sees a failure from any point.
+ *
+ * Nesting deeper than MAX_DEPTH throws std::length_error and closing more
+ * containers than were opened throws std::logic_error.
+ */
+class JsonStreamWriter {
+  public:
+    static constexpr std::size_t DEFAULT_FLUSH_THRESHOLD = 1 << 16;
+    static constexpr std::size_t MAX_DEPTH = 64;
+
+    JsonStreamWriter() = default;
+    explicit JsonStreamWriter(
+        int fd, std::size_t flushThreshold = DEFAULT_FLUSH_THRESHOLD)
+        : fd_(fd), flushThreshold_(flushThreshold) {
+        buffer_.reserve(flushThreshold + flushThreshold / 4);
+    }
+    ~JsonStreamWriter() { flush(); }
+
+    // Prevent copying and moving
+    JsonStreamWriter(const JsonStreamWriter &) = delete;
+    JsonStreamWriter &operator=(const JsonStreamWriter &) = delete;
+    JsonStreamWriter(JsonStreamWriter &&) = delete;
+    JsonStreamWriter &operator=(JsonStreamWriter &&) = delete;
+
+    // Structure
+    JsonStreamWriter &beginObject() { return open('{'); }
+    JsonStreamWriter &endObject() { return close('}'); }
+    JsonStreamWriter &beginArray() { return open('['); }
+    JsonStreamWriter &endArray() { return close(']'); }
+
+    JsonStreamWriter &key(const JsonKey &name) {
+        separate();
+        buffer_ += '"';
+        buffer_ += name.name();
+        buffer_ += "\":";
+        afterKey_ = true;
+        return *this;
+    }
+
+    /**
+     * @brief Writes a key that is not known ahead of time (map keys)
+     */
+    JsonStreamWriter &dynamicKey(std::string_view name) {
+        separate();
+        writeEscaped(name);
+        buffer_ += ':';
+        afterKey_ = true;
+        return *this;
+    }
+
+    // Values
+    JsonStreamWriter &value(std::string_view text) {
+        separate();
+        writeEscaped(text);
+        return finishValue();
+    }
+    JsonStreamWriter &value(const char *text) {
+        return value(std::string_view(text));
+    }
+    JsonStreamWriter &value(const std::string &text) {
+        return value(std::string_view(text));
+    }
+    JsonStreamWriter &value(bool flag) {
+        separate();
+        buffer_ += flag ? "true" : "false";
+        return finishValue();
+    }
+    JsonStreamWriter &value(std::int64_t number) {
+        separate();
+        appendInteger(number < 0, number < 0
+                                      ? 0 - static_cast<std::uint64_t>(number)
+                                      : static_cast<std::uint64_t>(number));
+        return finishValue();
+    }
+    JsonStreamWriter &value(std::uint64_t number) {
+        separate();
+        appendInteger(false, number);
+        return finishValue();
+    }
+    JsonStreamWriter &value(int number) {
+        return value(static_cast<std::int64_t>(number));
+    }
+    JsonStreamWriter &value(unsigned number) {
+        return value(static_cast<std::uint64_t>(number));
+    }
+    JsonStreamWriter &value(double number) {
+        separate();
+        if (!std::isfinite(number)) {
+            buffer_ += "null";
+        } else {
+            std::array<char, 64> digits;
+            char *end = nlohmann::detail::to_chars(
+                digits.data(), digits.data() + digits.size(), number);
+            buffer_.append(digits.data(), end);
+        }
+        return finishValue();
+    }
+    JsonStreamWriter &value(float number) {
+        return value(static_cast<double>(number));
+    }
+    JsonStreamWriter &null() {
+        separate();
+        buffer_ += "null";
+        return finishValue();
+    }
+
+    /**
+     * @brief Splices an already serialized JSON value (e.g. a cached
+     * fragment) in place of a value
+     */
+    JsonStreamWriter &raw(std::string_view json) {
+        separate();
+        buffer_ += json;
+        return finishValue();
+    }
+
+    // Output
+    const std::string &str() const { return buffer_; }
+    std::string take() { return std::move(buffer_); }
+    void clear() {
+        buffer_.clear();
+        depth_ = 0;
+        needsComma_[0] = false;
+        afterKey_ = false;
+    }
+
+    /**
+     * @brief Writes buffered bytes to the descriptor, if any
+     *
+     * Retries short writes and EINTR.
+     * @return False if this or any earlier write failed
+     */
+    bool flush() {
+        if (fd_ < 0) {
+            return true;
+        }
+        std::size_t offset = 0;
+        while (error_ == 0 && offset < buffer_.size()) {
+            const ssize_t written =
+                ::write(fd_, buffer_.data() + offset, buffer_.size() - offset);
+            if (written > 0) {
+                offset += static_cast<std::size_t>(written);
+            } else if (written < 0 && errno == EINTR) {
+                continue;
+            } else {
+                error_ = written < 0 ? errno : EIO;
+            }
+        }
+        buffer_.clear();
+        return error_ == 0;
+    }
+
+    /**
+     * @brief errno of the first failed write, or 0
+     */
+    int getError() const { return error_; }
+
+  private:
+    std::string buffer_;
+    int fd_{-1};
+    std::size_t flushThreshold_{DEFAULT_FLUSH_THRESHOLD};
+    int error_{0};
+
+    // needsComma_[d] is set once the container at depth d has a member
+    std::array<bool, MAX_DEPTH + 1> needsComma_{};
+    std::size_t depth_{0};
+    bool afterKey_{false};
+
+    JsonStreamWriter &open(char bracket) {
+        if (depth_ == MAX_DEPTH) {
+            throw std::length_error("JsonStreamWriter: nesting exceeds "
+                                    "MAX_DEPTH");
+        }
+        separate();
+        buffer_ += bracket;
+        needsComma_[++depth_] = false;
+        return *this;
+    }
+
+    JsonStreamWriter &close(char bracket) {
+        if (depth_ == 0) {
+            throw std::logic_error("JsonStreamWriter: close without a "
+                                   "matching begin");
+        }
+        buffer_ += bracket;
+        --depth_;
+        return finishValue();
+    }
+
+    void separate() {
+        if (afterKey_) {
+            afterKey_ = false;
+            return;
+        }
+        if (needsComma_[depth_]) {
+            buffer_ += ',';
+        }
+        needsComma_[depth_] = true;
+    }
+
+    JsonStreamWriter &finishValue() {
+        // Partial documents are fine on a descriptor; flush at any depth
+        if (fd_ >= 0 && buffer_.size() >= flushThreshold_) {
+            flush();
+        }
+        return *this;
+    }
+
+    void appendInteger(bool negative, std::uint64_t magnitude) {
+        std::array<char, 20> digits;
+        std::size_t count = 0;
+        do {
+            digits[count++] = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (negative) {
+            buffer_ += '-';
+        }
+        while (count > 0) {
+            buffer_ += digits[--count];
+        }
+    }
+
+    void writeEscaped(std::string_view text) {
+        static constexpr char HEX[] = "0123456789abcdef";
+        buffer_ += '"';
+        std::size_t runStart = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            buffer_.append(text.data() + runStart, i - runStart);
+            runStart = i + 1;
+            switch (c) {
+            case '"':
+                buffer_ += "\\\"";
+                break;
+            case '\\':
+                buffer_ += "\\\\";
+                break;
+            case '\b':
+                buffer_ += "\\b";
+                break;
+            case '\t':
+                buffer_ += "\\t";
+                break;
+            case '\n':
+                buffer_ += "\\n";
+                break;
+            case '\f':
+                buffer_ += "\\f";
+                break;
+            case '\r':
+                buffer_ += "\\r";
+                break;
+            default:
+                buffer_ += "\\u00";
+                buffer_ += HEX[c >> 4];
+                buffer_ += HEX[c & 0xf];
+                break;
+            }
+        }
+        buffer_.append(text.data() + runStart, text.size() - runStart);
+        buffer_ += '"';
+    }
+};
+
+} // namespace crescent::io
+
+#endif // CREATURE_ENGINE_IO_JSON_STREAM_WRITER_H
@@ -0,0 +1,25 @@
+#ifndef CREATURE_ENGINE_IO_SERIALIZATION_CACHE_H
+#define CREATURE_ENGINE_IO_SERIALIZATION_CACHE_H
+
+#include "common/utils/VersionedByteCache.h"
+#include "creature_engine/io/SerializationStructures.h"
+
+namespace crescent {
+
+using common::SerializedBytes;
+using common::VersionStamp;
+
+/**
+ * @brief Serialized-output cache keyed by the options themselves
+ *
+ * Each entry keeps a copy of the SerializationOptions it was built with
+ * and a lookup matches only on operator==, so option sets that differ in
+ * any field never share bytes. Options are a few flags and small fields,
+ * so the copy costs no more than a packed key would.
+ */
+using SerializationByteCache =
+    common::BasicVersionedByteCache<SerializationOptions>;
+
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_IO_SERIALIZATION_CACHE_H
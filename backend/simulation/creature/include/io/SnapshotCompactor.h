@@ -0,0 +1,244 @@
+#ifndef CREATURE_ENGINE_IO_SNAPSHOT_COMPACTOR_H
+#define CREATURE_ENGINE_IO_SNAPSHOT_COMPACTOR_H
+
+#include "creature_engine/io/SnapshotStore.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent::io {
+
+/**
+ * @brief When a delta chain should be folded into a fresh base
+ */
+struct CompactionPolicy {
+    std::uint32_t maxChainDepth{16};  // Deltas before forcing a merge
+    float maxDeltaToBaseRatio{0.5f};  // Delta bytes relative to base bytes
+    bool deleteMergedSnapshots{true}; // Retire files once superseded
+};
+
+/**
+ * @brief Merges delta chains into new base snapshots on a background thread
+ *
+ * Compaction works purely on files, never on live creatures, so it does not
+ * contend with the simulation. It shares the writer's SnapshotChain: merged
+ * bases take their ids from it, and are published with publishCompacted()
+ * so they replace the head only if the writer has not moved on. The writer
+ * keeps appending deltas to the old chain; once a merged base is published
+ * it becomes the parent of the next delta. Superseded files are handed to
+ * SnapshotChain::retire(), which keeps anything still on the live chain or
+ * pinned (by the writer mid-commit, or by a replay).
+ */
+class SnapshotCompactor {
+  public:
+    explicit SnapshotCompactor(std::shared_ptr<SnapshotChain> chain,
+                               CompactionPolicy policy = {})
+        : chain_(std::move(chain)), policy_(policy) {}
+    ~SnapshotCompactor() { stop(); }
+
+    // Prevent copying and moving
+    SnapshotCompactor(const SnapshotCompactor &) = delete;
+    SnapshotCompactor &operator=(const SnapshotCompactor &) = delete;
+    SnapshotCompactor(SnapshotCompactor &&) = delete;
+    SnapshotCompactor &operator=(SnapshotCompactor &&) = delete;
+
+    // Worker lifecycle
+    void start() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_.load()) {
+            return;
+        }
+        running_.store(true);
+        worker_ = std::thread([this] { workerLoop(); });
+    }
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!running_.load()) {
+                return;
+            }
+            running_.store(false);
+        }
+        wakeup_.notify_all();
+        worker_.join();
+    }
+    bool isRunning() const { return running_.load(); }
+
+    /**
+     * @brief Notifies the compactor that a new snapshot was committed
+     *
+     * Only the newest notification is kept; the worker checks it against
+     * the policy and merges its chain if due.
+     */
+    void onSnapshotCommitted(const SnapshotHeader &header) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            pendingHead_ = header;
+        }
+        wakeup_.notify_one();
+    }
+
+    /**
+     * @brief Synchronously merges the chain ending at head
+     * @return Header of the merged base, or nothing if head stopped being
+     * the latest snapshot before the merge could be published
+     * @throws SerializationException if head is unknown or a link is
+     * corrupt
+     */
+    std::optional<SnapshotHeader> compactNow(SnapshotId head) {
+        // Keeps head's chain on disk while it is read
+        const SnapshotChain::Pin pinned = chain_->pin(head);
+        const SnapshotReader reader(chain_->getDirectory());
+        const std::vector<SnapshotHeader> links = reader.resolveChain(head);
+        std::unordered_map<std::string, CreatureDeltaRecord> merged =
+            reader.loadMerged(head);
+
+        // Sorted so equal populations give identical bases
+        std::vector<CreatureDeltaRecord *> ordered;
+        ordered.reserve(merged.size());
+        for (auto &entry : merged) {
+            ordered.push_back(&entry.second);
+        }
+        std::sort(ordered.begin(), ordered.end(),
+                  [](const CreatureDeltaRecord *a,
+                     const CreatureDeltaRecord *b) {
+                      return a->creatureId < b->creatureId;
+                  });
+
+        SnapshotHeader base;
+        base.id = chain_->allocateId();
+        base.baseId = base.id;
+        base.parentId = base.id;
+        base.kind = SnapshotKind::Base;
+        base.createdAt = std::chrono::system_clock::now();
+        // The merged base describes the world as of head, not as of now
+        base.clock = pinned.header().clock;
+        {
+            SnapshotFileWriter file(
+                SnapshotFile::pathFor(chain_->getDirectory(), base.id));
+            for (const CreatureDeltaRecord *record : ordered) {
+                file.appendRecord(*record);
+            }
+            base.recordCount = ordered.size();
+            file.commit(base, {});
+        }
+
+        if (!chain_->publishCompacted(base, head)) {
+            chain_->retire(base.id);
+            return std::nullopt;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            lastCompactedBase_ = base.id;
+        }
+        if (policy_.deleteMergedSnapshots) {
+            removeSuperseded(links);
+        }
+        return base;
+    }
+
+    std::optional<SnapshotId> getLastCompactedBase() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastCompactedBase_;
+    }
+
+    /**
+     * @brief What the worker's most recent failed merge threw, if any
+     */
+    std::exception_ptr getLastError() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lastError_;
+    }
+
+  private:
+    std::shared_ptr<SnapshotChain> chain_;
+    CompactionPolicy policy_;
+
+    // Worker state
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+    std::optional<SnapshotHeader> pendingHead_;
+    std::optional<SnapshotId> lastCompactedBase_;
+    std::exception_ptr lastError_;
+
+    // Internal helpers
+    void workerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            wakeup_.wait(lock, [this] {
+                return !running_.load() || pendingHead_.has_value();
+            });
+            if (!running_.load()) {
+                return;
+            }
+            const SnapshotHeader head = *pendingHead_;
+            pendingHead_.reset();
+            lock.unlock();
+            try {
+                if (shouldCompact(head)) {
+                    compactNow(head.id);
+                }
+            } catch (...) {
+                // A retired or damaged head; the next commit tries again
+                lock.lock();
+                lastError_ = std::current_exception();
+                continue;
+            }
+            lock.lock();
+        }
+    }
+
+    bool shouldCompact(const SnapshotHeader &header) const {
+        if (header.kind == SnapshotKind::Base) {
+            return false;
+        }
+        if (header.chainDepth >= policy_.maxChainDepth) {
+            return true;
+        }
+        const std::filesystem::path &dir = chain_->getDirectory();
+        std::error_code error;
+        const std::uintmax_t baseBytes = std::filesystem::file_size(
+            SnapshotFile::pathFor(dir, header.baseId), error);
+        if (error || baseBytes == 0) {
+            return false;
+        }
+        std::uintmax_t deltaBytes = 0;
+        for (const SnapshotHeader &link :
+             SnapshotReader(dir).resolveChain(header.id)) {
+            if (link.kind == SnapshotKind::Delta) {
+                deltaBytes += std::filesystem::file_size(
+                    SnapshotFile::pathFor(dir, link.id));
+            }
+        }
+        return static_cast<double>(deltaBytes) >
+               static_cast<double>(baseBytes) *
+                   static_cast<double>(policy_.maxDeltaToBaseRatio);
+    }
+
+    // Retirement is deferred for links a pin or the live chain still needs
+    void removeSuperseded(const std::vector<SnapshotHeader> &chain) const {
+        for (const SnapshotHeader &link : chain) {
+            chain_->retire(link.id);
+        }
+    }
+};
+
+} // namespace crescent::io
+
+#endif // CREATURE_ENGINE_IO_SNAPSHOT_COMPACTOR_H
@@ -0,0 +1,925 @@
+#ifndef CREATURE_ENGINE_IO_SNAPSHOT_STORE_H
+#define CREATURE_ENGINE_IO_SNAPSHOT_STORE_H
+
+#include "common/utils/SimulationClock.h"
+#include "creature_engine/core/ChangeTracking.h"
+#include "creature_engine/core/Exceptions.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace crescent::io {
+
+/**
+ * @brief Identifies a snapshot file within a snapshot directory
+ */
+using SnapshotId = std::uint64_t;
+
+enum class SnapshotKind {
+    Base, // Every live creature, full fields
+    Delta // Only creatures and fields changed since the parent
+};
+
+/**
+ * @brief Header stored at the front of every snapshot file
+ */
+struct SnapshotHeader {
+    SnapshotId id{0};
+    SnapshotId baseId{0};   // Full snapshot this chain starts from
+    SnapshotId parentId{0}; // Previous link in the chain (== id for a base)
+    SnapshotKind kind{SnapshotKind::Base};
+    std::uint32_t chainDepth{0}; // Deltas between this snapshot and its base
+    std::size_t recordCount{0};
+    std::size_t removedCount{0};
+    std::chrono::system_clock::time_point createdAt;
+    // SimulationClock::current().record() at write time. Records hold raw
+    // ticks; the reader installs SimulationClock(clock) before loading
+    common::ClockRecord clock;
+};
+
+/**
+ * @brief Single creature entry within a snapshot
+ *
+ * Base records carry every field; delta records carry the fields in
+ * their mask, as top-level keys of payload.
+ */
+struct CreatureDeltaRecord {
+    std::string creatureId;
+    std::uint64_t version{0};
+    ChangeTracker::FieldMask fields{0}; // CreatureCore::DirtyField bits
+    nlohmann::json payload;             // From serializeFieldsToJson
+};
+
+/**
+ * @brief On-disk layout of one snapshot
+ *
+ * A file is a fixed HEADER_BYTES slot holding the header as one JSON
+ * object padded with spaces, then a body object
+ * {"records":[...],"removals":[...]}. Each record is
+ * {"id":...,"version":...,"fields":...,"payload":{...}}. The fixed slot
+ * lets a streamed base write its header last without copying the body,
+ * and lets chain walks read headers without parsing bodies.
+ *
+ * Files are written to a ".tmp" sibling and renamed into place on commit,
+ * so a reader never sees a partial snapshot.
+ */
+class SnapshotFile {
+  public:
+    static constexpr std::size_t HEADER_BYTES = 512;
+
+    static std::filesystem::path pathFor(const std::filesystem::path &dir,
+                                         SnapshotId id) {
+        return dir / (std::to_string(id) + ".snap");
+    }
+
+    /**
+     * @brief Id of a committed snapshot file, or nothing for other files
+     */
+    static std::optional<SnapshotId>
+    idOf(const std::filesystem::path &path) {
+        if (path.extension() != ".snap") {
+            return std::nullopt;
+        }
+        const std::string stem = path.stem().string();
+        if (stem.empty() || stem.size() > 19 ||
+            !std::all_of(stem.begin(), stem.end(),
+                         [](char c) { return c >= '0' && c <= '9'; })) {
+            return std::nullopt;
+        }
+        return std::stoull(stem);
+    }
+
+    /**
+     * @brief Appends one record in file form to a streamed chunk
+     * @param payloadJson Serialized creature object, spliced in verbatim
+     */
+    static void appendRecordJson(std::string &out, std::string_view creatureId,
+                                 std::uint64_t version,
+                                 ChangeTracker::FieldMask fields,
+                                 std::string_view payloadJson) {
+        out += "{\"id\":";
+        out += nlohmann::json(std::string(creatureId)).dump();
+        out += ",\"version\":";
+        out += std::to_string(version);
+        out += ",\"fields\":";
+        out += std::to_string(fields);
+        out += ",\"payload\":";
+        out += payloadJson;
+        out += '}';
+    }
+
+    static void appendRecordJson(std::string &out,
+                                 const CreatureDeltaRecord &record) {
+        appendRecordJson(out, record.creatureId, record.version,
+                         record.fields, record.payload.dump());
+    }
+
+    /**
+     * @throws SerializationException if the file is missing or corrupt
+     */
+    static SnapshotHeader readHeader(const std::filesystem::path &path) {
+        std::ifstream in(path, std::ios::binary);
+        std::string slot(HEADER_BYTES, ' ');
+        if (!in.read(slot.data(), static_cast<std::streamsize>(slot.size()))) {
+            throw SerializationException("Cannot read snapshot header from " +
+                                         path.string());
+        }
+        try {
+            return decodeHeader(nlohmann::json::parse(slot));
+        } catch (const nlohmann::json::exception &error) {
+            throw SerializationException("Corrupt snapshot header in " +
+                                         path.string() + ": " + error.what());
+        }
+    }
+
+    /**
+     * @brief Reads a whole snapshot
+     * @throws SerializationException if the file is missing or corrupt
+     */
+    static SnapshotHeader read(const std::filesystem::path &path,
+                               std::vector<CreatureDeltaRecord> &records,
+                               std::vector<std::string> &removals) {
+        const SnapshotHeader header = readHeader(path);
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(HEADER_BYTES));
+        try {
+            const nlohmann::json body = nlohmann::json::parse(in);
+            const nlohmann::json &list = body.at("records");
+            records.clear();
+            records.reserve(list.size());
+            for (const nlohmann::json &record : list) {
+                records.push_back({record.at("id").get<std::string>(),
+                                   record.at("version").get<std::uint64_t>(),
+                                   record.at("fields")
+                                       .get<ChangeTracker::FieldMask>(),
+                                   record.at("payload")});
+            }
+            removals = body.at("removals").get<std::vector<std::string>>();
+        } catch (const nlohmann::json::exception &error) {
+            throw SerializationException("Corrupt snapshot body in " +
+                                         path.string() + ": " + error.what());
+        }
+        if (records.size() != header.recordCount ||
+            removals.size() != header.removedCount) {
+            throw SerializationException("Snapshot " + path.string() +
+                                         " does not match its header counts");
+        }
+        return header;
+    }
+
+    static std::string encodeHeader(const SnapshotHeader &header) {
+        const nlohmann::json json = {
+            {"id", header.id},
+            {"baseId", header.baseId},
+            {"parentId", header.parentId},
+            {"kind", header.kind == SnapshotKind::Base ? "base" : "delta"},
+            {"chainDepth", header.chainDepth},
+            {"recordCount", header.recordCount},
+            {"removedCount", header.removedCount},
+            {"createdAtMicros",
+             std::chrono::duration_cast<std::chrono::microseconds>(
+                 header.createdAt.time_since_epoch())
+                 .count()},
+            {"clock",
+             {{"tickLengthMicros", header.clock.tickLengthMicros},
+              {"epochMicros", header.clock.epochMicros},
+              {"tick", header.clock.tick.value}}}};
+        std::string slot = json.dump();
+        if (slot.size() >= HEADER_BYTES) {
+            throw SerializationException("Snapshot header does not fit");
+        }
+        slot.resize(HEADER_BYTES - 1, ' ');
+        slot += '\n';
+        return slot;
+    }
+
+  private:
+    static SnapshotHeader decodeHeader(const nlohmann::json &json) {
+        SnapshotHeader header;
+        header.id = json.at("id").get<SnapshotId>();
+        header.baseId = json.at("baseId").get<SnapshotId>();
+        header.parentId = json.at("parentId").get<SnapshotId>();
+        const std::string kind = json.at("kind").get<std::string>();
+        if (kind != "base" && kind != "delta") {
+            throw SerializationException("Unknown snapshot kind " + kind);
+        }
+        header.kind = kind == "base" ? SnapshotKind::Base : SnapshotKind::Delta;
+        header.chainDepth = json.at("chainDepth").get<std::uint32_t>();
+        header.recordCount = json.at("recordCount").get<std::size_t>();
+        header.removedCount = json.at("removedCount").get<std::size_t>();
+        header.createdAt = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                std::chrono::microseconds(
+                    json.at("createdAtMicros").get<std::int64_t>())));
+        const nlohmann::json &clock = json.at("clock");
+        header.clock.tickLengthMicros =
+            clock.at("tickLengthMicros").get<std::int64_t>();
+        header.clock.epochMicros = clock.at("epochMicros").get<std::int64_t>();
+        header.clock.tick.value = clock.at("tick").get<std::uint32_t>();
+        return header;
+    }
+};
+
+/**
+ * @brief Streams one snapshot file and renames it into place on commit
+ *
+ * Destroying an uncommitted writer removes its temporary file.
+ */
+class SnapshotFileWriter {
+  public:
+    explicit SnapshotFileWriter(std::filesystem::path path)
+        : path_(std::move(path)), temporary_(path_.string() + ".tmp"),
+          out_(temporary_, std::ios::binary | std::ios::trunc) {
+        if (!out_) {
+            throw SerializationException("Cannot create snapshot file " +
+                                         temporary_.string());
+        }
+        out_ << std::string(SnapshotFile::HEADER_BYTES, ' ')
+             << "{\"records\":[";
+    }
+
+    ~SnapshotFileWriter() {
+        if (!committed_) {
+            out_.close();
+            std::error_code ignored;
+            std::filesystem::remove(temporary_, ignored);
+        }
+    }
+
+    // Prevent copying and moving
+    SnapshotFileWriter(const SnapshotFileWriter &) = delete;
+    SnapshotFileWriter &operator=(const SnapshotFileWriter &) = delete;
+    SnapshotFileWriter(SnapshotFileWriter &&) = delete;
+    SnapshotFileWriter &operator=(SnapshotFileWriter &&) = delete;
+
+    /**
+     * @brief Appends count comma-separated records built with
+     * SnapshotFile::appendRecordJson
+     */
+    void appendRecords(std::string_view chunk, std::size_t count) {
+        if (count == 0) {
+            return;
+        }
+        if (records_ > 0) {
+            out_ << ',';
+        }
+        out_ << chunk;
+        records_ += count;
+    }
+
+    void appendRecord(const CreatureDeltaRecord &record) {
+        scratch_.clear();
+        SnapshotFile::appendRecordJson(scratch_, record);
+        appendRecords(scratch_, 1);
+    }
+
+    std::size_t recordCount() const { return records_; }
+
+    /**
+     * @brief Finishes the body, fills in the header and renames the file
+     * into place
+     * @return Bytes in the committed file
+     */
+    std::size_t commit(SnapshotHeader header,
+                       const std::vector<std::string> &removals) {
+        header.recordCount = records_;
+        header.removedCount = removals.size();
+        out_ << "],\"removals\":" << nlohmann::json(removals).dump() << "}\n";
+        const std::size_t bytes = static_cast<std::size_t>(out_.tellp());
+        out_.seekp(0);
+        out_ << SnapshotFile::encodeHeader(header);
+        out_.close();
+        if (!out_) {
+            throw SerializationException("Failed writing snapshot file " +
+                                         temporary_.string());
+        }
+        std::filesystem::rename(temporary_, path_);
+        committed_ = true;
+        return bytes;
+    }
+
+  private:
+    std::filesystem::path path_;
+    std::filesystem::path temporary_;
+    std::ofstream out_;
+    std::size_t records_{0};
+    std::string scratch_;
+    bool committed_{false};
+};
+
+/**
+ * @brief Id allocation and file lifetime for one snapshot directory
+ *
+ * The writer and the compactor share one chain, so every snapshot id comes
+ * from one counter and no file is deleted while it is still needed. A file
+ * is needed while it is on the chain of the latest published snapshot or
+ * of a pinned one; retire() defers those and deletes them once nothing
+ * needs them. The head is recorded in a HEAD file, replaced atomically on
+ * every publish, and restored on construction together with the headers
+ * of every snapshot in the directory; the id counter resumes after the
+ * highest id found.
+ *
+ * All members are thread-safe. The chain must outlive its pins.
+ */
+class SnapshotChain {
+  public:
+    /**
+     * @brief Keeps a snapshot and the chain it replays from being retired
+     */
+    class Pin {
+      public:
+        Pin() = default;
+        ~Pin() { reset(); }
+
+        // Prevent copying, allow moving
+        Pin(const Pin &) = delete;
+        Pin &operator=(const Pin &) = delete;
+        Pin(Pin &&other) noexcept
+            : chain_(std::exchange(other.chain_, nullptr)),
+              header_(other.header_) {}
+        Pin &operator=(Pin &&other) noexcept {
+            if (this != &other) {
+                reset();
+                chain_ = std::exchange(other.chain_, nullptr);
+                header_ = other.header_;
+            }
+            return *this;
+        }
+
+        const SnapshotHeader &header() const { return header_; }
+        explicit operator bool() const { return chain_ != nullptr; }
+
+        void reset() {
+            if (chain_) {
+                chain_->unpin(header_.id);
+                chain_ = nullptr;
+            }
+        }
+
+      private:
+        friend class SnapshotChain;
+        Pin(SnapshotChain *chain, const SnapshotHeader &header)
+            : chain_(chain), header_(header) {}
+
+        SnapshotChain *chain_{nullptr};
+        SnapshotHeader header_;
+    };
+
+    /**
+     * @throws SerializationException if a snapshot file in the directory
+     * has a corrupt header
+     */
+    explicit SnapshotChain(std::filesystem::path directory)
+        : directory_(std::move(directory)) {
+        std::filesystem::create_directories(directory_);
+        for (const auto &entry :
+             std::filesystem::directory_iterator(directory_)) {
+            const std::filesystem::path &path = entry.path();
+            if (path.extension() == ".tmp") {
+                // Left by a writer that never committed
+                std::error_code ignored;
+                std::filesystem::remove(path, ignored);
+                continue;
+            }
+            if (const std::optional<SnapshotId> id = SnapshotFile::idOf(path)) {
+                headers_[*id] = SnapshotFile::readHeader(path);
+                nextId_ = std::max(nextId_, *id + 1);
+            }
+        }
+        std::ifstream head(directory_ / "HEAD");
+        SnapshotId id = 0;
+        if (head >> id && headers_.count(id) != 0) {
+            latest_ = id;
+        }
+    }
+
+    // Prevent copying and moving; pins refer to the chain by address
+    SnapshotChain(const SnapshotChain &) = delete;
+    SnapshotChain &operator=(const SnapshotChain &) = delete;
+    SnapshotChain(SnapshotChain &&) = delete;
+    SnapshotChain &operator=(SnapshotChain &&) = delete;
+
+    SnapshotId allocateId() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return nextId_++;
+    }
+
+    /**
+     * @brief Makes a committed snapshot the head of the live chain
+     *
+     * A delta whose parent was replaced by a merged base while it was
+     * being written still replays correctly from that parent, which its
+     * writer kept pinned; the merged base it displaces is retired. A new
+     * base leaves older chains for the caller to retire.
+     */
+    void publish(const SnapshotHeader &header) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::optional<SnapshotId> displaced = latest_;
+        headers_[header.id] = header;
+        latest_ = header.id;
+        writeHead(header.id);
+        if (header.kind == SnapshotKind::Delta && displaced &&
+            *displaced != header.parentId) {
+            deferred_.insert(*displaced);
+        }
+        sweepDeferred();
+    }
+
+    /**
+     * @brief Publishes a merged base in place of the head it was built from
+     * @return False, publishing nothing, if another snapshot has become
+     * the head since; the caller should retire the merged base
+     */
+    bool publishCompacted(const SnapshotHeader &merged, SnapshotId replaced) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (latest_ != replaced) {
+            headers_[merged.id] = merged; // So retire() can find it
+            return false;
+        }
+        headers_[merged.id] = merged;
+        latest_ = merged.id;
+        writeHead(merged.id);
+        sweepDeferred();
+        return true;
+    }
+
+    std::optional<SnapshotHeader> getLatest() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!latest_) {
+            return std::nullopt;
+        }
+        return headers_.at(*latest_);
+    }
+
+    /**
+     * @brief Pins a published snapshot
+     * @throws SerializationException if id is unknown or retired
+     */
+    Pin pin(SnapshotId id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = headers_.find(id);
+        if (it == headers_.end()) {
+            throw SerializationException("Snapshot " + std::to_string(id) +
+                                         " is unknown or retired");
+        }
+        ++pins_[id];
+        return Pin(this, it->second);
+    }
+
+    /**
+     * @brief Pins whatever is the head now; empty if nothing is published
+     */
+    Pin pinLatest() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!latest_) {
+            return {};
+        }
+        ++pins_[*latest_];
+        return Pin(this, headers_.at(*latest_));
+    }
+
+    /**
+     * @brief Deletes a snapshot's file if nothing needs it any more
+     * @return False if it is pinned or on the live chain; it is then
+     * deleted once that stops being true
+     */
+    bool retire(SnapshotId id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (headers_.count(id) == 0) {
+            return true;
+        }
+        if (isNeeded(id)) {
+            deferred_.insert(id);
+            return false;
+        }
+        remove(id);
+        return true;
+    }
+
+    /**
+     * @brief Whether id has a live file (published and not yet deleted)
+     */
+    bool contains(SnapshotId id) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return headers_.count(id) != 0;
+    }
+
+    const std::filesystem::path &getDirectory() const { return directory_; }
+
+  private:
+    std::filesystem::path directory_;
+
+    mutable std::mutex mutex_;
+    SnapshotId nextId_{1};
+    std::optional<SnapshotId> latest_;
+    std::unordered_map<SnapshotId, SnapshotHeader> headers_; // Not retired
+    std::unordered_map<SnapshotId, std::uint32_t> pins_;     // Pin counts
+    std::unordered_set<SnapshotId> deferred_; // Retired while still needed
+
+    void unpin(SnapshotId id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = pins_.find(id);
+        if (it != pins_.end() && --it->second == 0) {
+            pins_.erase(it);
+        }
+        sweepDeferred();
+    }
+
+    // Caller holds mutex_; walks parents from every pin and the head
+    bool isNeeded(SnapshotId id) const {
+        const auto reaches = [this, id](SnapshotId from) {
+            for (;;) {
+                if (from == id) {
+                    return true;
+                }
+                auto it = headers_.find(from);
+                if (it == headers_.end() ||
+                    it->second.kind == SnapshotKind::Base) {
+                    return false;
+                }
+                from = it->second.parentId;
+            }
+        };
+        if (latest_ && reaches(*latest_)) {
+            return true;
+        }
+        for (const auto &entry : pins_) {
+            if (reaches(entry.first)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Caller holds mutex_
+    void sweepDeferred() {
+        for (auto it = deferred_.begin(); it != deferred_.end();) {
+            if (isNeeded(*it)) {
+                ++it;
+            } else {
+                remove(*it);
+                it = deferred_.erase(it);
+            }
+        }
+    }
+
+    // Caller holds mutex_
+    void remove(SnapshotId id) {
+        headers_.erase(id);
+        std::error_code ignored;
+        std::filesystem::remove(SnapshotFile::pathFor(directory_, id),
+                                ignored);
+    }
+
+    // Caller holds mutex_
+    void writeHead(SnapshotId id) const {
+        const std::filesystem::path temporary = directory_ / "HEAD.tmp";
+        {
+            std::ofstream out(temporary, std::ios::trunc);
+            out << id << '\n';
+            if (!out) {
+                throw SerializationException("Cannot write " +
+                                             temporary.string());
+            }
+        }
+        std::filesystem::rename(temporary, directory_ / "HEAD");
+    }
+};
+
+/**
+ * @brief Replays snapshot files from one directory
+ */
+class SnapshotReader {
+  public:
+    explicit SnapshotReader(std::filesystem::path directory)
+        : directory_(std::move(directory)) {}
+
+    /**
+     * @brief Lists the chain ending at a snapshot, base first
+     * @throws SerializationException if a link is missing or corrupt
+     */
+    std::vector<SnapshotHeader> resolveChain(SnapshotId head) const {
+        std::vector<SnapshotHeader> chain;
+        SnapshotHeader header = readHeader(head);
+        const std::size_t depth = header.chainDepth;
+        chain.push_back(header);
+        while (header.kind == SnapshotKind::Delta) {
+            if (chain.size() > depth) {
+                throw SerializationException(
+                    "Snapshot chain at " + std::to_string(head) +
+                    " is longer than its depth");
+            }
+            header = readHeader(header.parentId);
+            chain.push_back(header);
+        }
+        std::reverse(chain.begin(), chain.end());
+        return chain;
+    }
+
+    /**
+     * @brief Replays a chain into merged creature records keyed by id
+     *
+     * Each delta record overlays its payload's top-level fields onto the
+     * merged record, ORs in its field mask and takes its version; removals
+     * drop the creature.
+     */
+    std::unordered_map<std::string, CreatureDeltaRecord>
+    loadMerged(SnapshotId head) const {
+        std::unordered_map<std::string, CreatureDeltaRecord> merged;
+        std::vector<CreatureDeltaRecord> records;
+        std::vector<std::string> removals;
+        for (const SnapshotHeader &link : resolveChain(head)) {
+            SnapshotFile::read(SnapshotFile::pathFor(directory_, link.id),
+                               records, removals);
+            for (const std::string &creatureId : removals) {
+                merged.erase(creatureId);
+            }
+            for (CreatureDeltaRecord &record : records) {
+                auto it = merged.find(record.creatureId);
+                if (it == merged.end()) {
+                    merged.emplace(record.creatureId, std::move(record));
+                    continue;
+                }
+                CreatureDeltaRecord &target = it->second;
+                for (auto &[key, value] : record.payload.items()) {
+                    target.payload[key] = std::move(value);
+                }
+                target.fields |= record.fields;
+                target.version = record.version;
+            }
+        }
+        return merged;
+    }
+
+    SnapshotHeader readHeader(SnapshotId id) const {
+        return SnapshotFile::readHeader(SnapshotFile::pathFor(directory_, id));
+    }
+
+    const std::filesystem::path &getDirectory() const { return directory_; }
+
+  private:
+    std::filesystem::path directory_;
+};
+
+/**
+ * @brief Writes base and delta snapshots for a creature population
+ *
+ * A checkpoint only records creatures for which getDirtyFields() is
+ * non-zero, which for CreatureCore covers the creature's own tracker and
+ * those of its trait, ability and synthesis owners, so its cost follows
+ * churn rather than population size. Each delta records the snapshot it
+ * was written against; readers replay base + deltas in order. Dirty bits
+ * are cleared only after the snapshot file has been committed, against
+ * the tracker versions captured before each record was serialized.
+ *
+ * Ids come from the SnapshotChain, which a SnapshotCompactor shares. A
+ * delta's parent is the chain's head at commit time, pinned while the
+ * file is written; that is either this writer's previous snapshot or a
+ * merged base with the same content.
+ *
+ * Creature provides getIdentity().id, getChangeTracker(),
+ * getDirtyFields(), PersistedVersions with capturePersistedVersions() and
+ * clearDirty(), serializeToBytes(options) and
+ * serializeFieldsToJson(fields, options), as CreatureCore does.
+ */
+template <typename Creature, typename Options> class BasicDeltaSnapshotWriter {
+  public:
+    /**
+     * @brief Writes into directory through a chain of its own
+     */
+    explicit BasicDeltaSnapshotWriter(std::filesystem::path directory,
+                                      Options options = {})
+        : BasicDeltaSnapshotWriter(
+              std::make_shared<SnapshotChain>(std::move(directory)),
+              std::move(options)) {}
+    BasicDeltaSnapshotWriter(std::shared_ptr<SnapshotChain> chain,
+                             Options options = {})
+        : chain_(std::move(chain)), options_(std::move(options)) {}
+    ~BasicDeltaSnapshotWriter() = default;
+
+    // Prevent copying, allow moving
+    BasicDeltaSnapshotWriter(const BasicDeltaSnapshotWriter &) = delete;
+    BasicDeltaSnapshotWriter &
+    operator=(const BasicDeltaSnapshotWriter &) = delete;
+    BasicDeltaSnapshotWriter(BasicDeltaSnapshotWriter &&) = default;
+    BasicDeltaSnapshotWriter &operator=(BasicDeltaSnapshotWriter &&) = default;
+
+    /**
+     * @brief Writes every creature in full and starts a new chain
+     */
+    SnapshotHeader writeBase(const std::vector<Creature *> &population) {
+        beginBase();
+        std::vector<std::pair<Creature *, PersistedVersions>> clears;
+        clears.reserve(population.size());
+        std::string chunk;
+        for (Creature *creature : population) {
+            clears.emplace_back(creature,
+                                creature->capturePersistedVersions());
+            chunk.clear();
+            SnapshotFile::appendRecordJson(
+                chunk, creature->getIdentity().id,
+                creature->getChangeTracker().getVersion(),
+                ChangeTracker::ALL_FIELDS,
+                *creature->serializeToBytes(options_));
+            appendBaseRecords(chunk, 1);
+        }
+        const SnapshotHeader header = commitBase();
+        for (auto &[creature, persisted] : clears) {
+            creature->clearDirty(persisted);
+        }
+        return header;
+    }
+
+    /**
+     * @brief Streams a base snapshot whose records are already serialized
+     *
+     * For bulk producers that never hold the whole population in memory.
+     * Each appended chunk holds count comma-separated records built with
+     * SnapshotFile::appendRecordJson; chunks are written in call order.
+     * @throws StateException if a base or delta is already open
+     */
+    void beginBase() {
+        requireIdle();
+        const SnapshotId id = chain_->allocateId();
+        base_ = std::make_unique<SnapshotFileWriter>(
+            SnapshotFile::pathFor(chain_->getDirectory(), id));
+        baseId_ = id;
+    }
+    void appendBaseRecords(std::string_view serializedRecords,
+                           std::size_t count) {
+        if (!base_) {
+            throw StateException("No base snapshot is open");
+        }
+        base_->appendRecords(serializedRecords, count);
+    }
+    SnapshotHeader commitBase() {
+        if (!base_) {
+            throw StateException("No base snapshot is open");
+        }
+        SnapshotHeader header = makeHeader(SnapshotKind::Base);
+        header.id = baseId_;
+        header.baseId = baseId_;
+        header.parentId = baseId_;
+        header.recordCount = base_->recordCount();
+        base_->commit(header, {});
+        base_.reset();
+        chain_->publish(header);
+        return header;
+    }
+
+    /**
+     * @brief Opens a delta against the most recent snapshot in the chain
+     * @throws SerializationException if no base snapshot exists yet
+     */
+    void beginDelta() {
+        requireIdle();
+        if (!chain_->getLatest()) {
+            throw SerializationException(
+                "A delta needs a base snapshot to follow");
+        }
+        deltaOpen_ = true;
+    }
+
+    /**
+     * @brief Records a creature if it, or a component it owns, changed
+     * since the last checkpoint
+     * @return True if a record was written
+     */
+    bool recordCreature(Creature &creature) {
+        requireDelta();
+        const ChangeTracker::FieldMask fields = creature.getDirtyFields();
+        if (fields == 0) {
+            return false;
+        }
+        pendingClears_.emplace_back(&creature,
+                                    creature.capturePersistedVersions());
+        pendingRecords_.push_back(
+            {creature.getIdentity().id,
+             creature.getChangeTracker().getVersion(), fields,
+             creature.serializeFieldsToJson(fields, options_)});
+        return true;
+    }
+    void recordRemoval(const std::string &creatureId) {
+        requireDelta();
+        pendingRemovals_.push_back(creatureId);
+    }
+
+    /**
+     * @brief Flushes the open delta and clears dirty bits it covered
+     */
+    SnapshotHeader commit() {
+        requireDelta();
+        // Held until published so a compactor cannot retire the parent
+        const SnapshotChain::Pin parent = chain_->pinLatest();
+        if (!parent) {
+            throw SerializationException(
+                "A delta needs a base snapshot to follow");
+        }
+        SnapshotHeader header = makeHeader(SnapshotKind::Delta);
+        header.id = chain_->allocateId();
+        header.baseId = parent.header().baseId;
+        header.parentId = parent.header().id;
+        header.chainDepth = parent.header().chainDepth + 1;
+        {
+            SnapshotFileWriter file(
+                SnapshotFile::pathFor(chain_->getDirectory(), header.id));
+            for (const CreatureDeltaRecord &record : pendingRecords_) {
+                file.appendRecord(record);
+            }
+            header.recordCount = pendingRecords_.size();
+            header.removedCount = pendingRemovals_.size();
+            file.commit(header, pendingRemovals_);
+        }
+        chain_->publish(header);
+        clearCommittedDirtyBits();
+        return header;
+    }
+    void abort() {
+        base_.reset();
+        deltaOpen_ = false;
+        pendingRecords_.clear();
+        pendingRemovals_.clear();
+        pendingClears_.clear();
+    }
+
+    // Chain queries
+    std::optional<SnapshotId> getLatestSnapshot() const {
+        const std::optional<SnapshotHeader> latest = chain_->getLatest();
+        return latest ? std::optional<SnapshotId>(latest->id) : std::nullopt;
+    }
+    std::uint32_t getChainDepth() const {
+        const std::optional<SnapshotHeader> latest = chain_->getLatest();
+        return latest ? latest->chainDepth : 0;
+    }
+    const std::filesystem::path &getDirectory() const {
+        return chain_->getDirectory();
+    }
+
+    /**
+     * @brief Chain to hand to a SnapshotCompactor or a replay driver
+     */
+    const std::shared_ptr<SnapshotChain> &getChain() const { return chain_; }
+
+  private:
+    using PersistedVersions = typename Creature::PersistedVersions;
+
+    std::shared_ptr<SnapshotChain> chain_;
+    Options options_;
+
+    // Open streamed base
+    std::unique_ptr<SnapshotFileWriter> base_;
+    SnapshotId baseId_{0};
+
+    // Open delta
+    bool deltaOpen_{false};
+    std::vector<CreatureDeltaRecord> pendingRecords_;
+    std::vector<std::string> pendingRemovals_;
+    std::vector<std::pair<Creature *, PersistedVersions>> pendingClears_;
+
+    static SnapshotHeader makeHeader(SnapshotKind kind) {
+        SnapshotHeader header;
+        header.kind = kind;
+        header.createdAt = std::chrono::system_clock::now();
+        header.clock = common::SimulationClock::current().record();
+        return header;
+    }
+
+    void requireIdle() const {
+        if (base_ || deltaOpen_) {
+            throw StateException("A snapshot is already open");
+        }
+    }
+
+    void requireDelta() const {
+        if (!deltaOpen_) {
+            throw StateException("No delta snapshot is open");
+        }
+    }
+
+    void clearCommittedDirtyBits() {
+        for (auto &[creature, persisted] : pendingClears_) {
+            creature->clearDirty(persisted);
+        }
+        abort();
+    }
+};
+
+} // namespace crescent::io
+
+#endif // CREATURE_ENGINE_IO_SNAPSHOT_STORE_H
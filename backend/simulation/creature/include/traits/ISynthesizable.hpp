@@ -1,6 +1,8 @@
 #ifndef CREATURE_ENGINE_TRAITS_INTERFACES_ISYNTHESIZABLE_H
 #define CREATURE_ENGINE_TRAITS_INTERFACES_ISYNTHESIZABLE_H
 
+#include "common/utils/StatusVisitor.h"
+#include "creature_engine/core/ErrorCodes.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/base/TraitEnums.h"
 #include "creature_engine/traits/synthesis/SynthesisRules.h"
@@ -9,21 +11,27 @@
 #include <chrono>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace crescent::traits {
 
 /**
- * @brief Result of a synthesis operation
+ * @brief What a successful synthesis operation produced
+ *
+ * Owns resultForm, so the outcome outlives any change to the rules.
  */
-struct SynthesisResult {
-    bool success;
-    std::string message;
+struct SynthesisOutcome {
     std::optional<std::string> resultForm;
-    float stabilityFactor;
-    std::vector<std::string> warnings;
+    float stabilityFactor{1.0f};
+    WarningList warnings;
 };
 
+/**
+ * @brief Result of a synthesis operation
+ */
+using SynthesisResult = common::Expected<SynthesisOutcome, Error>;
+
 /**
  * @brief Interface for objects that can undergo synthesis transformations
  *
@@ -64,6 +72,24 @@ class ISynthesizable {
     };
     virtual SynthesisPotential getSynthesisPotential() const = 0;
 
+    /**
+     * @brief Streams synthesis potential into a visitor
+     *
+     * The default forwards a copy from getSynthesisPotential; implementors
+     * should override it to report straight from their own storage.
+     */
+    virtual void visitSynthesisPotential(common::StatusVisitor &visitor) const {
+        const SynthesisPotential potential = getSynthesisPotential();
+        visitor.onCount("maxLevel", potential.maxLevel);
+        visitor.onValue("currentThreshold", potential.currentThreshold);
+        for (const auto &form : potential.availableForms) {
+            visitor.onListItem("availableForms", form);
+        }
+        for (const auto &[catalyst, threshold] : potential.catalystThresholds) {
+            visitor.onMapEntry("catalystThresholds", catalyst, threshold);
+        }
+    }
+
     /**
      * @brief Attempt to begin a synthesis transformation
      * @return Result of the synthesi
\ No newline at end of file
@@ -0,0 +1,233 @@
+#ifndef CREATURE_ENGINE_TRAITS_BASE_TRAIT_CATALOG_H
+#define CREATURE_ENGINE_TRAITS_BASE_TRAIT_CATALOG_H
+
+#include "creature_engine/core/Exceptions.h"
+#include "creature_engine/traits/base/TraitDefinition.h"
+#include "creature_engine/traits/base/TraitEnums.h"
+#include "creature_engine/traits/base/TraitIndex.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crucible {
+
+using crescent::traits::TraitIndex;
+
+/**
+ * @brief Environment name interned by a TraitCatalog
+ */
+using EnvironmentId = std::uint32_t;
+
+/**
+ * @brief The part of a TraitDefinition read every tick
+ *
+ * 20 bytes, so three records share a cache line. Affinities live in the
+ * catalog's own columns; affinityBegin and affinityCount locate this
+ * trait's slice, sorted by environment id.
+ */
+struct TraitHotRecord {
+    enum Flags : std::uint16_t {
+        Permanent = 1u << 0,         // ManifestationParameters::isPermanent
+        RequiresStability = 1u << 1, // ...::requiresStability
+    };
+
+    TraitCategory category{TraitCategory::Physical};
+    TraitOrigin origin{TraitOrigin::Innate};
+    float minimumAffinity{0.0f};
+    std::uint32_t affinityBegin{0};
+    std::uint16_t affinityCount{0};
+    std::uint16_t flags{0};
+
+    bool isPermanent() const { return flags & Permanent; }
+    bool requiresStability() const { return flags & RequiresStability; }
+};
+
+/**
+ * @brief Owns every TraitDefinition, split into hot records and cold data
+ *
+ * Simulation code works with TraitIndex and EnvironmentId: hot(index) and
+ * affinity(index, environment) read two small contiguous arrays, with no
+ * pointer chase, no string hashing and no reference counting. The full
+ * TraitDefinition (names, descriptions, effect strings, abilities) is kept
+ * apart and only fetched through definition() for display and
+ * serialization.
+ *
+ * Definitions are immutable templates: add them all while loading, before
+ * any TraitState refers to the catalog. After that every member is const
+ * and safe to call from any number of threads. Indices and references are
+ * stable for the catalog's lifetime.
+ */
+class TraitCatalog {
+  public:
+    static constexpr TraitIndex NO_TRAIT =
+        std::numeric_limits<TraitIndex>::max();
+    static constexpr EnvironmentId NO_ENVIRONMENT =
+        std::numeric_limits<EnvironmentId>::max();
+
+    /**
+     * @brief Catalog of the loaded game data
+     *
+     * Filled by DataLoader::initialize. Never destroyed, so trait states
+     * in static storage can still reach it during shutdown.
+     */
+    static TraitCatalog &global() {
+        static TraitCatalog *catalog = new TraitCatalog();
+        return *catalog;
+    }
+
+    TraitCatalog() = default;
+
+    // Prevent copying and moving; states hold pointers to the catalog
+    TraitCatalog(const TraitCatalog &) = delete;
+    TraitCatalog &operator=(const TraitCatalog &) = delete;
+    TraitCatalog(TraitCatalog &&) = delete;
+    TraitCatalog &operator=(TraitCatalog &&) = delete;
+
+    /**
+     * @brief Takes ownership of a definition and indexes it
+     * @throws crescent::TraitException if the id is already present
+     */
+    TraitIndex add(TraitDefinition definition) {
+        const auto index = static_cast<TraitIndex>(hot_.size());
+        if (!indices_.try_emplace(definition.getId(), index).second) {
+            throw crescent::TraitException("Duplicate trait definition: " +
+                                           definition.getId());
+        }
+
+        TraitHotRecord record;
+        record.category = definition.getCategory();
+        record.origin = definition.getOrigin();
+        const EnvironmentalParameters &environment =
+            definition.getEnvironmentalParams();
+        record.minimumAffinity = environment.minimumAffinity;
+        const ManifestationParameters &manifestation =
+            definition.getManifestationParams();
+        record.flags = static_cast<std::uint16_t>(
+            (manifestation.isPermanent ? TraitHotRecord::Permanent : 0) |
+            (manifestation.requiresStability
+                 ? TraitHotRecord::RequiresStability
+                 : 0));
+
+        std::vector<std::pair<EnvironmentId, float>> affinities;
+        affinities.reserve(environment.affinities.size());
+        for (const auto &[name, affinity] : environment.affinities) {
+            affinities.emplace_back(internEnvironment(name), affinity);
+        }
+        std::sort(affinities.begin(), affinities.end());
+        record.affinityBegin =
+            static_cast<std::uint32_t>(affinityEnvironments_.size());
+        record.affinityCount = static_cast<std::uint16_t>(affinities.size());
+        for (const auto &[id, affinity] : affinities) {
+            affinityEnvironments_.push_back(id);
+            affinityValues_.push_back(affinity);
+        }
+
+        hot_.push_back(record);
+        cold_.push_back(std::move(definition));
+        return index;
+    }
+
+    std::size_t size() const { return hot_.size(); }
+
+    std::optional<TraitIndex> find(const std::string &traitId) const {
+        auto it = indices_.find(traitId);
+        if (it == indices_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * @brief Id for an environment, or NO_ENVIRONMENT if no trait names it
+     *
+     * Resolve once per tick or per environment change, then pass the id
+     * to affinity().
+     */
+    EnvironmentId environmentId(const std::string &name) const {
+        auto it = environmentIds_.find(name);
+        return it == environmentIds_.end() ? NO_ENVIRONMENT : it->second;
+    }
+    const std::string &environmentName(EnvironmentId id) const {
+        return environmentNames_[id];
+    }
+
+    // Hot data
+    const TraitHotRecord &hot(TraitIndex index) const { return hot_[index]; }
+
+    /**
+     * @brief Affinity of a trait for an environment; 0 if unlisted
+     */
+    float affinity(TraitIndex index, EnvironmentId environment) const {
+        const TraitHotRecord &record = hot_[index];
+        const EnvironmentId *first =
+            affinityEnvironments_.data() + record.affinityBegin;
+        const EnvironmentId *last = first + record.affinityCount;
+        // Slices hold a handful of entries; a linear scan beats bisection
+        for (const EnvironmentId *it = first; it != last; ++it) {
+            if (*it >= environment) {
+                return *it == environment
+                           ? affinityValues_[static_cast<std::size_t>(
+                                 it - affinityEnvironments_.data())]
+                           : 0.0f;
+            }
+        }
+        return 0.0f;
+    }
+
+    bool meetsMinimumAffinity(TraitIndex index,
+                              EnvironmentId environment) const {
+        return affinity(index, environment) >= hot_[index].minimumAffinity;
+    }
+
+    // Cold data
+    const std::string &idOf(TraitIndex index) const {
+        return cold_[index].getId();
+    }
+    const TraitDefinition &definition(TraitIndex index) const {
+        return cold_[index];
+    }
+
+    /**
+     * @brief Bytes of hot data; what a tick actually streams through
+     */
+    std::size_t getHotFootprint() const {
+        return hot_.capacity() * sizeof(TraitHotRecord) +
+               affinityEnvironments_.capacity() * sizeof(EnvironmentId) +
+               affinityValues_.capacity() * sizeof(float);
+    }
+
+  private:
+    // Hot: one record per trait plus the affinity columns
+    std::vector<TraitHotRecord> hot_;
+    std::vector<EnvironmentId> affinityEnvironments_;
+    std::vector<float> affinityValues_;
+
+    // Cold: full definitions by index; a deque keeps them in place
+    std::deque<TraitDefinition> cold_;
+
+    // Lookup, used while loading and at API edges
+    std::unordered_map<std::string, TraitIndex> indices_;
+    std::unordered_map<std::string, EnvironmentId> environmentIds_;
+    std::vector<std::string> environmentNames_;
+
+    EnvironmentId internEnvironment(const std::string &name) {
+        auto [it, inserted] = environmentIds_.try_emplace(
+            name, static_cast<EnvironmentId>(environmentNames_.size()));
+        if (inserted) {
+            environmentNames_.push_back(name);
+        }
+        return it->second;
+    }
+};
+
+} // namespace crucible
+
+#endif // CREATURE_ENGINE_TRAITS_BASE_TRAIT_CATALOG_H
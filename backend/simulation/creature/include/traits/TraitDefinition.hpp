@@ -1,6 +1,7 @@
 #ifndef CRUCIBLE_ENGINES_CREATURE_TRAITS_ENUMS_HPP
 #define CRUCIBLE_ENGINES_CREATURE_TRAITS_ENUMS_HPP
 
+#include "creature_engine/io/JsonStreamWriter.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/base/TraitAbility.h"
 #include "creature_engine/traits/base/TraitEnums.h"
@@ -86,6 +87,14 @@ class TraitDefinition {
     serializeToJson(const SerializationOptions &options = {}) const;
     static TraitDefinition deserializeFromJson(const nlohmann::json &data);
 
+    /**
+     * @brief Streams the same JSON as serializeToJson without a DOM
+     *
+     * Byte-identical to serializeToJson(options).dump().
+     */
+    void writeJson(crescent::io::JsonStreamWriter &writer,
+                   const SerializationOptions &options = {}) const;
+
     // Builder pattern interface
     class Builder;
     static Builder create(std::string id);
@@ -0,0 +1,19 @@
+#ifndef CREATURE_ENGINE_TRAITS_BASE_TRAIT_INDEX_H
+#define CREATURE_ENGINE_TRAITS_BASE_TRAIT_INDEX_H
+
+#include <cstdint>
+
+namespace crescent::traits {
+
+/**
+ * @brief Dense position of a loaded trait
+ *
+ * DataLoader adds every trait to the TraitCatalog and then to the
+ * TraitCompatibilityMatrix in catalog order, so one index names the same
+ * trait in both.
+ */
+using TraitIndex = std::uint32_t;
+
+} // namespace crescent::traits
+
+#endif // CREATURE_ENGINE_TRAITS_BASE_TRAIT_INDEX_H
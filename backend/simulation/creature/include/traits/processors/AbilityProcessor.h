@@ -1,6 +1,14 @@
 #ifndef CREATURE_ENGINE_TRAITS_PROCESSORS_ABILITY_PROCESSOR_H
 #define CREATURE_ENGINE_TRAITS_PROCESSORS_ABILITY_PROCESSOR_H
 
+#include "common/metrics/LatencyHistogram.h"
+#include "common/metrics/TraceSpan.h"
+#include "common/utils/InlineVector.h"
+#include "common/utils/SimulationClock.h"
+#include "common/utils/StatusVisitor.h"
+#include "creature_engine/core/ChangeTracking.h"
+#include "creature_engine/core/ErrorCodes.h"
+#include "creature_engine/io/SerializationCache.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/base/TraitAbility.h"
 #include "creature_engine/traits/state/AbilityState.h"
@@ -33,17 +41,19 @@ struct AbilityStateKey {
 };
 
 /**
- * @brief Result of an ability operation
+ * @brief What a successful ability operation did
  */
-struct AbilityResult {
-    bool success;
-    std::string message;
-    std::vector<std::string> manifestedEffects;
-    std::vector<std::string> suppressedEffects;
-    std::vector<std::string> warnings;
-    std::optional<std::string> failureReason;
+struct AbilityOutcome {
+    EffectList manifestedEffects;
+    EffectList suppressedEffects;
+    WarningList warnings;
 };
 
+/**
+ * @brief Result of an ability operation
+ */
+using AbilityResult = common::Expected<AbilityOutcome, Error>;
+
 /**
  * @brief Processes ability manifestations and interactions
  */
@@ -59,6 +69,13 @@ class AbilityProcessor {
     AbilityProcessor(AbilityProcessor &&) = default;
     AbilityProcessor &operator=(AbilityProcessor &&) = default;
 
+    /**
+     * @brief Independent copy for a forked creature
+     *
+     * Clones every AbilityState under the lock; metrics start empty.
+     */
+    std::unique_ptr<AbilityProcessor> fork() const;
+
     // Core ability operations
     AbilityResult registerAbility(const AbilityDefinition &ability);
     AbilityResult unregisterAbility(const std::string &abilityId);
@@ -72,7 +89,10 @@ class AbilityProcessor {
     };
 
     AbilityResult manifestAbility(const std::string &abilityId,
-                                  const ManifestationContext &context);
+                                  const ManifestationContext &context) {
+        CRESCENT_TRACE_SPAN(ManifestAbility);
+        return manifestAbilityImpl(abilityId, context);
+    }
 
     AbilityResult unmanifestAbility(const std::string &abilityId);
 
@@ -110,10 +130,19 @@ class AbilityProcessor {
         std::vector<std::string> suppressedEffects;
         std::vector<std::string> missingRequirements;
         std::unordered_map<std::string, float> environmentalInfluences;
-        std::chrono::system_clock::time_point lastStateChange;
+        common::SimTick lastStateChange;
     };
     AbilityStatusInfo getAbilityStatus(const std::string &abilityId) const;
 
+    /**
+     * @brief Streams ability status without building AbilityStatusInfo
+     * @return False if the ability is not registered
+     *
+     * The processor lock is held for the duration of the visit.
+     */
+    bool visitAbilityStatus(const std::string &abilityId,
+                            common::StatusVisitor &visitor) const;
+
     /**
      * @brief Processing statistics
      */
@@ -122,15 +151,41 @@ class AbilityProcessor {
         size_t activeManifestations{0};
         size_t failedManifestations{0};
         float averageEnvironmentalInfluence{0.0f};
-        std::chrono::system_clock::time_point lastUpdate;
+        // From MetricsRegistry; present in every build so the layout does
+        // not depend on CRESCENT_ENABLE_METRICS, and empty without it
+        metrics::LatencySummary manifestLatency;
+        common::SimTick lastUpdate;
     };
     ProcessingMetrics getMetrics() const;
 
+    // Change tracking; covers every ability state
+    enum DirtyField : ChangeTracker::FieldMask {
+        DirtyAbilitySet = 1u << 0, // Abilities registered or unregistered
+        DirtyManifestation = 1u << 1,
+        DirtyInfluences = 1u << 2
+    };
+    /**
+     * @brief Copy of the tracker taken under the processor lock
+     */
+    ChangeTracker getChangeTracker() const;
+    void clearDirty(std::uint64_t persistedVersion);
+
     // Serialization
     nlohmann::json
-    serializeToJson(const SerializationOptions &options = {}) const;
+    serializeToJson(const SerializationOptions &options = {}) const {
+        CRESCENT_TRACE_SPAN(SerializeAbilities);
+        return serializeToJsonImpl(options);
+    }
     static AbilityProcessor deserializeFromJson(const nlohmann::json &data);
 
+    /**
+     * @brief Cached serializeToJson text; rebuilt only when getVersion()
+     * moves
+     */
+    SerializedBytes
+    serializeToBytes(const SerializationOptions &options = {}) const;
+    std::uint64_t getVersion() const;
+
   private:
     // Thread safety
     mutable std::mutex mutex_;
@@ -146,12 +201,23 @@ class AbilityProcessor {
         std::string currentEnvironment;
         float influence{0.0f};
         std::vector<std::string> activeEffects;
-        std::chrono::system_clock::time_point lastUpdate;
+        common::SimTick lastUpdate;
     } environmentalContext_;
 
     // Metrics
     ProcessingMetrics metrics_;
 
+    // Snapshot bookkeeping and serialization caching; marked under mutex_
+    // by every state change
+    ChangeTracker changeTracker_;
+    SerializationByteCache serializationCache_;
+
+    // Bodies of the instrumented entry points above
+    AbilityResult manifestAbilityImpl(const std::string &abilityId,
+                                      const ManifestationContext &context);
+    nlohmann::json
+    serializeToJsonImpl(const SerializationOptions &options) const;
+
     // Internal helpers
     bool validateManifestationRequirements(
         const std::string &abilityId,
@@ -159,7 +225,6 @@ class AbilityProcessor {
     void updateAbilityStates();
     void updateMetrics(const AbilityResult &result);
     void notifyAbilityStateChanged(const std::string &abilityId);
-    AbilityResult createResult(bool success, std::string message) const;
 };
 
 } // namespace crescent::traits
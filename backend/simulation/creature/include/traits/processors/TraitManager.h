@@ -1,15 +1,26 @@
 #ifndef CREATURE_ENGINE_TRAITS_PROCESSORS_TRAIT_MANAGER_H
 #define CREATURE_ENGINE_TRAITS_PROCESSORS_TRAIT_MANAGER_H
 
+#include "common/metrics/TraceSpan.h"
+#include "common/utils/InlineVector.h"
+#include "common/utils/PersistentMap.h"
+#include "common/utils/StatusVisitor.h"
+#include "creature_engine/core/ChangeTracking.h"
+#include "creature_engine/core/ErrorCodes.h"
 #include "creature_engine/core/changes/FormChange.h"
+#include "creature_engine/io/SerializationCache.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/base/TraitDefinition.h"
 #include "creature_engine/traits/interfaces/ITraitProcessor.h"
 #include "creature_engine/traits/interfaces/ITraitValidator.h"
 #include "creature_engine/traits/state/TraitState.h"
 #include "creature_engine/traits/synthesis/SynthesisProcessor.h"
+#include "creature_engine/traits/validation/TraitCompatibilityMatrix.h"
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -21,8 +32,15 @@ namespace crescent::traits {
  */
 class TraitManager {
   public:
-    // Construction/Destruction
+    // Construction/Destruction; without a catalog and table, traits are
+    // looked up in TraitCatalog::global(), which DataLoader fills, and
+    // syntheses record their catalyst influences in
+    // CatalystInfluenceTable::global()
     TraitManager();
+    explicit TraitManager(const TraitCompatibilityMatrix &compatibility);
+    TraitManager(const crucible::TraitCatalog &catalog,
+                 const TraitCompatibilityMatrix &compatibility,
+                 CatalystInfluenceTable &influences);
     ~TraitManager() = default;
 
     // Prevent copying, allow moving
@@ -31,19 +49,32 @@ class TraitManager {
     TraitManager(TraitManager &&) = default;
     TraitManager &operator=(TraitManager &&) = default;
 
+    /**
+     * @brief Copy for a forked creature
+     *
+     * Shares the trait table structurally, so trait states are copied only
+     * when either side first mutates them (see mutableTrait), and forks
+     * the synthesis processor. Starts a new write epoch on this manager;
+     * the fork gets its own owner tag.
+     */
+    std::unique_ptr<TraitManager> fork() const;
+
     // Core trait operations
-    struct TraitResult {
-        bool success;
-        std::string message;
-        std::vector<std::string> sideEffects;
+    // sideEffects owns its effect names, so results outlive the traits
+    struct TraitEffects {
+        common::InlineVector<std::string, 4> sideEffects;
         std::optional<FormChange> change;
     };
+    using TraitResult = common::Expected<TraitEffects, Error>;
 
     TraitResult addTrait(const std::string &traitId);
     TraitResult removeTrait(const std::string &traitId);
 
     // State management
-    void updateTraits(float deltaTime);
+    void updateTraits(float deltaTime) {
+        CRESCENT_TRACE_SPAN(UpdateTraits);
+        updateTraitsImpl(deltaTime);
+    }
     void processEnvironmentalEffects(const std::string &environment);
 
     // Adaptation tracking
@@ -60,6 +91,65 @@ class TraitManager {
     const TraitState *getTraitState(const std::string &traitId) const;
     std::vector<std::string> getActiveTraits() const;
 
+    /**
+     * @brief A trait state and the (owner tag, epoch) it was written under
+     *
+     * A table node may be shared by several versions while holding each
+     * state pointer once, so use_count() cannot tell whether a state is
+     * shared. Instead each manager has a unique owner tag and an epoch
+     * that every snapshot, fork and restore advances; a state stamped with
+     * the current pair was created or cloned since, so only the live table
+     * can see it.
+     */
+    struct TraitSlot {
+        std::shared_ptr<const TraitState> state;
+        std::uint64_t ownerTag{0};
+        std::uint64_t epoch{0};
+    };
+
+    /**
+     * @brief Trait states keyed by id, shared structurally between versions
+     */
+    using TraitTable = common::PersistentMap<std::string, TraitSlot>;
+
+    /**
+     * @brief O(1) snapshot of every trait state
+     *
+     * Starts a new write epoch, so the next write to any trait clones it.
+     */
+    TraitTable snapshotTraits() const {
+        ++epoch_;
+        return traits_;
+    }
+
+    /**
+     * @brief Reinstates a snapshot and rebuilds the interaction set
+     *
+     * Starts a new write epoch; the caller may still hold the table.
+     */
+    void restoreTraits(TraitTable traits);
+
+    /**
+     * @brief Non-neutral pairs among active traits, kept current on every
+     * add and remove
+     */
+    const TraitInteractionSet &getInteractions() const {
+        return interactions_;
+    }
+
+    /**
+     * @brief Reports each active trait id as an "activeTraits" list item
+     */
+    void visitActiveTraits(common::StatusVisitor &visitor) const;
+
+    /**
+     * @brief Syntheses of this creature's traits
+     */
+    SynthesisProcessor &getSynthesis() { return *synthesisProcessor_; }
+    const SynthesisProcessor &getSynthesis() const {
+        return *synthesisProcessor_;
+    }
+
     // Environmental interaction
     float
     calculateEnvironmentalCompatibility(const std::string &environment) const;
@@ -69,10 +159,45 @@ class TraitManager {
     ChangeResult processChange(const FormChange &change);
     std::optional<FormChange> getLastChange() const;
 
+    // Change tracking; covers every trait state, not the syntheses
+    enum DirtyField : ChangeTracker::FieldMask {
+        DirtyTraitSet = 1u << 0, // Traits added or removed
+        DirtyActivation = 1u << 1,
+        DirtyStrength = 1u << 2,
+        DirtyModifications = 1u << 3,
+        DirtyEnvironment = 1u << 4
+    };
+    const ChangeTracker &getChangeTracker() const { return changeTracker_; }
+    void clearDirty(std::uint64_t persistedVersion) {
+        changeTracker_.clearDirty(persistedVersion);
+    }
+
     // Serialization
     nlohmann::json
-    serializeToJson(const SerializationOptions &options = {}) const;
+    serializeToJson(const SerializationOptions &options = {}) const {
+        CRESCENT_TRACE_SPAN(SerializeTraits);
+        return serializeToJsonImpl(options);
+    }
     static TraitManager deserializeFromJson(const nlohmann::json &data);
+    static TraitManager
+    deserializeFromJson(const nlohmann::json &data,
+                        const crucible::TraitCatalog &catalog);
+
+    /**
+     * @brief Cached serializeToJson text, syntheses included; rebuilt only
+     * when getSerializationVersion() changes
+     */
+    SerializedBytes
+    serializeToBytes(const SerializationOptions &options = {}) const;
+    std::uint64_t getVersion() const { return changeTracker_.getVersion(); }
+
+    /**
+     * @brief Trait and synthesis versions the serialized output depends on
+     */
+    VersionStamp getSerializationVersion() const {
+        return {getVersion(),
+                synthesisProcessor_->getChangeTracker().getVersion()};
+    }
 
   private:
     // Core systems
@@ -81,9 +206,20 @@ class TraitManager {
     std::unique_ptr<SynthesisProcessor> synthesisProcessor_;
 
     // State tracking
-    std::unordered_map<std::string, std::unique_ptr<TraitState>> traits_;
+    TraitTable traits_;
+    std::uint64_t ownerTag_{nextOwnerTag_.fetch_add(1)};
+    mutable std::uint64_t epoch_{0}; // Advanced by snapshots and forks
+    inline static std::atomic<std::uint64_t> nextOwnerTag_{1};
+    const crucible::TraitCatalog *catalog_; // New states index into it
+    const TraitCompatibilityMatrix *compatibility_;
+    TraitInteractionSet interactions_;
     std::vector<FormChange> changeHistory_;
 
+    // Snapshot bookkeeping and serialization caching; every mutating
+    // operation marks the tracker with the fields it touched
+    ChangeTracker changeTracker_;
+    SerializationByteCache serializationCache_;
+
     // Environmental tracking
     struct EnvironmentalState {
         std::string currentEnvironment;
@@ -91,12 +227,36 @@ class TraitManager {
         std::unordered_map<std::string, float> traitStressLevels;
     } environmentalState_;
 
+    // Bodies of the instrumented entry points above
+    void updateTraitsImpl(float deltaTime);
+    nlohmann::json
+    serializeToJsonImpl(const SerializationOptions &options) const;
+
     // Internal helpers
     void updateAdaptationMetrics();
     void processTraitInteractions();
+    // Re-evaluates only the active pairs involving the changed trait
+    void processTraitInteractions(TraitIndex changed);
     void cleanupInactiveTraits();
     bool validateTraitOperation(const std::string &traitId) const;
     void notifyTraitChanged(const std::string &traitId);
+    // Clones the trait into traits_ first unless it carries this manager's
+    // current (owner tag, epoch); new states are stamped the same way
+    TraitState &mutableTrait(const std::string &traitId) {
+        const TraitSlot *slot = traits_.find(traitId);
+        if (!slot) {
+            throw std::out_of_range("Unknown trait: " + traitId);
+        }
+        if (slot->ownerTag == ownerTag_ && slot->epoch == epoch_) {
+            // Allocated non-const by this manager and unseen by snapshots
+            return const_cast<TraitState &>(*slot->state);
+        }
+        std::shared_ptr<TraitState> copy = slot->state->clone();
+        TraitState &state = *copy;
+        traits_ = traits_.set(traitId,
+                              TraitSlot{std::move(copy), ownerTag_, epoch_});
+        return state;
+    }
 };
 
 } // namespace crescent::traits
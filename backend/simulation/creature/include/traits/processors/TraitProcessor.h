@@ -1,6 +1,11 @@
 #ifndef CREATURE_ENGINE_TRAITS_PROCESSORS_TRAIT_PROCESSOR_H
 #define CREATURE_ENGINE_TRAITS_PROCESSORS_TRAIT_PROCESSOR_H
 
+#include "common/metrics/LatencyHistogram.h"
+#include "common/metrics/TraceSpan.h"
+#include "common/utils/InlineVector.h"
+#include "common/utils/SimulationClock.h"
+#include "creature_engine/core/ErrorCodes.h"
 #include "creature_engine/core/changes/FormChange.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/interfaces/ITraitProcessor.h"
@@ -16,16 +21,22 @@
 namespace crescent::traits {
 
 /**
- * @brief Result of a trait processing operation
+ * @brief What a successful trait processing operation did
+ *
+ * Owns its trait ids, so it stays valid whatever other threads do to the
+ * processor afterwards.
  */
-struct ProcessingResult {
-    bool success;
-    std::string message;
-    std::vector<std::string> warnings;
+struct TraitOutcome {
     std::optional<FormChange> change;
-    std::vector<std::string> affectedTraits;
+    common::InlineVector<std::string, 4> affectedTraits;
+    WarningList warnings;
 };
 
+/**
+ * @brief Result of a trait processing operation
+ */
+using ProcessingResult = common::Expected<TraitOutcome, Error>;
+
 /**
  * @brief Processes and manages trait states and changes
  */
@@ -38,7 +49,10 @@ class TraitProcessor : public ITraitProcessor {
 
     // Core state changes (from ITraitProcessor)
     ProcessingResult processTrait(const TraitDefinition &trait) override;
-    ProcessingResult applyChange(const FormChange &change) override;
+    ProcessingResult applyChange(const FormChange &change) override {
+        CRESCENT_TRACE_SPAN(ApplyChange);
+        return applyChangeImpl(change);
+    }
     std::optional<FormChange> getLastChange() const override;
 
     // Query interface (from ITraitProcessor)
@@ -76,13 +90,19 @@ class TraitProcessor : public ITraitProcessor {
         size_t failedChanges{0};
         float averageTraitStrength{0.0f};
         std::vector<std::string> recentWarnings;
-        std::chrono::system_clock::time_point lastUpdate;
+        // From MetricsRegistry; present in every build so the layout does
+        // not depend on CRESCENT_ENABLE_METRICS, and empty without it
+        metrics::LatencySummary applyChangeLatency;
+        common::SimTick lastUpdate;
     };
     ProcessingMetrics getMetrics() const;
 
     // Serialization
     nlohmann::json
-    serializeToJson(const SerializationOptions &options = {}) const override;
+    serializeToJson(const SerializationOptions &options = {}) const override {
+        CRESCENT_TRACE_SPAN(SerializeTraits);
+        return serializeToJsonImpl(options);
+    }
 
   private:
     // Thread safety
@@ -107,9 +127,14 @@ class TraitProcessor : public ITraitProcessor {
         size_t totalFailed{0};
         float strengthSum{0.0f};
         size_t strengthCount{0};
-        std::chrono::system_clock::time_point lastUpdate;
+        common::SimTick lastUpdate;
     } metrics_;
 
+    // Bodies of the instrumented entry points above
+    ProcessingResult applyChangeImpl(const FormChange &change);
+    nlohmann::json
+    serializeToJsonImpl(const SerializationOptions &options) const;
+
     // Processing helpers
     ProcessingResult validateChange(const FormChange &change) const;
     void applyValidatedChange(const FormChange &change);
@@ -120,7 +145,6 @@ class TraitProcessor : public ITraitProcessor {
     void updateTraitState(const std::string &traitId, const FormChange &change);
     bool resolveTraitConflicts(const std::string &traitId);
     void updateMetrics(const ProcessingResult &result);
-    ProcessingResult createResult(bool success, std::string message) const;
 };
 
 } // namespace crescent::traits
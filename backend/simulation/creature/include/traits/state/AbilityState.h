@@ -1,11 +1,18 @@
 #ifndef CREATURE_ENGINE_TRAITS_STATE_ABILITY_STATE_H
 #define CREATURE_ENGINE_TRAITS_STATE_ABILITY_STATE_H
 
+#include "common/utils/InlineVector.h"
+#include "common/utils/SimulationClock.h"
+#include "common/utils/SmallFlatMap.h"
+#include "common/utils/StatusVisitor.h"
+#include "common/utils/Views.h"
+#include "creature_engine/core/ErrorCodes.h"
+#include "creature_engine/io/JsonStreamWriter.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/base/TraitAbility.h"
 #include "creature_engine/traits/base/TraitEnums.h"
 
-#include <chrono>
+#include <memory>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -13,14 +20,27 @@
 
 namespace crescent::traits {
 
+/**
+ * @brief Influence per environment; abilities see only a few environments
+ */
+using InfluenceMap = common::SmallFlatMap<std::string, float, 4>;
+
+/**
+ * @brief Effect names reported by a result
+ *
+ * Owns its names, so a result stays valid after the ability is
+ * unregistered. Up to four names stay inline.
+ */
+using EffectList = common::InlineVector<std::string, 4>;
+
 /**
  * @brief Tracks the manifestation state of a trait-granted ability
  */
 struct AbilityManifestation {
     bool isManifested{false};
     std::vector<std::string> activeEffects;
-    std::unordered_map<std::string, float> environmentalInfluences;
-    std::chrono::system_clock::time_point lastStateChange;
+    InfluenceMap environmentalInfluences;
+    common::SimTick lastStateChange;
 };
 
 /**
@@ -39,17 +59,18 @@ class AbilityState {
     AbilityState(AbilityState &&) = default;
     AbilityState &operator=(AbilityState &&) = default;
 
+    /**
+     * @brief Explicit deep copy for forked owners
+     */
+    std::unique_ptr<AbilityState> clone() const;
+
     // Core state access
     const std::string &getId() const { return id_; }
     bool isAvailable() const;
     bool isManifested() const;
 
     // State changes
-    struct ManifestationResult {
-        bool success;
-        std::string message;
-        std::vector<std::string> manifestedEffects;
-    };
+    using ManifestationResult = common::Expected<EffectList, Error>;
 
     ManifestationResult manifest();
     ManifestationResult unmanifest();
@@ -70,15 +91,47 @@ class AbilityState {
         bool isManifested;
         std::vector<std::string> activeEffects;
         std::unordered_map<std::string, float> environmentalInfluences;
-        std::chrono::system_clock::time_point lastStateChange;
+        common::SimTick lastStateChange;
     };
     AbilityStatus getStatus() const;
 
+    /**
+     * @brief Allocation-free status over internal storage
+     *
+     * Valid until the next non-const call on this AbilityState.
+     */
+    struct StatusView {
+        bool isAvailable;
+        bool isManifested;
+        common::Span<const std::string> activeEffects;
+        common::MapView<InfluenceMap> environmentalInfluences;
+        common::SimTick lastStateChange;
+    };
+    StatusView getStatusView() const;
+
+    /**
+     * @brief Streams the same fields as getStatus into a visitor
+     */
+    void visitStatus(common::StatusVisitor &visitor) const;
+
+    /**
+     * @brief Bytes owned by this state, including spilled map storage
+     */
+    std::size_t getMemoryFootprint() const;
+
     // Serialization
     nlohmann::json
     serializeToJson(const SerializationOptions &options = {}) const;
     static AbilityState deserializeFromJson(const nlohmann::json &data);
 
+    /**
+     * @brief Streams the same JSON as serializeToJson without a DOM
+     *
+     * Byte-identical to serializeToJson(options).dump().
+     */
+    void writeJson(io::JsonStreamWriter &writer,
+                   const SerializationOptions &options = {}) const;
+
   private:
     // Core identification
     std::string id_;
@@ -1,12 +1,17 @@
 #ifndef CREATURE_ENGINE_TRAITS_STATE_TRAIT_STATE_H
 #define CREATURE_ENGINE_TRAITS_STATE_TRAIT_STATE_H
 
+#include "common/utils/SimulationClock.h"
+#include "common/utils/SmallFlatMap.h"
+#include "common/utils/StatusVisitor.h"
+#include "common/utils/Views.h"
+#include "creature_engine/io/JsonStreamWriter.h"
 #include "creature_engine/io/SerializationStructures.h"
+#include "creature_engine/traits/base/TraitCatalog.h"
 #include "creature_engine/traits/base/TraitDefinition.h"
 #include "creature_engine/traits/base/TraitEnums.h"
 #include "creature_engine/traits/synthesis/SynthesisState.h"
 
-#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
@@ -22,17 +27,31 @@ struct TraitModification {
     float strengthModifier{1.0f};
     bool isSuppressed{false};
     std::vector<std::string> activeEffects;
-    std::chrono::system_clock::time_point lastUpdate;
+    crescent::common::SimTick lastUpdate;
 };
 
+/**
+ * @brief Modifications keyed by source; rarely more than a few per trait
+ */
+using ModificationMap =
+    crescent::common::SmallFlatMap<std::string, TraitModification, 4>;
+
 /**
  * @brief Manages the current state and history of a trait
  */
 class TraitState {
   public:
     // Construction/Destruction
-    TraitState() = default;
-    explicit TraitState(const TraitDefinition &definition);
+
+    /**
+     * @brief State for a catalogued trait
+     *
+     * The catalog must outlive the state. Hot per-tick data is read from
+     * the catalog by index; the definition itself is only touched by
+     * getDefinition().
+     * @throws crescent::TraitException if the index is not in the catalog
+     */
+    TraitState(TraitIndex definition, const TraitCatalog &catalog);
     ~TraitState() = default;
 
     // Prevent copying, allow moving
@@ -41,9 +60,20 @@ class TraitState {
     TraitState(TraitState &&) = default;
     TraitState &operator=(TraitState &&) = default;
 
+    /**
+     * @brief Explicit deep copy for copy-on-write owners
+     */
+    std::unique_ptr<TraitState> clone() const;
+
     // Core state access
-    const std::string &getId() const { return id_; }
-    const TraitDefinition &getDefinition() const { return *definition_; }
+    const std::string &getId() const { return catalog_->idOf(definition_); }
+    TraitIndex getDefinitionIndex() const { return definition_; }
+    const TraitHotRecord &getHotRecord() const {
+        return catalog_->hot(definition_);
+    }
+    const TraitDefinition &getDefinition() const {
+        return catalog_->definition(definition_);
+    }
     float getStrength() const { return strength_; }
     bool isActive() const { return isActive_; }
 
@@ -61,8 +91,7 @@ class TraitState {
 
     ModificationResult removeModification(const std::string &source);
 
-    const std::unordered_map<std::string, TraitModification> &
-    getActiveModifications() const {
+    const ModificationMap &getActiveModifications() const {
         return modifications_;
     }
 
@@ -71,6 +100,13 @@ class TraitState {
     void updateEnvironmentalResponse(const std::string &environment,
                                      float deltaTime);
 
+    /**
+     * @brief Per-tick forms taking an id from TraitCatalog::environmentId
+     */
+    float calculateEnvironmentalAffinity(EnvironmentId environment) const;
+    void updateEnvironmentalResponse(EnvironmentId environment,
+                                     float deltaTime);
+
     // State transitions
     bool activate();
     bool deactivate();
@@ -83,19 +119,57 @@ class TraitState {
         bool isSuppressed;
         float currentStrength;
         std::vector<std::string> activeEffects;
-        std::chrono::system_clock::time_point lastStateChange;
+        crescent::common::SimTick lastStateChange;
     };
     StatusInfo getStatus() const;
 
+    /**
+     * @brief Bytes owned by this state, including spilled map storage
+     */
+    std::size_t getMemoryFootprint() const;
+
+    /**
+     * @brief Allocation-free status over internal storage
+     *
+     * Active effects stay grouped by modification source rather than being
+     * flattened. Valid until the next non-const call on this TraitState.
+     */
+    struct StatusView {
+        bool isActive;
+        bool isSuppressed;
+        float currentStrength;
+        crescent::common::MapView<ModificationMap> modifications;
+        crescent::common::SimTick lastStateChange;
+    };
+    StatusView getStatusView() const;
+
+    /**
+     * @brief Streams the same fields as getStatus into a visitor
+     */
+    void visitStatus(crescent::common::StatusVisitor &visitor) const;
+
     // Serialization
     nlohmann::json
     serializeToJson(const SerializationOptions &options = {}) const;
-    static TraitState deserializeFromJson(const nlohmann::json &data);
+    /**
+     * @brief Rebuilds a state, resolving its trait id in the catalog
+     * @throws crescent::TraitException if the catalog lacks the trait
+     */
+    static TraitState deserializeFromJson(const nlohmann::json &data,
+                                          const TraitCatalog &catalog);
+
+    /**
+     * @brief Streams the same JSON as serializeToJson without a DOM
+     *
+     * Byte-identical to serializeToJson(options).dump().
+     */
+    void writeJson(crescent::io::JsonStreamWriter &writer,
+                   const SerializationOptions &options = {}) const;
 
   private:
-    // Core identification
-    std::string id_;
-    std::shared_ptr<const TraitDefinition> definition_;
+    // Core identification; id and definition live in the catalog
+    const TraitCatalog *catalog_{nullptr};
+    TraitIndex definition_{TraitCatalog::NO_TRAIT};
 
     // Current state
     bool isActive_{false};
@@ -103,8 +177,8 @@ class TraitState {
     float strength_{1.0f};
 
     // Modification tracking
-    std::unordered_map<std::string, TraitModification> modifications_;
-    std::chrono::system_clock::time_point lastStateChange_;
+    ModificationMap modifications_;
+    crescent::common::SimTick lastStateChange_;
 
     // Internal helpers
     void updateStrength();
@@ -0,0 +1,696 @@
+#ifndef CREATURE_ENGINE_TRAITS_SYNTHESIS_CATALYST_INFLUENCE_TABLE_H
+#define CREATURE_ENGINE_TRAITS_SYNTHESIS_CATALYST_INFLUENCE_TABLE_H
+
+#include "common/utils/WorkerPool.h"
+#include "creature_engine/traits/synthesis/SynthesisEnums.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent::traits {
+
+/**
+ * @brief Key for tracking catalyst influences
+ */
+struct CatalystKey {
+    CatalystType type;
+    std::string id;
+
+    bool operator==(const CatalystKey &other) const {
+        return type == other.type && id == other.id;
+    }
+
+    struct Hash {
+        std::size_t operator()(const CatalystKey &k) const {
+            return std::hash<std::string>()(k.id) ^
+                   (std::hash<int>()(static_cast<int>(k.type)) << 1);
+        }
+    };
+};
+
+/**
+ * @brief Tracks the influence of a specific catalyst
+ *
+ * A copy of one table row; the table itself is columnar.
+ */
+struct CatalystInfluence {
+    float currentStrength{0.0f};
+    float peakStrength{0.0f};
+    int exposureCount{0};
+    float secondsSinceExposure{0.0f};
+    std::vector<std::string>
+        affectedForms; // Forms this catalyst has influenced
+};
+
+/**
+ * @brief Every catalyst influence in the engine, stored by column
+ *
+ * Rows are keyed by (owner, catalyst type, catalyst id), where an owner is
+ * one SynthesisState. Rows live in shards chosen by owner, and within a
+ * shard in one block per catalyst type, so each block decays at a single
+ * rate. decay() is then a straight pass over float columns per block:
+ * peak tracking, exponential decay, idle ageing and expiry flags in one
+ * auto-vectorized loop, followed by a swap-remove of the (rare) expired
+ * rows. Catalyst ids and form names are interned once for the table.
+ *
+ * Exposure and reads lock only the owner's shard, so creatures processed
+ * on different workers rarely contend. decay() locks each shard in turn.
+ *
+ * Every exposure, restore, copy and expiry gives the owner a new version
+ * (versionOf) drawn from one table-wide counter, so versions never repeat
+ * even when owner ids are recycled. Decay alone does not: strength and
+ * idle time follow from the last exposure and the time since, so a
+ * snapshot keeps the values from the owner's last versioned change and a
+ * restored row goes on decaying from there. Otherwise every owner with
+ * rows would count as changed on every tick.
+ */
+class CatalystInfluenceTable {
+  public:
+    using OwnerId = std::uint32_t;
+    static constexpr OwnerId NO_OWNER = std::numeric_limits<OwnerId>::max();
+    static constexpr std::size_t SHARD_COUNT = 16;
+    static constexpr std::size_t CATALYST_TYPE_COUNT =
+        static_cast<std::size_t>(CatalystType::External) + 1;
+
+    struct Config {
+        // Seconds for an unrefreshed influence to lose half its strength,
+        // indexed by CatalystType; infinity disables decay
+        std::array<float, CATALYST_TYPE_COUNT> halfLife{30.0f, 10.0f, 5.0f,
+                                                        120.0f, 60.0f};
+        float expiryStrength{0.01f};  // Rows below this are dropped
+        float maxIdleSeconds{600.0f}; // Rows not refreshed this long too
+    };
+
+    /**
+     * @brief Move-only owner registration; releases its rows on destruction
+     */
+    class Owner {
+      public:
+        Owner() = default;
+        ~Owner() { reset(); }
+
+        // Prevent copying, allow moving
+        Owner(const Owner &) = delete;
+        Owner &operator=(const Owner &) = delete;
+        Owner(Owner &&other) noexcept
+            : table_(std::exchange(other.table_, nullptr)),
+              id_(std::exchange(other.id_, NO_OWNER)) {}
+        Owner &operator=(Owner &&other) noexcept {
+            if (this != &other) {
+                reset();
+                table_ = std::exchange(other.table_, nullptr);
+                id_ = std::exchange(other.id_, NO_OWNER);
+            }
+            return *this;
+        }
+
+        CatalystInfluenceTable *table() const { return table_; }
+        OwnerId id() const { return id_; }
+        explicit operator bool() const { return table_ != nullptr; }
+
+        void reset() {
+            if (table_) {
+                table_->releaseOwner(id_);
+                table_ = nullptr;
+                id_ = NO_OWNER;
+            }
+        }
+
+      private:
+        friend class CatalystInfluenceTable;
+        Owner(CatalystInfluenceTable *table, OwnerId id)
+            : table_(table), id_(id) {}
+
+        CatalystInfluenceTable *table_{nullptr};
+        OwnerId id_{NO_OWNER};
+    };
+
+    CatalystInfluenceTable() = default;
+    explicit CatalystInfluenceTable(Config config) : config_(config) {}
+
+    // Prevent copying and moving
+    CatalystInfluenceTable(const CatalystInfluenceTable &) = delete;
+    CatalystInfluenceTable &operator=(const CatalystInfluenceTable &) = delete;
+    CatalystInfluenceTable(CatalystInfluenceTable &&) = delete;
+    CatalystInfluenceTable &operator=(CatalystInfluenceTable &&) = delete;
+
+    /**
+     * @brief Engine-wide table for TraitManagers built without one
+     *
+     * Never destroyed, so states held by other statics can still release
+     * their rows during shutdown.
+     */
+    static CatalystInfluenceTable &global() {
+        static CatalystInfluenceTable *table = new CatalystInfluenceTable();
+        return *table;
+    }
+
+    /**
+     * @brief Registers a new owner; ids are recycled after release
+     * @throws std::length_error if every owner id is in use
+     */
+    Owner acquire() {
+        std::lock_guard<std::mutex> lock(ownersMutex_);
+        if (!freeOwners_.empty()) {
+            const OwnerId id = freeOwners_.back();
+            freeOwners_.pop_back();
+            return Owner(this, id);
+        }
+        if (nextOwner_ == NO_OWNER) {
+            throw std::length_error("CatalystInfluenceTable: out of owners");
+        }
+        return Owner(this, nextOwner_++);
+    }
+
+    /**
+     * @brief Adds intensity to an influence, creating it if needed
+     *
+     * Strength saturates at 1; the exposure count increments and the idle
+     * age resets. form, if given, is recorded as an affected form.
+     */
+    void recordExposure(OwnerId owner, CatalystType type,
+                        const std::string &catalystId, float intensity,
+                        const std::string &form = {}) {
+        const std::uint32_t catalyst = intern(catalystId);
+        const std::uint32_t formId =
+            form.empty() ? NO_STRING : intern(form);
+        Shard &shard = shardOf(owner);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const std::uint64_t key = packKey(owner, type, catalyst);
+        Block &block = shard.blocks[static_cast<std::size_t>(type)];
+        auto [it, inserted] = shard.rows.try_emplace(
+            key, static_cast<std::uint32_t>(block.size()));
+        if (inserted) {
+            block.push(owner, catalyst);
+            shard.ownerKeys[owner].push_back(key);
+        }
+        const std::uint32_t row = it->second;
+        shard.versions[owner] = nextVersion();
+        block.current[row] =
+            std::min(block.current[row] + std::max(intensity, 0.0f), 1.0f);
+        block.exposures[row] += 1;
+        block.age[row] = 0.0f;
+        if (formId != NO_STRING) {
+            std::vector<std::uint32_t> &forms = block.forms[row];
+            if (std::find(forms.begin(), forms.end(), formId) == forms.end()) {
+                forms.push_back(formId);
+            }
+        }
+    }
+
+    /**
+     * @brief Current strength, or 0 if there is no such influence
+     */
+    float strengthOf(OwnerId owner, CatalystType type,
+                     const std::string &catalystId) const {
+        const std::optional<std::uint32_t> catalyst = findInterned(catalystId);
+        if (!catalyst) {
+            return 0.0f;
+        }
+        const Shard &shard = shardOf(owner);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.rows.find(packKey(owner, type, *catalyst));
+        if (it == shard.rows.end()) {
+            return 0.0f;
+        }
+        return shard.blocks[static_cast<std::size_t>(type)]
+            .current[it->second];
+    }
+
+    std::optional<CatalystInfluence> find(OwnerId owner, CatalystType type,
+                                          const std::string &catalystId) const {
+        const std::optional<std::uint32_t> catalyst = findInterned(catalystId);
+        if (!catalyst) {
+            return std::nullopt;
+        }
+        const Shard &shard = shardOf(owner);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.rows.find(packKey(owner, type, *catalyst));
+        if (it == shard.rows.end()) {
+            return std::nullopt;
+        }
+        return materialize(shard.blocks[static_cast<std::size_t>(type)],
+                           it->second);
+    }
+
+    /**
+     * @brief Visits an owner's influences as fn(const CatalystKey &,
+     * const CatalystInfluence &), in first-exposure order
+     *
+     * Rows are copied out under the shard lock and visited after it is
+     * released, so fn may call back into the table.
+     */
+    template <typename Fn> void forEachOf(OwnerId owner, Fn &&fn) const {
+        std::vector<std::pair<CatalystKey, CatalystInfluence>> rows;
+        {
+            const Shard &shard = shardOf(owner);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto keys = shard.ownerKeys.find(owner);
+            if (keys == shard.ownerKeys.end()) {
+                return;
+            }
+            rows.reserve(keys->second.size());
+            for (std::uint64_t key : keys->second) {
+                const CatalystType type = typeOf(key);
+                const Block &block =
+                    shard.blocks[static_cast<std::size_t>(type)];
+                const std::uint32_t row = shard.rows.at(key);
+                rows.emplace_back(
+                    CatalystKey{type, stringOf(block.catalyst[row])},
+                    materialize(block, row));
+            }
+        }
+        for (const auto &[key, influence] : rows) {
+            fn(key, influence);
+        }
+    }
+
+    /**
+     * @brief Gives target a copy of every row source owns
+     *
+     * Used when a SynthesisState is cloned for a fork. target's existing
+     * rows for the same catalysts are overwritten.
+     */
+    void copyOwner(OwnerId source, OwnerId target) {
+        struct Row {
+            CatalystType type;
+            std::uint32_t catalyst;
+            float current, peak, age;
+            std::int32_t exposures;
+            std::vector<std::uint32_t> forms;
+        };
+        std::vector<Row> rows;
+        {
+            const Shard &shard = shardOf(source);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto keys = shard.ownerKeys.find(source);
+            if (keys == shard.ownerKeys.end()) {
+                return;
+            }
+            rows.reserve(keys->second.size());
+            for (std::uint64_t key : keys->second) {
+                const CatalystType type = typeOf(key);
+                const Block &block =
+                    shard.blocks[static_cast<std::size_t>(type)];
+                const std::uint32_t row = shard.rows.at(key);
+                rows.push_back({type, block.catalyst[row], block.current[row],
+                                block.peak[row], block.age[row],
+                                block.exposures[row], block.forms[row]});
+            }
+        }
+        Shard &shard = shardOf(target);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.versions[target] = nextVersion();
+        for (Row &copied : rows) {
+            Block &block = shard.blocks[static_cast<std::size_t>(copied.type)];
+            const std::uint64_t key = packKey(target, copied.type,
+                                              copied.catalyst);
+            auto [it, inserted] = shard.rows.try_emplace(
+                key, static_cast<std::uint32_t>(block.size()));
+            if (inserted) {
+                block.push(target, copied.catalyst);
+                shard.ownerKeys[target].push_back(key);
+            }
+            const std::uint32_t row = it->second;
+            block.current[row] = copied.current;
+            block.peak[row] = copied.peak;
+            block.age[row] = copied.age;
+            block.exposures[row] = copied.exposures;
+            block.forms[row] = std::move(copied.forms);
+        }
+    }
+
+    /**
+     * @brief Sets one row of owner to a copy read out of another table
+     *
+     * The inverse of forEachOf, for influences that arrive as values from
+     * a file or another process: the catalyst id and forms are interned
+     * in this table. An existing row for the same catalyst is overwritten.
+     */
+    void restore(OwnerId owner, const CatalystKey &key,
+                 const CatalystInfluence &influence) {
+        const std::uint32_t catalyst = intern(key.id);
+        std::vector<std::uint32_t> forms;
+        forms.reserve(influence.affectedForms.size());
+        for (const std::string &form : influence.affectedForms) {
+            forms.push_back(intern(form));
+        }
+        Shard &shard = shardOf(owner);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        const std::uint64_t rowKey = packKey(owner, key.type, catalyst);
+        Block &block = shard.blocks[static_cast<std::size_t>(key.type)];
+        auto [it, inserted] = shard.rows.try_emplace(
+            rowKey, static_cast<std::uint32_t>(block.size()));
+        if (inserted) {
+            block.push(owner, catalyst);
+            shard.ownerKeys[owner].push_back(rowKey);
+        }
+        const std::uint32_t row = it->second;
+        shard.versions[owner] = nextVersion();
+        block.current[row] = influence.currentStrength;
+        block.peak[row] = influence.peakStrength;
+        block.age[row] = influence.secondsSinceExposure;
+        block.exposures[row] = influence.exposureCount;
+        block.forms[row] = std::move(forms);
+    }
+
+    /**
+     * @brief Version of the owner's last change; 0 if it never had rows
+     */
+    std::uint64_t versionOf(OwnerId owner) const {
+        const Shard &shard = shardOf(owner);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto it = shard.versions.find(owner);
+        return it == shard.versions.end() ? 0 : it->second;
+    }
+
+    std::size_t countOf(OwnerId owner) const {
+        const Shard &shard = shardOf(owner);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        auto keys = shard.ownerKeys.find(owner);
+        return keys == shard.ownerKeys.end() ? 0 : keys->second.size();
+    }
+
+    /**
+     * @brief Ages every influence by dt seconds and drops expired rows
+     *
+     * Shards run in parallel on pool when given. Owners that lost a row
+     * get a new version; owners whose rows only weakened keep theirs.
+     * @return Number of rows expired
+     */
+    std::size_t decay(float dt, common::WorkerPool *pool = nullptr) {
+        std::array<float, CATALYST_TYPE_COUNT> keep{};
+        for (std::size_t t = 0; t < CATALYST_TYPE_COUNT; ++t) {
+            const float halfLife = config_.halfLife[t];
+            keep[t] = halfLife > 0.0f ? std::exp2(-dt / halfLife) : 0.0f;
+        }
+        std::array<std::size_t, SHARD_COUNT> expired{};
+        const auto run = [&](std::size_t begin, std::size_t end,
+                             std::size_t) {
+            for (std::size_t s = begin; s < end; ++s) {
+                expired[s] = decayShard(shards_[s], dt, keep);
+            }
+        };
+        if (pool) {
+            pool->forEachChunk(SHARD_COUNT, 1, run);
+        } else {
+            run(0, SHARD_COUNT, 0);
+        }
+        std::size_t total = 0;
+        for (std::size_t count : expired) {
+            total += count;
+        }
+        return total;
+    }
+
+    std::size_t size() const {
+        std::size_t total = 0;
+        for (const Shard &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            total += shard.rows.size();
+        }
+        return total;
+    }
+
+    std::size_t getMemoryFootprint() const {
+        std::size_t bytes = 0;
+        for (const Shard &shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            for (const Block &block : shard.blocks) {
+                bytes += block.capacityBytes();
+            }
+            bytes += shard.rows.size() *
+                     (sizeof(std::uint64_t) + sizeof(std::uint32_t));
+        }
+        std::shared_lock<std::shared_mutex> lock(internMutex_);
+        for (const std::string &value : strings_) {
+            bytes += sizeof(std::string) + value.capacity();
+        }
+        return bytes;
+    }
+
+  private:
+    static constexpr std::uint32_t NO_STRING =
+        std::numeric_limits<std::uint32_t>::max();
+
+    struct Block {
+        // Hot columns, read by decay()
+        std::vector<float> current;
+        std::vector<float> peak;
+        std::vector<float> age;
+        std::vector<std::uint8_t> expired;
+        // Identity and counters
+        std::vector<OwnerId> owner;
+        std::vector<std::uint32_t> catalyst;
+        std::vector<std::int32_t> exposures;
+        // Cold: interned affected forms
+        std::vector<std::vector<std::uint32_t>> forms;
+
+        std::size_t size() const { return current.size(); }
+
+        void push(OwnerId ownerId, std::uint32_t catalystId) {
+            current.push_back(0.0f);
+            peak.push_back(0.0f);
+            age.push_back(0.0f);
+            expired.push_back(0);
+            owner.push_back(ownerId);
+            catalyst.push_back(catalystId);
+            exposures.push_back(0);
+            forms.emplace_back();
+        }
+
+        void moveRow(std::size_t from, std::size_t to) {
+            current[to] = current[from];
+            peak[to] = peak[from];
+            age[to] = age[from];
+            expired[to] = expired[from];
+            owner[to] = owner[from];
+            catalyst[to] = catalyst[from];
+            exposures[to] = exposures[from];
+            forms[to] = std::move(forms[from]);
+        }
+
+        void popBack() {
+            current.pop_back();
+            peak.pop_back();
+            age.pop_back();
+            expired.pop_back();
+            owner.pop_back();
+            catalyst.pop_back();
+            exposures.pop_back();
+            forms.pop_back();
+        }
+
+        std::size_t capacityBytes() const {
+            std::size_t bytes =
+                (current.capacity() + peak.capacity() + age.capacity()) *
+                    sizeof(float) +
+                expired.capacity() + owner.capacity() * sizeof(OwnerId) +
+                catalyst.capacity() * sizeof(std::uint32_t) +
+                exposures.capacity() * sizeof(std::int32_t) +
+                forms.capacity() * sizeof(std::vector<std::uint32_t>);
+            for (const auto &list : forms) {
+                bytes += list.capacity() * sizeof(std::uint32_t);
+            }
+            return bytes;
+        }
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::array<Block, CATALYST_TYPE_COUNT> blocks;
+        std::unordered_map<std::uint64_t, std::uint32_t> rows; // Key -> row
+        std::unordered_map<OwnerId, std::vector<std::uint64_t>> ownerKeys;
+        std::unordered_map<OwnerId, std::uint64_t> versions; // See versionOf
+    };
+
+    Config config_;
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    // Owner id allocation
+    std::mutex ownersMutex_;
+    std::vector<OwnerId> freeOwners_;
+    OwnerId nextOwner_{0};
+    std::atomic<std::uint64_t> versionClock_{0};
+
+    // Interned catalyst ids and form names; append-only
+    mutable std::shared_mutex internMutex_;
+    std::unordered_map<std::string, std::uint32_t> internIds_;
+    std::vector<std::string> strings_;
+
+    Shard &shardOf(OwnerId owner) { return shards_[owner % SHARD_COUNT]; }
+    const Shard &shardOf(OwnerId owner) const {
+        return shards_[owner % SHARD_COUNT];
+    }
+
+    // owner:32 | catalyst:29 | type:3; intern() keeps ids below MAX_INTERNED
+    static constexpr std::uint32_t MAX_INTERNED = std::uint32_t{1} << 29;
+    static std::uint64_t packKey(OwnerId owner, CatalystType type,
+                                 std::uint32_t catalyst) {
+        return (static_cast<std::uint64_t>(owner) << 32) |
+               (static_cast<std::uint64_t>(catalyst) << 3) |
+               static_cast<std::uint64_t>(type);
+    }
+    static CatalystType typeOf(std::uint64_t key) {
+        return static_cast<CatalystType>(key & 7);
+    }
+
+    std::uint32_t intern(const std::string &value) {
+        {
+            std::shared_lock<std::shared_mutex> lock(internMutex_);
+            auto it = internIds_.find(value);
+            if (it != internIds_.end()) {
+                return it->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(internMutex_);
+        if (strings_.size() >= MAX_INTERNED && !internIds_.count(value)) {
+            throw std::length_error(
+                "CatalystInfluenceTable: too many catalyst ids and forms");
+        }
+        auto [it, inserted] = internIds_.try_emplace(
+            value, static_cast<std::uint32_t>(strings_.size()));
+        if (inserted) {
+            strings_.emplace_back(value);
+        }
+        return it->second;
+    }
+
+    std::uint64_t nextVersion() {
+        return versionClock_.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    std::optional<std::uint32_t> findInterned(const std::string &value) const {
+        std::shared_lock<std::shared_mutex> lock(internMutex_);
+        auto it = internIds_.find(value);
+        if (it == internIds_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::string stringOf(std::uint32_t id) const {
+        std::shared_lock<std::shared_mutex> lock(internMutex_);
+        return strings_[id];
+    }
+
+    CatalystInfluence materialize(const Block &block,
+                                  std::uint32_t row) const {
+        CatalystInfluence influence;
+        influence.currentStrength = block.current[row];
+        influence.peakStrength = std::max(block.peak[row], block.current[row]);
+        influence.exposureCount = block.exposures[row];
+        influence.secondsSinceExposure = block.age[row];
+        influence.affectedForms.reserve(block.forms[row].size());
+        for (std::uint32_t form : block.forms[row]) {
+            influence.affectedForms.push_back(stringOf(form));
+        }
+        return influence;
+    }
+
+    std::size_t
+    decayShard(Shard &shard, float dt,
+               const std::array<float, CATALYST_TYPE_COUNT> &keep) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::size_t expiredRows = 0;
+        std::uint64_t version = 0; // Shared by every owner expiring here
+        for (std::size_t t = 0; t < CATALYST_TYPE_COUNT; ++t) {
+            Block &block = shard.blocks[t];
+            const std::size_t n = block.size();
+            float *current = block.current.data();
+            float *peak = block.peak.data();
+            float *age = block.age.data();
+            std::uint8_t *expired = block.expired.data();
+            const float factor = keep[t];
+            const float floor = config_.expiryStrength;
+            const float maxIdle = config_.maxIdleSeconds;
+            std::uint32_t flagged = 0;
+            // Branch-free so the loop vectorizes
+            for (std::size_t i = 0; i < n; ++i) {
+                const float c = current[i];
+                peak[i] = std::max(peak[i], c);
+                const float decayed = c * factor;
+                const float idle = age[i] + dt;
+                current[i] = decayed;
+                age[i] = idle;
+                const std::uint8_t gone = (decayed < floor) | (idle > maxIdle);
+                expired[i] = gone;
+                flagged += gone;
+            }
+            if (flagged == 0) {
+                continue;
+            }
+            expiredRows += flagged;
+            if (version == 0) {
+                version = nextVersion();
+            }
+            // Walk backwards so each swap pulls in an already-checked row
+            for (std::size_t i = n; i-- > 0;) {
+                if (expired[i]) {
+                    shard.versions[block.owner[i]] = version;
+                    removeRow(shard, block, static_cast<CatalystType>(t),
+                              i);
+                }
+            }
+        }
+        return expiredRows;
+    }
+
+    void removeRow(Shard &shard, Block &block, CatalystType type,
+                   std::size_t row) {
+        const std::uint64_t key =
+            packKey(block.owner[row], type, block.catalyst[row]);
+        shard.rows.erase(key);
+        auto keys = shard.ownerKeys.find(block.owner[row]);
+        std::vector<std::uint64_t> &list = keys->second;
+        list.erase(std::find(list.begin(), list.end(), key));
+        if (list.empty()) {
+            shard.ownerKeys.erase(keys);
+        }
+        const std::size_t last = block.size() - 1;
+        if (row != last) {
+            block.moveRow(last, row);
+            shard.rows[packKey(block.owner[row], type, block.catalyst[row])] =
+                static_cast<std::uint32_t>(row);
+        }
+        block.popBack();
+    }
+
+    void releaseOwner(OwnerId owner) {
+        {
+            Shard &shard = shardOf(owner);
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto keys = shard.ownerKeys.find(owner);
+            if (keys != shard.ownerKeys.end()) {
+                const std::vector<std::uint64_t> list = keys->second;
+                for (std::uint64_t key : list) {
+                    const CatalystType type = typeOf(key);
+                    removeRow(shard,
+                              shard.blocks[static_cast<std::size_t>(type)],
+                              type, shard.rows.at(key));
+                }
+            }
+            shard.versions.erase(owner);
+        }
+        std::lock_guard<std::mutex> lock(ownersMutex_);
+        freeOwners_.push_back(owner);
+    }
+};
+
+} // namespace crescent::traits
+
+#endif // CREATURE_ENGINE_TRAITS_SYNTHESIS_CATALYST_INFLUENCE_TABLE_H
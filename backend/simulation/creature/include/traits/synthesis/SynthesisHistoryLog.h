@@ -0,0 +1,425 @@
+#ifndef CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_HISTORY_LOG_H
+#define CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_HISTORY_LOG_H
+
+#include "common/utils/SimulationClock.h"
+#include "common/utils/StringArena.h"
+#include "creature_engine/traits/synthesis/SynthesisEnums.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace crescent::traits {
+
+/**
+ * @brief Records a synthesis transformation with complete context
+ */
+struct SynthesisEvent {
+    std::string sourceForm;
+    std::string resultForm;
+    CatalystType catalystType;
+    std::string catalystId;
+    float intensity;
+    SynthesisStage stage;
+    std::vector<std::string> affectedTraits; // Traits modified by this event
+    common::SimTick timestamp;
+
+    // Validation
+    bool isValid() const;
+};
+
+/**
+ * @brief Append-only synthesis history stored by column
+ *
+ * Forms, catalyst ids and trait ids are interned into a shared
+ * StringInterner, so an event costs a few 32-bit ids instead of five or
+ * more strings. The log holds one interner reference per stored id and
+ * drops it when the event is dropped, so the interner forgets strings no
+ * log uses any more. Timestamps are simulation ticks stored as varint deltas
+ * from the previous event (usually one byte), with an absolute checkpoint
+ * every CHECKPOINT_INTERVAL events so random access decodes at most that
+ * many deltas; sequential reads such as recent() decode forward once.
+ * Affected traits are a CSR pair of offset and id columns.
+ *
+ * A per-CatalystType list of event indices answers filtered queries
+ * without scanning other types. Past maxEvents the oldest quarter is
+ * dropped in one compaction, so appends stay amortized O(1).
+ *
+ * Not thread-safe; owned and guarded like the SynthesisState it belongs to.
+ */
+class SynthesisHistoryLog {
+  public:
+    using StringId = common::StringInterner::Id;
+    static constexpr std::size_t DEFAULT_MAX_EVENTS = 4096;
+    static constexpr std::size_t CHECKPOINT_INTERVAL = 64;
+    static constexpr std::size_t CATALYST_TYPE_COUNT =
+        static_cast<std::size_t>(CatalystType::External) + 1;
+
+    /**
+     * @brief Interner shared by every log unless one is supplied
+     *
+     * Never destroyed, so logs held by other statics can still release
+     * their strings during shutdown.
+     */
+    static common::StringInterner &sharedStrings() {
+        static common::StringInterner *strings = new common::StringInterner();
+        return *strings;
+    }
+
+    explicit SynthesisHistoryLog(
+        std::size_t maxEvents = DEFAULT_MAX_EVENTS,
+        common::StringInterner &strings = sharedStrings())
+        : strings_(&strings), maxEvents_(std::max<std::size_t>(maxEvents, 1)) {
+        affectedOffsets_.push_back(0);
+    }
+
+    ~SynthesisHistoryLog() { releaseStrings(0, size()); }
+
+    // Copies take their own interner references
+    SynthesisHistoryLog(const SynthesisHistoryLog &other)
+        : strings_(other.strings_), maxEvents_(other.maxEvents_),
+          sourceForm_(other.sourceForm_), resultForm_(other.resultForm_),
+          catalystId_(other.catalystId_), catalystType_(other.catalystType_),
+          stage_(other.stage_), intensity_(other.intensity_),
+          affectedOffsets_(other.affectedOffsets_),
+          affectedIds_(other.affectedIds_), timeDeltas_(other.timeDeltas_),
+          checkpoints_(other.checkpoints_), lastTick_(other.lastTick_),
+          byType_(other.byType_) {
+        for (const std::vector<StringId> *column :
+             {&sourceForm_, &resultForm_, &catalystId_, &affectedIds_}) {
+            strings_->retain(column->begin(), column->end());
+        }
+    }
+    SynthesisHistoryLog(SynthesisHistoryLog &&other) noexcept
+        : strings_(other.strings_), maxEvents_(other.maxEvents_) {
+        swap(other);
+    }
+    SynthesisHistoryLog &operator=(SynthesisHistoryLog other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    void swap(SynthesisHistoryLog &other) noexcept {
+        std::swap(strings_, other.strings_);
+        std::swap(maxEvents_, other.maxEvents_);
+        sourceForm_.swap(other.sourceForm_);
+        resultForm_.swap(other.resultForm_);
+        catalystId_.swap(other.catalystId_);
+        catalystType_.swap(other.catalystType_);
+        stage_.swap(other.stage_);
+        intensity_.swap(other.intensity_);
+        affectedOffsets_.swap(other.affectedOffsets_);
+        affectedIds_.swap(other.affectedIds_);
+        timeDeltas_.swap(other.timeDeltas_);
+        checkpoints_.swap(other.checkpoints_);
+        std::swap(lastTick_, other.lastTick_);
+        byType_.swap(other.byType_);
+    }
+
+    std::size_t size() const { return intensity_.size(); }
+    bool empty() const { return intensity_.empty(); }
+    std::size_t maxEvents() const { return maxEvents_; }
+
+    std::size_t countOf(CatalystType type) const {
+        return byType_[static_cast<std::size_t>(type)].size();
+    }
+
+    void append(const SynthesisEvent &event) {
+        const common::SimTick tick = event.timestamp;
+        if (size() % CHECKPOINT_INTERVAL == 0) {
+            checkpoints_.push_back(
+                {tick, static_cast<std::uint32_t>(timeDeltas_.size())});
+        } else {
+            writeVarint(zigzag(tickDelta(lastTick_, tick)));
+        }
+        lastTick_ = tick;
+
+        const std::uint32_t index = static_cast<std::uint32_t>(size());
+        sourceForm_.push_back(strings_->intern(event.sourceForm));
+        resultForm_.push_back(strings_->intern(event.resultForm));
+        catalystId_.push_back(strings_->intern(event.catalystId));
+        catalystType_.push_back(static_cast<std::uint8_t>(event.catalystType));
+        stage_.push_back(static_cast<std::uint8_t>(event.stage));
+        intensity_.push_back(event.intensity);
+        for (const std::string &trait : event.affectedTraits) {
+            affectedIds_.push_back(strings_->intern(trait));
+        }
+        affectedOffsets_.push_back(
+            static_cast<std::uint32_t>(affectedIds_.size()));
+        byType_[static_cast<std::size_t>(event.catalystType)].push_back(
+            index);
+
+        if (size() > maxEvents_) {
+            dropOldest(size() - std::max<std::size_t>(maxEvents_ * 3 / 4, 1));
+        }
+    }
+
+    /**
+     * @brief Event at index, 0 being the oldest retained
+     */
+    SynthesisEvent at(std::size_t index) const {
+        return eventAt(index, timestampAt(index));
+    }
+
+    common::SimTick timestampAt(std::size_t index) const {
+        return TickCursor(*this).seek(index);
+    }
+
+    /**
+     * @brief Indices of events of one catalyst type, oldest first
+     */
+    const std::vector<std::uint32_t> &indicesOf(CatalystType type) const {
+        return byType_[static_cast<std::size_t>(type)];
+    }
+
+    /**
+     * @brief Most recent events, oldest first, optionally of one type
+     * @param count Maximum number of events to return (0 for all)
+     */
+    std::vector<SynthesisEvent>
+    recent(std::size_t count = 0,
+           std::optional<CatalystType> type = std::nullopt) const {
+        std::vector<SynthesisEvent> out;
+        if (type) {
+            const std::vector<std::uint32_t> &indices = indicesOf(*type);
+            const std::size_t take = clampCount(count, indices.size());
+            out.reserve(take);
+            TickCursor ticks(*this);
+            for (std::size_t i = indices.size() - take; i < indices.size();
+                 ++i) {
+                out.push_back(eventAt(indices[i], ticks.seek(indices[i])));
+            }
+            return out;
+        }
+        const std::size_t take = clampCount(count, size());
+        out.reserve(take);
+        TickCursor ticks(*this);
+        for (std::size_t i = size() - take; i < size(); ++i) {
+            out.push_back(eventAt(i, ticks.seek(i)));
+        }
+        return out;
+    }
+
+    void clear() {
+        releaseStrings(0, size());
+        sourceForm_.clear();
+        resultForm_.clear();
+        catalystId_.clear();
+        catalystType_.clear();
+        stage_.clear();
+        intensity_.clear();
+        affectedOffsets_.assign(1, 0);
+        affectedIds_.clear();
+        timeDeltas_.clear();
+        checkpoints_.clear();
+        for (auto &indices : byType_) {
+            indices.clear();
+        }
+        lastTick_ = {};
+    }
+
+    /**
+     * @brief Bytes owned by this log; interned strings are shared and
+     * not counted
+     */
+    std::size_t getMemoryFootprint() const {
+        std::size_t bytes =
+            (sourceForm_.capacity() + resultForm_.capacity() +
+             catalystId_.capacity() + affectedIds_.capacity()) *
+                sizeof(StringId) +
+            catalystType_.capacity() + stage_.capacity() +
+            intensity_.capacity() * sizeof(float) +
+            affectedOffsets_.capacity() * sizeof(std::uint32_t) +
+            timeDeltas_.capacity() +
+            checkpoints_.capacity() * sizeof(Checkpoint);
+        for (const auto &indices : byType_) {
+            bytes += indices.capacity() * sizeof(std::uint32_t);
+        }
+        return bytes;
+    }
+
+  private:
+    struct Checkpoint {
+        common::SimTick tick; // Absolute time of the first event in the run
+        std::uint32_t offset; // Start of the following deltas in timeDeltas_
+    };
+
+    // Decodes timestamps for ascending indices; each seek reads only the
+    // deltas since the previous one unless it enters a later checkpoint run
+    class TickCursor {
+      public:
+        explicit TickCursor(const SynthesisHistoryLog &log) : log_(&log) {}
+
+        common::SimTick seek(std::size_t index) {
+            const std::size_t run = index / CHECKPOINT_INTERVAL;
+            if (index < index_ || run != index_ / CHECKPOINT_INTERVAL) {
+                const Checkpoint &checkpoint = log_->checkpoints_[run];
+                tick_ = checkpoint.tick.value;
+                offset_ = checkpoint.offset;
+                index_ = run * CHECKPOINT_INTERVAL;
+            }
+            for (; index_ < index; ++index_) {
+                tick_ += static_cast<std::uint32_t>(
+                    unzigzag(log_->readVarint(offset_)));
+            }
+            return {tick_};
+        }
+
+      private:
+        const SynthesisHistoryLog *log_;
+        std::size_t index_{SIZE_MAX}; // Nothing decoded yet
+        std::uint32_t tick_{0};
+        std::size_t offset_{0};
+    };
+
+    common::StringInterner *strings_;
+    std::size_t maxEvents_;
+
+    // One entry per event
+    std::vector<StringId> sourceForm_;
+    std::vector<StringId> resultForm_;
+    std::vector<StringId> catalystId_;
+    std::vector<std::uint8_t> catalystType_;
+    std::vector<std::uint8_t> stage_;
+    std::vector<float> intensity_;
+    std::vector<std::uint32_t> affectedOffsets_; // size() + 1 entries
+    std::vector<StringId> affectedIds_;
+
+    // Timestamps: zigzag varint deltas between checkpoints
+    std::vector<std::uint8_t> timeDeltas_;
+    std::vector<Checkpoint> checkpoints_;
+    common::SimTick lastTick_{};
+
+    std::array<std::vector<std::uint32_t>, CATALYST_TYPE_COUNT> byType_;
+
+    SynthesisEvent eventAt(std::size_t index, common::SimTick tick) const {
+        SynthesisEvent event;
+        event.sourceForm = strings_->str(sourceForm_[index]);
+        event.resultForm = strings_->str(resultForm_[index]);
+        event.catalystType = static_cast<CatalystType>(catalystType_[index]);
+        event.catalystId = strings_->str(catalystId_[index]);
+        event.intensity = intensity_[index];
+        event.stage = static_cast<SynthesisStage>(stage_[index]);
+        event.affectedTraits.reserve(affectedOffsets_[index + 1] -
+                                     affectedOffsets_[index]);
+        for (std::uint32_t i = affectedOffsets_[index];
+             i < affectedOffsets_[index + 1]; ++i) {
+            event.affectedTraits.push_back(strings_->str(affectedIds_[i]));
+        }
+        event.timestamp = tick;
+        return event;
+    }
+
+    // Drops the interner references of events [first, last)
+    void releaseStrings(std::size_t first, std::size_t last) {
+        if (first == last) {
+            return;
+        }
+        const auto from = static_cast<std::ptrdiff_t>(first);
+        const auto to = static_cast<std::ptrdiff_t>(last);
+        for (const std::vector<StringId> *column :
+             {&sourceForm_, &resultForm_, &catalystId_}) {
+            strings_->release(column->begin() + from, column->begin() + to);
+        }
+        strings_->release(affectedIds_.begin() + affectedOffsets_[first],
+                          affectedIds_.begin() + affectedOffsets_[last]);
+    }
+
+    static std::size_t clampCount(std::size_t count, std::size_t available) {
+        return count == 0 ? available : std::min(count, available);
+    }
+
+    // Signed, so out-of-order events still encode in a few bytes
+    static std::int64_t tickDelta(common::SimTick from, common::SimTick to) {
+        return static_cast<std::int32_t>(to.ticksSince(from));
+    }
+
+    static std::uint64_t zigzag(std::int64_t value) {
+        return (static_cast<std::uint64_t>(value) << 1) ^
+               static_cast<std::uint64_t>(value >> 63);
+    }
+    static std::int64_t unzigzag(std::uint64_t value) {
+        return static_cast<std::int64_t>(value >> 1) ^
+               -static_cast<std::int64_t>(value & 1);
+    }
+
+    void writeVarint(std::uint64_t value) {
+        while (value >= 0x80) {
+            timeDeltas_.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        timeDeltas_.push_back(static_cast<std::uint8_t>(value));
+    }
+    std::uint64_t readVarint(std::size_t &offset) const {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const std::uint8_t byte = timeDeltas_[offset++];
+            value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+    }
+
+    /**
+     * @brief Rebuilds the columns without the oldest count events
+     */
+    void dropOldest(std::size_t count) {
+        const std::size_t kept = size() - count;
+        std::vector<common::SimTick> times(kept);
+        TickCursor ticks(*this);
+        for (std::size_t i = 0; i < kept; ++i) {
+            times[i] = ticks.seek(count + i);
+        }
+        releaseStrings(0, count);
+        const auto dropped = static_cast<std::ptrdiff_t>(count);
+        const auto dropFront = [dropped](auto &column) {
+            column.erase(column.begin(), column.begin() + dropped);
+        };
+        dropFront(sourceForm_);
+        dropFront(resultForm_);
+        dropFront(catalystId_);
+        dropFront(catalystType_);
+        dropFront(stage_);
+        dropFront(intensity_);
+
+        const std::uint32_t firstAffected = affectedOffsets_[count];
+        affectedIds_.erase(affectedIds_.begin(),
+                           affectedIds_.begin() + firstAffected);
+        affectedOffsets_.erase(affectedOffsets_.begin(),
+                               affectedOffsets_.begin() + dropped);
+        for (std::uint32_t &offset : affectedOffsets_) {
+            offset -= firstAffected;
+        }
+
+        timeDeltas_.clear();
+        checkpoints_.clear();
+        for (std::size_t i = 0; i < kept; ++i) {
+            if (i % CHECKPOINT_INTERVAL == 0) {
+                checkpoints_.push_back(
+                    {times[i], static_cast<std::uint32_t>(timeDeltas_.size())});
+            } else {
+                writeVarint(zigzag(tickDelta(times[i - 1], times[i])));
+            }
+        }
+
+        for (auto &indices : byType_) {
+            std::size_t out = 0;
+            for (std::uint32_t index : indices) {
+                if (index >= count) {
+                    indices[out++] = static_cast<std::uint32_t>(index - count);
+                }
+            }
+            indices.resize(out);
+        }
+    }
+};
+
+} // namespace crescent::traits
+
+#endif // CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_HISTORY_LOG_H
@@ -1,11 +1,19 @@
 #ifndef CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_PROCESSOR_H
 #define CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_PROCESSOR_H
 
+#include "common/metrics/LatencyHistogram.h"
+#include "common/metrics/TraceSpan.h"
+#include "common/utils/SimulationClock.h"
+#include "common/utils/StatusVisitor.h"
+#include "creature_engine/core/ChangeTracking.h"
+#include "creature_engine/core/ErrorCodes.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/base/TraitDefinition.h"
 #include "creature_engine/traits/synthesis/SynthesisRules.h"
 #include "creature_engine/traits/synthesis/SynthesisState.h"
 
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -15,25 +23,53 @@
 namespace crescent::traits {
 
 /**
- * @brief Result of a synthesis processing operation
+ * @brief ErrorCode reported for a synthesis failure mode
+ */
+inline ErrorCode toErrorCode(SynthesisFailureType failure) {
+    switch (failure) {
+    case SynthesisFailureType::Requirements:
+        return ErrorCode::SynthesisRequirements;
+    case SynthesisFailureType::Stability:
+        return ErrorCode::SynthesisUnstable;
+    case SynthesisFailureType::Incompatible:
+        return ErrorCode::SynthesisIncompatible;
+    case SynthesisFailureType::Environmental:
+        return ErrorCode::SynthesisEnvironmental;
+    case SynthesisFailureType::CatalystWeak:
+        return ErrorCode::SynthesisCatalystWeak;
+    case SynthesisFailureType::SystemicFailure:
+        break;
+    }
+    return ErrorCode::SynthesisSystemic;
+}
+
+/**
+ * @brief What a successful synthesis processing step did
+ *
+ * event is only set when the step changed stage, so routine progress
+ * updates carry no strings.
  */
-struct ProcessingResult {
-    bool success;
-    std::string message;
-    std::optional<SynthesisFailureType> failureType;
+struct SynthesisStep {
     std::optional<SynthesisEvent> event;
-    std::vector<std::string> warnings;
-    float resultingStability;
+    float resultingStability{1.0f};
+    WarningList warnings;
 };
 
+/**
+ * @brief Result of a synthesis processing operation
+ */
+using ProcessingResult = common::Expected<SynthesisStep, Error>;
+
 /**
  * @brief Processes and coordinates trait synthesis transformations
  */
 class SynthesisProcessor {
   public:
-    // Construction/Destruction
-    SynthesisProcessor();
-    explicit SynthesisProcessor(std::shared_ptr<SynthesisRules> rules);
+    // Construction/Destruction; influences must outlive the processor and
+    // holds the catalyst rows of every state it creates
+    explicit SynthesisProcessor(CatalystInfluenceTable &influences);
+    SynthesisProcessor(CatalystInfluenceTable &influences,
+                       std::shared_ptr<SynthesisRules> rules);
     ~SynthesisProcessor() = default;
 
     // Prevent copying, allow moving
@@ -42,6 +78,15 @@ class SynthesisProcessor {
     SynthesisProcessor(SynthesisProcessor &&) = default;
     SynthesisProcessor &operator=(SynthesisProcessor &&) = default;
 
+    /**
+     * @brief Independent copy for a forked creature
+     *
+     * Shares rules_ and the influence table; clones every active
+     * SynthesisState. A creature rarely has more than a couple of
+     * syntheses in flight.
+     */
+    std::unique_ptr<SynthesisProcessor> fork() const;
+
     /**
      * @brief Attempts to synthesize a trait using a catalyst
      * @param trait Trait to synthesize
@@ -53,7 +98,11 @@ class SynthesisProcessor {
     ProcessingResult processSynthesis(const TraitDefinition &trait,
                                       CatalystType catalystType,
                                       const std::string &catalystId,
-                                      float intensity);
+                                      float intensity) {
+        CRESCENT_TRACE_SPAN(ProcessSynthesis);
+        return processSynthesisImpl(trait, catalystType, catalystId,
+                                    intensity);
+    }
 
     /**
      * @brief Updates all active synthesis processes
@@ -81,11 +130,26 @@ class SynthesisProcessor {
      */
     ProcessingResult revertSynthesis(const TraitDefinition &trait);
 
+    /**
+     * @brief Forwards a catalyst exposure to every active synthesis
+     *
+     * Population passes such as ResonanceField deliver through this.
+     */
+    void recordCatalystExposure(CatalystType catalystType,
+                                const std::string &catalystId,
+                                float intensity);
+
     // State queries
     bool hasActiveSynthesis(const std::string &traitId) const;
     const SynthesisState *getSynthesisState(const std::string &traitId) const;
     std::vector<std::string> getTraitsInSynthesis() const;
 
+    /**
+     * @brief Reports each synthesizing trait id as a "traitsInSynthesis" list
+     * item; the processor lock is held for the duration of the visit
+     */
+    void visitTraitsInSynthesis(common::StatusVisitor &visitor) const;
+
     /**
      * @brief Gets statistics about synthesis processing
      */
@@ -94,20 +158,51 @@ class SynthesisProcessor {
         size_t completedSyntheses;
         size_t failedSyntheses;
         float averageStability;
-        std::chrono::system_clock::time_point lastUpdate;
+        // From MetricsRegistry; present in every build so the layout does
+        // not depend on CRESCENT_ENABLE_METRICS, and empty without it
+        metrics::LatencySummary synthesisLatency;
+        common::SimTick lastUpdate;
     };
     ProcessingMetrics getMetrics() const;
 
+    // Change tracking; covers every active synthesis state
+    enum DirtyField : ChangeTracker::FieldMask {
+        DirtyForm = 1u << 0,
+        DirtyStage = 1u << 1,
+        DirtyProgress = 1u << 2,
+        DirtyHistory = 1u << 3,
+        DirtyCatalysts = 1u << 4
+    };
+    /**
+     * @brief Copy of the tracker taken under the processor lock
+     *
+     * Exposures and expiry land in the influence table, so table versions
+     * that moved since the last call are folded in as DirtyCatalysts first.
+     * Decay that expires nothing leaves versions alone and marks nothing.
+     */
+    ChangeTracker getChangeTracker() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        foldCatalystVersions();
+        return changeTracker_;
+    }
+    void clearDirty(std::uint64_t persistedVersion);
+
     // Serialization
     nlohmann::json
-    serializeToJson(const SerializationOptions &options = {}) const;
-    static SynthesisProcessor deserializeFromJson(const nlohmann::json &data);
+    serializeToJson(const SerializationOptions &options = {}) const {
+        CRESCENT_TRACE_SPAN(SerializeSynthesis);
+        return serializeToJsonImpl(options);
+    }
+    static SynthesisProcessor
+    deserializeFromJson(const nlohmann::json &data,
+                        CatalystInfluenceTable &influences);
 
   private:
     // Thread safety
     mutable std::mutex mutex_;
 
     // Core components
+    CatalystInfluenceTable *influences_; // Not owned
     std::shared_ptr<SynthesisRules> rules_;
     std::unordered_map<std::string, std::unique_ptr<SynthesisState>>
         activeStates_;
@@ -118,9 +213,23 @@ class SynthesisProcessor {
         size_t totalFailed{0};
         float stabilitySum{0.0f};
         size_t stabilityCount{0};
-        std::chrono::system_clock::time_point lastUpdate;
+        common::SimTick lastUpdate;
     } metrics_;
 
+    // Snapshot bookkeeping; marked under mutex_ by every state change, and
+    // by foldCatalystVersions for table-side changes
+    mutable ChangeTracker changeTracker_;
+    mutable std::unordered_map<std::string, std::uint64_t>
+        catalystVersionsSeen_; // Trait id -> last folded table version
+
+    // Bodies of the instrumented entry points above
+    ProcessingResult processSynthesisImpl(const TraitDefinition &trait,
+                                          CatalystType catalystType,
+                                          const std::string &catalystId,
+                                          float intensity);
+    nlohmann::json
+    serializeToJsonImpl(const SerializationOptions &options) const;
+
     // Internal helpers
     ProcessingResult validateAndPrepare(const TraitDefinition &trait,
                                         const std::string &targetForm,
@@ -128,7 +237,28 @@ class SynthesisProcessor {
 
     void updateMetrics(const ProcessingResult &result);
     void cleanupCompletedSyntheses();
-    ProcessingResult createResult(bool success, std::string message) const;
+
+    // Caller holds mutex_
+    void foldCatalystVersions() const {
+        bool changed = false;
+        for (const auto &[traitId, state] : activeStates_) {
+            const std::uint64_t version = state->getCatalystVersion();
+            std::uint64_t &seen = catalystVersionsSeen_[traitId];
+            changed |= version != seen;
+            seen = version;
+        }
+        if (catalystVersionsSeen_.size() != activeStates_.size()) {
+            for (auto it = catalystVersionsSeen_.begin();
+                 it != catalystVersionsSeen_.end();) {
+                it = activeStates_.count(it->first)
+                         ? std::next(it)
+                         : catalystVersionsSeen_.erase(it);
+            }
+        }
+        if (changed) {
+            changeTracker_.markDirty(DirtyCatalysts);
+        }
+    }
 };
 
 } // namespace crescent::traits
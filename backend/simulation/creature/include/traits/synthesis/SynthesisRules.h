@@ -1,6 +1,8 @@
 #ifndef CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_RULES_H
 #define CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_RULES_H
 
+#include "common/metrics/TraceSpan.h"
+#include "creature_engine/io/SerializationCache.h"
 #include "creature_engine/io/SerializationStructures.h"
 #include "creature_engine/traits/base/TraitDefinition.h"
 #include "creature_engine/traits/base/TraitEnums.h"
@@ -105,9 +107,22 @@ class SynthesisRules {
 
     // Serialization
     nlohmann::json
-    serializeToJson(const SerializationOptions &options = {}) const;
+    serializeToJson(const SerializationOptions &options = {}) const {
+        CRESCENT_TRACE_SPAN(SerializeSynthesis);
+        return serializeToJsonImpl(options);
+    }
     static SynthesisRules deserializeFromJson(const nlohmann::json &data);
 
+    /**
+     * @brief Cached serialized output
+     *
+     * Rules only change through registerSynthesisPath, so after loading this
+     * is serialized once per SerializationOptions and shared thereafter.
+     */
+    SerializedBytes
+    serializeToBytes(const SerializationOptions &options = {}) const;
+    std::uint64_t getVersion() const { return version_; }
+
   private:
     // Rule storage
     struct SynthesisPath {
@@ -153,7 +168,13 @@ class SynthesisRules {
         float minStability{0.2f};
     } stabilityFactors_;
 
+    // Serialization caching; bumped by registerSynthesisPath
+    std::uint64_t version_{0};
+    SerializationByteCache serializationCache_;
+
     // Internal helpers
+    nlohmann::json
+    serializeToJsonImpl(const SerializationOptions &options) const;
     bool
     validateRequirements(const SynthesisRequirement &requirements,
                          float intensity,
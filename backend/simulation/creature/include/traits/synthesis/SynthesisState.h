@@ -1,14 +1,18 @@
 #ifndef CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_STATE_H
 #define CREATURE_ENGINE_TRAITS_SYNTHESIS_SYNTHESIS_STATE_H
 
+#include "common/utils/SimulationClock.h"
+#include "creature_engine/io/JsonStreamWriter.h"
 #include "creature_engine/io/SerializationStructures.h"
+#include "creature_engine/traits/synthesis/CatalystInfluenceTable.h"
 #include "creature_engine/traits/synthesis/SynthesisEnums.h"
+#include "creature_engine/traits/synthesis/SynthesisHistoryLog.h"
 
-#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <string>
-#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace crescent::traits {
@@ -22,55 +26,47 @@ struct SynthesisProgress {
     float stabilityFactor{1.0f};  // Current stability value
     float catalystStrength{0.0f}; // Current catalyst influence
 
-    std::chrono::system_clock::time_point lastUpdate;
+    common::SimTick lastUpdate;
 };
 
 /**
- * @brief Records a synthesis transformation with complete context
+ * @brief One state's rows in the catalyst influence table
+ *
+ * Cheap to copy; valid while the owning SynthesisState is alive.
  */
-struct SynthesisEvent {
-    std::string sourceForm;
-    std::string resultForm;
-    CatalystType catalystType;
-    std::string catalystId;
-    float intensity;
-    SynthesisStage stage;
-    std::vector<std::string> affectedTraits; // Traits modified by this event
-    std::chrono::system_clock::time_point timestamp;
-
-    // Validation
-    bool isValid() const;
-};
+class CatalystInfluenceView {
+  public:
+    CatalystInfluenceView() = default;
+    CatalystInfluenceView(const CatalystInfluenceTable *table,
+                          CatalystInfluenceTable::OwnerId owner)
+        : table_(table), owner_(owner) {}
 
-/**
- * @brief Key for tracking catalyst influences
- */
-struct CatalystKey {
-    CatalystType type;
-    std::string id;
+    std::size_t size() const { return table_ ? table_->countOf(owner_) : 0; }
+    bool empty() const { return size() == 0; }
 
-    bool operator==(const CatalystKey &other) const {
-        return type == other.type && id == other.id;
+    float strengthOf(CatalystType type, const std::string &catalystId) const {
+        return table_ ? table_->strengthOf(owner_, type, catalystId) : 0.0f;
+    }
+    std::optional<CatalystInfluence>
+    find(CatalystType type, const std::string &catalystId) const {
+        if (!table_) {
+            return std::nullopt;
+        }
+        return table_->find(owner_, type, catalystId);
     }
 
-    struct Hash {
-        std::size_t operator()(const CatalystKey &k) const {
-            return std::hash<std::string>()(k.id) ^
-                   (std::hash<int>()(static_cast<int>(k.type)) << 1);
+    /**
+     * @brief Visits fn(const CatalystKey &, const CatalystInfluence &)
+     */
+    template <typename Fn> void forEach(Fn &&fn) const {
+        if (table_) {
+            table_->forEachOf(owner_, std::forward<Fn>(fn));
         }
-    };
-};
+    }
 
-/**
- * @brief Tracks the influence of a specific catalyst
- */
-struct CatalystInfluence {
-    float currentStrength{0.0f};
-    float peakStrength{0.0f};
-    int exposureCount{0};
-    std::chrono::system_clock::time_point lastExposure;
-    std::vector<std::string>
-        affectedForms; // Forms this catalyst has influenced
+  private:
+    const CatalystInfluenceTable *table_{nullptr};
+    CatalystInfluenceTable::OwnerId owner_{CatalystInfluenceTable::NO_OWNER};
 };
 
 /**
@@ -78,9 +74,8 @@ struct CatalystInfluence {
  */
 class SynthesisState {
   public:
-    // Construction/Destruction
-    SynthesisState() = default;
-    explicit SynthesisState(std::string traitId);
+    // Construction/Destruction; influences must outlive the state
+    SynthesisState(std::string traitId, CatalystInfluenceTable &influences);
     ~SynthesisState() = default;
 
     // Prevent copying, allow moving
@@ -89,6 +84,15 @@ class SynthesisState {
     SynthesisState(SynthesisState &&) = default;
     SynthesisState &operator=(SynthesisState &&) = default;
 
+    /**
+     * @brief Explicit deep copy for forked owners
+     *
+     * The copy registers as a new owner in the same influence table and
+     * starts with a copy of this state's rows (CatalystInfluenceTable::
+     * copyOwner), so the two decay and take exposures independently.
+     */
+    std::unique_ptr<SynthesisState> clone() const;
+
     // Core state access
     const std::string &getTraitId() const { return traitId_; }
     const std::string &getCurrentForm() const { return currentForm_; }
@@ -118,6 +122,9 @@ class SynthesisState {
 
     /**
      * @brief Records exposure to a catalyst and updates influence
+     *
+     * Writes this state's row in the influence table; decay happens there
+     * for all states at once, so this state needs no per-tick update.
      */
     void recordCatalystExposure(CatalystType type,
                                 const std::string &catalystId, float intensity);
@@ -125,10 +132,19 @@ class SynthesisState {
     // State queries
     bool isInProgress() const { return currentStage_ != SynthesisStage::None; }
     const SynthesisProgress &getProgress() const { return progress_; }
-    const std::unordered_map<CatalystKey, CatalystInfluence,
-                             CatalystKey::Hash> &
-    getCatalystInfluences() const {
-        return catalystInfluences_;
+    CatalystInfluenceView getCatalystInfluences() const {
+        return {catalystInfluences_.table(), catalystInfluences_.id()};
+    }
+
+    /**
+     * @brief Table version of this state's influences
+     *
+     * Changes on every exposure and every decay pass, which happen in the
+     * table rather than through this state.
+     */
+    std::uint64_t getCatalystVersion() const {
+        const CatalystInfluenceTable *table = catalystInfluences_.table();
+        return table ? table->versionOf(catalystInfluences_.id()) : 0;
     }
 
     /**
@@ -138,12 +154,36 @@ class SynthesisState {
      */
     std::vector<SynthesisEvent>
     getHistory(size_t count = 0,
-               std::optional<CatalystType> type = std::nullopt) const;
+               std::optional<CatalystType> type = std::nullopt) const {
+        return history_.recent(count, type);
+    }
+
+    /**
+     * @brief Columnar history; indices and per-type lists without copies
+     */
+    const SynthesisHistoryLog &getHistoryLog() const { return history_; }
+
+    /**
+     * @brief Bytes owned by this state, including history
+     *
+     * Influence rows live in the shared table and are not counted here.
+     */
+    std::size_t getMemoryFootprint() const;
 
     // Serialization
     nlohmann::json
     serializeToJson(const SerializationOptions &options = {}) const;
-    static SynthesisState deserializeFromJson(const nlohmann::json &data);
+    static SynthesisState
+    deserializeFromJson(const nlohmann::json &data,
+                        CatalystInfluenceTable &influences);
+
+    /**
+     * @brief Streams the same JSON as serializeToJson without a DOM
+     *
+     * Byte-identical to serializeToJson(options).dump().
+     */
+    void writeJson(io::JsonStreamWriter &writer,
+                   const SerializationOptions &options = {}) const;
 
   private:
     // Core identification
@@ -156,15 +196,13 @@ class SynthesisState {
     SynthesisProgress progress_;
 
     // Tracking
-    std::vector<SynthesisEvent> history_;
-    std::unordered_map<CatalystKey, CatalystInfluence, CatalystKey::Hash>
-        catalystInfluences_;
+    SynthesisHistoryLog history_;
+    CatalystInfluenceTable::Owner catalystInfluences_; // Rows in the table
 
     // Internal helpers
     void updateStability();
     void recordEvent(SynthesisEvent event);
     bool validateTransition(SynthesisStage newStage) const;
-    void pruneHistory(size_t maxSize = 100);
 };
 
 } // namespace crescent::traits
@@ -0,0 +1,350 @@
+#ifndef CREATURE_ENGINE_TRAITS_VALIDATION_TRAIT_COMPATIBILITY_MATRIX_H
+#define CREATURE_ENGINE_TRAITS_VALIDATION_TRAIT_COMPATIBILITY_MATRIX_H
+
+#include "common/utils/Views.h"
+#include "creature_engine/traits/base/TraitEnums.h"
+#include "creature_engine/traits/base/TraitIndex.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace crescent::traits {
+
+/**
+ * @brief Pairwise trait compatibility compiled once at load time
+ *
+ * Levels are packed two bits per unordered pair (lower triangle, diagonal
+ * included) and default to Neutral. Non-neutral pairs are also kept as
+ * per-trait adjacency lists so interaction passes only touch pairs that can
+ * actually interact. Immutable once built; safe to share between threads.
+ */
+class TraitCompatibilityMatrix {
+  public:
+    struct Edge {
+        TraitIndex other;
+        CompatibilityLevel level;
+    };
+
+    /**
+     * @brief Collects trait ids and pair levels, then compiles them
+     */
+    class Builder {
+      public:
+        /**
+         * @brief Registers a trait id; repeated ids return the same index
+         */
+        TraitIndex addTrait(std::string_view id) {
+            auto [it, inserted] = indices_.try_emplace(
+                std::string(id), static_cast<TraitIndex>(ids_.size()));
+            if (inserted) {
+                ids_.emplace_back(id);
+            }
+            return it->second;
+        }
+
+        /**
+         * @brief Sets the level for an unordered pair; last call wins
+         */
+        void set(TraitIndex a, TraitIndex b, CompatibilityLevel level) {
+            if (a >= ids_.size() || b >= ids_.size() || a == b) {
+                throw std::out_of_range("Invalid trait pair");
+            }
+            pairs_[pairKey(a, b)] = level;
+        }
+
+        void set(std::string_view a, std::string_view b,
+                 CompatibilityLevel level) {
+            set(addTrait(a), addTrait(b), level);
+        }
+
+        TraitCompatibilityMatrix build() && {
+            TraitCompatibilityMatrix matrix;
+            const std::size_t n = ids_.size();
+            matrix.ids_ = std::move(ids_);
+            matrix.indices_ = std::move(indices_);
+
+            const std::size_t cells = n * (n + 1) / 2;
+            matrix.cells_.assign((cells + CELLS_PER_WORD - 1) /
+                                     CELLS_PER_WORD,
+                                 NEUTRAL_WORD);
+
+            matrix.offsets_.assign(n + 1, 0);
+            for (const auto &[key, level] : pairs_) {
+                if (level == CompatibilityLevel::Neutral) {
+                    continue;
+                }
+                ++matrix.offsets_[(key >> 32) + 1];
+                ++matrix.offsets_[(key & 0xffffffffu) + 1];
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                matrix.offsets_[i + 1] += matrix.offsets_[i];
+            }
+
+            matrix.edges_.resize(matrix.offsets_[n]);
+            std::vector<std::uint32_t> fill(matrix.offsets_.begin(),
+                                            matrix.offsets_.end() - 1);
+            for (const auto &[key, level] : pairs_) {
+                const auto a = static_cast<TraitIndex>(key >> 32);
+                const auto b = static_cast<TraitIndex>(key & 0xffffffffu);
+                matrix.store(a, b, level);
+                if (level != CompatibilityLevel::Neutral) {
+                    matrix.edges_[fill[a]++] = {b, level};
+                    matrix.edges_[fill[b]++] = {a, level};
+                }
+            }
+            for (std::size_t i = 0; i < n; ++i) {
+                std::sort(matrix.edges_.begin() + matrix.offsets_[i],
+                          matrix.edges_.begin() + matrix.offsets_[i + 1],
+                          [](const Edge &x, const Edge &y) {
+                              return x.other < y.other;
+                          });
+            }
+            return matrix;
+        }
+
+      private:
+        std::vector<std::string> ids_;
+        std::unordered_map<std::string, TraitIndex> indices_;
+        std::unordered_map<std::uint64_t, CompatibilityLevel> pairs_;
+
+        static std::uint64_t pairKey(TraitIndex a, TraitIndex b) {
+            if (a < b) {
+                std::swap(a, b);
+            }
+            return (static_cast<std::uint64_t>(a) << 32) | b;
+        }
+    };
+
+    TraitCompatibilityMatrix() = default;
+
+    CompatibilityLevel level(TraitIndex a, TraitIndex b) const {
+        const std::size_t cell = cellIndex(a, b);
+        const std::uint64_t word = cells_[cell / CELLS_PER_WORD];
+        return static_cast<CompatibilityLevel>(
+            (word >> ((cell % CELLS_PER_WORD) * 2)) & 0x3u);
+    }
+
+    /**
+     * @brief Non-neutral partners of a trait, sorted by index
+     */
+    common::Span<const Edge> neighbors(TraitIndex trait) const {
+        return {edges_.data() + offsets_[trait],
+                offsets_[trait + 1] - offsets_[trait]};
+    }
+
+    std::optional<TraitIndex> indexOf(std::string_view id) const {
+        auto it = indices_.find(std::string(id));
+        if (it == indices_.end()) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+    const std::string &idOf(TraitIndex trait) const { return ids_[trait]; }
+    std::size_t traitCount() const { return ids_.size(); }
+    std::size_t interactingPairCount() const { return edges_.size() / 2; }
+
+    std::size_t getMemoryFootprint() const {
+        std::size_t bytes = cells_.capacity() * sizeof(std::uint64_t) +
+                            offsets_.capacity() * sizeof(std::uint32_t) +
+                            edges_.capacity() * sizeof(Edge);
+        for (const std::string &id : ids_) {
+            bytes += sizeof(std::string) + id.capacity();
+        }
+        return bytes;
+    }
+
+  private:
+    static constexpr std::size_t CELLS_PER_WORD = 32;
+    static constexpr std::uint64_t NEUTRAL_WORD = 0x5555555555555555ull;
+    static_assert(static_cast<unsigned>(CompatibilityLevel::Neutral) == 1,
+                  "NEUTRAL_WORD assumes Neutral encodes as 0b01");
+
+    std::vector<std::string> ids_;
+    std::unordered_map<std::string, TraitIndex> indices_;
+    std::vector<std::uint64_t> cells_;
+    std::vector<std::uint32_t> offsets_{0};
+    std::vector<Edge> edges_;
+
+    static std::size_t cellIndex(TraitIndex a, TraitIndex b) {
+        if (a < b) {
+            std::swap(a, b);
+        }
+        return static_cast<std::size_t>(a) * (a + 1) / 2 + b;
+    }
+
+    void store(TraitIndex a, TraitIndex b, CompatibilityLevel level) {
+        const std::size_t cell = cellIndex(a, b);
+        const unsigned shift = (cell % CELLS_PER_WORD) * 2;
+        std::uint64_t &word = cells_[cell / CELLS_PER_WORD];
+        word = (word & ~(std::uint64_t{0x3} << shift)) |
+               (static_cast<std::uint64_t>(level) << shift);
+    }
+};
+
+/**
+ * @brief Non-neutral pairs among one creature's active traits
+ *
+ * Adding or removing a trait walks only that trait's adjacency list, so
+ * keeping the set current costs O(degree * log active) per change instead of
+ * re-checking every active pair. Active pairs sit in a flat vector indexed
+ * by pair key, so removing one is a swap with the last. Required pairs are
+ * treated as mutual; a requirement is unmet while exactly one side is
+ * active.
+ */
+class TraitInteractionSet {
+  public:
+    struct ActivePair {
+        TraitIndex first; // Lower index
+        TraitIndex second;
+        CompatibilityLevel level;
+    };
+
+    explicit TraitInteractionSet(const TraitCompatibilityMatrix &matrix)
+        : matrix_(&matrix) {}
+
+    /**
+     * @brief Activates a trait
+     * @return False if it was already active
+     */
+    bool add(TraitIndex trait) {
+        auto it = std::lower_bound(active_.begin(), active_.end(), trait);
+        if (it != active_.end() && *it == trait) {
+            return false;
+        }
+        active_.insert(it, trait);
+        for (const auto &edge : matrix_->neighbors(trait)) {
+            const bool partnerActive = isActive(edge.other);
+            if (edge.level == CompatibilityLevel::Required) {
+                unmetRequirements_ += partnerActive ? -1 : 1;
+            }
+            if (partnerActive) {
+                insertPair(trait, edge.other, edge.level);
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Deactivates a trait
+     * @return False if it was not active
+     */
+    bool remove(TraitIndex trait) {
+        auto it = std::lower_bound(active_.begin(), active_.end(), trait);
+        if (it == active_.end() || *it != trait) {
+            return false;
+        }
+        active_.erase(it);
+        for (const auto &edge : matrix_->neighbors(trait)) {
+            const bool partnerActive = isActive(edge.other);
+            if (edge.level == CompatibilityLevel::Required) {
+                unmetRequirements_ += partnerActive ? 1 : -1;
+            }
+            if (partnerActive) {
+                erasePair(trait, edge.other);
+            }
+        }
+        return true;
+    }
+
+    void clear() {
+        active_.clear();
+        pairs_.clear();
+        pairIndex_.clear();
+        incompatibleCount_ = synergisticCount_ = 0;
+        unmetRequirements_ = 0;
+    }
+
+    bool isActive(TraitIndex trait) const {
+        return std::binary_search(active_.begin(), active_.end(), trait);
+    }
+
+    /**
+     * @brief Visits active pairs involving a trait as fn(partner, level), in
+     * partner index order
+     */
+    template <typename Fn> void forEachPairOf(TraitIndex trait, Fn &&fn) const {
+        if (!isActive(trait)) {
+            return;
+        }
+        for (const auto &edge : matrix_->neighbors(trait)) {
+            if (isActive(edge.other)) {
+                fn(edge.other, edge.level);
+            }
+        }
+    }
+
+    /**
+     * @brief Active pairs in no particular order
+     */
+    common::Span<const ActivePair> pairs() const { return pairs_; }
+    common::Span<const TraitIndex> activeTraits() const { return active_; }
+    std::size_t incompatibleCount() const { return incompatibleCount_; }
+    std::size_t synergisticCount() const { return synergisticCount_; }
+    std::size_t unmetRequirements() const {
+        return static_cast<std::size_t>(unmetRequirements_);
+    }
+    bool isConsistent() const {
+        return incompatibleCount_ == 0 && unmetRequirements_ == 0;
+    }
+
+  private:
+    const TraitCompatibilityMatrix *matrix_;
+    std::vector<TraitIndex> active_; // Sorted
+    std::vector<ActivePair> pairs_;
+    std::unordered_map<std::uint64_t, std::size_t> pairIndex_; // Into pairs_
+    std::size_t incompatibleCount_{0};
+    std::size_t synergisticCount_{0};
+    std::ptrdiff_t unmetRequirements_{0};
+
+    static std::uint64_t pairKey(TraitIndex a, TraitIndex b) {
+        return (static_cast<std::uint64_t>(std::min(a, b)) << 32) |
+               std::max(a, b);
+    }
+
+    void insertPair(TraitIndex a, TraitIndex b, CompatibilityLevel level) {
+        pairIndex_.emplace(pairKey(a, b), pairs_.size());
+        pairs_.push_back({std::min(a, b), std::max(a, b), level});
+        countPair(level, true);
+    }
+
+    void erasePair(TraitIndex a, TraitIndex b) {
+        const auto it = pairIndex_.find(pairKey(a, b));
+        const std::size_t position = it->second;
+        pairIndex_.erase(it);
+        countPair(pairs_[position].level, false);
+        if (position + 1 != pairs_.size()) {
+            pairs_[position] = pairs_.back();
+            pairIndex_[pairKey(pairs_[position].first,
+                               pairs_[position].second)] = position;
+        }
+        pairs_.pop_back();
+    }
+
+    void countPair(CompatibilityLevel level, bool added) {
+        std::size_t *count = level == CompatibilityLevel::Incompatible
+                                 ? &incompatibleCount_
+                             : level == CompatibilityLevel::Synergistic
+                                 ? &synergisticCount_
+                                 : nullptr;
+        if (!count) {
+            return;
+        }
+        if (added) {
+            ++*count;
+        } else {
+            --*count;
+        }
+    }
+};
+
+} // namespace crescent::traits
+
+#endif // CREATURE_ENGINE_TRAITS_VALIDATION_TRAIT_COMPATIBILITY_MATRIX_H
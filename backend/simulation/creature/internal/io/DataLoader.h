@@ -4,6 +4,8 @@
 #include "creature_engine/core/CreatureCore.h"
 #include "creature_engine/systems/CreatureTheme.h"
 #include "creature_engine/systems/environment/base/EnvironmentSystem.h"
+#include "creature_engine/traits/base/TraitCatalog.h"
+#include "creature_engine/traits/validation/TraitCompatibilityMatrix.h"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <unordered_map>
@@ -29,6 +31,27 @@ class DataLoader {
     const EnvironmentData &getEnvironmentData(const std::string &name) const;
     const TraitDefinition &getTraitDefinition(const std::string &name) const;
 
+    /**
+     * @brief Every loaded trait, split into hot records and cold data
+     *
+     * loadTraits adds each definition to TraitCatalog::global() in file
+     * order; this is that catalog. Trait states index into it.
+     */
+    const crucible::TraitCatalog &getTraitCatalog() const {
+        return traitCatalog;
+    }
+
+    /**
+     * @brief Pairwise trait compatibility compiled from incompatibleTraits
+     * and synthesis data once all traits are loaded
+     *
+     * Traits are added in catalog order first, so a traits::TraitIndex
+     * names the same trait here and in getTraitCatalog().
+     */
+    const traits::TraitCompatibilityMatrix &getCompatibilityMatrix() const {
+        return compatibilityMatrix;
+    }
+
     // Validation
     bool validateData() const;
 
@@ -47,6 +70,7 @@ class DataLoader {
     void loadAbilities(const std::string &filepath);
 
     void validateTraitCompatibility();
+    void compileCompatibilityMatrix();
     void validateInitialization() const;
 
     bool isInitialized = false;
@@ -54,6 +78,8 @@ class DataLoader {
     std::unordered_map<std::string, EnvironmentData> environments;
     std::unordered_map<std::string, TraitDefinition> traits;
     std::unordered_map<std::string, Ability> baseAbilities;
+    crucible::TraitCatalog &traitCatalog = crucible::TraitCatalog::global();
+    traits::TraitCompatibilityMatrix compatibilityMatrix;
 };
 
 bool validateDataFile(const std::string &filepath);
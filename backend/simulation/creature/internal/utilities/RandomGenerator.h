@@ -3,6 +3,9 @@
 #define CREATURE_ENGINE_INTERNAL_NAME_GENERATOR_H
 
 #include "creature_engine/core/CreatureCore.h"
+#include "UniqueNameGenerator.h"
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -18,6 +21,14 @@ class NameGenerator {
     static std::string generateCreatureName(const PhysicalForm &form);
     static std::string generateDescriptiveName(const CreatureState &state);
 
+    /**
+     * @brief Bulk, arena-backed naming over the same prefix/suffix tables
+     *
+     * Use for population-scale generation where names must be unique.
+     */
+    static std::unique_ptr<UniqueNameGenerator>
+    createUniqueGenerator(std::uint64_t seed);
+
   private:
     static const std::unordered_map<Size, std::vector<std::string>> prefixes;
     static const std::vector<std::string> suffixes;
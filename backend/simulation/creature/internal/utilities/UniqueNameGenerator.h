@@ -0,0 +1,205 @@
+// internal/utilities/UniqueNameGenerator.h
+#ifndef CREATURE_ENGINE_INTERNAL_UNIQUE_NAME_GENERATOR_H
+#define CREATURE_ENGINE_INTERNAL_UNIQUE_NAME_GENERATOR_H
+
+#include "common/utils/SeededRandom.h"
+#include "common/utils/StringArena.h"
+#include "creature_engine/core/CreatureCore.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace crescent {
+namespace detail {
+
+/**
+ * @brief Every prefix x suffix combination for one Size, addressable by index
+ *
+ * Index i maps to prefix i / suffixCount and suffix i % suffixCount, so a
+ * name is drawn by copying two precomputed fragments with no intermediate
+ * string.
+ */
+class NameCombinationTable {
+  public:
+    NameCombinationTable() = default;
+    NameCombinationTable(const std::vector<std::string> &prefixes,
+                         const std::vector<std::string> &suffixes)
+        : prefixes_(prefixes), suffixes_(suffixes) {}
+
+    std::size_t combinations() const {
+        return prefixes_.size() * suffixes_.size();
+    }
+
+    std::size_t lengthOf(std::size_t index) const {
+        return prefixes_[index / suffixes_.size()].size() +
+               suffixes_[index % suffixes_.size()].size();
+    }
+
+    /**
+     * @brief Writes combination index to out, which holds lengthOf(index)
+     */
+    void writeTo(std::size_t index, char *out) const {
+        const std::string &prefix = prefixes_[index / suffixes_.size()];
+        const std::string &suffix = suffixes_[index % suffixes_.size()];
+        std::memcpy(out, prefix.data(), prefix.size());
+        std::memcpy(out + prefix.size(), suffix.data(), suffix.size());
+    }
+
+  private:
+    std::vector<std::string> prefixes_;
+    std::vector<std::string> suffixes_;
+};
+
+/**
+ * @brief Bulk creature naming with a uniqueness guarantee
+ *
+ * Names are written straight into a StringArena and checked against a
+ * compact hash set. Each Size draws its combinations in a seeded permuted
+ * order (a full-period stride), so the first combinations() draws for a
+ * Size never collide with each other. Once a table is exhausted, or a name
+ * collides with one from another table, a numeric suffix (" 2", " 3", ...)
+ * is appended deterministically. Offsets and strides are drawn in Size
+ * order rather than map order, so same seed and call order, same names.
+ *
+ * Not thread-safe; give each generation worker its own instance or name in
+ * a single pass after generation.
+ */
+class UniqueNameGenerator {
+  public:
+    UniqueNameGenerator(
+        const std::unordered_map<Size, std::vector<std::string>> &prefixes,
+        const std::vector<std::string> &suffixes, std::uint64_t seed)
+        : names_(arena_) {
+        // Seed the tables in Size order; map iteration order is unspecified
+        std::vector<Size> sizes;
+        sizes.reserve(prefixes.size());
+        for (const auto &entry : prefixes) {
+            sizes.push_back(entry.first);
+        }
+        std::sort(sizes.begin(), sizes.end());
+
+        common::SeededRandom random(seed);
+        for (const Size size : sizes) {
+            Draw &draw = draws_[size];
+            draw.table = NameCombinationTable(prefixes.at(size), suffixes);
+            const std::size_t n = draw.table.combinations();
+            if (n == 0) {
+                continue;
+            }
+            draw.offset = random.pickIndex(n);
+            draw.stride = 1 + random.pickIndex(n);
+            while (std::gcd(draw.stride, n) != 1) {
+                draw.stride = draw.stride % n + 1;
+            }
+        }
+    }
+
+    // Prevent copying; views point into the owned arena
+    UniqueNameGenerator(const UniqueNameGenerator &) = delete;
+    UniqueNameGenerator &operator=(const UniqueNameGenerator &) = delete;
+    UniqueNameGenerator(UniqueNameGenerator &&) = delete;
+    UniqueNameGenerator &operator=(UniqueNameGenerator &&) = delete;
+
+    void reserve(std::size_t names) {
+        arena_.reserve(names);
+        names_.reserve(names);
+    }
+
+    /**
+     * @brief Draws the next unique name for a size
+     * @return View valid for the generator's lifetime
+     * @throws std::invalid_argument if the size has no name table
+     */
+    std::string_view next(Size size) {
+        auto it = draws_.find(size);
+        if (it == draws_.end() || it->second.table.combinations() == 0) {
+            throw std::invalid_argument("No name table for size");
+        }
+        Draw &draw = it->second;
+        const std::size_t n = draw.table.combinations();
+        const std::size_t round = draw.count / n;
+        const std::size_t index =
+            (draw.offset + (draw.count % n) * draw.stride) % n;
+        ++draw.count;
+
+        const std::size_t baseLength = draw.table.lengthOf(index);
+        char *out = arena_.allocate(baseLength);
+        draw.table.writeTo(index, out);
+        return commitUnique(out, baseLength, round);
+    }
+
+    /**
+     * @brief Reserves a name supplied from elsewhere (e.g. loaded data)
+     * @return The stored, possibly disambiguated, name
+     */
+    std::string_view claim(std::string_view name) {
+        char *out = arena_.allocate(name.size());
+        std::memcpy(out, name.data(), name.size());
+        return commitUnique(out, name.size(), 0);
+    }
+
+    bool contains(std::string_view name) const {
+        return names_.contains(name);
+    }
+    std::size_t size() const { return names_.size(); }
+
+    std::size_t getMemoryFootprint() const {
+        return arena_.getMemoryFootprint() + names_.getMemoryFootprint();
+    }
+
+  private:
+    struct Draw {
+        NameCombinationTable table;
+        std::size_t offset{0};
+        std::size_t stride{1};
+        std::size_t count{0};
+    };
+
+    common::StringArena arena_;
+    common::UniqueStringSet names_;
+    std::unordered_map<Size, Draw> draws_;
+
+    std::string_view commitUnique(char *out, std::size_t baseLength,
+                                  std::size_t round) {
+        std::size_t length = baseLength;
+        for (std::size_t ordinal = round + 1;; ++ordinal) {
+            if (ordinal > 1) {
+                char digits[24];
+                std::size_t count = 0;
+                for (std::size_t v = ordinal; v != 0; v /= 10) {
+                    digits[count++] = static_cast<char>('0' + v % 10);
+                }
+                length = baseLength + 1 + count;
+                char *grown = arena_.allocate(length);
+                if (grown != out) {
+                    std::memcpy(grown, out, baseLength);
+                    out = grown;
+                }
+                out[baseLength] = ' ';
+                for (std::size_t i = 0; i < count; ++i) {
+                    out[baseLength + 1 + i] = digits[count - 1 - i];
+                }
+            }
+            const std::string_view candidate(out, length);
+            const std::uint64_t h = common::UniqueStringSet::hash(candidate);
+            if (!names_.contains(candidate, h)) {
+                const common::StringArena::Id id = arena_.commit();
+                names_.insert(id, h);
+                return arena_[id];
+            }
+        }
+    }
+};
+
+} // namespace detail
+} // namespace crescent
+
+#endif // CREATURE_ENGINE_INTERNAL_UNIQUE_NAME_GENERATOR_H
@@ -3,6 +3,10 @@
 #define CREATURE_ENGINE_INTERNAL_VALIDATION_UTILS_H
 
 #include "creature_engine/core/CreatureCore.h"
+#include "creature_engine/core/ValidationCodes.h"
+#include "creature_engine/traits/validation/TraitCompatibilityMatrix.h"
+
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -16,9 +20,24 @@ class ValidationUtils {
   public:
     static bool checkTraitCompatibility(const std::string &trait1,
                                         const std::string &trait2);
+    // Index form; matrix is the one the indices were compiled into
+    static bool
+    checkTraitCompatibility(const traits::TraitCompatibilityMatrix &matrix,
+                            traits::TraitIndex trait1,
+                            traits::TraitIndex trait2) {
+        return matrix.level(trait1, trait2) !=
+               traits::CompatibilityLevel::Incompatible;
+    }
     static bool checkThemeStackValidity(const std::vector<std::string> &themes);
     static bool checkEnvironmentalCompatibility(const std::string &environment,
                                                 const CreatureState &state);
+
+    // Code-returning variants for bulk validation; never allocate
+    static std::optional<ViolationCode>
+    themeStackViolation(const std::vector<std::string> &themes);
+    static std::optional<ViolationCode>
+    environmentalViolation(const std::string &environment,
+                           const CreatureState &state);
 };
 
 } // namespace detail
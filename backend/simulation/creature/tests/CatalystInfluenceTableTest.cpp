@@ -0,0 +1,186 @@
+#include "creature_engine/traits/synthesis/CatalystInfluenceTable.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+using crescent::traits::CatalystInfluenceTable;
+using crescent::traits::CatalystKey;
+using crescent::traits::CatalystInfluence;
+using crescent::traits::CatalystType;
+
+namespace {
+
+CatalystInfluenceTable::Config noDecay() {
+    CatalystInfluenceTable::Config config;
+    config.halfLife.fill(std::numeric_limits<float>::infinity());
+    return config;
+}
+
+} // namespace
+
+TEST_CASE("Exposures saturate and record affected forms", "[influence]") {
+    CatalystInfluenceTable table;
+    const CatalystInfluenceTable::Owner owner = table.acquire();
+
+    table.recordExposure(owner.id(), CatalystType::Resonance, "song", 0.6f,
+                         "chorus");
+    table.recordExposure(owner.id(), CatalystType::Resonance, "song", 0.6f,
+                         "chorus");
+    table.recordExposure(owner.id(), CatalystType::Resonance, "song", 0.1f,
+                         "verse");
+
+    const auto influence =
+        table.find(owner.id(), CatalystType::Resonance, "song");
+    REQUIRE(influence);
+    REQUIRE(influence->currentStrength == 1.0f);
+    REQUIRE(influence->exposureCount == 3);
+    REQUIRE(influence->affectedForms ==
+            std::vector<std::string>{"chorus", "verse"});
+    REQUIRE(table.strengthOf(owner.id(), CatalystType::External, "song") ==
+            0.0f);
+    REQUIRE_FALSE(table.find(owner.id(), CatalystType::Resonance, "other"));
+    REQUIRE(table.countOf(owner.id()) == 1);
+}
+
+TEST_CASE("Decay halves strength per half-life and expires weak rows",
+          "[influence]") {
+    CatalystInfluenceTable::Config config = noDecay();
+    const auto resonance = static_cast<std::size_t>(CatalystType::Resonance);
+    config.halfLife[resonance] = 10.0f;
+    CatalystInfluenceTable table(config);
+    const CatalystInfluenceTable::Owner owner = table.acquire();
+
+    table.recordExposure(owner.id(), CatalystType::Resonance, "song", 0.8f);
+    table.recordExposure(owner.id(), CatalystType::External, "heat", 0.8f);
+
+    REQUIRE(table.decay(10.0f) == 0);
+    REQUIRE(table.strengthOf(owner.id(), CatalystType::Resonance, "song") ==
+            Approx(0.4f));
+    REQUIRE(table.strengthOf(owner.id(), CatalystType::External, "heat") ==
+            Approx(0.8f));
+    const auto influence =
+        table.find(owner.id(), CatalystType::Resonance, "song");
+    REQUIRE(influence->peakStrength == Approx(0.8f));
+    REQUIRE(influence->secondsSinceExposure == Approx(10.0f));
+
+    // 0.4 * 2^-6 < 0.01; the heat row idles past maxIdleSeconds
+    REQUIRE(table.decay(60.0f) == 1);
+    REQUIRE(table.countOf(owner.id()) == 1);
+    REQUIRE(table.decay(config.maxIdleSeconds) == 1);
+    REQUIRE(table.countOf(owner.id()) == 0);
+    REQUIRE(table.size() == 0);
+}
+
+TEST_CASE("Exposures give the owner a new version; decay alone does not",
+          "[influence]") {
+    CatalystInfluenceTable table(noDecay());
+    const CatalystInfluenceTable::Owner first = table.acquire();
+    const CatalystInfluenceTable::Owner second = table.acquire();
+    REQUIRE(table.versionOf(first.id()) == 0);
+
+    table.recordExposure(first.id(), CatalystType::Resonance, "song", 0.5f);
+    const std::uint64_t exposed = table.versionOf(first.id());
+    REQUIRE(exposed != 0);
+    REQUIRE(table.versionOf(second.id()) == 0);
+
+    table.decay(1.0f);
+    REQUIRE(table.versionOf(first.id()) == exposed);
+    REQUIRE(table.versionOf(second.id()) == 0); // No rows, nothing changed
+
+    table.recordExposure(first.id(), CatalystType::Resonance, "song", 0.1f);
+    REQUIRE(table.versionOf(first.id()) > exposed);
+}
+
+TEST_CASE("Only owners that lose a row to decay get a new version",
+          "[influence]") {
+    CatalystInfluenceTable::Config config;
+    config.halfLife.fill(10.0f);
+    CatalystInfluenceTable table(config);
+    const CatalystInfluenceTable::Owner fading = table.acquire();
+    const CatalystInfluenceTable::Owner strong = table.acquire();
+    table.recordExposure(fading.id(), CatalystType::Resonance, "whisper",
+                         0.015f);
+    table.recordExposure(fading.id(), CatalystType::Resonance, "song", 0.9f);
+    table.recordExposure(strong.id(), CatalystType::Resonance, "song", 0.9f);
+    const std::uint64_t fadingBefore = table.versionOf(fading.id());
+    const std::uint64_t strongBefore = table.versionOf(strong.id());
+
+    // Halves every row: the whisper drops below expiryStrength
+    REQUIRE(table.decay(10.0f) == 1);
+    REQUIRE(table.versionOf(fading.id()) > fadingBefore);
+    REQUIRE(table.versionOf(strong.id()) == strongBefore);
+    REQUIRE(table.find(strong.id(), CatalystType::Resonance, "song")
+                ->currentStrength == Approx(0.45f));
+}
+
+TEST_CASE("Released owners drop their rows and versions", "[influence]") {
+    CatalystInfluenceTable table(noDecay());
+    std::uint64_t before = 0;
+    CatalystInfluenceTable::OwnerId id = 0;
+    {
+        const CatalystInfluenceTable::Owner owner = table.acquire();
+        id = owner.id();
+        table.recordExposure(id, CatalystType::Resonance, "song", 0.5f);
+        before = table.versionOf(id);
+    }
+    REQUIRE(table.size() == 0);
+    REQUIRE(table.versionOf(id) == 0);
+
+    // The recycled id starts clean, and its versions keep climbing
+    const CatalystInfluenceTable::Owner reused = table.acquire();
+    REQUIRE(reused.id() == id);
+    REQUIRE(table.countOf(id) == 0);
+    table.recordExposure(id, CatalystType::Resonance, "song", 0.5f);
+    REQUIRE(table.versionOf(id) > before);
+}
+
+TEST_CASE("Copied owners diverge independently", "[influence]") {
+    CatalystInfluenceTable table(noDecay());
+    const CatalystInfluenceTable::Owner source = table.acquire();
+    const CatalystInfluenceTable::Owner target = table.acquire();
+    table.recordExposure(source.id(), CatalystType::Resonance, "song", 0.3f,
+                         "chorus");
+    table.recordExposure(source.id(), CatalystType::External, "heat", 0.2f);
+
+    table.copyOwner(source.id(), target.id());
+    REQUIRE(table.versionOf(target.id()) != 0);
+    table.recordExposure(target.id(), CatalystType::Resonance, "song", 0.3f);
+
+    std::vector<std::string> ids;
+    table.forEachOf(target.id(), [&](const CatalystKey &key,
+                                     const CatalystInfluence &influence) {
+        ids.push_back(key.id);
+        if (key.type == CatalystType::Resonance) {
+            REQUIRE(influence.affectedForms ==
+                    std::vector<std::string>{"chorus"});
+        }
+    });
+    REQUIRE(ids == std::vector<std::string>{"song", "heat"});
+    REQUIRE(table.strengthOf(source.id(), CatalystType::Resonance, "song") ==
+            Approx(0.3f));
+    REQUIRE(table.strengthOf(target.id(), CatalystType::Resonance, "song") ==
+            Approx(0.6f));
+}
+
+TEST_CASE("Decay on a worker pool matches the serial pass", "[influence]") {
+    CatalystInfluenceTable serial;
+    CatalystInfluenceTable parallel;
+    std::vector<CatalystInfluenceTable::Owner> owners;
+    for (int i = 0; i < 64; ++i) {
+        const float intensity = 0.02f * static_cast<float>(i % 10 + 1);
+        for (CatalystInfluenceTable *table : {&serial, &parallel}) {
+            owners.push_back(table->acquire());
+            table->recordExposure(owners.back().id(), CatalystType::Resonance,
+                                  "song", intensity);
+        }
+    }
+    crescent::common::WorkerPool pool(2);
+    const std::size_t expired = serial.decay(12.0f);
+    REQUIRE(parallel.decay(12.0f, &pool) == expired);
+    REQUIRE(expired > 0);
+    REQUIRE(parallel.size() == serial.size());
+}
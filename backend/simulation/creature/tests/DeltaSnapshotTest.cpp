@@ -0,0 +1,465 @@
+#include "creature_engine/io/SnapshotCompactor.h"
+#include "creature_engine/io/SnapshotStore.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using crescent::ChangeTracker;
+using crescent::SerializationException;
+using crescent::StateException;
+using crescent::io::BasicDeltaSnapshotWriter;
+using crescent::io::CompactionPolicy;
+using crescent::io::CreatureDeltaRecord;
+using crescent::io::SnapshotChain;
+using crescent::io::SnapshotFile;
+using crescent::io::SnapshotHeader;
+using crescent::io::SnapshotId;
+using crescent::io::SnapshotKind;
+using crescent::io::SnapshotReader;
+
+namespace {
+
+constexpr ChangeTracker::FieldMask NAME = 1u << 0;
+constexpr ChangeTracker::FieldMask HEALTH = 1u << 1;
+
+struct Options {
+    bool verbose{false};
+};
+
+// Stands in for CreatureCore: two fields behind one tracker
+class Critter {
+  public:
+    struct Identity {
+        std::string id;
+    };
+    struct PersistedVersions {
+        std::uint64_t creature{0};
+    };
+
+    Critter(std::string id, std::string name, int health)
+        : identity_{std::move(id)}, name_(std::move(name)), health_(health) {}
+
+    void rename(std::string name) {
+        name_ = std::move(name);
+        tracker_.markDirty(NAME);
+    }
+    void setHealth(int health) {
+        health_ = health;
+        tracker_.markDirty(HEALTH);
+    }
+
+    const Identity &getIdentity() const { return identity_; }
+    const ChangeTracker &getChangeTracker() const { return tracker_; }
+    ChangeTracker::FieldMask getDirtyFields() const {
+        return tracker_.getDirtyFields();
+    }
+    PersistedVersions capturePersistedVersions() const {
+        return {tracker_.getVersion()};
+    }
+    void clearDirty(const PersistedVersions &persisted) {
+        tracker_.clearDirty(persisted.creature);
+    }
+
+    std::shared_ptr<const std::string>
+    serializeToBytes(const Options &options) const {
+        return std::make_shared<const std::string>(
+            serializeFieldsToJson(ChangeTracker::ALL_FIELDS, options).dump());
+    }
+    nlohmann::json serializeFieldsToJson(ChangeTracker::FieldMask fields,
+                                         const Options &) const {
+        nlohmann::json json = nlohmann::json::object();
+        json["id"] = identity_.id;
+        if (fields & NAME) {
+            json["name"] = name_;
+        }
+        if (fields & HEALTH) {
+            json["health"] = health_;
+        }
+        return json;
+    }
+
+  private:
+    Identity identity_;
+    std::string name_;
+    int health_;
+    ChangeTracker tracker_;
+};
+
+using Writer = BasicDeltaSnapshotWriter<Critter, Options>;
+
+// Fresh directory per test, removed afterwards
+class ScratchDirectory {
+  public:
+    ScratchDirectory() {
+        static std::atomic<int> counter{0};
+        path_ = std::filesystem::temp_directory_path() /
+                ("delta_snapshot_test_" + std::to_string(::getpid()) + "_" +
+                 std::to_string(counter++));
+        std::filesystem::remove_all(path_);
+    }
+    ~ScratchDirectory() {
+        std::error_code ignored;
+        std::filesystem::remove_all(path_, ignored);
+    }
+    const std::filesystem::path &path() const { return path_; }
+
+  private:
+    std::filesystem::path path_;
+};
+
+std::vector<Critter *> pointers(std::vector<Critter> &critters) {
+    std::vector<Critter *> out;
+    for (Critter &critter : critters) {
+        out.push_back(&critter);
+    }
+    return out;
+}
+
+std::unordered_map<std::string, nlohmann::json>
+payloads(const std::filesystem::path &dir, SnapshotId head) {
+    std::unordered_map<std::string, nlohmann::json> out;
+    for (auto &[id, record] : SnapshotReader(dir).loadMerged(head)) {
+        out[id] = record.payload;
+    }
+    return out;
+}
+
+nlohmann::json critter(const std::string &id, const std::string &name,
+                       int health) {
+    return {{"id", id}, {"name", name}, {"health", health}};
+}
+
+} // namespace
+
+TEST_CASE("A base and its deltas replay to the latest state",
+          "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    std::vector<Critter> critters{{"a", "Ash", 10}, {"b", "Birch", 20},
+                                  {"c", "Cedar", 30}};
+    Writer writer(scratch.path());
+
+    const SnapshotHeader base = writer.writeBase(pointers(critters));
+    REQUIRE(base.kind == SnapshotKind::Base);
+    REQUIRE(base.recordCount == 3);
+    REQUIRE(critters[0].getDirtyFields() == 0);
+
+    critters[1].setHealth(25);
+    writer.beginDelta();
+    for (Critter &c : critters) {
+        writer.recordCreature(c);
+    }
+    const SnapshotHeader first = writer.commit();
+    REQUIRE(first.kind == SnapshotKind::Delta);
+    REQUIRE(first.parentId == base.id);
+    REQUIRE(first.baseId == base.id);
+    REQUIRE(first.chainDepth == 1);
+    // Only the changed creature, and only its changed field
+    REQUIRE(first.recordCount == 1);
+    std::vector<CreatureDeltaRecord> records;
+    std::vector<std::string> removals;
+    SnapshotFile::read(SnapshotFile::pathFor(scratch.path(), first.id),
+                       records, removals);
+    REQUIRE(records.size() == 1);
+    REQUIRE(records[0].fields == HEALTH);
+    REQUIRE(records[0].payload == nlohmann::json{{"id", "b"},
+                                                 {"health", 25}});
+
+    critters[2].rename("Cypress");
+    writer.beginDelta();
+    for (Critter &c : critters) {
+        writer.recordCreature(c);
+    }
+    writer.recordRemoval("a");
+    const SnapshotHeader second = writer.commit();
+    REQUIRE(second.chainDepth == 2);
+    REQUIRE(second.removedCount == 1);
+    REQUIRE(writer.getLatestSnapshot() == second.id);
+    REQUIRE(writer.getChainDepth() == 2);
+
+    const SnapshotReader reader(scratch.path());
+    const std::vector<SnapshotHeader> chain = reader.resolveChain(second.id);
+    REQUIRE(chain.size() == 3);
+    REQUIRE(chain[0].id == base.id);
+    REQUIRE(chain[2].id == second.id);
+
+    const auto merged = reader.loadMerged(second.id);
+    REQUIRE(merged.size() == 2);
+    REQUIRE(merged.at("b").payload == critter("b", "Birch", 25));
+    REQUIRE(merged.at("b").fields == ChangeTracker::ALL_FIELDS);
+    REQUIRE(merged.at("c").payload == critter("c", "Cypress", 30));
+
+    // An earlier head still replays as it was
+    REQUIRE(payloads(scratch.path(), first.id).at("a") ==
+            critter("a", "Ash", 10));
+}
+
+TEST_CASE("Dirty bits clear only up to the recorded version",
+          "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    std::vector<Critter> critters{{"a", "Ash", 10}};
+    Writer writer(scratch.path());
+    writer.writeBase(pointers(critters));
+
+    critters[0].setHealth(11);
+    writer.beginDelta();
+    REQUIRE(writer.recordCreature(critters[0]));
+    // Lands after the record was taken, so it belongs in the next delta
+    critters[0].rename("Alder");
+    writer.commit();
+    REQUIRE(critters[0].getDirtyFields() == (NAME | HEALTH));
+
+    // An aborted delta leaves every bit in place
+    writer.beginDelta();
+    REQUIRE(writer.recordCreature(critters[0]));
+    writer.abort();
+    REQUIRE(critters[0].getDirtyFields() == (NAME | HEALTH));
+
+    writer.beginDelta();
+    REQUIRE(writer.recordCreature(critters[0]));
+    const SnapshotHeader last = writer.commit();
+    REQUIRE(critters[0].getDirtyFields() == 0);
+    REQUIRE(payloads(scratch.path(), last.id).at("a") ==
+            critter("a", "Alder", 11));
+
+    writer.beginDelta();
+    REQUIRE_FALSE(writer.recordCreature(critters[0]));
+    writer.abort();
+}
+
+TEST_CASE("Writer misuse is rejected", "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    Writer writer(scratch.path());
+    Critter lone("a", "Ash", 1);
+
+    REQUIRE_THROWS_AS(writer.beginDelta(), SerializationException);
+    REQUIRE_THROWS_AS(writer.recordCreature(lone), StateException);
+    REQUIRE_THROWS_AS(writer.commitBase(), StateException);
+
+    writer.beginBase();
+    REQUIRE_THROWS_AS(writer.beginDelta(), StateException);
+    writer.abort();
+    // The uncommitted file is gone
+    REQUIRE(std::filesystem::is_empty(scratch.path()));
+    REQUIRE_FALSE(writer.getLatestSnapshot());
+}
+
+TEST_CASE("A streamed base matches a written one", "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    Writer writer(scratch.path());
+
+    writer.beginBase();
+    std::string chunk;
+    for (int i = 0; i < 5; ++i) {
+        if (!chunk.empty()) {
+            chunk += ',';
+        }
+        const std::string id = "g" + std::to_string(i);
+        SnapshotFile::appendRecordJson(chunk, id, 0,
+                                       ChangeTracker::ALL_FIELDS,
+                                       critter(id, "Gen", i).dump());
+    }
+    writer.appendBaseRecords(chunk, 5);
+    writer.appendBaseRecords("", 0);
+    chunk.clear();
+    SnapshotFile::appendRecordJson(chunk, "g5", 0, ChangeTracker::ALL_FIELDS,
+                                   critter("g5", "Gen", 5).dump());
+    writer.appendBaseRecords(chunk, 1);
+    const SnapshotHeader base = writer.commitBase();
+
+    REQUIRE(base.recordCount == 6);
+    REQUIRE(SnapshotFile::readHeader(SnapshotFile::pathFor(
+                                         scratch.path(), base.id))
+                .recordCount == 6);
+    const auto merged = payloads(scratch.path(), base.id);
+    REQUIRE(merged.size() == 6);
+    REQUIRE(merged.at("g5") == critter("g5", "Gen", 5));
+}
+
+TEST_CASE("A reopened chain resumes from its head", "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    std::vector<Critter> critters{{"a", "Ash", 10}};
+    SnapshotId head = 0;
+    {
+        Writer writer(scratch.path());
+        writer.writeBase(pointers(critters));
+        critters[0].setHealth(12);
+        writer.beginDelta();
+        writer.recordCreature(critters[0]);
+        head = writer.commit().id;
+    }
+    // Left behind by a writer that died mid-file
+    { std::ofstream(scratch.path() / "99.snap.tmp") << "partial"; }
+
+    auto chain = std::make_shared<SnapshotChain>(scratch.path());
+    REQUIRE(chain->getLatest()->id == head);
+    REQUIRE(chain->allocateId() == head + 1);
+    REQUIRE_FALSE(std::filesystem::exists(scratch.path() / "99.snap.tmp"));
+
+    Writer writer(chain);
+    critters[0].rename("Alder");
+    writer.beginDelta();
+    writer.recordCreature(critters[0]);
+    const SnapshotHeader next = writer.commit();
+    REQUIRE(next.parentId == head);
+    REQUIRE(next.chainDepth == 2);
+    REQUIRE(payloads(scratch.path(), next.id).at("a") ==
+            critter("a", "Alder", 12));
+}
+
+TEST_CASE("Pinned and live snapshots outlive retire", "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    std::vector<Critter> critters{{"a", "Ash", 10}};
+    Writer writer(scratch.path());
+    const std::shared_ptr<SnapshotChain> &chain = writer.getChain();
+    const SnapshotHeader base = writer.writeBase(pointers(critters));
+    critters[0].setHealth(1);
+    writer.beginDelta();
+    writer.recordCreature(critters[0]);
+    const SnapshotHeader delta = writer.commit();
+
+    // On the live chain: deferred, not deleted
+    REQUIRE_FALSE(chain->retire(base.id));
+    REQUIRE(std::filesystem::exists(
+        SnapshotFile::pathFor(scratch.path(), base.id)));
+
+    SnapshotChain::Pin pin = chain->pin(delta.id);
+    // A new base moves the head off the old chain; the pin still holds it
+    const SnapshotHeader rebase = writer.writeBase(pointers(critters));
+    REQUIRE(chain->getLatest()->id == rebase.id);
+    REQUIRE_FALSE(chain->retire(delta.id));
+    REQUIRE(payloads(scratch.path(), delta.id).at("a") ==
+            critter("a", "Ash", 1));
+
+    // Dropping the pin releases both deferred files
+    pin.reset();
+    REQUIRE_FALSE(chain->contains(base.id));
+    REQUIRE_FALSE(chain->contains(delta.id));
+    REQUIRE_FALSE(std::filesystem::exists(
+        SnapshotFile::pathFor(scratch.path(), base.id)));
+    REQUIRE_THROWS_AS(chain->pin(delta.id), SerializationException);
+    REQUIRE(chain->retire(delta.id));
+}
+
+TEST_CASE("Compaction folds a chain into an equal base", "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    std::vector<Critter> critters{{"a", "Ash", 10}, {"b", "Birch", 20}};
+    Writer writer(scratch.path());
+    const SnapshotHeader base = writer.writeBase(pointers(critters));
+    for (int round = 0; round < 4; ++round) {
+        critters[static_cast<std::size_t>(round % 2)].setHealth(round);
+        writer.beginDelta();
+        for (Critter &c : critters) {
+            writer.recordCreature(c);
+        }
+        if (round == 3) {
+            writer.recordRemoval("a");
+        }
+        writer.commit();
+    }
+    const SnapshotId head = *writer.getLatestSnapshot();
+    const auto before = payloads(scratch.path(), head);
+    const SnapshotHeader headHeader =
+        SnapshotFile::readHeader(SnapshotFile::pathFor(scratch.path(), head));
+
+    crescent::io::SnapshotCompactor compactor(writer.getChain());
+    const std::optional<SnapshotHeader> merged = compactor.compactNow(head);
+    REQUIRE(merged);
+    REQUIRE(merged->kind == SnapshotKind::Base);
+    REQUIRE(merged->recordCount == 1);
+    REQUIRE(merged->clock.tick.value == headHeader.clock.tick.value);
+    REQUIRE(merged->clock.epochMicros == headHeader.clock.epochMicros);
+    REQUIRE(compactor.getLastCompactedBase() == merged->id);
+    REQUIRE(payloads(scratch.path(), merged->id) == before);
+
+    // The old chain is gone; the writer continues from the merged base
+    REQUIRE_FALSE(std::filesystem::exists(
+        SnapshotFile::pathFor(scratch.path(), base.id)));
+    REQUIRE_FALSE(std::filesystem::exists(
+        SnapshotFile::pathFor(scratch.path(), head)));
+    critters[1].rename("Beech");
+    writer.beginDelta();
+    writer.recordCreature(critters[1]);
+    const SnapshotHeader next = writer.commit();
+    REQUIRE(next.parentId == merged->id);
+    REQUIRE(next.chainDepth == 1);
+    REQUIRE(payloads(scratch.path(), next.id).at("b") ==
+            critter("b", "Beech", 3));
+}
+
+TEST_CASE("A merge that loses the race is discarded", "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    std::vector<Critter> critters{{"a", "Ash", 10}};
+    Writer writer(scratch.path());
+    writer.writeBase(pointers(critters));
+    critters[0].setHealth(1);
+    writer.beginDelta();
+    writer.recordCreature(critters[0]);
+    const SnapshotId stale = writer.commit().id;
+    critters[0].setHealth(2);
+    writer.beginDelta();
+    writer.recordCreature(critters[0]);
+    const SnapshotId head = writer.commit().id;
+
+    crescent::io::SnapshotCompactor compactor(writer.getChain());
+    REQUIRE_FALSE(compactor.compactNow(stale));
+    REQUIRE_FALSE(compactor.getLastCompactedBase());
+    REQUIRE(writer.getLatestSnapshot() == head);
+    // Only the base and the two deltas remain
+    std::size_t files = 0;
+    for (const auto &entry :
+         std::filesystem::directory_iterator(scratch.path())) {
+        if (SnapshotFile::idOf(entry.path())) {
+            ++files;
+        }
+    }
+    REQUIRE(files == 3);
+}
+
+TEST_CASE("The worker compacts once the chain is too deep",
+          "[delta-snapshot]") {
+    ScratchDirectory scratch;
+    std::vector<Critter> critters{{"a", "Ash", 10}};
+    Writer writer(scratch.path());
+    writer.writeBase(pointers(critters));
+
+    CompactionPolicy policy;
+    policy.maxChainDepth = 3;
+    policy.maxDeltaToBaseRatio = 1000.0f;
+    crescent::io::SnapshotCompactor compactor(writer.getChain(), policy);
+    compactor.start();
+    REQUIRE(compactor.isRunning());
+
+    for (int round = 0; round < 3; ++round) {
+        critters[0].setHealth(round);
+        writer.beginDelta();
+        writer.recordCreature(critters[0]);
+        compactor.onSnapshotCommitted(writer.commit());
+    }
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!compactor.getLastCompactedBase() &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    compactor.stop();
+    REQUIRE_FALSE(compactor.isRunning());
+    REQUIRE_FALSE(compactor.getLastError());
+
+    REQUIRE(compactor.getLastCompactedBase());
+    REQUIRE(writer.getLatestSnapshot() == compactor.getLastCompactedBase());
+    REQUIRE(writer.getChainDepth() == 0);
+    REQUIRE(payloads(scratch.path(), *writer.getLatestSnapshot()).at("a") ==
+            critter("a", "Ash", 2));
+}
@@ -0,0 +1,106 @@
+#include "creature_engine/core/Exceptions.hpp"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Allocations made by this thread while counting is on
+thread_local bool counting = false;
+thread_local std::size_t allocations = 0;
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    if (counting) {
+        ++allocations;
+    }
+    if (void *block = std::malloc(size == 0 ? 1 : size)) {
+        return block;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept { std::free(pointer); }
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+using crescent::CreatureException;
+using crescent::ErrorCode;
+using crescent::LimitException;
+using crescent::SerializationException;
+using crescent::TraitException;
+
+TEST_CASE("Messages combine category and context", "[exceptions]") {
+    const TraitException withContext("missing trait fire");
+    REQUIRE(std::string(withContext.what()) ==
+            "Trait Error: missing trait fire");
+    REQUIRE(withContext.context() == "missing trait fire");
+
+    const TraitException withCode(ErrorCode::LimitExceeded);
+    REQUIRE(std::string(withCode.what()) == "Trait Error: limit exceeded");
+    REQUIRE(withCode.code() == ErrorCode::LimitExceeded);
+
+    const CreatureException plain("bare");
+    REQUIRE(std::string(plain.what()) == "bare");
+    REQUIRE(plain.code() == ErrorCode::Unspecified);
+}
+
+TEST_CASE("Copies and concurrent readers see one message", "[exceptions]") {
+    const SerializationException original("disk full");
+    const SerializationException copy = original;
+    REQUIRE(std::strcmp(copy.what(), original.what()) == 0);
+    REQUIRE(copy.code() == ErrorCode::SerializationFailed);
+
+    std::vector<std::thread> threads;
+    std::vector<const char *> seen(4, nullptr);
+    for (std::size_t t = 0; t < seen.size(); ++t) {
+        threads.emplace_back([&original, &seen, t] {
+            for (int i = 0; i < 1000; ++i) {
+                seen[t] = original.what();
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (const char *text : seen) {
+        REQUIRE(text == original.what());
+    }
+}
+
+TEST_CASE("Limit exceptions own their limit name", "[exceptions]") {
+    std::string name = "population";
+    const LimitException error("too many creatures", name, 11, 10);
+    name.assign("overwritten");
+    REQUIRE(error.getLimitType() == "population");
+    REQUIRE(error.getCurrentValue() == 11);
+    REQUIRE(error.getMaxValue() == 10);
+    REQUIRE(error.code() == ErrorCode::LimitExceeded);
+    REQUIRE(std::string(error.what()) == "Limit Error: too many creatures");
+}
+
+TEST_CASE("Code-only exceptions format their message on first use",
+          "[exceptions]") {
+    allocations = 0;
+    counting = true;
+    try {
+        throw TraitException(ErrorCode::LimitExceeded);
+    } catch (const TraitException &error) {
+        counting = false;
+        // The exception object itself comes from the runtime, not new
+        REQUIRE(allocations == 0);
+        REQUIRE(std::string(error.what()) == "Trait Error: limit exceeded");
+        REQUIRE(error.what() == error.what());
+    }
+    counting = false;
+}
@@ -0,0 +1,114 @@
+#include "creature_engine/io/JsonStreamWriter.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using crescent::io::JsonKey;
+using crescent::io::JsonStreamWriter;
+
+namespace {
+
+constexpr JsonKey ID{"id"};
+constexpr JsonKey NAME{"name"};
+constexpr JsonKey STATS{"stats"};
+constexpr JsonKey TAGS{"tags"};
+
+void writeSample(JsonStreamWriter &writer, int index) {
+    writer.beginObject();
+    writer.key(ID).value(index);
+    writer.key(NAME).value("line\n\"quoted\"\t\x01 caf\xc3\xa9");
+    writer.key(STATS).beginObject();
+    writer.dynamicKey("speed").value(0.1f);
+    writer.dynamicKey("weight").value(-12.5);
+    writer.endObject();
+    writer.key(TAGS).beginArray().value(true).null().value(
+        std::uint64_t{18446744073709551615u});
+    writer.endArray();
+    writer.endObject();
+}
+
+nlohmann::json sampleDom(int index) {
+    nlohmann::json dom;
+    dom["id"] = index;
+    dom["name"] = "line\n\"quoted\"\t\x01 caf\xc3\xa9";
+    dom["stats"]["speed"] = 0.1f;
+    dom["stats"]["weight"] = -12.5;
+    dom["tags"] = {true, nullptr, std::uint64_t{18446744073709551615u}};
+    return dom;
+}
+
+} // namespace
+
+TEST_CASE("Streamed output matches nlohmann dump", "[json-writer]") {
+    JsonStreamWriter writer;
+    writeSample(writer, 7);
+    REQUIRE(writer.str() == sampleDom(7).dump());
+}
+
+TEST_CASE("Nesting is bounded by MAX_DEPTH", "[json-writer]") {
+    JsonStreamWriter writer;
+    for (std::size_t d = 0; d < JsonStreamWriter::MAX_DEPTH; ++d) {
+        writer.beginArray();
+    }
+    REQUIRE_THROWS_AS(writer.beginArray(), std::length_error);
+    for (std::size_t d = 0; d < JsonStreamWriter::MAX_DEPTH; ++d) {
+        writer.endArray();
+    }
+    REQUIRE_THROWS_AS(writer.endArray(), std::logic_error);
+    REQUIRE(nlohmann::json::parse(writer.str()).is_array());
+}
+
+TEST_CASE("Flushes through a pipe in threshold-sized chunks",
+          "[json-writer]") {
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    std::string received;
+    std::thread reader([&received, fd = fds[0]] {
+        char chunk[4096];
+        ssize_t count;
+        while ((count = ::read(fd, chunk, sizeof(chunk))) > 0) {
+            received.append(chunk, static_cast<std::size_t>(count));
+        }
+    });
+
+    nlohmann::json expected = nlohmann::json::array();
+    {
+        JsonStreamWriter writer(fds[1], 256);
+        writer.beginArray();
+        for (int i = 0; i < 500; ++i) {
+            writeSample(writer, i);
+            expected.push_back(sampleDom(i));
+            REQUIRE(writer.str().size() < 256 + 256);
+        }
+        writer.endArray();
+        REQUIRE(writer.flush());
+        REQUIRE(writer.getError() == 0);
+    }
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+
+    REQUIRE(received == expected.dump());
+}
+
+TEST_CASE("Write errors are reported and sticky", "[json-writer]") {
+    const int readOnly = ::open("/dev/null", O_RDONLY);
+    REQUIRE(readOnly >= 0);
+    {
+        JsonStreamWriter writer(readOnly, 16);
+        writeSample(writer, 1); // Passes the threshold and flushes
+        REQUIRE(writer.getError() == EBADF);
+        writer.beginArray().value(1).endArray();
+        REQUIRE_FALSE(writer.flush());
+        REQUIRE(writer.str().empty());
+    }
+    ::close(readOnly);
+}
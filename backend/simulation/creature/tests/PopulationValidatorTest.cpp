@@ -0,0 +1,170 @@
+#include "common/utils/ShardedSlotMap.h"
+#include "creature_engine/core/BasicPopulationValidator.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+using crescent::BasicPopulationValidator;
+using crescent::Violation;
+using crescent::ViolationCode;
+using crescent::ViolationSink;
+using crescent::common::ShardedSlotMap;
+using crescent::common::SlotHandle;
+
+namespace {
+
+// Stands in for CreatureCore: a few fields checked in a fixed order
+struct Specimen {
+    bool hasIdentity{true};
+    float stress{0.5f};
+    std::uint32_t badTraits{0};
+    bool explode{false};
+
+    void validateInto(ViolationSink &sink) const {
+        if (explode) {
+            throw std::runtime_error("check failed");
+        }
+        if (!hasIdentity) {
+            sink.report(ViolationCode::MissingIdentity);
+        }
+        if (stress < 0.0f || stress > 1.0f) {
+            sink.report(ViolationCode::StressOutOfRange);
+        }
+        for (std::uint32_t i = 0; i < badTraits && !sink.full(); ++i) {
+            sink.report(ViolationCode::TraitStateInvalid, i);
+        }
+    }
+};
+
+using Registry = ShardedSlotMap<Specimen>;
+using Validator = BasicPopulationValidator<Registry>;
+using Report = Validator::Report;
+
+std::vector<SlotHandle> populate(Registry &registry, std::size_t count) {
+    std::vector<SlotHandle> handles;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto specimen = std::make_unique<Specimen>();
+        specimen->hasIdentity = i % 7 != 0;
+        specimen->stress = i % 11 == 0 ? 1.5f : 0.25f;
+        specimen->badTraits = static_cast<std::uint32_t>(i % 13);
+        handles.push_back(registry.insert(std::move(specimen), i * 31));
+    }
+    return handles;
+}
+
+using Row = std::tuple<std::uint64_t, ViolationCode, std::uint32_t>;
+
+std::vector<Row> sortedRows(const Report &report) {
+    std::vector<Row> rows;
+    report.forEachViolation([&rows](SlotHandle handle, const Violation &v) {
+        rows.emplace_back(handle.pack(), v.code, v.detail);
+    });
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+} // namespace
+
+TEST_CASE("A parallel pass matches a serial one", "[population-validator]") {
+    Registry registry;
+    const std::vector<SlotHandle> handles = populate(registry, 5000);
+    REQUIRE(registry.erase(handles[42]) != nullptr);
+
+    Validator::Config parallelConfig;
+    parallelConfig.workerCount = 4;
+    parallelConfig.maxViolationsPerCreature = 5;
+    Validator parallel(registry, parallelConfig);
+    Report parallelReport;
+    parallel.run(parallelReport);
+
+    // One creature at a time on this thread
+    Validator::Config serialConfig;
+    serialConfig.workerCount = 1;
+    serialConfig.maxViolationsPerCreature = 5;
+    Validator serial(registry, serialConfig);
+    Report serialReport;
+    std::size_t stale = 0;
+    for (const SlotHandle handle : handles) {
+        if (!serial.validateOne(handle, serialReport)) {
+            ++stale;
+        }
+    }
+
+    REQUIRE(stale == 1);
+    REQUIRE(parallelReport.creaturesChecked() == 4999);
+    REQUIRE(parallelReport.creaturesChecked() ==
+            serialReport.creaturesChecked());
+    REQUIRE(parallelReport.creaturesFailed() ==
+            serialReport.creaturesFailed());
+    REQUIRE(parallelReport.countByCode() == serialReport.countByCode());
+    REQUIRE(sortedRows(parallelReport) == sortedRows(serialReport));
+    REQUIRE(parallelReport.elapsed().count() > 0);
+
+    // The per-creature limit caps what a creature stores
+    std::size_t trait12 = 0;
+    parallelReport.forEachViolation([&](SlotHandle handle, const Violation &) {
+        if (handle == handles[12]) {
+            ++trait12;
+        }
+    });
+    REQUIRE(trait12 == 5);
+}
+
+TEST_CASE("Repeated passes reuse the report", "[population-validator]") {
+    Registry registry;
+    const std::vector<SlotHandle> handles = populate(registry, 1000);
+    Validator::Config config;
+    config.workerCount = 3;
+    Validator validator(registry, config);
+    Report report(16);
+
+    validator.run(report);
+    const std::vector<Row> first = sortedRows(report);
+    REQUIRE_FALSE(report.clean());
+
+    for (const SlotHandle handle : handles) {
+        registry.write(handle, [](Specimen &specimen) {
+            specimen = Specimen{};
+        });
+    }
+    validator.run(report);
+    REQUIRE(report.clean());
+    REQUIRE(report.creaturesChecked() == 1000);
+    REQUIRE(report.creaturesFailed() == 0);
+
+    registry.write(handles[3], [](Specimen &specimen) {
+        specimen.hasIdentity = false;
+    });
+    validator.run(report);
+    REQUIRE(sortedRows(report) ==
+            std::vector<Row>{{handles[3].pack(),
+                              ViolationCode::MissingIdentity, 0}});
+    REQUIRE(first.size() > 1);
+}
+
+TEST_CASE("A throwing check fails the pass after it drains",
+          "[population-validator]") {
+    Registry registry;
+    const std::vector<SlotHandle> handles = populate(registry, 500);
+    registry.write(handles[250],
+                   [](Specimen &specimen) { specimen.explode = true; });
+    Validator::Config config;
+    config.workerCount = 4;
+    Validator validator(registry, config);
+    Report report;
+
+    REQUIRE_THROWS_AS(validator.run(report), std::runtime_error);
+
+    // The validator is still usable afterwards
+    registry.write(handles[250],
+                   [](Specimen &specimen) { specimen.explode = false; });
+    validator.run(report);
+    REQUIRE(report.creaturesChecked() == 500);
+}
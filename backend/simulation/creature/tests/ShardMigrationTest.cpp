@@ -0,0 +1,228 @@
+#include "common/utils/ProcessShardGroup.h"
+#include "creature_engine/io/CreatureCodec.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using crescent::common::ProcessShardGroup;
+using crescent::common::ShardOutbox;
+using crescent::common::ShardWorker;
+using crescent::common::SimTick;
+using crescent::common::StringInterner;
+using crescent::io::CreatureReader;
+using crescent::traits::CatalystInfluenceTable;
+using crescent::traits::CatalystType;
+using crescent::traits::SynthesisEvent;
+using crescent::traits::SynthesisHistoryLog;
+using crescent::traits::SynthesisStage;
+
+namespace {
+
+// Stands in for the synthesis part of a creature: influence rows in a
+// table plus a history log, both keyed by process-local ids
+struct SynthesisPart {
+    CatalystInfluenceTable::Owner owner;
+    SynthesisHistoryLog history;
+};
+
+SynthesisPart makePart(CatalystInfluenceTable &table, StringInterner &strings,
+                       std::uint32_t seed) {
+    SynthesisPart part{table.acquire(), SynthesisHistoryLog(64, strings)};
+    const std::string tag = std::to_string(seed);
+    table.recordExposure(part.owner.id(), CatalystType::Resonance,
+                         "song" + tag, 0.25f, "chorus" + tag);
+    table.recordExposure(part.owner.id(), CatalystType::Stress, "heat", 0.5f);
+    table.recordExposure(part.owner.id(), CatalystType::Resonance,
+                         "song" + tag, 0.125f, "verse");
+    for (std::uint32_t i = 0; i < 5; ++i) {
+        SynthesisEvent event;
+        event.sourceForm = "form" + std::to_string(seed + i);
+        event.resultForm = "form" + std::to_string(seed + i + 1);
+        event.catalystType = CatalystType::Resonance;
+        event.catalystId = "song" + tag;
+        event.intensity = 0.1f * static_cast<float>(i);
+        event.stage = SynthesisStage::Forming;
+        event.affectedTraits.assign(i % 3, "trait" + tag);
+        event.timestamp = {seed * 100 + i * 7};
+        part.history.append(event);
+    }
+    return part;
+}
+
+std::string encodePart(const CatalystInfluenceTable &table,
+                       const SynthesisPart &part) {
+    std::string out;
+    crescent::io::putInfluences(out, table, part.owner.id());
+    crescent::io::putHistory(out, part.history);
+    return out;
+}
+
+SynthesisPart decodePart(std::string_view bytes, CatalystInfluenceTable &table,
+                         StringInterner &strings) {
+    CreatureReader reader(bytes);
+    SynthesisPart part{table.acquire(), SynthesisHistoryLog(1, strings)};
+    crescent::io::readInfluences(reader, table, part.owner.id());
+    part.history = crescent::io::readHistory(reader, strings);
+    if (!reader.atEnd()) {
+        throw std::runtime_error("Trailing bytes after synthesis part");
+    }
+    return part;
+}
+
+/**
+ * @brief Sends one creature to the other shard on tick 0, which sends
+ * it straight back on tick 1; the owner checks it came back unchanged
+ *
+ * Each shard fills its table and interner with other strings first, so
+ * ids differ between the processes.
+ */
+class RoundTripWorker final : public ShardWorker {
+  public:
+    explicit RoundTripWorker(std::uint32_t shard)
+        : shard_(shard), local_(makePart(table_, strings_, 1000 + shard)) {}
+
+    void step(SimTick tick, ShardOutbox &outbox) override {
+        const std::uint32_t peer = 1 - shard_;
+        if (tick.value == 0) {
+            SynthesisPart creature = makePart(table_, strings_, shard_);
+            sent_ = encodePart(table_, creature);
+            outbox.send(peer, crescent::io::encodeMigration(
+                                  tick, shard_, "elsewhere", sent_));
+        } else if (tick.value == 1) {
+            outbox.send(peer, crescent::io::encodeMigration(
+                                  tick, shard_, "home", returning_));
+        }
+    }
+
+    void admit(std::uint32_t fromShard, std::string_view payload) override {
+        const crescent::io::MigrationRecord record =
+            crescent::io::decodeMigration(payload);
+        if (record.fromShard != fromShard) {
+            throw std::runtime_error("Migration from the wrong shard");
+        }
+        const SynthesisPart arrived =
+            decodePart(record.creature, table_, strings_);
+        if (record.tick.value == 0) {
+            returning_ = encodePart(table_, arrived);
+            return;
+        }
+        if (encodePart(table_, arrived) != sent_) {
+            throw std::runtime_error("Creature changed on its round trip");
+        }
+        returned_ = true;
+    }
+
+    void finish() override {
+        if (!returned_) {
+            throw std::runtime_error("Creature never came back");
+        }
+    }
+
+  private:
+    std::uint32_t shard_;
+    CatalystInfluenceTable table_;
+    StringInterner strings_;
+    SynthesisPart local_;
+    std::string sent_;
+    std::string returning_;
+    bool returned_{false};
+};
+
+} // namespace
+
+TEST_CASE("Synthesis state travels as values, not process ids",
+          "[migration]") {
+    CatalystInfluenceTable sourceTable;
+    StringInterner sourceStrings;
+    const SynthesisPart source = makePart(sourceTable, sourceStrings, 7);
+    const std::string bytes = encodePart(sourceTable, source);
+
+    // The receiver already interned other strings, so ids do not line up
+    CatalystInfluenceTable targetTable;
+    StringInterner targetStrings;
+    const SynthesisPart other = makePart(targetTable, targetStrings, 8);
+    const SynthesisPart copy = decodePart(bytes, targetTable, targetStrings);
+
+    REQUIRE(encodePart(targetTable, copy) == bytes);
+    const auto influence =
+        targetTable.find(copy.owner.id(), CatalystType::Resonance, "song7");
+    REQUIRE(influence);
+    REQUIRE(influence->currentStrength == 0.375f);
+    REQUIRE(influence->exposureCount == 2);
+    REQUIRE(influence->affectedForms ==
+            std::vector<std::string>{"chorus7", "verse"});
+    REQUIRE(targetTable.countOf(other.owner.id()) == 2);
+
+    const std::vector<SynthesisEvent> events = copy.history.recent();
+    REQUIRE(events.size() == 5);
+    REQUIRE(events[3].sourceForm == "form10");
+    REQUIRE(events[3].intensity == source.history.at(3).intensity);
+    REQUIRE(events[3].stage == SynthesisStage::Forming);
+    REQUIRE(events[4].timestamp == SimTick{728});
+    REQUIRE(copy.history.maxEvents() == 64);
+}
+
+TEST_CASE("Corrupt synthesis values are rejected", "[migration]") {
+    std::string bytes;
+    crescent::io::CreatureCodec::putVarint(bytes, 1);  // One row
+    crescent::io::CreatureCodec::putVarint(bytes, 99); // No such type
+    CatalystInfluenceTable table;
+    const CatalystInfluenceTable::Owner owner = table.acquire();
+    CreatureReader reader(bytes);
+    REQUIRE_THROWS_AS(crescent::io::readInfluences(reader, table, owner.id()),
+                      crescent::SerializationException);
+
+    CatalystInfluenceTable source;
+    StringInterner strings;
+    const std::string whole = encodePart(source, makePart(source, strings, 1));
+    CreatureReader truncated(std::string_view(whole).substr(0, 20));
+    REQUIRE_THROWS_AS(
+        crescent::io::readInfluences(truncated, table, owner.id()),
+        crescent::SerializationException);
+}
+
+TEST_CASE("Two shards send creatures there and back", "[migration]") {
+    ProcessShardGroup::Config config;
+    config.shardCount = 2;
+    config.ringCapacity = 1 << 12;
+    config.tickCount = 2;
+    ProcessShardGroup group(config);
+
+    std::fflush(nullptr);
+    const ProcessShardGroup::Report report =
+        group.run([](std::uint32_t shard) -> std::unique_ptr<ShardWorker> {
+            return std::make_unique<RoundTripWorker>(shard);
+        });
+    for (const ProcessShardGroup::ShardReport &shard : report.shards) {
+        INFO("shard " << shard.shard << ": " << shard.error);
+        REQUIRE(shard.succeeded);
+        REQUIRE(shard.ticksCompleted == 2);
+        REQUIRE(shard.messagesSent == 2);
+        REQUIRE(shard.messagesReceived == 2);
+    }
+    REQUIRE(report.succeeded);
+}
+
+TEST_CASE("Shards are only forked from a single-threaded process",
+          "[migration]") {
+    ProcessShardGroup group(ProcessShardGroup::Config{});
+    std::promise<void> release;
+    std::thread other([done = release.get_future()]() mutable {
+        done.wait();
+    });
+    REQUIRE_THROWS_AS(group.run([](std::uint32_t shard) {
+        return std::make_unique<RoundTripWorker>(shard);
+    }),
+                      std::logic_error);
+    release.set_value();
+    other.join();
+}
@@ -0,0 +1,114 @@
+#include "creature_engine/traits/synthesis/SynthesisHistoryLog.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using crescent::common::SimTick;
+using crescent::common::StringInterner;
+using crescent::traits::CatalystType;
+using crescent::traits::SynthesisEvent;
+using crescent::traits::SynthesisHistoryLog;
+using crescent::traits::SynthesisStage;
+
+namespace {
+
+SynthesisEvent makeEvent(std::size_t i) {
+    SynthesisEvent event;
+    event.sourceForm = "form" + std::to_string(i);
+    event.resultForm = "form" + std::to_string(i + 1);
+    event.catalystType =
+        i % 3 == 0 ? CatalystType::Resonance : CatalystType::Stress;
+    event.catalystId = "catalyst" + std::to_string(i % 5);
+    event.intensity = 0.5f;
+    event.stage = SynthesisStage::None;
+    event.affectedTraits.assign(i % 3, "trait" + std::to_string(i));
+    // Mostly forward, sometimes backwards, sometimes a long jump
+    const std::uint32_t base = static_cast<std::uint32_t>(i * 7);
+    event.timestamp = {i % 11 == 0   ? base - 3
+                       : i % 17 == 0 ? base + 100000
+                                     : base};
+    return event;
+}
+
+void requireSame(const SynthesisEvent &actual, const SynthesisEvent &expected) {
+    REQUIRE(actual.sourceForm == expected.sourceForm);
+    REQUIRE(actual.resultForm == expected.resultForm);
+    REQUIRE(actual.catalystType == expected.catalystType);
+    REQUIRE(actual.catalystId == expected.catalystId);
+    REQUIRE(actual.affectedTraits == expected.affectedTraits);
+    REQUIRE(actual.timestamp == expected.timestamp);
+}
+
+} // namespace
+
+TEST_CASE("Recent events decode in order across checkpoints", "[history]") {
+    StringInterner strings;
+    SynthesisHistoryLog log(1000, strings);
+    for (std::size_t i = 0; i < 300; ++i) {
+        log.append(makeEvent(i));
+    }
+
+    const std::vector<SynthesisEvent> all = log.recent();
+    REQUIRE(all.size() == 300);
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        requireSame(all[i], makeEvent(i));
+        REQUIRE(log.timestampAt(i) == all[i].timestamp);
+    }
+
+    const std::vector<SynthesisEvent> last = log.recent(70);
+    REQUIRE(last.size() == 70);
+    requireSame(last.front(), makeEvent(230));
+
+    const std::vector<SynthesisEvent> resonance =
+        log.recent(0, CatalystType::Resonance);
+    REQUIRE(resonance.size() == log.countOf(CatalystType::Resonance));
+    for (std::size_t i = 0; i < resonance.size(); ++i) {
+        requireSame(resonance[i], makeEvent(i * 3));
+    }
+}
+
+TEST_CASE("Dropping old events keeps the newest and their times",
+          "[history]") {
+    StringInterner strings;
+    SynthesisHistoryLog log(100, strings);
+    for (std::size_t i = 0; i < 101; ++i) {
+        log.append(makeEvent(i));
+    }
+    REQUIRE(log.size() == 75);
+    const std::vector<SynthesisEvent> kept = log.recent();
+    for (std::size_t i = 0; i < kept.size(); ++i) {
+        requireSame(kept[i], makeEvent(26 + i));
+    }
+    for (std::uint32_t index : log.indicesOf(CatalystType::Resonance)) {
+        REQUIRE(log.at(index).catalystType == CatalystType::Resonance);
+    }
+}
+
+TEST_CASE("Logs release their interned strings", "[history]") {
+    StringInterner strings;
+    {
+        SynthesisHistoryLog log(100, strings);
+        for (std::size_t i = 0; i < 101; ++i) {
+            log.append(makeEvent(i));
+        }
+        // Forms of dropped events are gone; catalyst ids are still used
+        REQUIRE_FALSE(strings.find("form0"));
+        REQUIRE_FALSE(strings.find("trait25"));
+        REQUIRE(strings.find("form26"));
+        REQUIRE(strings.find("catalyst0"));
+
+        SynthesisHistoryLog copy = log;
+        log.clear();
+        REQUIRE(strings.find("form26"));
+        requireSame(copy.at(0), makeEvent(26));
+
+        SynthesisHistoryLog moved = std::move(copy);
+        requireSame(moved.at(0), makeEvent(26));
+    }
+    REQUIRE(strings.size() == 0);
+}
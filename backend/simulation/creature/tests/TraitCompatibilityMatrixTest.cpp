@@ -0,0 +1,197 @@
+#include "creature_engine/traits/validation/TraitCompatibilityMatrix.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+using crescent::traits::CompatibilityLevel;
+using crescent::traits::TraitCompatibilityMatrix;
+using crescent::traits::TraitIndex;
+using crescent::traits::TraitInteractionSet;
+
+namespace {
+
+CompatibilityLevel levelFor(std::size_t a, std::size_t b) {
+    switch ((a * 7 + b * 13 + a * b) % 9) {
+    case 0:
+        return CompatibilityLevel::Incompatible;
+    case 1:
+        return CompatibilityLevel::Synergistic;
+    case 2:
+        return CompatibilityLevel::Required;
+    default:
+        return CompatibilityLevel::Neutral;
+    }
+}
+
+TraitCompatibilityMatrix makeMatrix(std::size_t traits) {
+    TraitCompatibilityMatrix::Builder builder;
+    for (std::size_t i = 0; i < traits; ++i) {
+        builder.addTrait("trait" + std::to_string(i));
+    }
+    for (std::size_t a = 0; a < traits; ++a) {
+        for (std::size_t b = a + 1; b < traits; ++b) {
+            builder.set(static_cast<TraitIndex>(a), static_cast<TraitIndex>(b),
+                        levelFor(a, b));
+        }
+    }
+    return std::move(builder).build();
+}
+
+// Recounts everything from the active set alone
+struct Reference {
+    std::size_t incompatible{0};
+    std::size_t synergistic{0};
+    std::size_t unmet{0};
+    std::set<std::pair<TraitIndex, TraitIndex>> pairs;
+};
+
+Reference recount(const TraitCompatibilityMatrix &matrix,
+                  const std::set<TraitIndex> &active) {
+    Reference reference;
+    for (TraitIndex a : active) {
+        for (TraitIndex b = 0; b < matrix.traitCount(); ++b) {
+            const CompatibilityLevel level = matrix.level(a, b);
+            if (a == b || level == CompatibilityLevel::Neutral) {
+                continue;
+            }
+            if (!active.count(b)) {
+                reference.unmet += level == CompatibilityLevel::Required;
+                continue;
+            }
+            if (a > b) {
+                continue;
+            }
+            reference.pairs.emplace(a, b);
+            reference.incompatible += level == CompatibilityLevel::Incompatible;
+            reference.synergistic += level == CompatibilityLevel::Synergistic;
+        }
+    }
+    return reference;
+}
+
+} // namespace
+
+TEST_CASE("The compiled matrix answers pair levels symmetrically",
+          "[compatibility]") {
+    TraitCompatibilityMatrix::Builder builder;
+    builder.set("fire", "water", CompatibilityLevel::Incompatible);
+    builder.set("fire", "air", CompatibilityLevel::Synergistic);
+    builder.set("fire", "air", CompatibilityLevel::Required);
+    const TraitIndex earth = builder.addTrait("earth");
+    const TraitCompatibilityMatrix matrix = std::move(builder).build();
+
+    const TraitIndex fire = *matrix.indexOf("fire");
+    const TraitIndex water = *matrix.indexOf("water");
+    const TraitIndex air = *matrix.indexOf("air");
+    REQUIRE(matrix.traitCount() == 4);
+    REQUIRE(matrix.idOf(earth) == "earth");
+    REQUIRE_FALSE(matrix.indexOf("void"));
+
+    REQUIRE(matrix.level(fire, water) == CompatibilityLevel::Incompatible);
+    REQUIRE(matrix.level(water, fire) == CompatibilityLevel::Incompatible);
+    REQUIRE(matrix.level(air, fire) == CompatibilityLevel::Required);
+    REQUIRE(matrix.level(earth, fire) == CompatibilityLevel::Neutral);
+    REQUIRE(matrix.interactingPairCount() == 2);
+
+    const auto neighbors = matrix.neighbors(fire);
+    REQUIRE(neighbors.size() == 2);
+    REQUIRE(neighbors[0].other < neighbors[1].other);
+    REQUIRE(matrix.neighbors(earth).empty());
+}
+
+TEST_CASE("The builder rejects self and unknown pairs", "[compatibility]") {
+    TraitCompatibilityMatrix::Builder builder;
+    const TraitIndex a = builder.addTrait("a");
+    REQUIRE(builder.addTrait("a") == a);
+    REQUIRE_THROWS_AS(builder.set(a, a, CompatibilityLevel::Synergistic),
+                      std::out_of_range);
+    REQUIRE_THROWS_AS(builder.set(a, 5, CompatibilityLevel::Synergistic),
+                      std::out_of_range);
+}
+
+TEST_CASE("Interaction counts follow adds and removes", "[compatibility]") {
+    TraitCompatibilityMatrix::Builder builder;
+    builder.set("a", "b", CompatibilityLevel::Incompatible);
+    builder.set("a", "c", CompatibilityLevel::Required);
+    builder.set("b", "c", CompatibilityLevel::Synergistic);
+    const TraitCompatibilityMatrix matrix = std::move(builder).build();
+    const TraitIndex a = *matrix.indexOf("a");
+    const TraitIndex b = *matrix.indexOf("b");
+    const TraitIndex c = *matrix.indexOf("c");
+
+    TraitInteractionSet set(matrix);
+    REQUIRE(set.add(a));
+    REQUIRE_FALSE(set.add(a));
+    REQUIRE(set.unmetRequirements() == 1);
+    REQUIRE_FALSE(set.isConsistent());
+
+    REQUIRE(set.add(c));
+    REQUIRE(set.unmetRequirements() == 0);
+    REQUIRE(set.isConsistent());
+
+    REQUIRE(set.add(b));
+    REQUIRE(set.incompatibleCount() == 1);
+    REQUIRE(set.synergisticCount() == 1);
+    REQUIRE(set.pairs().size() == 3);
+
+    std::vector<TraitIndex> partners;
+    set.forEachPairOf(b, [&](TraitIndex partner, CompatibilityLevel) {
+        partners.push_back(partner);
+    });
+    REQUIRE(partners == std::vector<TraitIndex>{a, c});
+
+    REQUIRE(set.remove(a));
+    REQUIRE_FALSE(set.remove(a));
+    REQUIRE(set.incompatibleCount() == 0);
+    REQUIRE(set.synergisticCount() == 1);
+    REQUIRE(set.unmetRequirements() == 1); // c still requires a
+    REQUIRE(set.pairs().size() == 1);
+
+    partners.clear();
+    set.forEachPairOf(a, [&](TraitIndex partner, CompatibilityLevel) {
+        partners.push_back(partner);
+    });
+    REQUIRE(partners.empty());
+
+    set.clear();
+    REQUIRE(set.activeTraits().empty());
+    REQUIRE(set.pairs().empty());
+    REQUIRE(set.isConsistent());
+}
+
+TEST_CASE("Random adds and removes match a full recount", "[compatibility]") {
+    constexpr std::size_t TRAITS = 40;
+    const TraitCompatibilityMatrix matrix = makeMatrix(TRAITS);
+    TraitInteractionSet set(matrix);
+    std::set<TraitIndex> active;
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<TraitIndex> pick(0, TRAITS - 1);
+    for (int step = 0; step < 2000; ++step) {
+        const TraitIndex trait = pick(rng);
+        if (rng() % 2 == 0) {
+            REQUIRE(set.add(trait) == active.insert(trait).second);
+        } else {
+            REQUIRE(set.remove(trait) == (active.erase(trait) == 1));
+        }
+
+        const Reference reference = recount(matrix, active);
+        REQUIRE(set.incompatibleCount() == reference.incompatible);
+        REQUIRE(set.synergisticCount() == reference.synergistic);
+        REQUIRE(set.unmetRequirements() == reference.unmet);
+
+        std::set<std::pair<TraitIndex, TraitIndex>> pairs;
+        for (const auto &pair : set.pairs()) {
+            REQUIRE(pair.first < pair.second);
+            REQUIRE(pair.level == matrix.level(pair.first, pair.second));
+            pairs.emplace(pair.first, pair.second);
+        }
+        REQUIRE(pairs == reference.pairs);
+    }
+}
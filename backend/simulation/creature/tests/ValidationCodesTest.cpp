@@ -0,0 +1,57 @@
+#include "common/utils/ShardedSlotMap.h"
+#include "creature_engine/core/ValidationCodes.h"
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+using crescent::Violation;
+using crescent::ViolationCode;
+using crescent::ViolationSink;
+
+TEST_CASE("Standalone violations carry no subject", "[validation]") {
+    std::vector<Violation> out;
+    ViolationSink sink(out, Violation::NO_SUBJECT);
+    sink.report(ViolationCode::StressOutOfRange, 3);
+
+    REQUIRE(out.size() == 1);
+    REQUIRE_FALSE(out[0].hasSubject());
+    REQUIRE(out[0].detail == 3);
+}
+
+TEST_CASE("No registry handle packs to the standalone sentinel",
+          "[validation]") {
+    crescent::common::ShardedSlotMap<int, 2> slots;
+    const auto first = slots.insert(std::make_unique<int>(0), 0);
+    REQUIRE(first.index == 0);
+    REQUIRE(first.pack() != Violation::NO_SUBJECT);
+
+    std::vector<Violation> out;
+    ViolationSink sink(out, first.pack());
+    sink.report(ViolationCode::MissingIdentity);
+    REQUIRE(out[0].hasSubject());
+}
+
+TEST_CASE("Sinks store up to their limit", "[validation]") {
+    std::vector<Violation> out;
+    ViolationSink sink(out, Violation::NO_SUBJECT, 2);
+    REQUIRE(sink.clean());
+
+    sink.report(ViolationCode::TraitIncompatible, 1);
+    REQUIRE_FALSE(sink.full());
+    sink.report(ViolationCode::TraitIncompatible, 2);
+    REQUIRE(sink.full());
+    sink.report(ViolationCode::TraitIncompatible, 3);
+
+    REQUIRE(out.size() == 2);
+    REQUIRE(sink.count() == 3);
+}
+
+TEST_CASE("Every code has a name", "[validation]") {
+    for (std::size_t i = 0; i < crescent::VIOLATION_CODE_COUNT; ++i) {
+        const auto code = static_cast<ViolationCode>(i);
+        REQUIRE(std::string(crescent::violationCodeName(code)) != "Unknown");
+    }
+}
@@ -0,0 +1,301 @@
+#ifndef SIMULATION_ENVIRONMENT_CORE_SPATIAL_HASH_GRID_H
+#define SIMULATION_ENVIRONMENT_CORE_SPATIAL_HASH_GRID_H
+
+#include "common/utils/WorkerPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace crescent::environment {
+
+/**
+ * @brief Uniform grid over 2D points, wrapped so the world is unbounded
+ *
+ * Cells of side cellSize fold onto a power-of-two table of W x H buckets
+ * (cell (cx, cy) lands in bucket (cx mod W, cy mod H)), sized to the point
+ * count. Distant cells may alias, which distance checks filter out, while
+ * neighbouring cells stay in neighbouring buckets: a query row is one or
+ * two contiguous ranges, and visiting points in order() keeps successive
+ * queries on the same cache lines.
+ *
+ * A rebuild is a parallel counting sort: bucket ids and counts in one
+ * pass, a prefix sum, then a scatter into bucket order with each bucket
+ * sorted by point index so results do not depend on thread timing.
+ * Positions are copied into bucket order alongside.
+ *
+ * Pick cellSize close to the usual query radius; a radius query then reads
+ * three short rows. Queries are const and may run concurrently with each
+ * other, but not with rebuild().
+ */
+class SpatialHashGrid {
+  public:
+    static constexpr std::uint32_t NO_INDEX =
+        std::numeric_limits<std::uint32_t>::max();
+
+    struct Config {
+        float cellSize{1.0f};
+        std::size_t grain{4096}; // Points per parallel chunk
+    };
+
+    struct Neighbor {
+        std::uint32_t index;
+        float distanceSq;
+    };
+
+    explicit SpatialHashGrid(Config config) : config_(config) {
+        if (!(config.cellSize > 0.0f) || !std::isfinite(config.cellSize)) {
+            throw std::invalid_argument("Invalid spatial grid cell size");
+        }
+        invCellSize_ = 1.0f / config.cellSize;
+    }
+
+    // Prevent copying, allow moving
+    SpatialHashGrid(const SpatialHashGrid &) = delete;
+    SpatialHashGrid &operator=(const SpatialHashGrid &) = delete;
+    SpatialHashGrid(SpatialHashGrid &&) = default;
+    SpatialHashGrid &operator=(SpatialHashGrid &&) = default;
+
+    float cellSize() const { return config_.cellSize; }
+    std::size_t size() const { return order_.size(); }
+
+    /**
+     * @brief Re-indexes count points; index i refers to (xs[i], ys[i])
+     *
+     * Non-finite coordinates land in an edge cell and are never returned
+     * by queries with a finite origin and radius.
+     */
+    void rebuild(const float *xs, const float *ys, std::size_t count,
+                 common::WorkerPool *pool = nullptr) {
+        if (count >= NO_INDEX) {
+            throw std::length_error("Too many points for spatial grid");
+        }
+        widthBits_ = 2;
+        while ((std::size_t{1} << (2 * widthBits_)) < count) {
+            ++widthBits_;
+        }
+        const std::size_t buckets = std::size_t{1} << (2 * widthBits_);
+        reserveBuckets(buckets);
+        cellMask_ = (std::int32_t{1} << widthBits_) - 1;
+        bucketOf_.resize(count);
+        order_.resize(count);
+        sortedX_.resize(count);
+        sortedY_.resize(count);
+        bucketStart_.assign(buckets + 1, 0);
+        for (std::size_t b = 0; b < buckets; ++b) {
+            counters_[b].store(0, std::memory_order_relaxed);
+        }
+
+        forEachChunk(pool, count, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint32_t bucket =
+                    bucketFor(cellCoord(xs[i]), cellCoord(ys[i]));
+                bucketOf_[i] = bucket;
+                counters_[bucket].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+        std::uint32_t offset = 0;
+        for (std::size_t b = 0; b < buckets; ++b) {
+            bucketStart_[b] = offset;
+            offset += counters_[b].load(std::memory_order_relaxed);
+            counters_[b].store(bucketStart_[b], std::memory_order_relaxed);
+        }
+        bucketStart_[buckets] = offset;
+
+        forEachChunk(pool, count, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint32_t slot = counters_[bucketOf_[i]].fetch_add(
+                    1, std::memory_order_relaxed);
+                order_[slot] = static_cast<std::uint32_t>(i);
+            }
+        });
+        // Buckets hold about one point each, so sorting them is cheap
+        forEachChunk(pool, buckets, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t b = begin; b < end; ++b) {
+                const std::uint32_t first = bucketStart_[b];
+                const std::uint32_t last = bucketStart_[b + 1];
+                std::sort(order_.begin() + first, order_.begin() + last);
+                for (std::uint32_t p = first; p < last; ++p) {
+                    sortedX_[p] = xs[order_[p]];
+                    sortedY_[p] = ys[order_[p]];
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Visits points within radius as fn(index, distanceSq)
+     *
+     * Buckets are visited once each, so every point is reported once.
+     */
+    template <typename Fn>
+    void forEachWithin(float x, float y, float radius, Fn &&fn) const {
+        if (order_.empty() || !(radius >= 0.0f)) {
+            return;
+        }
+        const float radiusSq = radius * radius;
+        const auto visit = [&](std::uint32_t first, std::uint32_t last) {
+            for (std::uint32_t p = first; p < last; ++p) {
+                const float dx = sortedX_[p] - x;
+                const float dy = sortedY_[p] - y;
+                const float distanceSq = dx * dx + dy * dy;
+                if (distanceSq <= radiusSq) {
+                    fn(order_[p], distanceSq);
+                }
+            }
+        };
+        const std::int32_t cx0 = cellCoord(x - radius);
+        const std::int32_t cy0 = cellCoord(y - radius);
+        const std::int32_t side = cellMask_ + 1;
+        // Past one table width the columns (or rows) repeat; visit each once
+        const std::int32_t columns =
+            static_cast<std::int32_t>(std::min<std::int64_t>(
+                std::int64_t{cellCoord(x + radius)} - cx0 + 1, side));
+        const std::int32_t rows =
+            static_cast<std::int32_t>(std::min<std::int64_t>(
+                std::int64_t{cellCoord(y + radius)} - cy0 + 1, side));
+        const std::int32_t firstColumn = cx0 & cellMask_;
+        const std::int32_t wrapped =
+            std::max(firstColumn + columns - side, std::int32_t{0});
+        for (std::int32_t r = 0; r < rows; ++r) {
+            const std::uint32_t row =
+                static_cast<std::uint32_t>((cy0 + r) & cellMask_)
+                << widthBits_;
+            const std::uint32_t first =
+                row + static_cast<std::uint32_t>(firstColumn);
+            visit(bucketStart_[first],
+                  bucketStart_[first + static_cast<std::uint32_t>(
+                                           columns - wrapped)]);
+            if (wrapped > 0) {
+                visit(bucketStart_[row],
+                      bucketStart_[row + static_cast<std::uint32_t>(wrapped)]);
+            }
+        }
+    }
+
+    /**
+     * @brief Up to k nearest points within maxRadius, nearest first
+     *
+     * The search radius starts at one cell and doubles until k points are
+     * inside it, so dense regions stay cheap. Ties break by index. out is
+     * cleared and reused as the working heap, so passing the same vector
+     * across queries avoids allocation.
+     */
+    void nearest(float x, float y, std::size_t k, std::vector<Neighbor> &out,
+                 float maxRadius = std::numeric_limits<float>::infinity(),
+                 std::uint32_t exclude = NO_INDEX) const {
+        out.clear();
+        if (k == 0 || order_.empty() || !(maxRadius >= 0.0f)) {
+            return;
+        }
+        const auto closer = [](const Neighbor &a, const Neighbor &b) {
+            if (a.distanceSq != b.distanceSq) {
+                return a.distanceSq < b.distanceSq;
+            }
+            return a.index < b.index;
+        };
+        const std::size_t available =
+            order_.size() - (exclude < order_.size() ? 1 : 0);
+        float radius = std::min(config_.cellSize, maxRadius);
+        for (;;) {
+            out.clear();
+            forEachWithin(x, y, radius,
+                          [&](std::uint32_t index, float distanceSq) {
+                if (index == exclude) {
+                    return;
+                }
+                const Neighbor candidate{index, distanceSq};
+                if (out.size() < k) {
+                    out.push_back(candidate);
+                    std::push_heap(out.begin(), out.end(), closer);
+                } else if (closer(candidate, out.front())) {
+                    std::pop_heap(out.begin(), out.end(), closer);
+                    out.back() = candidate;
+                    std::push_heap(out.begin(), out.end(), closer);
+                }
+            });
+            if (out.size() == k || out.size() == available ||
+                radius >= maxRadius) {
+                break;
+            }
+            radius = std::min(radius * 2.0f, maxRadius);
+        }
+        std::sort_heap(out.begin(), out.end(), closer);
+    }
+
+    /**
+     * @brief Point indices in bucket order
+     *
+     * Issuing per-point queries in this order keeps neighbouring queries
+     * on the same buckets, which is much cheaper than index order.
+     */
+    const std::vector<std::uint32_t> &order() const { return order_; }
+
+    std::size_t getMemoryFootprint() const {
+        return bucketOf_.capacity() * sizeof(std::uint32_t) +
+               order_.capacity() * sizeof(std::uint32_t) +
+               (sortedX_.capacity() + sortedY_.capacity()) * sizeof(float) +
+               bucketStart_.capacity() * sizeof(std::uint32_t) +
+               counterCapacity_ * sizeof(std::atomic<std::uint32_t>);
+    }
+
+  private:
+    Config config_;
+    float invCellSize_{1.0f};
+    unsigned widthBits_{0};    // Table is 2^widthBits_ buckets square
+    std::int32_t cellMask_{0}; // 2^widthBits_ - 1
+
+    std::vector<std::uint32_t> bucketOf_;    // By point index
+    std::vector<std::uint32_t> order_;       // Point indices, bucket order
+    std::vector<float> sortedX_;             // Positions, bucket order
+    std::vector<float> sortedY_;
+    std::vector<std::uint32_t> bucketStart_; // Size buckets + 1
+
+    // Counts, then scatter cursors, during rebuild
+    std::unique_ptr<std::atomic<std::uint32_t>[]> counters_;
+    std::size_t counterCapacity_{0};
+
+    std::int32_t cellCoord(float v) const {
+        // Clamp before converting; NaN falls to the low edge
+        constexpr float LIMIT = 1073741824.0f; // 2^30
+        const float cell = std::floor(v * invCellSize_);
+        if (!(cell > -LIMIT)) {
+            return -(1 << 30);
+        }
+        return static_cast<std::int32_t>(std::min(cell, LIMIT));
+    }
+
+    std::uint32_t bucketFor(std::int32_t cx, std::int32_t cy) const {
+        return (static_cast<std::uint32_t>(cy & cellMask_) << widthBits_) |
+               static_cast<std::uint32_t>(cx & cellMask_);
+    }
+
+    void reserveBuckets(std::size_t buckets) {
+        if (buckets > counterCapacity_) {
+            counters_ = std::make_unique<std::atomic<std::uint32_t>[]>(buckets);
+            counterCapacity_ = buckets;
+        }
+    }
+
+    template <typename Fn>
+    void forEachChunk(common::WorkerPool *pool, std::size_t count,
+                      Fn &&fn) const {
+        if (!pool) {
+            fn(std::size_t{0}, count);
+            return;
+        }
+        pool->forEachChunk(count, config_.grain,
+                           [&](std::size_t begin, std::size_t end,
+                               std::size_t) { fn(begin, end); });
+    }
+};
+
+} // namespace crescent::environment
+
+#endif // SIMULATION_ENVIRONMENT_CORE_SPATIAL_HASH_GRID_H
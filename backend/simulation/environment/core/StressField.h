@@ -0,0 +1,284 @@
+#ifndef SIMULATION_ENVIRONMENT_CORE_STRESS_FIELD_H
+#define SIMULATION_ENVIRONMENT_CORE_STRESS_FIELD_H
+
+#include "common/utils/WorkerPool.h"
+#include "environment/core/StressSample.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace crescent::environment {
+
+/**
+ * @brief How a biome treats one stressor channel
+ *
+ * Each tick a cell relaxes toward equilibrium at decayRate (per second)
+ * and gains sourceRate (per second) on top.
+ */
+struct BiomeChannelParams {
+    float equilibrium{0.0f};
+    float decayRate{0.0f};
+    float sourceRate{0.0f};
+};
+
+/**
+ * @brief Stressor concentrations over a 2D grid of biomes
+ *
+ * Each channel (heat, toxicity, pressure, ...) is a dense float plane,
+ * double buffered. A step runs explicit diffusion plus per-biome decay and
+ * sources with zero-flux edges; the row kernel is branch-free over the
+ * interior so it auto-vectorizes. Rows are split into tiles run on a
+ * common::WorkerPool, and reading only the previous buffer means tiles
+ * need no halo exchange.
+ *
+ * step() and the sampling methods must not run concurrently.
+ */
+class StressField {
+  public:
+    static constexpr std::size_t MAX_BIOMES = 256;
+
+    struct Config {
+        std::size_t width{0};
+        std::size_t height{0};
+        std::size_t channels{1};    // At most StressSample::MAX_CHANNELS
+        std::size_t workerCount{0}; // 0 = hardware concurrency
+        std::size_t rowsPerTile{32};
+    };
+
+    explicit StressField(Config config)
+        : config_(validate(config)), cellCount_(config.width * config.height),
+          biomes_(cellCount_, 0), diffusion_(config.channels, 0.0f),
+          biomeParams_(config.channels), pool_(config.workerCount) {
+        for (auto &buffers : planes_) {
+            buffers.assign(config.channels,
+                           std::vector<float>(cellCount_, 0.0f));
+        }
+        // Per-worker row coefficients, sized once
+        scratch_.resize(pool_.size());
+        for (RowScratch &scratch : scratch_) {
+            scratch.keep.resize(config.width);
+            scratch.add.resize(config.width);
+        }
+    }
+
+    // Prevent copying and moving
+    StressField(const StressField &) = delete;
+    StressField &operator=(const StressField &) = delete;
+    StressField(StressField &&) = delete;
+    StressField &operator=(StressField &&) = delete;
+
+    std::size_t width() const { return config_.width; }
+    std::size_t height() const { return config_.height; }
+    std::size_t channels() const { return config_.channels; }
+
+    // Configuration; call between steps
+    void setBiome(std::size_t x, std::size_t y, BiomeId biome) {
+        biomes_[index(x, y)] = biome;
+    }
+    /**
+     * @brief Sets every cell in [x0, x1) x [y0, y1)
+     * @throws std::invalid_argument if x1 < x0 or y1 < y0
+     * @throws std::out_of_range if the rectangle leaves the grid
+     */
+    void fillBiome(std::size_t x0, std::size_t y0, std::size_t x1,
+                   std::size_t y1, BiomeId biome) {
+        if (x1 < x0 || y1 < y0) {
+            throw std::invalid_argument("Inverted biome rectangle");
+        }
+        if (x1 > config_.width || y1 > config_.height) {
+            throw std::out_of_range("Biome rectangle outside the field");
+        }
+        for (std::size_t y = y0; y < y1; ++y) {
+            std::fill_n(biomes_.data() + index(x0, y), x1 - x0, biome);
+        }
+    }
+    BiomeId getBiome(std::size_t x, std::size_t y) const {
+        return biomes_[index(x, y)];
+    }
+
+    /**
+     * @brief Diffusion coefficient in cells^2 per second
+     *
+     * The explicit scheme is clamped to its stability limit per step.
+     */
+    void setDiffusion(std::size_t channel, float coefficient) {
+        diffusion_[channel] = coefficient;
+    }
+    void setBiomeParams(BiomeId biome, std::size_t channel,
+                        BiomeChannelParams params) {
+        biomeParams_[channel][biome] = params;
+    }
+
+    /**
+     * @brief Adds an amount to one cell, e.g. a local event
+     */
+    void inject(std::size_t x, std::size_t y, std::size_t channel,
+                float amount) {
+        float &cell = current(channel)[index(x, y)];
+        cell = std::max(0.0f, cell + amount);
+    }
+
+    /**
+     * @brief Advances every channel by dt seconds
+     */
+    void step(float dt) {
+        for (std::size_t c = 0; c < config_.channels; ++c) {
+            ChannelStep &params = channelSteps_[c];
+            params.diffusion = std::min(diffusion_[c] * dt, 0.25f);
+            for (std::size_t b = 0; b < MAX_BIOMES; ++b) {
+                const BiomeChannelParams &biome = biomeParams_[c][b];
+                // v' = v * keep + add, keep = 1 - decay*dt
+                const float decay = std::min(biome.decayRate * dt, 1.0f);
+                params.keep[b] = 1.0f - decay;
+                params.add[b] =
+                    decay * biome.equilibrium + biome.sourceRate * dt;
+            }
+        }
+        pool_.forEachChunk(
+            config_.height, config_.rowsPerTile,
+            [this](std::size_t first, std::size_t last, std::size_t worker) {
+                RowScratch &scratch = scratch_[worker];
+                for (std::size_t c = 0; c < config_.channels; ++c) {
+                    for (std::size_t y = first; y < last; ++y) {
+                        stepRow(c, y, scratch.keep.data(), scratch.add.data());
+                    }
+                }
+            });
+        front_ ^= 1;
+    }
+
+    float value(std::size_t x, std::size_t y, std::size_t channel) const {
+        return current(channel)[index(x, y)];
+    }
+
+    StressSample sample(std::size_t x, std::size_t y) const {
+        StressSample out;
+        const std::size_t cell = index(std::min(x, config_.width - 1),
+                                       std::min(y, config_.height - 1));
+        out.channelCount = static_cast<std::uint8_t>(config_.channels);
+        out.biome = biomes_[cell];
+        for (std::size_t c = 0; c < config_.channels; ++c) {
+            out.values[c] = current(c)[cell];
+        }
+        return out;
+    }
+
+    /**
+     * @brief Samples many positions (in cell units) at once
+     */
+    void sampleMany(const float *xs, const float *ys, std::size_t count,
+                    StressSample *out) const {
+        const float maxX = static_cast<float>(config_.width - 1);
+        const float maxY = static_cast<float>(config_.height - 1);
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = sample(
+                static_cast<std::size_t>(std::clamp(xs[i], 0.0f, maxX)),
+                static_cast<std::size_t>(std::clamp(ys[i], 0.0f, maxY)));
+        }
+    }
+
+    /**
+     * @brief Read-only plane for a channel, row-major
+     */
+    const float *data(std::size_t channel) const {
+        return current(channel).data();
+    }
+
+    std::size_t getMemoryFootprint() const {
+        return cellCount_ * (sizeof(float) * 2 * config_.channels +
+                             sizeof(BiomeId));
+    }
+
+  private:
+    struct ChannelStep {
+        float diffusion{0.0f};
+        std::array<float, MAX_BIOMES> keep{};
+        std::array<float, MAX_BIOMES> add{};
+    };
+
+    // Per-row biome coefficients, gathered once per row so the stencil
+    // loop reads only contiguous floats
+    struct RowScratch {
+        std::vector<float> keep;
+        std::vector<float> add;
+    };
+
+    Config config_;
+    std::size_t cellCount_;
+    std::vector<BiomeId> biomes_;
+    std::vector<float> diffusion_;
+    std::vector<std::array<BiomeChannelParams, MAX_BIOMES>> biomeParams_;
+    std::array<ChannelStep, StressSample::MAX_CHANNELS> channelSteps_{};
+
+    // planes_[buffer][channel]; front_ selects the current buffer
+    std::array<std::vector<std::vector<float>>, 2> planes_;
+    unsigned front_{0};
+
+    // Tile scheduling; scratch_ is indexed by pool worker
+    common::WorkerPool pool_;
+    std::vector<RowScratch> scratch_;
+
+    static Config validate(Config config) {
+        if (config.width < 2 || config.height < 2 || config.channels == 0 ||
+            config.channels > StressSample::MAX_CHANNELS ||
+            config.rowsPerTile == 0) {
+            throw std::invalid_argument("Invalid stress field dimensions");
+        }
+        return config;
+    }
+
+    std::size_t index(std::size_t x, std::size_t y) const {
+        return y * config_.width + x;
+    }
+    const std::vector<float> &current(std::size_t channel) const {
+        return planes_[front_][channel];
+    }
+    std::vector<float> &current(std::size_t channel) {
+        return planes_[front_][channel];
+    }
+
+    void stepRow(std::size_t channel, std::size_t y, float *rowKeep,
+                 float *rowAdd) {
+        const std::size_t w = config_.width;
+        const float *src = planes_[front_][channel].data();
+        float *dst = planes_[front_ ^ 1][channel].data();
+        const float *mid = src + y * w;
+        const float *up = y > 0 ? mid - w : mid; // Zero-flux edges
+        const float *down = y + 1 < config_.height ? mid + w : mid;
+        const BiomeId *biome = biomes_.data() + y * w;
+        float *out = dst + y * w;
+        const ChannelStep &params = channelSteps_[channel];
+        const float d = params.diffusion;
+        const float *keep = params.keep.data();
+        const float *add = params.add.data();
+
+        for (std::size_t x = 0; x < w; ++x) {
+            rowKeep[x] = keep[biome[x]];
+            rowAdd[x] = add[biome[x]];
+        }
+        // Interior: contiguous loads only, so this loop vectorizes
+        for (std::size_t x = 1; x + 1 < w; ++x) {
+            const float lap =
+                up[x] + down[x] + mid[x - 1] + mid[x + 1] - 4.0f * mid[x];
+            const float v = (mid[x] + d * lap) * rowKeep[x] + rowAdd[x];
+            out[x] = std::max(v, 0.0f);
+        }
+        // Edges mirror the missing neighbour
+        const std::size_t last = w - 1;
+        const float lapFirst = up[0] + down[0] + mid[1] - 3.0f * mid[0];
+        const float lapLast =
+            up[last] + down[last] + mid[last - 1] - 3.0f * mid[last];
+        out[0] = std::max((mid[0] + d * lapFirst) * rowKeep[0] + rowAdd[0],
+                          0.0f);
+        out[last] = std::max(
+            (mid[last] + d * lapLast) * rowKeep[last] + rowAdd[last], 0.0f);
+    }
+};
+
+} // namespace crescent::environment
+
+#endif // SIMULATION_ENVIRONMENT_CORE_STRESS_FIELD_H
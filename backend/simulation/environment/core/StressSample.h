@@ -0,0 +1,28 @@
+#ifndef SIMULATION_ENVIRONMENT_CORE_STRESS_SAMPLE_H
+#define SIMULATION_ENVIRONMENT_CORE_STRESS_SAMPLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace crescent::environment {
+
+/**
+ * @brief Index into the biome table; one per grid cell
+ */
+using BiomeId = std::uint8_t;
+
+/**
+ * @brief Stress values read from one cell, handed to a creature
+ */
+struct StressSample {
+    static constexpr std::size_t MAX_CHANNELS = 8;
+
+    std::array<float, MAX_CHANNELS> values{};
+    std::uint8_t channelCount{0};
+    BiomeId biome{0};
+};
+
+} // namespace crescent::environment
+
+#endif // SIMULATION_ENVIRONMENT_CORE_STRESS_SAMPLE_H
@@ -0,0 +1,142 @@
+#include "environment/core/SpatialHashGrid.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using crescent::common::WorkerPool;
+using crescent::environment::SpatialHashGrid;
+
+namespace {
+
+struct Points {
+    std::vector<float> xs;
+    std::vector<float> ys;
+};
+
+Points randomPoints(std::size_t count, float extent, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> coordinate(-extent, extent);
+    Points points;
+    for (std::size_t i = 0; i < count; ++i) {
+        points.xs.push_back(coordinate(rng));
+        points.ys.push_back(coordinate(rng));
+    }
+    return points;
+}
+
+std::vector<std::uint32_t> bruteWithin(const Points &points, float x, float y,
+                                       float radius) {
+    std::vector<std::uint32_t> out;
+    for (std::size_t i = 0; i < points.xs.size(); ++i) {
+        const float dx = points.xs[i] - x;
+        const float dy = points.ys[i] - y;
+        if (dx * dx + dy * dy <= radius * radius) {
+            out.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+    return out;
+}
+
+std::vector<std::uint32_t> gridWithin(const SpatialHashGrid &grid, float x,
+                                      float y, float radius) {
+    std::vector<std::uint32_t> out;
+    grid.forEachWithin(x, y, radius, [&](std::uint32_t index, float) {
+        out.push_back(index);
+    });
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+} // namespace
+
+TEST_CASE("Radius queries match a brute-force scan", "[spatial_grid]") {
+    const Points points = randomPoints(2000, 50.0f, 1);
+    WorkerPool pool(3);
+    SpatialHashGrid grid({2.0f, 128});
+    grid.rebuild(points.xs.data(), points.ys.data(), points.xs.size(), &pool);
+    REQUIRE(grid.size() == 2000);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> coordinate(-60.0f, 60.0f);
+    std::uniform_real_distribution<float> radius(0.0f, 12.0f);
+    for (int q = 0; q < 200; ++q) {
+        const float x = coordinate(rng);
+        const float y = coordinate(rng);
+        const float r = radius(rng);
+        REQUIRE(gridWithin(grid, x, y, r) == bruteWithin(points, x, y, r));
+    }
+}
+
+TEST_CASE("Radii wider than the table visit each bucket once",
+          "[spatial_grid]") {
+    const Points points = randomPoints(50, 1000.0f, 3);
+    SpatialHashGrid grid({1.0f, 4096});
+    grid.rebuild(points.xs.data(), points.ys.data(), points.xs.size());
+    REQUIRE(gridWithin(grid, 0.0f, 0.0f, 5000.0f) ==
+            bruteWithin(points, 0.0f, 0.0f, 5000.0f));
+    REQUIRE(gridWithin(grid, 3.5f, -7.0f, 40.0f) ==
+            bruteWithin(points, 3.5f, -7.0f, 40.0f));
+}
+
+TEST_CASE("Rebuilds with and without a pool agree", "[spatial_grid]") {
+    const Points points = randomPoints(5000, 30.0f, 4);
+    WorkerPool pool(4);
+    SpatialHashGrid serial({1.5f, 256});
+    SpatialHashGrid parallel({1.5f, 256});
+    serial.rebuild(points.xs.data(), points.ys.data(), points.xs.size());
+    parallel.rebuild(points.xs.data(), points.ys.data(), points.xs.size(),
+                     &pool);
+    REQUIRE(serial.order() == parallel.order());
+}
+
+TEST_CASE("Nearest returns the k closest, ties by index", "[spatial_grid]") {
+    const Points points = randomPoints(1000, 20.0f, 5);
+    SpatialHashGrid grid({1.0f, 4096});
+    grid.rebuild(points.xs.data(), points.ys.data(), points.xs.size());
+
+    std::vector<SpatialHashGrid::Neighbor> found;
+    for (std::uint32_t self = 0; self < 1000; self += 37) {
+        const float x = points.xs[self];
+        const float y = points.ys[self];
+        grid.nearest(x, y, 8, found, std::numeric_limits<float>::infinity(),
+                     self);
+        std::vector<std::pair<float, std::uint32_t>> expected;
+        for (std::uint32_t i = 0; i < 1000; ++i) {
+            if (i == self) {
+                continue;
+            }
+            const float dx = points.xs[i] - x;
+            const float dy = points.ys[i] - y;
+            expected.emplace_back(dx * dx + dy * dy, i);
+        }
+        std::sort(expected.begin(), expected.end());
+        REQUIRE(found.size() == 8);
+        for (std::size_t n = 0; n < found.size(); ++n) {
+            REQUIRE(found[n].index == expected[n].second);
+            REQUIRE(found[n].distanceSq == expected[n].first);
+        }
+    }
+
+    grid.nearest(0.0f, 0.0f, 5000, found);
+    REQUIRE(found.size() == 1000);
+    grid.nearest(100.0f, 100.0f, 3, found, 10.0f);
+    REQUIRE(found.empty());
+}
+
+TEST_CASE("Non-finite points are never returned", "[spatial_grid]") {
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    const std::vector<float> xs{0.0f, nan, inf, 1.0f};
+    const std::vector<float> ys{0.0f, 0.0f, 0.0f, nan};
+    SpatialHashGrid grid({1.0f, 4096});
+    grid.rebuild(xs.data(), ys.data(), xs.size());
+    REQUIRE(gridWithin(grid, 0.0f, 0.0f, 100.0f) ==
+            std::vector<std::uint32_t>{0});
+}
@@ -0,0 +1,123 @@
+#include "environment/core/StressField.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using crescent::environment::BiomeChannelParams;
+using crescent::environment::StressField;
+
+namespace {
+
+StressField::Config fieldConfig(std::size_t workers) {
+    StressField::Config config;
+    config.width = 37;
+    config.height = 29;
+    config.channels = 2;
+    config.workerCount = workers;
+    config.rowsPerTile = 4;
+    return config;
+}
+
+double total(const StressField &field, std::size_t channel) {
+    double sum = 0.0;
+    const float *plane = field.data(channel);
+    for (std::size_t i = 0; i < field.width() * field.height(); ++i) {
+        sum += static_cast<double>(plane[i]);
+    }
+    return sum;
+}
+
+} // namespace
+
+TEST_CASE("Invalid dimensions are rejected", "[stress_field]") {
+    StressField::Config config = fieldConfig(1);
+    config.width = 1;
+    REQUIRE_THROWS_AS(StressField(config), std::invalid_argument);
+    config = fieldConfig(1);
+    config.channels = 0;
+    REQUIRE_THROWS_AS(StressField(config), std::invalid_argument);
+    config = fieldConfig(1);
+    config.rowsPerTile = 0;
+    REQUIRE_THROWS_AS(StressField(config), std::invalid_argument);
+}
+
+TEST_CASE("fillBiome checks bounds and ordering", "[stress_field]") {
+    StressField field(fieldConfig(1));
+    field.fillBiome(2, 3, 10, 8, 4);
+    REQUIRE(field.getBiome(2, 3) == 4);
+    REQUIRE(field.getBiome(9, 7) == 4);
+    REQUIRE(field.getBiome(10, 7) == 0);
+    REQUIRE(field.getBiome(9, 8) == 0);
+    REQUIRE(field.getBiome(1, 3) == 0);
+
+    field.fillBiome(0, 0, field.width(), field.height(), 1);
+    REQUIRE(field.getBiome(field.width() - 1, field.height() - 1) == 1);
+    field.fillBiome(5, 5, 5, 9, 2); // Empty rectangle
+    REQUIRE(field.getBiome(5, 5) == 1);
+
+    REQUIRE_THROWS_AS(field.fillBiome(5, 0, 4, 1, 3), std::invalid_argument);
+    REQUIRE_THROWS_AS(field.fillBiome(0, 5, 1, 4, 3), std::invalid_argument);
+    REQUIRE_THROWS_AS(field.fillBiome(0, 0, field.width() + 1, 1, 3),
+                      std::out_of_range);
+    REQUIRE_THROWS_AS(field.fillBiome(0, 0, 1, field.height() + 1, 3),
+                      std::out_of_range);
+}
+
+TEST_CASE("Diffusion conserves mass with zero-flux edges", "[stress_field]") {
+    StressField field(fieldConfig(2));
+    field.setDiffusion(0, 1.0f);
+    field.inject(0, 0, 0, 100.0f);
+    field.inject(18, 14, 0, 50.0f);
+    for (int i = 0; i < 50; ++i) {
+        field.step(0.1f);
+    }
+    REQUIRE(total(field, 0) == Approx(150.0).epsilon(1e-4));
+    REQUIRE(field.value(1, 0, 0) > 0.0f);
+    REQUIRE(field.value(18, 14, 0) < 50.0f);
+    // Symmetric spread around an interior source, to rounding
+    REQUIRE(field.value(17, 14, 0) == Approx(field.value(19, 14, 0)));
+    REQUIRE(field.value(18, 13, 0) == Approx(field.value(18, 15, 0)));
+}
+
+TEST_CASE("Biomes relax toward their equilibrium", "[stress_field]") {
+    StressField field(fieldConfig(1));
+    field.fillBiome(0, 0, 10, field.height(), 3);
+    field.setBiomeParams(3, 1, BiomeChannelParams{5.0f, 2.0f, 0.0f});
+    for (int i = 0; i < 200; ++i) {
+        field.step(0.05f);
+    }
+    REQUIRE(field.value(4, 10, 1) == Approx(5.0f).epsilon(1e-3));
+    REQUIRE(field.value(30, 10, 1) == 0.0f);
+    REQUIRE(field.value(4, 10, 0) == 0.0f);
+
+    const auto sample = field.sample(4, 10);
+    REQUIRE(sample.channelCount == 2);
+    REQUIRE(sample.biome == 3);
+    REQUIRE(sample.values[1] == field.value(4, 10, 1));
+}
+
+TEST_CASE("Results do not depend on the worker count", "[stress_field]") {
+    std::vector<float> planes[2];
+    const std::size_t workerCounts[] = {1, 4};
+    for (std::size_t run = 0; run < 2; ++run) {
+        StressField field(fieldConfig(workerCounts[run]));
+        field.fillBiome(0, 0, 20, 15, 1);
+        field.setDiffusion(0, 0.8f);
+        field.setDiffusion(1, 0.3f);
+        field.setBiomeParams(1, 0, BiomeChannelParams{2.0f, 0.5f, 0.1f});
+        field.setBiomeParams(0, 1, BiomeChannelParams{0.0f, 0.2f, 0.3f});
+        field.inject(30, 20, 0, 40.0f);
+        for (int i = 0; i < 25; ++i) {
+            field.step(0.1f);
+        }
+        for (std::size_t c = 0; c < field.channels(); ++c) {
+            const float *plane = field.data(c);
+            planes[run].insert(planes[run].end(), plane,
+                               plane + field.width() * field.height());
+        }
+    }
+    REQUIRE(planes[0] == planes[1]);
+}
@@ -0,0 +1,28 @@
+# Engine headers include each other by module path ("common/utils/...",
+# "environment/core/...", "creature_engine/<dir>/...", "api/..."), which
+# does not match the source layout. crescent_stage_engine_headers() builds
+# that layout under <destination> as links into the source tree.
+function(crescent_stage_engine_headers root destination)
+    set(simulation "${root}/backend/simulation")
+    file(MAKE_DIRECTORY "${destination}/creature_engine/traits/base")
+    file(CREATE_LINK "${simulation}/common/include"
+         "${destination}/common" SYMBOLIC)
+    file(CREATE_LINK "${simulation}/environment"
+         "${destination}/environment" SYMBOLIC)
+    file(CREATE_LINK "${root}/backend/api/include"
+         "${destination}/api" SYMBOLIC)
+    foreach(module core io stress)
+        file(CREATE_LINK "${simulation}/creature/include/${module}"
+             "${destination}/creature_engine/${module}" SYMBOLIC)
+    endforeach()
+    foreach(module processors state synthesis validation)
+        file(CREATE_LINK "${simulation}/creature/include/traits/${module}"
+             "${destination}/creature_engine/traits/${module}" SYMBOLIC)
+    endforeach()
+    file(GLOB trait_base_headers "${simulation}/creature/include/traits/*.hpp")
+    foreach(header ${trait_base_headers})
+        get_filename_component(name "${header}" NAME_WE)
+        file(CREATE_LINK "${header}"
+             "${destination}/creature_engine/traits/base/${name}.h" SYMBOLIC)
+    endforeach()
+endfunction()
@@ -0,0 +1,124 @@
+// Bytes per creature held by the per-creature maps, SmallFlatMap against
+// the std::unordered_map they replaced. Heap use is measured by counting
+// live allocations; the inline part is sizeof the container.
+//
+// CreatureCore and the trait, ability and synthesis states have no
+// definitions in the header-only build, so this models a creature by its
+// maps: trait divergence keyed by trait id, and one influence map per
+// ability. Both hold string -> float, as in CreatureCore and AbilityState.
+
+#include "common/utils/SmallFlatMap.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+std::size_t liveBytes = 0;
+
+// Each block carries its size so the unsized delete can account for it
+constexpr std::size_t HEADER = alignof(std::max_align_t);
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    auto *block = static_cast<unsigned char *>(std::malloc(size + HEADER));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    *reinterpret_cast<std::size_t *>(block) = size;
+    liveBytes += size;
+    return block + HEADER;
+}
+
+void operator delete(void *pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    unsigned char *block = static_cast<unsigned char *>(pointer) - HEADER;
+    liveBytes -= *reinterpret_cast<std::size_t *>(block);
+    std::free(block);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
+
+namespace {
+
+using FlatDivergence = crescent::common::SmallFlatMap<std::string, float, 8>;
+using FlatInfluences = crescent::common::SmallFlatMap<std::string, float, 4>;
+using HashMap = std::unordered_map<std::string, float>;
+
+template <typename Divergence, typename Influences> struct CreatureMaps {
+    Divergence traitDivergence;
+    std::vector<Influences> abilityInfluences;
+};
+
+std::string key(const char *prefix, int index) {
+    char buffer[16];
+    std::snprintf(buffer, sizeof(buffer), "%s%02d", prefix, index);
+    return buffer;
+}
+
+template <typename Divergence, typename Influences>
+std::size_t bytesPerCreature(int traits, int abilities, int influences) {
+    constexpr int CREATURES = 1000;
+    const std::size_t before = liveBytes;
+    std::vector<CreatureMaps<Divergence, Influences>> creatures(CREATURES);
+    for (auto &creature : creatures) {
+        for (int t = 0; t < traits; ++t) {
+            creature.traitDivergence[key("trait_", t)] = 0.1f;
+        }
+        creature.abilityInfluences.resize(static_cast<std::size_t>(abilities));
+        for (auto &map : creature.abilityInfluences) {
+            for (int i = 0; i < influences; ++i) {
+                map[key("stat_", i)] = 0.5f;
+            }
+        }
+    }
+    return (liveBytes - before) / CREATURES;
+}
+
+} // namespace
+
+int main() {
+    struct Shape {
+        int traits;
+        int abilities;
+        int influences;
+    };
+    const Shape shapes[] = {{0, 0, 0}, {4, 2, 2}, {8, 4, 3}, {12, 6, 6}};
+
+    std::printf("%8s %10s %11s %14s %14s %8s\n", "traits", "abilities",
+                "influences", "flat B/crt", "unordered B/crt", "ratio");
+    bool flatSmaller = true;
+    for (const Shape &shape : shapes) {
+        const std::size_t flat =
+            bytesPerCreature<FlatDivergence, FlatInfluences>(
+                shape.traits, shape.abilities, shape.influences);
+        const std::size_t hashed = bytesPerCreature<HashMap, HashMap>(
+            shape.traits, shape.abilities, shape.influences);
+        std::printf("%8d %10d %11d %14zu %14zu %8.2f\n", shape.traits,
+                    shape.abilities, shape.influences, flat, hashed,
+                    hashed == 0 ? 0.0
+                                : static_cast<double>(flat) /
+                                      static_cast<double>(hashed));
+        // Spilled maps keep their inline footprint on top of the table, so
+        // only the populated shapes the inline capacities are sized for
+        // have to come out smaller
+        constexpr int DIVERGENCE_INLINE = FlatDivergence::INLINE_CAPACITY;
+        constexpr int INFLUENCES_INLINE = FlatInfluences::INLINE_CAPACITY;
+        const bool fitsInline = shape.traits <= DIVERGENCE_INLINE &&
+                                shape.influences <= INFLUENCES_INLINE;
+        if (shape.traits > 0 && fitsInline && flat >= hashed) {
+            flatSmaller = false;
+        }
+    }
+    return flatSmaller ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,351 @@
+// Cache misses per trait state for one environmental pass, TraitCatalog's
+// hot records against the shared_ptr<const TraitDefinition> they replaced.
+// Misses come from the hardware counter through perf_event_open; where
+// that is unavailable (not Linux, no PMU, perf_event_paranoid) the pass
+// times are still printed and nothing is checked.
+//
+// TraitDefinition needs headers that are not in the header-only build, so
+// both layouts are modelled here: the old one as a heap definition with a
+// string-keyed affinity map reached through a shared_ptr, the new one as
+// TraitCatalog lays it out, 20-byte records plus two affinity columns.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr std::size_t DEFINITIONS = 2000;
+constexpr std::size_t STATES = 400000;
+constexpr std::size_t ENVIRONMENTS = 24;
+constexpr std::size_t AFFINITIES = 6;
+constexpr int PASSES = 5;
+
+/**
+ * @brief Hardware cache-miss counter for this thread
+ */
+class CacheMissCounter {
+  public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        const long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (fd < 0) {
+            error_ = std::strerror(errno);
+            return;
+        }
+        fd_ = static_cast<int>(fd);
+#else
+        error_ = "perf_event_open is Linux only";
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+#endif
+    }
+
+    // Prevent copying and moving
+    CacheMissCounter(const CacheMissCounter &) = delete;
+    CacheMissCounter &operator=(const CacheMissCounter &) = delete;
+    CacheMissCounter(CacheMissCounter &&) = delete;
+    CacheMissCounter &operator=(CacheMissCounter &&) = delete;
+
+    bool available() const { return fd_ >= 0; }
+    const std::string &error() const { return error_; }
+
+    /**
+     * @brief Misses while fn runs, or nullopt without a counter
+     */
+    template <typename Fn> std::optional<std::uint64_t> measure(Fn &&fn) {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+            fn();
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            std::uint64_t count = 0;
+            if (read(fd_, &count, sizeof(count)) == sizeof(count)) {
+                return count;
+            }
+            return std::nullopt;
+        }
+#endif
+        fn();
+        return std::nullopt;
+    }
+
+  private:
+    int fd_{-1};
+    std::string error_;
+};
+
+// Old layout: everything behind one shared, reference-counted pointer
+struct SharedDefinition {
+    std::string id;
+    std::string name;
+    std::string description;
+    int category{0};
+    int origin{0};
+    std::unordered_map<std::string, float> affinities;
+    float minimumAffinity{0.0f};
+    bool isPermanent{false};
+    bool requiresStability{false};
+    std::vector<std::string> effects;
+};
+
+struct SharedState {
+    std::shared_ptr<const SharedDefinition> definition;
+    std::string id;
+    float strength{1.0f};
+};
+
+// New layout, as in TraitCatalog
+struct HotRecord {
+    std::uint8_t category{0};
+    std::uint8_t origin{0};
+    float minimumAffinity{0.0f};
+    std::uint32_t affinityBegin{0};
+    std::uint16_t affinityCount{0};
+    std::uint16_t flags{0};
+};
+
+struct Catalog {
+    std::vector<HotRecord> hot;
+    std::vector<std::uint32_t> affinityEnvironments;
+    std::vector<float> affinityValues;
+
+    float affinity(std::uint32_t index, std::uint32_t environment) const {
+        const HotRecord &record = hot[index];
+        const std::uint32_t *first =
+            affinityEnvironments.data() + record.affinityBegin;
+        const std::uint32_t *last = first + record.affinityCount;
+        for (const std::uint32_t *it = first; it != last; ++it) {
+            if (*it >= environment) {
+                return *it == environment
+                           ? affinityValues[static_cast<std::size_t>(
+                                 it - affinityEnvironments.data())]
+                           : 0.0f;
+            }
+        }
+        return 0.0f;
+    }
+};
+
+struct CatalogState {
+    const Catalog *catalog{nullptr};
+    std::uint32_t definition{0};
+    float strength{1.0f};
+};
+
+std::string environmentName(std::size_t environment) {
+    return "environment_" + std::to_string(environment);
+}
+
+// Definitions are allocated one at a time between unrelated allocations,
+// as a loader parsing JSON would leave them
+std::vector<std::shared_ptr<const SharedDefinition>>
+makeDefinitions(std::mt19937 &random,
+                std::vector<std::unique_ptr<char[]>> &clutter) {
+    std::vector<std::shared_ptr<const SharedDefinition>> definitions;
+    std::uniform_int_distribution<std::size_t> environment(0,
+                                                           ENVIRONMENTS - 1);
+    std::uniform_real_distribution<float> value(0.0f, 1.0f);
+    for (std::size_t i = 0; i < DEFINITIONS; ++i) {
+        auto definition = std::make_shared<SharedDefinition>();
+        definition->id = "trait_" + std::to_string(i);
+        definition->name = "Trait number " + std::to_string(i);
+        definition->description.assign(160, 'd');
+        definition->category = static_cast<int>(i % 8);
+        definition->origin = static_cast<int>(i % 4);
+        while (definition->affinities.size() < AFFINITIES) {
+            definition->affinities[environmentName(environment(random))] =
+                value(random);
+            clutter.push_back(std::make_unique<char[]>(96));
+        }
+        definition->minimumAffinity = value(random) * 0.5f;
+        definition->isPermanent = i % 5 == 0;
+        definition->requiresStability = i % 3 == 0;
+        definition->effects.assign(3, "effect_" + std::to_string(i));
+        definitions.push_back(std::move(definition));
+    }
+    return definitions;
+}
+
+Catalog makeCatalog(
+    const std::vector<std::shared_ptr<const SharedDefinition>> &definitions) {
+    Catalog catalog;
+    for (const auto &definition : definitions) {
+        HotRecord record;
+        record.category = static_cast<std::uint8_t>(definition->category);
+        record.origin = static_cast<std::uint8_t>(definition->origin);
+        record.minimumAffinity = definition->minimumAffinity;
+        record.flags = static_cast<std::uint16_t>(
+            (definition->isPermanent ? 1u : 0u) |
+            (definition->requiresStability ? 2u : 0u));
+
+        std::vector<std::pair<std::uint32_t, float>> affinities;
+        for (const auto &[name, affinity] : definition->affinities) {
+            affinities.emplace_back(
+                static_cast<std::uint32_t>(
+                    std::stoul(name.substr(std::strlen("environment_")))),
+                affinity);
+        }
+        std::sort(affinities.begin(), affinities.end());
+        record.affinityBegin =
+            static_cast<std::uint32_t>(catalog.affinityEnvironments.size());
+        record.affinityCount = static_cast<std::uint16_t>(affinities.size());
+        for (const auto &[id, affinity] : affinities) {
+            catalog.affinityEnvironments.push_back(id);
+            catalog.affinityValues.push_back(affinity);
+        }
+        catalog.hot.push_back(record);
+    }
+    return catalog;
+}
+
+// The per-tick question: which states respond to this environment
+float sharedPass(const std::vector<SharedState> &states,
+                 const std::string &environment) {
+    float total = 0.0f;
+    for (const SharedState &state : states) {
+        const SharedDefinition &definition = *state.definition;
+        auto it = definition.affinities.find(environment);
+        const float affinity =
+            it == definition.affinities.end() ? 0.0f : it->second;
+        if (affinity >= definition.minimumAffinity &&
+            !definition.isPermanent) {
+            total += affinity * state.strength;
+        }
+    }
+    return total;
+}
+
+float catalogPass(const std::vector<CatalogState> &states,
+                  std::uint32_t environment) {
+    float total = 0.0f;
+    for (const CatalogState &state : states) {
+        const HotRecord &record = state.catalog->hot[state.definition];
+        const float affinity =
+            state.catalog->affinity(state.definition, environment);
+        if (affinity >= record.minimumAffinity && (record.flags & 1u) == 0) {
+            total += affinity * state.strength;
+        }
+    }
+    return total;
+}
+
+struct Result {
+    std::optional<std::uint64_t> misses;
+    double milliseconds{0.0};
+    float checksum{0.0f};
+};
+
+template <typename Fn> Result run(CacheMissCounter &counter, Fn &&pass) {
+    Result result;
+    std::uint64_t misses = 0;
+    bool counted = true;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < PASSES; ++i) {
+        const std::optional<std::uint64_t> passMisses =
+            counter.measure([&] { result.checksum += pass(); });
+        if (passMisses) {
+            misses += *passMisses;
+        } else {
+            counted = false;
+        }
+    }
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    result.milliseconds = elapsed.count() / PASSES;
+    if (counted) {
+        result.misses = misses / PASSES;
+    }
+    return result;
+}
+
+} // namespace
+
+int main() {
+    std::mt19937 random(49);
+    std::vector<std::unique_ptr<char[]>> clutter;
+    const auto definitions = makeDefinitions(random, clutter);
+    const Catalog catalog = makeCatalog(definitions);
+
+    std::uniform_int_distribution<std::uint32_t> pick(
+        0, static_cast<std::uint32_t>(DEFINITIONS - 1));
+    std::vector<SharedState> sharedStates;
+    std::vector<CatalogState> catalogStates;
+    sharedStates.reserve(STATES);
+    catalogStates.reserve(STATES);
+    for (std::size_t i = 0; i < STATES; ++i) {
+        const std::uint32_t index = pick(random);
+        sharedStates.push_back({definitions[index], definitions[index]->id,
+                                1.0f});
+        catalogStates.push_back({&catalog, index, 1.0f});
+    }
+
+    const std::uint32_t environment = 7;
+    const std::string name = environmentName(environment);
+    CacheMissCounter counter;
+    const Result shared =
+        run(counter, [&] { return sharedPass(sharedStates, name); });
+    const Result hot =
+        run(counter, [&] { return catalogPass(catalogStates, environment); });
+
+    std::printf("%zu states over %zu definitions, %d passes\n", STATES,
+                DEFINITIONS, PASSES);
+    std::printf("%10s %12s %14s\n", "layout", "ms/pass", "misses/state");
+    for (const auto &[label, result] :
+         {std::pair<const char *, const Result &>{"shared_ptr", shared},
+          std::pair<const char *, const Result &>{"catalog", hot}}) {
+        if (result.misses) {
+            std::printf("%10s %12.2f %14.3f\n", label, result.milliseconds,
+                        static_cast<double>(*result.misses) /
+                            static_cast<double>(STATES));
+        } else {
+            std::printf("%10s %12.2f %14s\n", label, result.milliseconds,
+                        "n/a");
+        }
+    }
+    if (shared.checksum != hot.checksum) {
+        std::printf("layouts disagree: %f vs %f\n",
+                    static_cast<double>(shared.checksum),
+                    static_cast<double>(hot.checksum));
+        return EXIT_FAILURE;
+    }
+    if (!shared.misses || !hot.misses) {
+        std::printf("cache-miss counter unavailable (%s); not checked\n",
+                    counter.error().c_str());
+        return EXIT_SUCCESS;
+    }
+    return *hot.misses < *shared.misses ? EXIT_SUCCESS : EXIT_FAILURE;
+}
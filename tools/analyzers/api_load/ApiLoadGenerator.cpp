@@ -0,0 +1,465 @@
+#include "ApiLoadGenerator.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+namespace crescent::tools {
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+// EWOULDBLOCK is EAGAIN on Linux
+bool wouldBlock() { return errno == EAGAIN; }
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               const auto lower = [](char c) {
+                   return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32)
+                                               : c;
+               };
+               return lower(x) == lower(y);
+           });
+}
+
+/**
+ * @brief Status line and the headers the generator cares about
+ */
+struct ResponseHead {
+    int status{0};
+    std::size_t contentLength{0};
+    std::string_view etag;
+    bool close{false};
+    std::size_t headLength{0};
+};
+
+bool parseResponseHead(std::string_view input, ResponseHead &head) {
+    const std::size_t end = input.find("\r\n\r\n");
+    if (end == std::string_view::npos) {
+        return false;
+    }
+    head = ResponseHead{};
+    head.headLength = end + 4;
+    std::string_view lines = input.substr(0, end + 2);
+    const std::size_t firstEnd = lines.find("\r\n");
+    const std::string_view statusLine = lines.substr(0, firstEnd);
+    if (statusLine.size() >= 12) {
+        head.status = std::atoi(std::string(statusLine.substr(9, 3)).c_str());
+    }
+    lines.remove_prefix(firstEnd + 2);
+    while (!lines.empty()) {
+        const std::size_t lineEnd = lines.find("\r\n");
+        const std::string_view line = lines.substr(0, lineEnd);
+        lines.remove_prefix(lineEnd + 2);
+        const std::size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            continue;
+        }
+        const std::string_view name = line.substr(0, colon);
+        std::string_view value = line.substr(colon + 1);
+        value.remove_prefix(std::min(value.find_first_not_of(' '),
+                                     value.size()));
+        if (equalsIgnoreCase(name, "Content-Length")) {
+            head.contentLength = std::strtoull(std::string(value).c_str(),
+                                               nullptr, 10);
+        } else if (equalsIgnoreCase(name, "ETag")) {
+            head.etag = value;
+        } else if (equalsIgnoreCase(name, "Connection")) {
+            head.close = equalsIgnoreCase(value, "close");
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief One keep-alive connection with one request in flight
+ */
+struct LoadConnection {
+    int fd{-1};
+    std::size_t nextTarget{0};
+    std::string output;
+    std::size_t sent{0};
+    std::string input;
+    SteadyClock::time_point sentAt;
+    std::vector<std::string> etags; // Last ETag per target
+
+    ~LoadConnection() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+};
+
+/**
+ * @brief Counters one worker thread owns until the run ends
+ */
+struct WorkerResult {
+    std::uint64_t requests{0};
+    std::uint64_t notModified{0};
+    std::uint64_t errors{0};
+    std::uint64_t bytes{0};
+    metrics::LatencyHistogram latency;
+    std::exception_ptr failure;
+};
+
+class LoadWorker {
+  public:
+    LoadWorker(const ApiLoadGenerator::Config &config, std::size_t connections,
+               SteadyClock::time_point measureFrom,
+               SteadyClock::time_point deadline, WorkerResult &result)
+        : config_(config), measureFrom_(measureFrom), deadline_(deadline),
+          result_(result), connections_(connections) {}
+
+    ~LoadWorker() {
+        if (epollFd_ >= 0) {
+            ::close(epollFd_);
+        }
+    }
+
+    // Prevent copying and moving
+    LoadWorker(const LoadWorker &) = delete;
+    LoadWorker &operator=(const LoadWorker &) = delete;
+    LoadWorker(LoadWorker &&) = delete;
+    LoadWorker &operator=(LoadWorker &&) = delete;
+
+    void run() {
+        epollFd_ = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd_ < 0) {
+            throw std::system_error(errno, std::generic_category(), "epoll");
+        }
+        for (std::size_t i = 0; i < connections_.size(); ++i) {
+            LoadConnection &connection = connections_[i];
+            connection.etags.resize(config_.targets.size());
+            connection.nextTarget = i % config_.targets.size();
+            connect(connection, i);
+            sendNext(connection);
+        }
+
+        std::array<epoll_event, 64> events{};
+        while (SteadyClock::now() < deadline_) {
+            const int ready = ::epoll_wait(epollFd_, events.data(),
+                                           static_cast<int>(events.size()),
+                                           10);
+            for (int i = 0; i < ready; ++i) {
+                const epoll_event &event = events[static_cast<std::size_t>(i)];
+                LoadConnection &connection = connections_[event.data.u64];
+                if (event.events & EPOLLOUT) {
+                    flush(connection);
+                }
+                if (event.events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                    receive(connection, event.data.u64);
+                }
+            }
+        }
+    }
+
+  private:
+    const ApiLoadGenerator::Config &config_;
+    SteadyClock::time_point measureFrom_;
+    SteadyClock::time_point deadline_;
+    WorkerResult &result_;
+    std::vector<LoadConnection> connections_;
+    int epollFd_{-1};
+
+    void connect(LoadConnection &connection, std::size_t index) {
+        const int fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "socket");
+        }
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(config_.port);
+        if (::inet_pton(AF_INET, config_.host.c_str(), &address.sin_addr) !=
+                1 ||
+            ::connect(fd, reinterpret_cast<const sockaddr *>(&address),
+                      sizeof(address)) != 0) {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(),
+                                    "connect " + config_.host);
+        }
+        const int one = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        const int flags = ::fcntl(fd, F_GETFL);
+        ::fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = index;
+        ::epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event);
+        connection.fd = fd;
+        connection.input.clear();
+        connection.output.clear();
+        connection.sent = 0;
+    }
+
+    void sendNext(LoadConnection &connection) {
+        const std::size_t target = connection.nextTarget;
+        connection.output = "GET ";
+        connection.output += config_.targets[target];
+        connection.output += " HTTP/1.1\r\nHost: ";
+        connection.output += config_.host;
+        connection.output += "\r\n";
+        if (config_.sendIfNoneMatch && !connection.etags[target].empty()) {
+            connection.output += "If-None-Match: ";
+            connection.output += connection.etags[target];
+            connection.output += "\r\n";
+        }
+        connection.output += "\r\n";
+        connection.sent = 0;
+        connection.sentAt = SteadyClock::now();
+        flush(connection);
+    }
+
+    void flush(LoadConnection &connection) {
+        while (connection.sent < connection.output.size()) {
+            const ssize_t written = ::send(
+                connection.fd, connection.output.data() + connection.sent,
+                connection.output.size() - connection.sent, MSG_NOSIGNAL);
+            if (written > 0) {
+                connection.sent += static_cast<std::size_t>(written);
+            } else if (written < 0 && errno == EINTR) {
+                continue;
+            } else {
+                // Full socket: resume on EPOLLOUT; failures show up on read
+                setEvents(connection, EPOLLIN | EPOLLOUT);
+                return;
+            }
+        }
+        setEvents(connection, EPOLLIN);
+    }
+
+    void setEvents(LoadConnection &connection, std::uint32_t events) {
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = static_cast<std::uint64_t>(&connection -
+                                                    connections_.data());
+        ::epoll_ctl(epollFd_, EPOLL_CTL_MOD, connection.fd, &event);
+    }
+
+    void receive(LoadConnection &connection, std::size_t index) {
+        std::array<char, 16 * 1024> buffer;
+        bool closed = false;
+        for (;;) {
+            const ssize_t received =
+                ::recv(connection.fd, buffer.data(), buffer.size(), 0);
+            if (received > 0) {
+                connection.input.append(buffer.data(),
+                                        static_cast<std::size_t>(received));
+                continue;
+            }
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            closed = received == 0 ||
+                     !wouldBlock();
+            break;
+        }
+
+        ResponseHead head;
+        if (!parseResponseHead(connection.input, head) ||
+            connection.input.size() < head.headLength + head.contentLength) {
+            if (closed) {
+                // Closed or failed mid-response
+                ++result_.errors;
+                reconnect(connection, index);
+            }
+            return;
+        }
+        const SteadyClock::time_point now = SteadyClock::now();
+        const std::size_t target = connection.nextTarget;
+        if (connection.sentAt >= measureFrom_ && now < deadline_) {
+            if (head.status == 200 || head.status == 304) {
+                ++result_.requests;
+                if (head.status == 304) {
+                    ++result_.notModified;
+                }
+                result_.bytes += head.headLength + head.contentLength;
+                result_.latency.record(static_cast<std::uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        now - connection.sentAt)
+                        .count()));
+            } else {
+                ++result_.errors;
+            }
+        }
+        if (head.status == 200 && !head.etag.empty()) {
+            connection.etags[target] = std::string(head.etag);
+        }
+        const bool close = head.close || closed;
+        connection.input.erase(0, head.headLength + head.contentLength);
+        connection.nextTarget = (target + 1) % config_.targets.size();
+        if (close) {
+            reconnect(connection, index);
+            return;
+        }
+        sendNext(connection);
+    }
+
+    void reconnect(LoadConnection &connection, std::size_t index) {
+        ::epoll_ctl(epollFd_, EPOLL_CTL_DEL, connection.fd, nullptr);
+        ::close(connection.fd);
+        connection.fd = -1;
+        if (SteadyClock::now() >= deadline_) {
+            return;
+        }
+        connect(connection, index);
+        sendNext(connection);
+    }
+};
+
+double seconds(SteadyClock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+ApiLoadGenerator::ApiLoadGenerator(Config config)
+    : config_(std::move(config)) {
+    if (config_.targets.empty()) {
+        config_.targets.emplace_back("/creatures");
+    }
+    config_.threads = std::max<std::size_t>(config_.threads, 1);
+    config_.connections = std::max(config_.connections, config_.threads);
+}
+
+ApiLoadGenerator::Report ApiLoadGenerator::run() {
+    const SteadyClock::time_point begin = SteadyClock::now();
+    const SteadyClock::time_point measureFrom = begin + config_.warmup;
+    const SteadyClock::time_point deadline = measureFrom + config_.duration;
+
+    std::vector<std::unique_ptr<WorkerResult>> results;
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < config_.threads; ++t) {
+        // Spread connections as evenly as the counts allow
+        std::size_t count = config_.connections / config_.threads;
+        if (t < config_.connections % config_.threads) {
+            ++count;
+        }
+        results.push_back(std::make_unique<WorkerResult>());
+        WorkerResult &result = *results.back();
+        threads.emplace_back([this, count, measureFrom, deadline, &result] {
+            try {
+                LoadWorker(config_, count, measureFrom, deadline, result)
+                    .run();
+            } catch (...) {
+                result.failure = std::current_exception();
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    Report report;
+    metrics::LatencyHistogram::Snapshot latency;
+    std::uint64_t bytes = 0;
+    for (const std::unique_ptr<WorkerResult> &result : results) {
+        if (result->failure) {
+            std::rethrow_exception(result->failure);
+        }
+        report.requests += result->requests;
+        report.notModified += result->notModified;
+        report.errors += result->errors;
+        bytes += result->bytes;
+        result->latency.mergeInto(latency);
+    }
+    const double measured =
+        seconds(std::min(SteadyClock::now(), deadline) - measureFrom);
+    if (measured > 0.0) {
+        report.requestsPerSecond =
+            static_cast<double>(report.requests) / measured;
+        report.bytesPerSecond = static_cast<double>(bytes) / measured;
+    }
+    report.latency = latency.summarize();
+    return report;
+}
+
+std::string ApiLoadGenerator::formatReport(const Report &report) {
+    const auto micros = [](std::uint64_t nanos) {
+        return static_cast<double>(nanos) / 1000.0;
+    };
+    char text[512];
+    std::snprintf(
+        text, sizeof(text),
+        "requests     %llu (%.0f/s, %.2f MB/s)\n"
+        "304          %llu\n"
+        "errors       %llu\n"
+        "latency (us) p50 %.1f  p90 %.1f  p99 %.1f  p999 %.1f  max %.1f\n",
+        static_cast<unsigned long long>(report.requests),
+        report.requestsPerSecond, report.bytesPerSecond / 1e6,
+        static_cast<unsigned long long>(report.notModified),
+        static_cast<unsigned long long>(report.errors),
+        micros(report.latency.p50), micros(report.latency.p90),
+        micros(report.latency.p99), micros(report.latency.p999),
+        micros(report.latency.max));
+    return text;
+}
+
+int runApiLoadCli(int argc, char **argv) {
+    ApiLoadGenerator::Config config;
+    config.targets.clear();
+    const auto usage = [argv] {
+        std::fprintf(stderr,
+                     "usage: %s [--host H] [--port N] [--connections N] "
+                     "[--threads N] [--duration S] [--warmup S] [--no-etag] "
+                     "TARGET...\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    };
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--host" && hasValue) {
+                config.host = argv[++i];
+            } else if (arg == "--port" && hasValue) {
+                config.port = static_cast<std::uint16_t>(std::stoul(argv[++i]));
+            } else if (arg == "--connections" && hasValue) {
+                config.connections = std::stoul(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                config.threads = std::stoul(argv[++i]);
+            } else if (arg == "--duration" && hasValue) {
+                config.duration = std::chrono::seconds(std::stol(argv[++i]));
+            } else if (arg == "--warmup" && hasValue) {
+                config.warmup = std::chrono::seconds(std::stol(argv[++i]));
+            } else if (arg == "--no-etag") {
+                config.sendIfNoneMatch = false;
+            } else if (!arg.empty() && arg.front() == '/') {
+                config.targets.emplace_back(arg);
+            } else {
+                return usage();
+            }
+        }
+        if (config.targets.empty()) {
+            return usage();
+        }
+        ApiLoadGenerator generator(std::move(config));
+        std::fputs(ApiLoadGenerator::formatReport(generator.run()).c_str(),
+                   stdout);
+    } catch (const std::exception &error) {
+        std::fprintf(stderr, "api_load: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace crescent::tools
@@ -0,0 +1,70 @@
+#ifndef CRESCENT_TOOLS_ANALYZERS_API_LOAD_GENERATOR_H
+#define CRESCENT_TOOLS_ANALYZERS_API_LOAD_GENERATOR_H
+
+#include "common/metrics/LatencyHistogram.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace crescent::tools {
+
+/**
+ * @brief Closed-loop HTTP load against a local ApiServer
+ *
+ * Each connection keeps one request in flight over keep-alive sockets,
+ * cycling through the target list. Optionally replays the last ETag per
+ * target so the 304 path can be measured separately from full bodies.
+ */
+class ApiLoadGenerator {
+  public:
+    struct Config {
+        std::string host{"127.0.0.1"};
+        std::uint16_t port{8420};
+        std::vector<std::string> targets{"/creatures"};
+        std::size_t connections{64};
+        std::size_t threads{4};
+        std::chrono::seconds duration{10};
+        std::chrono::seconds warmup{2};
+        bool sendIfNoneMatch{true};
+    };
+
+    /**
+     * @brief Results of one run; latencies are per request, in nanoseconds
+     */
+    struct Report {
+        std::uint64_t requests{0};
+        std::uint64_t notModified{0};
+        std::uint64_t errors{0};
+        double requestsPerSecond{0.0};
+        double bytesPerSecond{0.0};
+        metrics::LatencySummary latency;
+    };
+
+    explicit ApiLoadGenerator(Config config);
+
+    /**
+     * @brief Runs warmup then the measured interval
+     * @throws std::system_error if the server cannot be reached
+     */
+    Report run();
+
+    static std::string formatReport(const Report &report);
+
+  private:
+    Config config_;
+};
+
+/**
+ * @brief Entry point for the api_load CLI
+ *
+ * Usage: api_load [--host H] [--port N] [--connections N] [--threads N]
+ *                 [--duration S] [--warmup S] [--no-etag] TARGET...
+ * Prints requests/sec and p50/p90/p99/p999 latency.
+ */
+int runApiLoadCli(int argc, char **argv);
+
+} // namespace crescent::tools
+
+#endif // CRESCENT_TOOLS_ANALYZERS_API_LOAD_GENERATOR_H
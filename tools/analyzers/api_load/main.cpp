@@ -0,0 +1,5 @@
+#include "ApiLoadGenerator.h"
+
+int main(int argc, char **argv) {
+    return crescent::tools::runApiLoadCli(argc, argv);
+}
@@ -0,0 +1,358 @@
+#include "TraceReplayer.h"
+
+#include "creature_engine/io/DeltaSnapshot.h"
+#include "creature_engine/io/JsonStreamWriter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace crescent::tools {
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+std::chrono::nanoseconds since(SteadyClock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        SteadyClock::now() - start);
+}
+
+double seconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+double millis(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+// Installs the trace's clock for one replay and uninstalls it after
+class ClockScope {
+  public:
+    using Clock = common::SimulationClock;
+
+    explicit ClockScope(const io::TraceHeader &header)
+        : clock_(Clock::Config{
+              Clock::TickLength(header.tickLengthMicros),
+              Clock::WallClock::time_point(
+                  std::chrono::milliseconds(header.epochMillis)),
+              header.startTick}) {
+        Clock::install(&clock_);
+    }
+    ~ClockScope() { Clock::install(nullptr); }
+
+    // Prevent copying and moving
+    ClockScope(const ClockScope &) = delete;
+    ClockScope &operator=(const ClockScope &) = delete;
+    ClockScope(ClockScope &&) = delete;
+    ClockScope &operator=(ClockScope &&) = delete;
+
+    Clock &clock() { return clock_; }
+
+  private:
+    Clock clock_;
+};
+
+// Creatures by id; offspring from transitions take over their parent's id
+class ReplayPopulation {
+  public:
+    explicit ReplayPopulation(std::vector<CreatureCore> restored)
+        : restored_(std::move(restored)) {
+        for (CreatureCore &creature : restored_) {
+            byId_[creature.getIdentity().id] = &creature;
+        }
+    }
+
+    std::size_t size() const { return byId_.size(); }
+
+    CreatureCore &find(std::string_view id) {
+        auto it = byId_.find(std::string(id));
+        if (it == byId_.end()) {
+            throw SerializationException("Trace names unknown creature " +
+                                         std::string(id));
+        }
+        return *it->second;
+    }
+
+    void replace(std::string_view id, std::unique_ptr<CreatureCore> next) {
+        byId_[std::string(id)] = next.get();
+        offspring_.push_back(std::move(next));
+    }
+
+    template <typename Fn> void forEach(Fn &&fn) {
+        for (auto &entry : byId_) {
+            fn(*entry.second);
+        }
+    }
+
+    /**
+     * @brief FNV-1a over every creature's JSON, in id order
+     */
+    std::uint64_t digest() const {
+        std::vector<const std::pair<const std::string, CreatureCore *> *>
+            ordered;
+        ordered.reserve(byId_.size());
+        for (const auto &entry : byId_) {
+            ordered.push_back(&entry);
+        }
+        std::sort(ordered.begin(), ordered.end(),
+                  [](const auto *a, const auto *b) {
+                      return a->first < b->first;
+                  });
+
+        std::uint64_t hash = 0xcbf29ce484222325ull;
+        io::JsonStreamWriter json;
+        for (const auto *entry : ordered) {
+            json.clear();
+            entry->second->writeJson(json);
+            for (const char c : json.str()) {
+                hash = (hash ^ static_cast<unsigned char>(c)) *
+                       0x100000001b3ull;
+            }
+        }
+        return hash;
+    }
+
+  private:
+    std::vector<CreatureCore> restored_;
+    std::vector<std::unique_ptr<CreatureCore>> offspring_;
+    std::unordered_map<std::string, CreatureCore *> byId_;
+};
+
+} // namespace
+
+TraceReplayer::TraceReplayer(Config config) : config_(std::move(config)) {}
+
+TraceReplayer::Report TraceReplayer::run() {
+    io::InputTraceReader reader(config_.tracePath);
+    Report report;
+    report.traceBytes = reader.sizeBytes();
+
+    // Decode once; the records' views point into reader
+    std::vector<io::TraceRecord> records;
+    io::TraceRecord record;
+    while (reader.next(record)) {
+        if (record.kind == io::TraceRecordKind::Tick) {
+            ++report.ticks;
+        }
+        records.push_back(record);
+    }
+    report.records = records.size();
+
+    std::optional<std::uint64_t> expectedDigest;
+    const std::size_t total = config_.warmupRuns + config_.repetitions;
+    for (std::size_t index = 0; index < total; ++index) {
+        RunReport result = replayOnce(reader.header(), records,
+                                      report.creatures);
+        if (config_.verifyDeterminism) {
+            if (!expectedDigest) {
+                expectedDigest = result.populationDigest;
+            } else if (*expectedDigest != result.populationDigest) {
+                report.deterministic = false;
+            }
+        }
+        if (index >= config_.warmupRuns) {
+            report.runs.push_back(std::move(result));
+        }
+    }
+
+    if (!report.runs.empty()) {
+        const auto best = std::min_element(
+            report.runs.begin(), report.runs.end(),
+            [](const RunReport &a, const RunReport &b) {
+                return a.elapsed < b.elapsed;
+            });
+        const double wall = seconds(best->elapsed);
+        if (wall > 0.0) {
+            const double simulated =
+                static_cast<double>(report.ticks) *
+                static_cast<double>(reader.header().tickLengthMicros) / 1e6;
+            report.ticksPerSecond = static_cast<double>(report.ticks) / wall;
+            report.realtimeFactor = simulated / wall;
+        }
+    }
+    return report;
+}
+
+TraceReplayer::RunReport
+TraceReplayer::replayOnce(const io::TraceHeader &header,
+                          const std::vector<io::TraceRecord> &records,
+                          std::size_t &creatures) const {
+    ClockScope clock(header);
+    RunReport report;
+    const auto runStart = SteadyClock::now();
+
+    std::filesystem::path directory =
+        config_.snapshotDirectory.value_or(header.snapshotDirectory);
+    if (directory.is_relative()) {
+        directory = config_.tracePath.parent_path() / directory;
+    }
+    auto phaseStart = SteadyClock::now();
+    ReplayPopulation population(
+        io::DeltaSnapshotReader(directory).loadPopulation(header.snapshotId));
+    report.phases.restore = since(phaseStart);
+    creatures = population.size();
+
+    const float tickSeconds = clock.clock().tickSeconds();
+    metrics::LatencyHistogram tickLatency;
+    std::vector<SlowTick> ticks;
+    std::chrono::nanoseconds tickElapsed{0};
+    std::size_t tickInputs = 0;
+
+    for (const io::TraceRecord &record : records) {
+        phaseStart = SteadyClock::now();
+        switch (record.kind) {
+        case io::TraceRecordKind::FormChange:
+            population.find(record.creatureId)
+                .applyChange(io::decodeTracedChange(record.payload));
+            report.phases.formChanges += since(phaseStart);
+            break;
+        case io::TraceRecordKind::EnvironmentTransition:
+            population.replace(record.creatureId,
+                               population.find(record.creatureId)
+                                   .createAdaptedOffspring(
+                                       std::string(record.target)));
+            report.phases.environmentTransitions += since(phaseStart);
+            break;
+        case io::TraceRecordKind::CatalystExposure:
+            population.find(record.creatureId)
+                .getTraits()
+                .getSynthesis()
+                .recordCatalystExposure(record.catalystType,
+                                        std::string(record.name),
+                                        record.intensity);
+            report.phases.catalystExposures += since(phaseStart);
+            break;
+        case io::TraceRecordKind::Seed:
+            break; // Counted below; see the class comment
+        case io::TraceRecordKind::Tick: {
+            clock.clock().set(record.tick);
+            population.forEach([tickSeconds](CreatureCore &creature) {
+                creature.processEnvironmentalStress(tickSeconds);
+                creature.getTraits().updateTraits(tickSeconds);
+            });
+            const std::chrono::nanoseconds step = since(phaseStart);
+            report.phases.step += step;
+            tickElapsed += step;
+            tickLatency.record(
+                static_cast<std::uint64_t>(tickElapsed.count()));
+            ticks.push_back({record.tick, tickElapsed, tickInputs});
+            tickElapsed = std::chrono::nanoseconds{0};
+            tickInputs = 0;
+            continue;
+        }
+        case io::TraceRecordKind::End:
+            break;
+        }
+        tickElapsed += since(phaseStart);
+        ++tickInputs;
+    }
+    report.elapsed = since(runStart);
+
+    metrics::LatencyHistogram::Snapshot latency;
+    tickLatency.mergeInto(latency);
+    report.tickLatency = latency.summarize();
+    const std::size_t slowest = std::min(config_.slowestTicks, ticks.size());
+    std::partial_sort(ticks.begin(),
+                      ticks.begin() + static_cast<std::ptrdiff_t>(slowest),
+                      ticks.end(), [](const SlowTick &a, const SlowTick &b) {
+                          return a.elapsed > b.elapsed;
+                      });
+    ticks.resize(slowest);
+    report.slowestTicks = std::move(ticks);
+    report.populationDigest = population.digest();
+    return report;
+}
+
+std::string TraceReplayer::formatReport(const Report &report) {
+    std::string text;
+    char line[256];
+    std::snprintf(line, sizeof(line),
+                  "trace        %zu records, %zu ticks, %zu bytes, "
+                  "%zu creatures\n"
+                  "best run     %.0f ticks/s, %.1fx realtime%s\n",
+                  report.records, report.ticks, report.traceBytes,
+                  report.creatures, report.ticksPerSecond,
+                  report.realtimeFactor,
+                  report.deterministic ? "" : ", NOT DETERMINISTIC");
+    text += line;
+    for (std::size_t i = 0; i < report.runs.size(); ++i) {
+        const RunReport &timed = report.runs[i];
+        const PhaseTimings &phases = timed.phases;
+        std::snprintf(
+            line, sizeof(line),
+            "run %-8zu %.1f ms: restore %.1f  forms %.1f  transitions %.1f  "
+            "exposures %.1f  step %.1f\n"
+            "tick (us)    p50 %.1f  p90 %.1f  p99 %.1f  max %.1f\n",
+            i + 1, millis(timed.elapsed), millis(phases.restore),
+            millis(phases.formChanges), millis(phases.environmentTransitions),
+            millis(phases.catalystExposures), millis(phases.step),
+            static_cast<double>(timed.tickLatency.p50) / 1000.0,
+            static_cast<double>(timed.tickLatency.p90) / 1000.0,
+            static_cast<double>(timed.tickLatency.p99) / 1000.0,
+            static_cast<double>(timed.tickLatency.max) / 1000.0);
+        text += line;
+        for (const SlowTick &tick : timed.slowestTicks) {
+            std::snprintf(line, sizeof(line),
+                          "  tick %-10u %.1f us, %zu inputs\n",
+                          tick.tick.value,
+                          static_cast<double>(tick.elapsed.count()) / 1000.0,
+                          tick.inputs);
+            text += line;
+        }
+    }
+    return text;
+}
+
+int runReplayCli(int argc, char **argv) {
+    TraceReplayer::Config config;
+    const auto usage = [argv] {
+        std::fprintf(stderr,
+                     "usage: %s [--snapshots DIR] [--repeat N] [--warmup N] "
+                     "[--slowest N] [--no-verify] TRACE\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    };
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--snapshots" && hasValue) {
+                config.snapshotDirectory = std::filesystem::path(argv[++i]);
+            } else if (arg == "--repeat" && hasValue) {
+                config.repetitions = std::stoul(argv[++i]);
+            } else if (arg == "--warmup" && hasValue) {
+                config.warmupRuns = std::stoul(argv[++i]);
+            } else if (arg == "--slowest" && hasValue) {
+                config.slowestTicks = std::stoul(argv[++i]);
+            } else if (arg == "--no-verify") {
+                config.verifyDeterminism = false;
+            } else if (config.tracePath.empty() && !arg.empty() &&
+                       arg.front() != '-') {
+                config.tracePath = argv[i];
+            } else {
+                return usage();
+            }
+        }
+        if (config.tracePath.empty()) {
+            return usage();
+        }
+        TraceReplayer replayer(std::move(config));
+        const TraceReplayer::Report report = replayer.run();
+        std::fputs(TraceReplayer::formatReport(report).c_str(), stdout);
+        if (!report.deterministic) {
+            return EXIT_FAILURE;
+        }
+    } catch (const std::exception &error) {
+        std::fprintf(stderr, "replay_trace: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace crescent::tools
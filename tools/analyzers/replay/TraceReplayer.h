@@ -0,0 +1,115 @@
+#ifndef CRESCENT_TOOLS_ANALYZERS_TRACE_REPLAYER_H
+#define CRESCENT_TOOLS_ANALYZERS_TRACE_REPLAYER_H
+
+#include "common/metrics/LatencyHistogram.h"
+#include "common/utils/SimulationClock.h"
+#include "creature_engine/io/InputTrace.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace crescent::tools {
+
+/**
+ * @brief Re-executes a captured input trace as fast as the engine allows
+ *
+ * Installs a SimulationClock with the trace's epoch and tick length,
+ * restores the initial population from the referenced snapshot, then
+ * feeds records back through the same entry points that recorded them:
+ * CreatureCore::applyChange, createAdaptedOffspring (the offspring takes
+ * over the id for later records) and SynthesisProcessor::
+ * recordCatalystExposure. Each Tick record sets the clock and runs one
+ * step over the population: processEnvironmentalStress then
+ * updateTraits, one tick long. Nothing waits on wall time.
+ *
+ * Seed records are decoded and counted as inputs, but not applied: no
+ * engine random stream takes an external seed yet. Replays are
+ * deterministic because every other input comes from the trace, and
+ * verifyDeterminism checks that by comparing final digests.
+ *
+ * The trace is decoded once before timing starts. Each input phase and the
+ * step itself are timed separately, so a spike can be attributed to, say,
+ * a burst of form changes rather than the synthesis pass.
+ */
+class TraceReplayer {
+  public:
+    struct Config {
+        std::filesystem::path tracePath;
+        std::optional<std::filesystem::path> snapshotDirectory; // Override
+        std::size_t repetitions{1};   // Timed runs after warmup
+        std::size_t warmupRuns{0};    // Untimed runs to warm caches
+        std::size_t slowestTicks{10}; // Ticks listed in the report
+        bool verifyDeterminism{true}; // Compare final digests across runs
+    };
+
+    /**
+     * @brief Time spent per phase, summed over a run
+     */
+    struct PhaseTimings {
+        std::chrono::nanoseconds restore{0}; // Snapshot load, not per tick
+        std::chrono::nanoseconds formChanges{0};
+        std::chrono::nanoseconds environmentTransitions{0};
+        std::chrono::nanoseconds catalystExposures{0};
+        std::chrono::nanoseconds step{0}; // Scheduler steps
+    };
+
+    struct SlowTick {
+        common::SimTick tick;
+        std::chrono::nanoseconds elapsed{0}; // Inputs plus step
+        std::size_t inputs{0};               // Records applied this tick
+    };
+
+    struct RunReport {
+        PhaseTimings phases;
+        std::chrono::nanoseconds elapsed{0};
+        metrics::LatencySummary tickLatency; // Inputs plus step, per tick
+        std::vector<SlowTick> slowestTicks;  // Slowest first
+        std::uint64_t populationDigest{0};   // Hash of the final state
+    };
+
+    struct Report {
+        std::size_t records{0};
+        std::size_t ticks{0};
+        std::size_t traceBytes{0};
+        std::size_t creatures{0}; // Initial population
+        std::vector<RunReport> runs;
+        double ticksPerSecond{0.0}; // Best run
+        double realtimeFactor{0.0}; // Simulated time / wall time, best run
+        bool deterministic{true};   // All digests matched
+    };
+
+    explicit TraceReplayer(Config config);
+
+    /**
+     * @brief Runs warmup then the timed repetitions
+     * @throws SerializationException if the trace or snapshot is unreadable
+     */
+    Report run();
+
+    static std::string formatReport(const Report &report);
+
+  private:
+    Config config_;
+
+    RunReport replayOnce(const io::TraceHeader &header,
+                         const std::vector<io::TraceRecord> &records,
+                         std::size_t &creatures) const;
+};
+
+/**
+ * @brief Entry point for the replay_trace CLI
+ *
+ * Usage: replay_trace [--snapshots DIR] [--repeat N] [--warmup N]
+ *                     [--slowest N] [--no-verify] TRACE
+ * Prints per-phase time, tick latency percentiles and the slowest ticks.
+ */
+int runReplayCli(int argc, char **argv);
+
+} // namespace crescent::tools
+
+#endif // CRESCENT_TOOLS_ANALYZERS_TRACE_REPLAYER_H
@@ -0,0 +1,5 @@
+#include "TraceReplayer.h"
+
+int main(int argc, char **argv) {
+    return crescent::tools::runReplayCli(argc, argv);
+}
@@ -0,0 +1,310 @@
+#include "BulkCreatureGenerator.h"
+
+#include "creature_engine/io/JsonStreamWriter.h"
+#include "creature_engine/io/SnapshotStore.h"
+#include "io/DataLoader.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <utility>
+
+namespace crescent::tools {
+
+namespace {
+
+using SteadyClock = std::chrono::steady_clock;
+
+// Traits drawn per creature, before rejections
+constexpr int MIN_TRAITS = 2;
+constexpr int MAX_TRAITS = 5;
+// Draws allowed per wanted trait, so rejections cannot loop forever
+constexpr std::size_t DRAWS_PER_TRAIT = 4;
+
+std::size_t threadsOr(std::size_t configured, std::size_t share) {
+    if (configured != 0) {
+        return configured;
+    }
+    const std::size_t hardware =
+        std::max(1u, std::thread::hardware_concurrency());
+    return std::max<std::size_t>(hardware * share / 4, 1);
+}
+
+double seconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double>(duration).count();
+}
+
+} // namespace
+
+BulkCreatureGenerator::BulkCreatureGenerator(Config config)
+    : config_(std::move(config)),
+      catalog_(crucible::TraitCatalog::global()) {
+    config_.batchSize = std::max<std::size_t>(config_.batchSize, 1);
+    candidates_.reserve(config_.mix.size());
+    for (const MixEntry &entry : config_.mix) {
+        if (entry.theme.empty()) {
+            throw std::invalid_argument("Mix entry has no theme");
+        }
+        const crucible::EnvironmentId environment =
+            catalog_.environmentId(entry.environment);
+        if (environment == crucible::TraitCatalog::NO_ENVIRONMENT) {
+            throw std::invalid_argument("Unknown environment: " +
+                                        entry.environment);
+        }
+        std::vector<traits::TraitIndex> candidates;
+        for (std::size_t i = 0; i < catalog_.size(); ++i) {
+            const auto index = static_cast<traits::TraitIndex>(i);
+            if (catalog_.meetsMinimumAffinity(index, environment)) {
+                candidates.push_back(index);
+            }
+        }
+        if (candidates.empty()) {
+            throw std::invalid_argument("No trait can live in " +
+                                        entry.environment);
+        }
+        candidates_.push_back(std::move(candidates));
+    }
+}
+
+BulkCreatureGenerator::Report BulkCreatureGenerator::run() {
+    const auto start = SteadyClock::now();
+    Report report;
+
+    io::DeltaSnapshotWriter writer(config_.outputDirectory,
+                                   config_.serialization);
+    writer.beginBase();
+
+    using Pipeline = common::BatchPipeline<Batch>;
+    Pipeline pipeline(
+        {{[this](Batch &batch) { generateBatch(batch); },
+          threadsOr(config_.generateThreads, 1)},
+         {[this](Batch &batch) { assignTraits(batch); },
+          threadsOr(config_.traitThreads, 2)},
+         {[this](Batch &batch) { serializeBatch(batch); },
+          threadsOr(config_.serializeThreads, 1)}},
+        config_.queueDepth);
+    const Pipeline::Timings timings =
+        pipeline.run(planBatches(), [&](Batch &batch) {
+            writer.appendBaseRecords(batch.serialized, batch.count);
+            report.creatures += batch.count;
+            report.bytesWritten += batch.serialized.size();
+        });
+    report.snapshot = writer.commitBase();
+
+    report.stages.generate = timings[0];
+    report.stages.traits = timings[1];
+    report.stages.serialize = timings[2];
+    report.stages.write = timings[3];
+    report.elapsed = SteadyClock::now() - start;
+    if (report.elapsed.count() > 0) {
+        report.creaturesPerSecond =
+            static_cast<double>(report.creatures) / seconds(report.elapsed);
+    }
+    return report;
+}
+
+std::unique_ptr<CreatureCore>
+BulkCreatureGenerator::generateOne(std::size_t mixIndex,
+                                   std::size_t ordinal) const {
+    if (mixIndex >= config_.mix.size()) {
+        throw std::out_of_range("No mix entry " + std::to_string(mixIndex));
+    }
+    std::unique_ptr<CreatureCore> creature = makeCreature(mixIndex, ordinal);
+    addTraits(*creature, mixIndex, ordinal);
+    return creature;
+}
+
+std::unique_ptr<CreatureCore>
+BulkCreatureGenerator::makeCreature(std::size_t mixIndex,
+                                    std::size_t ordinal) const {
+    const MixEntry &entry = config_.mix[mixIndex];
+    auto creature = std::make_unique<CreatureCore>(
+        entry.theme + '-' + entry.environment + '-' +
+        std::to_string(mixIndex) + '-' + std::to_string(ordinal));
+    creature->bindEnvironment({entry.environment, {}});
+    return creature;
+}
+
+void BulkCreatureGenerator::addTraits(CreatureCore &creature,
+                                      std::size_t mixIndex,
+                                      std::size_t ordinal) const {
+    const std::vector<traits::TraitIndex> &candidates = candidates_[mixIndex];
+    common::SeededRandom random(
+        creatureSeed(config_.seed, mixIndex, ordinal));
+    const auto wanted = std::min(
+        static_cast<std::size_t>(random.uniformInt(MIN_TRAITS, MAX_TRAITS)),
+        candidates.size());
+
+    std::size_t added = 0;
+    for (std::size_t draw = 0;
+         added < wanted && draw < wanted * DRAWS_PER_TRAIT; ++draw) {
+        const traits::TraitIndex index =
+            candidates[random.pickIndex(candidates.size())];
+        auto result = creature.getTraits().addTrait(catalog_.idOf(index));
+        if (!result) {
+            continue; // Duplicate or incompatible with an earlier draw
+        }
+        if (result->change) {
+            creature.applyChange(*result->change);
+        }
+        ++added;
+    }
+    if (added == 0) {
+        throw std::runtime_error("Creature " + creature.getIdentity().id +
+                                 " accepted no trait");
+    }
+}
+
+void BulkCreatureGenerator::generateBatch(Batch &batch) const {
+    batch.creatures.reserve(batch.count);
+    for (std::size_t i = 0; i < batch.count; ++i) {
+        batch.creatures.push_back(
+            makeCreature(batch.mixIndex, batch.firstOrdinal + i));
+    }
+}
+
+void BulkCreatureGenerator::assignTraits(Batch &batch) const {
+    for (std::size_t i = 0; i < batch.creatures.size(); ++i) {
+        addTraits(*batch.creatures[i], batch.mixIndex, batch.firstOrdinal + i);
+    }
+}
+
+void BulkCreatureGenerator::serializeBatch(Batch &batch) const {
+    io::JsonStreamWriter payload;
+    for (const std::unique_ptr<CreatureCore> &creature : batch.creatures) {
+        payload.clear();
+        creature->writeJson(payload, config_.serialization);
+        if (!batch.serialized.empty()) {
+            batch.serialized += ',';
+        }
+        io::SnapshotFile::appendRecordJson(
+            batch.serialized, creature->getIdentity().id,
+            creature->getChangeTracker().getVersion(),
+            ChangeTracker::ALL_FIELDS, payload.str());
+    }
+    // The writer only needs the records from here on
+    batch.creatures.clear();
+}
+
+std::vector<BulkCreatureGenerator::Batch>
+BulkCreatureGenerator::planBatches() const {
+    std::vector<Batch> batches;
+    for (std::size_t mix = 0; mix < config_.mix.size(); ++mix) {
+        const std::size_t total = config_.mix[mix].count;
+        for (std::size_t first = 0; first < total;
+             first += config_.batchSize) {
+            Batch batch;
+            batch.sequence = batches.size();
+            batch.mixIndex = mix;
+            batch.firstOrdinal = first;
+            batch.count = std::min(config_.batchSize, total - first);
+            batches.push_back(std::move(batch));
+        }
+    }
+    return batches;
+}
+
+std::string BulkCreatureGenerator::formatReport(const Report &report) {
+    char text[512];
+    std::snprintf(
+        text, sizeof(text),
+        "creatures    %zu (%.0f/s, %.2f MB)\n"
+        "snapshot     %llu\n"
+        "elapsed (s)  %.3f\n"
+        "busy (s)     generate %.3f  traits %.3f  serialize %.3f  "
+        "write %.3f\n",
+        report.creatures, report.creaturesPerSecond,
+        static_cast<double>(report.bytesWritten) / 1e6,
+        static_cast<unsigned long long>(report.snapshot.id),
+        seconds(report.elapsed), seconds(report.stages.generate),
+        seconds(report.stages.traits), seconds(report.stages.serialize),
+        seconds(report.stages.write));
+    return text;
+}
+
+namespace {
+
+// THEME:ENVIRONMENT:COUNT
+BulkCreatureGenerator::MixEntry parseMixEntry(std::string_view text) {
+    const std::size_t first = text.find(':');
+    const std::size_t last = text.rfind(':');
+    if (first == std::string_view::npos || first == last) {
+        throw std::invalid_argument("Expected THEME:ENVIRONMENT:COUNT, got " +
+                                    std::string(text));
+    }
+    BulkCreatureGenerator::MixEntry entry;
+    entry.theme = std::string(text.substr(0, first));
+    entry.environment = std::string(text.substr(first + 1, last - first - 1));
+    entry.count = std::stoul(std::string(text.substr(last + 1)));
+    return entry;
+}
+
+// G,T,S
+void parseThreads(std::string_view text,
+                  BulkCreatureGenerator::Config &config) {
+    const std::array<std::size_t *, 3> targets = {
+        &config.generateThreads, &config.traitThreads,
+        &config.serializeThreads};
+    for (std::size_t *target : targets) {
+        const std::size_t comma = text.find(',');
+        *target = std::stoul(std::string(text.substr(0, comma)));
+        if (comma == std::string_view::npos) {
+            return;
+        }
+        text.remove_prefix(comma + 1);
+    }
+}
+
+} // namespace
+
+int runGenerateCli(int argc, char **argv) {
+    BulkCreatureGenerator::Config config;
+    std::string dataDirectory = "data";
+    const auto usage = [argv] {
+        std::fprintf(stderr,
+                     "usage: %s --out DIR [--data DIR] [--seed N] "
+                     "[--batch N] [--threads G,T,S] "
+                     "THEME:ENVIRONMENT:COUNT...\n",
+                     argv[0]);
+        return EXIT_FAILURE;
+    };
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string_view arg = argv[i];
+            const bool hasValue = i + 1 < argc;
+            if (arg == "--out" && hasValue) {
+                config.outputDirectory = argv[++i];
+            } else if (arg == "--data" && hasValue) {
+                dataDirectory = argv[++i];
+            } else if (arg == "--seed" && hasValue) {
+                config.seed = std::stoull(argv[++i]);
+            } else if (arg == "--batch" && hasValue) {
+                config.batchSize = std::stoul(argv[++i]);
+            } else if (arg == "--threads" && hasValue) {
+                parseThreads(argv[++i], config);
+            } else if (!arg.empty() && arg.front() != '-') {
+                config.mix.push_back(parseMixEntry(arg));
+            } else {
+                return usage();
+            }
+        }
+        if (config.outputDirectory.empty() || config.mix.empty()) {
+            return usage();
+        }
+        detail::DataLoader::instance().initialize(dataDirectory);
+        BulkCreatureGenerator generator(std::move(config));
+        std::fputs(BulkCreatureGenerator::formatReport(generator.run()).c_str(),
+                   stdout);
+    } catch (const std::exception &error) {
+        std::fprintf(stderr, "generate_creatures: %s\n", error.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace crescent::tools
@@ -0,0 +1,5 @@
+#include "BulkCreatureGenerator.h"
+
+int main(int argc, char **argv) {
+    return crescent::tools::runGenerateCli(argc, argv);
+}